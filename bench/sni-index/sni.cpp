@@ -0,0 +1,161 @@
+// Microbenchmark for the usockets SNI index (crypto/sni_tree.cpp) against the
+// std::map label tree it replaced.
+//
+//   c++ -std=c++20 -O2 bench/sni-index/sni.cpp packages/bun-usockets/src/crypto/sni_tree.cpp -o /tmp/sni-bench
+//   /tmp/sni-bench [names]
+//
+// Registers a multi-tenant edge's worth of names (default 100k, a fifth of
+// them wildcards), resolves the same hostname mix through both structures,
+// checks that every hostname lands on the same pattern, then times lookups
+// and a round of certificate churn (remove + re-add).
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+extern "C" {
+void *sni_new();
+void sni_free(void *sni, void (*cb)(void *));
+int sni_add(void *sni, const char *hostname, void *user);
+void *sni_remove(void *sni, const char *hostname);
+void *sni_find(void *sni, const char *hostname);
+}
+
+// The previous implementation: one std::map per label, walked right to left,
+// trying the label and then "*" at each level.
+struct LabelTree {
+  void *user = nullptr;
+  std::map<std::string, std::unique_ptr<LabelTree>, std::less<>> children;
+
+  static std::vector<std::string_view> labels(std::string_view name) {
+    std::vector<std::string_view> out;
+    while (!name.empty()) {
+      size_t dot = name.find('.');
+      out.push_back(name.substr(0, dot));
+      name.remove_prefix(dot == std::string_view::npos ? name.size() : dot + 1);
+    }
+    return out;
+  }
+
+  void add(std::string_view name, void *value) {
+    LabelTree *node = this;
+    for (std::string_view label : labels(name)) {
+      auto &child = node->children[std::string(label)];
+      if (!child) child = std::make_unique<LabelTree>();
+      node = child.get();
+    }
+    node->user = value;
+  }
+
+  void *find(const std::string_view *label, const std::string_view *end) const {
+    if (label == end) return user;
+    auto it = children.find(*label);
+    if (it != children.end()) {
+      if (void *found = it->second->find(label + 1, end)) return found;
+    }
+    it = children.find("*");
+    return it == children.end() ? nullptr : it->second->find(label + 1, end);
+  }
+
+  void *find(std::string_view name) const {
+    // The old tree parsed into a fixed array of 10 labels without allocating.
+    std::string_view parsed[10];
+    size_t count = 0;
+    while (!name.empty()) {
+      if (count == 10) return nullptr;
+      size_t dot = name.find('.');
+      parsed[count++] = name.substr(0, dot);
+      name.remove_prefix(dot == std::string_view::npos ? name.size() : dot + 1);
+    }
+    return find(parsed, parsed + count);
+  }
+};
+
+static std::string pattern(int i) {
+  if (i % 5 == 4) return "*.tenant" + std::to_string(i) + ".apps.example.net";
+  return "shop" + std::to_string(i) + ".customers.example.com";
+}
+
+static std::vector<std::string> makeHostnames(int names) {
+  std::vector<std::string> hostnames;
+  for (int i = 0; i < names; i += 3) {
+    hostnames.push_back("shop" + std::to_string(i) + ".customers.example.com");
+    hostnames.push_back("api.tenant" + std::to_string(i) + ".apps.example.net");
+    hostnames.push_back("unknown" + std::to_string(i) + ".example.org");
+  }
+  return hostnames;
+}
+
+template <typename F>
+static double nsPerOp(size_t ops, F f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / (double) ops;
+}
+
+int main(int argc, char **argv) {
+  int names = argc > 1 ? atoi(argv[1]) : 100000;
+
+  void *index = sni_new();
+  LabelTree tree;
+  double addIndex = nsPerOp(names, [&] {
+    for (int i = 0; i < names; i++) sni_add(index, pattern(i).c_str(), (void *) (uintptr_t) (i + 1));
+  });
+  double addTree = nsPerOp(names, [&] {
+    for (int i = 0; i < names; i++) tree.add(pattern(i), (void *) (uintptr_t) (i + 1));
+  });
+
+  std::vector<std::string> hostnames = makeHostnames(names);
+  size_t hits = 0;
+  for (const std::string &hostname : hostnames) {
+    void *expected = tree.find(hostname);
+    if (sni_find(index, hostname.c_str()) != expected) {
+      fprintf(stderr, "mismatch for %s\n", hostname.c_str());
+      return 1;
+    }
+    hits += expected != nullptr;
+  }
+
+  const int rounds = 20;
+  uintptr_t sink = 0;
+  double findIndex = nsPerOp(hostnames.size() * rounds, [&] {
+    for (int r = 0; r < rounds; r++)
+      for (const std::string &hostname : hostnames) sink += (uintptr_t) sni_find(index, hostname.c_str());
+  });
+  double findTree = nsPerOp(hostnames.size() * rounds, [&] {
+    for (int r = 0; r < rounds; r++)
+      for (const std::string &hostname : hostnames) sink += (uintptr_t) tree.find(hostname);
+  });
+
+  // Rotate a tenth of the certificates in place.
+  int churn = names / 10;
+  double churnIndex = nsPerOp(churn, [&] {
+    for (int i = 0; i < churn; i++) {
+      std::string name = pattern(i * 10);
+      void *user = sni_remove(index, name.c_str());
+      sni_add(index, name.c_str(), user);
+    }
+  });
+  for (const std::string &hostname : hostnames) {
+    if (sni_find(index, hostname.c_str()) != tree.find(hostname)) {
+      fprintf(stderr, "mismatch after churn for %s\n", hostname.c_str());
+      return 1;
+    }
+  }
+
+  printf("%d names, %zu hostnames (%zu matched)\n", names, hostnames.size(), hits);
+  printf("%-12s %10s %10s\n", "", "index", "label tree");
+  printf("%-12s %8.1fns %8.1fns\n", "add", addIndex, addTree);
+  printf("%-12s %8.1fns %8.1fns\n", "find", findIndex, findTree);
+  printf("%-12s %8.1fns\n", "replace", churnIndex);
+
+  sni_free(index, [](void *) {});
+  return sink == 42;
+}
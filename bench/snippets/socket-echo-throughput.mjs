@@ -0,0 +1,87 @@
+// TCP echo throughput and accept rate over loopback. Compare the epoll loop
+// with the io_uring one:
+//
+//   bun bench/snippets/socket-echo-throughput.mjs
+//   BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING=1 bun bench/snippets/socket-echo-throughput.mjs
+import { bench, group, run } from "../runner.mjs";
+
+const CONNECTIONS = 64;
+const MESSAGE = Buffer.alloc(16 * 1024, "x");
+const ROUNDS = 16;
+
+const server = Bun.listen({
+  hostname: "127.0.0.1",
+  port: 0,
+  socket: {
+    data(socket, chunk) {
+      socket.write(chunk);
+    },
+  },
+});
+
+function connect(onData) {
+  return Bun.connect({
+    hostname: server.hostname,
+    port: server.port,
+    socket: {
+      data(socket, chunk) {
+        onData(socket, chunk.length);
+      },
+    },
+  });
+}
+
+// Each client sends MESSAGE and waits for it to come back, ROUNDS times.
+let pending = 0;
+let done;
+const remaining = new Map();
+const clients = await Promise.all(
+  Array.from({ length: CONNECTIONS }, () =>
+    connect((socket, length) => {
+      let left = remaining.get(socket) - length;
+      if (left <= 0) {
+        const round = socket.data - 1;
+        socket.data = round;
+        if (round > 0) {
+          left = MESSAGE.length;
+          socket.write(MESSAGE);
+        } else if (--pending === 0) {
+          done();
+        }
+      }
+      remaining.set(socket, left);
+    }),
+  ),
+);
+
+group(`${CONNECTIONS} connections`, () => {
+  bench(`echo ${ROUNDS} x ${MESSAGE.length / 1024} KiB on each`, async () => {
+    const { promise, resolve } = Promise.withResolvers();
+    done = resolve;
+    pending = clients.length;
+    for (const socket of clients) {
+      socket.data = ROUNDS;
+      remaining.set(socket, MESSAGE.length);
+      socket.write(MESSAGE);
+    }
+    await promise;
+  });
+
+  bench("connect + 1 byte round trip + close", async () => {
+    await Promise.all(
+      Array.from({ length: CONNECTIONS }, () => {
+        const { promise, resolve } = Promise.withResolvers();
+        connect(socket => {
+          socket.end();
+          resolve();
+        }).then(socket => socket.write("x"));
+        return promise;
+      }),
+    );
+  });
+});
+
+await run();
+
+for (const socket of clients) socket.end();
+server.stop(true);
@@ -0,0 +1,62 @@
+// Cost of socket idle timeouts as the number of open connections grows:
+// re-arming a timeout (done on every read/write by HTTP servers) and the CPU
+// an otherwise idle process spends sweeping them.
+//
+//   bun bench/snippets/socket-idle-timeouts.mjs
+import { bench, group, run } from "../runner.mjs";
+
+const COUNTS = [1_000, 10_000];
+const IDLE_SAMPLE_MS = 10_000;
+
+const server = Bun.listen({
+  hostname: "127.0.0.1",
+  port: 0,
+  socket: { data() {} },
+});
+
+async function openSockets(count) {
+  const sockets = [];
+  for (let i = 0; i < count; i += 256) {
+    const batch = [];
+    for (let j = i; j < Math.min(count, i + 256); j++) {
+      batch.push(
+        Bun.connect({
+          hostname: server.hostname,
+          port: server.port,
+          socket: { data() {}, timeout() {} },
+        }),
+      );
+    }
+    sockets.push(...(await Promise.all(batch)));
+  }
+  return sockets;
+}
+
+const open = [];
+for (const count of COUNTS) {
+  const sockets = await openSockets(count - open.length);
+  open.push(...sockets);
+  for (const socket of open) socket.timeout(120);
+
+  // Nothing is due for two minutes, so any CPU spent here is sweep overhead.
+  const before = process.cpuUsage();
+  await Bun.sleep(IDLE_SAMPLE_MS);
+  const { user, system } = process.cpuUsage(before);
+  console.log(`${count} idle sockets: ${((user + system) / 1000).toFixed(1)}ms CPU over ${IDLE_SAMPLE_MS / 1000}s`);
+
+  const subset = open.slice();
+  group(`${count} sockets`, () => {
+    bench("re-arm timeout(120) on every socket", () => {
+      for (const socket of subset) socket.timeout(120);
+    });
+    bench("alternate timeout(30) / timeout(120) on every socket", () => {
+      for (const socket of subset) socket.timeout(30);
+      for (const socket of subset) socket.timeout(120);
+    });
+  });
+}
+
+await run();
+
+for (const socket of open) socket.end();
+server.stop(true);
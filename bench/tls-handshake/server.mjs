@@ -0,0 +1,19 @@
+// HTTPS server for the handshake-storm benchmark. Prints a READY line with the
+// port it bound, then answers every request with 200 "ok".
+//
+//   HANDSHAKE_THREADS=4 bun server.mjs
+import { join } from "node:path";
+
+const here = new URL(".", import.meta.url).pathname;
+
+const server = Bun.serve({
+  port: 0,
+  tls: {
+    key: Bun.file(join(here, "key.pem")),
+    cert: Bun.file(join(here, "cert.pem")),
+    handshakeThreads: Number(process.env.HANDSHAKE_THREADS ?? 0),
+  },
+  fetch: () => new Response("ok"),
+});
+
+console.log(`READY ${server.port}`);
@@ -0,0 +1,118 @@
+// TLS handshake storm: how much do new connections slow down established ones?
+//
+// Starts server.mjs once per HANDSHAKE_THREADS setting, opens KEEPALIVE
+// connections that ping the server back to back, and records their request
+// latency first on a quiet server and then while STORM fresh handshakes (no
+// session resumption, CONCURRENCY in flight) hit it. With signing on the
+// event loop every handshake's RSA signature sits in front of the pings; with
+// handshakeThreads it runs on crypto workers.
+//
+//   bun storm.mjs
+//   THREADS=0,2,4 STORM=5000 CONCURRENCY=500 bun storm.mjs
+import { spawn } from "node:child_process";
+import { createInterface } from "node:readline";
+import * as tls from "node:tls";
+
+const here = new URL(".", import.meta.url).pathname;
+const THREADS = (process.env.THREADS ?? "0,4").split(",").map(Number);
+const KEEPALIVE = Number(process.env.KEEPALIVE ?? 20);
+const STORM = Number(process.env.STORM ?? 2000);
+const CONCURRENCY = Number(process.env.CONCURRENCY ?? 200);
+const QUIET_MS = Number(process.env.QUIET_MS ?? 1000);
+
+async function startServer(threads) {
+  const proc = spawn(process.execPath, [`${here}server.mjs`], {
+    env: { ...process.env, HANDSHAKE_THREADS: String(threads) },
+    stdio: ["ignore", "pipe", "inherit"],
+  });
+  const rl = createInterface({ input: proc.stdout });
+  for await (const line of rl) {
+    const m = /^READY (\d+)$/.exec(line);
+    if (m) {
+      rl.close();
+      return { proc, port: Number(m[1]) };
+    }
+  }
+  throw new Error("server exited before READY");
+}
+
+function connect(port) {
+  return new Promise((resolve, reject) => {
+    const socket = tls.connect({ port, host: "127.0.0.1", rejectUnauthorized: false });
+    socket.once("secureConnect", () => resolve(socket));
+    socket.once("error", reject);
+  });
+}
+
+// One request at a time per socket; every response is the same size, so
+// counting "ok" bodies is enough to find the end of each one.
+function pinger(socket, samples) {
+  let stopped = false;
+  let start = 0;
+  const send = () => {
+    start = performance.now();
+    socket.write("GET / HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  };
+  socket.on("data", chunk => {
+    if (!chunk.toString("latin1").endsWith("ok")) return;
+    samples.push(performance.now() - start);
+    if (!stopped) send();
+  });
+  send();
+  return () => {
+    stopped = true;
+    socket.destroy();
+  };
+}
+
+async function storm(port) {
+  let started = 0;
+  let failed = 0;
+  const worker = async () => {
+    while (started < STORM) {
+      started++;
+      try {
+        (await connect(port)).destroy();
+      } catch {
+        failed++;
+      }
+    }
+  };
+  const start = performance.now();
+  await Promise.all(Array.from({ length: CONCURRENCY }, worker));
+  return { seconds: (performance.now() - start) / 1000, failed };
+}
+
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor((sorted.length * p) / 100))] ?? NaN;
+}
+
+function summarize(samples) {
+  const sorted = samples.toSorted((a, b) => a - b);
+  return `p50 ${percentile(sorted, 50).toFixed(2)} ms  p99 ${percentile(sorted, 99).toFixed(2)} ms  max ${sorted.at(-1).toFixed(2)} ms`;
+}
+
+for (const threads of THREADS) {
+  const { proc, port } = await startServer(threads);
+  try {
+    const quiet = [];
+    const during = [];
+    let samples = quiet;
+    const sockets = await Promise.all(Array.from({ length: KEEPALIVE }, () => connect(port)));
+    const stops = sockets.map(socket => pinger(socket, { push: ms => samples.push(ms) }));
+
+    await Bun.sleep(QUIET_MS);
+    samples = during;
+    const result = await storm(port);
+    for (const stop of stops) stop();
+
+    console.log(`handshakeThreads: ${threads}`);
+    console.log(`  quiet   ${summarize(quiet)}`);
+    console.log(`  storm   ${summarize(during)}`);
+    console.log(
+      `  ${STORM} handshakes in ${result.seconds.toFixed(2)} s (${(STORM / result.seconds).toFixed(0)}/s, ${result.failed} failed)`,
+    );
+  } finally {
+    proc.kill();
+  }
+}
@@ -0,0 +1,118 @@
+// Microbenchmark for uWS::HttpRouter: Node tree walk vs the compiled tree.
+//
+//   c++ -std=c++20 -O2 -I packages/bun-uws/src bench/uws-router/router.cpp -o /tmp/router-bench
+//   /tmp/router-bench [routes]
+//
+// Registers an API-gateway shaped route table (static prefixes, :params,
+// sibling :params that diverge further down, trailing wildcards, a catch-all
+// ANY route), routes the same URL mix through
+// both modes, checks that every URL lands on the same handler, then times them.
+
+#include "HttpRouter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct Match {
+  int handler = -1;
+  int params = 0;
+};
+
+using Router = uWS::HttpRouter<Match>;
+
+static void addRoutes(Router &router, int count) {
+  static const std::string_view methods[] = {"GET", "POST", "PUT", "DELETE"};
+  for (int i = 0; i < count; i++) {
+    std::string pattern;
+    switch (i % 4) {
+      case 0: pattern = "/api/v" + std::to_string(i % 3) + "/service" + std::to_string(i) + "/:id"; break;
+      case 1: pattern = "/api/v" + std::to_string(i % 3) + "/service" + std::to_string(i) + "/:id/items/:item"; break;
+      case 2: pattern = "/static/bucket" + std::to_string(i) + "/*"; break;
+      default: pattern = "/api/v" + std::to_string(i % 3) + "/service" + std::to_string(i) + "/health"; break;
+    }
+    std::string_view method = methods[i % 4];
+    router.add({&method, 1}, pattern, [i](Router *r) {
+      r->getUserData().handler = i;
+      r->getUserData().params = r->getParameters().first + 1;
+      return true;
+    });
+    if (i % 4 == 0) {
+      /* A sibling of /:id that only matches one segment further down */
+      std::string sibling = "/api/v" + std::to_string(i % 3) + "/service" + std::to_string(i) + "/:name/profile";
+      router.add({&method, 1}, sibling, [i, count](Router *r) {
+        r->getUserData().handler = count + i;
+        r->getUserData().params = r->getParameters().first + 1;
+        return true;
+      });
+    }
+  }
+  std::string_view any = Router::ANY_METHOD_TOKEN;
+  router.add({&any, 1}, "/*", [](Router *r) {
+    r->getUserData().handler = -2;
+    return true;
+  }, Router::LOW_PRIORITY);
+}
+
+static std::vector<std::pair<std::string, std::string>> makeRequests(int count) {
+  static const char *methods[] = {"GET", "POST", "PUT", "DELETE"};
+  std::vector<std::pair<std::string, std::string>> requests;
+  for (int i = 0; i < count * 2; i += 3) {
+    int route = i % count;
+    std::string base = "/api/v" + std::to_string(route % 3) + "/service" + std::to_string(route);
+    requests.emplace_back(methods[route % 4], base + "/1234");
+    requests.emplace_back(methods[route % 4], base + "/1234/profile");
+    requests.emplace_back(methods[route % 4], base + "/1234/items/abc");
+    requests.emplace_back(methods[route % 4], "/static/bucket" + std::to_string(route) + "/a/b.css");
+    requests.emplace_back(methods[route % 4], base + "/health");
+    requests.emplace_back("GET", "/missing/" + std::to_string(i));
+  }
+  return requests;
+}
+
+static double run(Router &router, const std::vector<std::pair<std::string, std::string>> &requests, long iterations, long &checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (long n = 0; n < iterations; n++) {
+    const auto &[method, url] = requests[n % requests.size()];
+    router.getUserData() = {};
+    router.route(method, url);
+    checksum += router.getUserData().handler;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+  int count = argc > 1 ? atoi(argv[1]) : 2000;
+  auto requests = makeRequests(count);
+
+  Router tree, compiled;
+  addRoutes(tree, count);
+  addRoutes(compiled, count);
+  tree.setCompileMode(Router::CompileMode::NEVER);
+  compiled.setCompileMode(Router::CompileMode::ALWAYS);
+
+  for (const auto &[method, url] : requests) {
+    tree.getUserData() = {};
+    compiled.getUserData() = {};
+    tree.route(method, url);
+    compiled.route(method, url);
+    if (tree.getUserData().handler != compiled.getUserData().handler ||
+        tree.getUserData().params != compiled.getUserData().params) {
+      fprintf(stderr, "mismatch for %s %s: tree=%d compiled=%d\n", method.c_str(), url.c_str(),
+              tree.getUserData().handler, compiled.getUserData().handler);
+      return 1;
+    }
+  }
+
+  long iterations = 2000000, treeChecksum = 0, compiledChecksum = 0;
+  double treeNs = run(tree, requests, iterations, treeChecksum);
+  double compiledNs = run(compiled, requests, iterations, compiledChecksum);
+
+  printf("%d routes, %zu distinct requests\n", count, requests.size());
+  printf("tree:     %7.1f ns/route\n", treeNs);
+  printf("compiled: %7.1f ns/route (%.2fx)\n", compiledNs, treeNs / compiledNs);
+  return treeChecksum == compiledChecksum ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// Microbenchmark for uWS WebSocket unmasking: the previous 4-bytes-per-step
+// loop vs protocol::unmask (WebSocketUnmask.h), which also reports whether the
+// payload was ASCII so text frames can skip UTF-8 validation.
+//
+// With Highway (vendor/highway is fetched by a regular build):
+//   c++ -std=c++20 -O2 -I packages/bun-uws/src -I src/jsc/bindings -I vendor/highway bench/uws-websocket/unmask.cpp src/jsc/bindings/highway_strings.cpp vendor/highway/hwy/targets.cc vendor/highway/hwy/abort.cc -o /tmp/unmask-bench
+// Without (protocol::unmask XORs a word at a time):
+//   c++ -std=c++20 -O2 -DUWS_NO_HIGHWAY -I packages/bun-uws/src bench/uws-websocket/unmask.cpp -o /tmp/unmask-bench
+//   /tmp/unmask-bench [megabytes per size]
+//
+// The timed loops unmask in place, like consumeContinuation; a correctness
+// check first unmasks over the masking key, like consumeMessage.
+
+#include "WebSocketUnmask.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef UWS_NO_HIGHWAY
+#include <hwy/targets.h>
+#endif
+
+/* What WebSocketProtocol::unmaskImprecise did: whole 4-byte groups, so it
+ * writes up to 4 bytes past the payload into the receive buffer's padding */
+static void previousUnmask(char *dst, char *src, char *mask, unsigned int length) {
+  for (unsigned int n = (length >> 2) + 1; n; n--) {
+    *(dst++) = *(src++) ^ mask[0];
+    *(dst++) = *(src++) ^ mask[1];
+    *(dst++) = *(src++) ^ mask[2];
+    *(dst++) = *(src++) ^ mask[3];
+  }
+}
+
+int main(int argc, char **argv) {
+  double megabytes = argc > 1 ? atof(argv[1]) : 2000;
+  const size_t sizes[] = {16, 125, 1024, 16 * 1024, 512 * 1024};
+  const char key[4] = {0x37, (char) 0xfa, 0x21, 0x3d};
+
+  for (size_t size : sizes) {
+    /* Masking key, then the masked payload, then post padding */
+    std::string frame(4 + size + 8, '\0');
+    memcpy(frame.data(), key, 4);
+    for (size_t i = 0; i < size; i++) {
+      frame[4 + i] = (char) ('a' + i % 26) ^ key[i % 4];
+    }
+
+    std::string previous = frame, fused = frame;
+    previousUnmask(previous.data(), previous.data() + 4, (char *) key, (unsigned int) size);
+    bool ascii = uWS::protocol::unmask(fused.data(), fused.data() + 4, key, size);
+    if (memcmp(previous.data(), fused.data(), size) != 0 || !ascii) {
+      fprintf(stderr, "mismatch at %zu bytes\n", size);
+      return 1;
+    }
+
+    long iterations = (long) (megabytes * 1024 * 1024 / size);
+    auto run = [&](auto unmask) {
+      std::string buffer = frame;
+      size_t checksum = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (long n = 0; n < iterations; n++) {
+        /* Unmasking twice restores the payload, so every round sees the same bytes */
+        checksum += unmask(buffer.data() + 4, buffer.data() + 4, size);
+        checksum += (unsigned char) buffer[n % size];
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      if (checksum == 0) printf("\n");
+      return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    };
+
+    double previousNs = run([&](char *dst, char *src, size_t length) {
+      previousUnmask(dst, src, (char *) key, (unsigned int) length);
+      return 0;
+    });
+    double fusedNs = run([&](char *dst, char *src, size_t length) {
+      return (int) uWS::protocol::unmask(dst, src, key, length);
+    });
+
+    printf("%7zu bytes: previous %8.1f ns (%6.2f GB/s)  unmask %8.1f ns (%6.2f GB/s, %.2fx)\n", size,
+        previousNs, size / previousNs, fusedNs, size / fusedNs, previousNs / fusedNs);
+  }
+
+#ifdef UWS_NO_HIGHWAY
+  printf("(UWS_NO_HIGHWAY)\n");
+#else
+  /* The best target both compiled and supported here is the one
+   * WebSocketUnmaskImpl dispatched to; lower bits are better targets */
+  int64_t targets = hwy::SupportedTargets() & HWY_TARGETS;
+  printf("(highway %s from 128 bytes)\n", hwy::TargetName(targets & -targets));
+#endif
+  return 0;
+}
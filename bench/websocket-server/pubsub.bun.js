@@ -0,0 +1,70 @@
+// Pub/sub microbenchmark for Bun.serve's TopicTree. See ./README.md.
+//
+// Connects CLIENTS_COUNT websockets to an in-process server, then times, on
+// the server side:
+//   - a subscribe/unsubscribe storm (every socket joins and leaves ROOMS rooms)
+//   - server.publish() fan-out to one topic holding every socket, with a
+//     PAYLOAD-byte message, compressed when DEFLATE=1
+const CLIENTS = parseInt(process.env.CLIENTS_COUNT || "", 10) || 2000;
+const ROOMS = parseInt(process.env.ROOMS || "", 10) || 64;
+const PUBLISHES = parseInt(process.env.PUBLISHES || "", 10) || 2000;
+const PAYLOAD = parseInt(process.env.PAYLOAD || "", 10) || 5;
+const DEFLATE = process.env.DEFLATE === "1";
+
+const sockets = [];
+let onAllOpen;
+const allOpen = new Promise(resolve => (onAllOpen = resolve));
+
+const server = Bun.serve({
+  port: 0,
+  websocket: {
+    open(ws) {
+      sockets.push(ws);
+      if (sockets.length === CLIENTS) onAllOpen();
+    },
+    message() {},
+    perMessageDeflate: DEFLATE,
+  },
+  fetch(req, server) {
+    if (server.upgrade(req)) return;
+    return new Response("Upgrade failed", { status: 400 });
+  },
+});
+
+const clients = [];
+let received = 0;
+for (let i = 0; i < CLIENTS; i++) {
+  const client = new WebSocket(`ws://localhost:${server.port}`);
+  client.onmessage = () => received++;
+  clients.push(client);
+}
+await allOpen;
+
+function time(label, ops, fn) {
+  const start = Bun.nanoseconds();
+  fn();
+  const ns = Bun.nanoseconds() - start;
+  console.log(`${label.padEnd(28)} ${(ns / 1e6).toFixed(1).padStart(8)} ms  ${(ns / ops).toFixed(0).padStart(6)} ns/op`);
+}
+
+const rooms = Array.from({ length: ROOMS }, (_, i) => `room-${i}`);
+
+for (let round = 0; round < 3; round++) {
+  time(`subscribe x${CLIENTS * ROOMS}`, CLIENTS * ROOMS, () => {
+    for (const ws of sockets) for (const room of rooms) ws.subscribe(room);
+  });
+  time(`unsubscribe x${CLIENTS * ROOMS}`, CLIENTS * ROOMS, () => {
+    for (const ws of sockets) for (const room of rooms) ws.unsubscribe(room);
+  });
+}
+
+for (const ws of sockets) ws.subscribe("everyone");
+const expected = received + CLIENTS * PUBLISHES;
+const message = Buffer.alloc(PAYLOAD, "hello ").toString();
+time(`publish to ${CLIENTS} x${PUBLISHES}`, CLIENTS * PUBLISHES, () => {
+  for (let i = 0; i < PUBLISHES; i++) server.publish("everyone", message, DEFLATE);
+});
+
+while (received < expected) await Bun.sleep(10);
+for (const client of clients) client.close();
+server.stop(true);
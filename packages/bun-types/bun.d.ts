@@ -4299,6 +4299,41 @@ declare module "bun" {
      */
     dhParamsFile?: string;
 
+    /**
+     * File path to one or more concatenated 48-byte session ticket keys
+     * (16-byte name, 16-byte HMAC secret, 16-byte AES key). The first key
+     * encrypts new tickets; the others still resume older ones.
+     *
+     * The file is re-read while the server runs, so processes sharing it
+     * (a file, `/dev/shm/...`, or `/dev/fd/N`) resume each other's sessions
+     * and pick up rotated keys together.
+     */
+    ticketKeysFile?: string;
+
+    /**
+     * Sign TLS handshakes on this many crypto worker threads instead of the
+     * event loop, so a burst of new connections does not stall requests on
+     * established ones. The worker pool is shared by the whole process and is
+     * sized by the largest value set before the first offloaded handshake.
+     * @default 0 (sign on the event loop)
+     */
+    handshakeThreads?: number;
+
+    /**
+     * Use TLS 1.3 early data (0-RTT) on resumed sessions.
+     *
+     * Servers accept it and answer requests before the handshake completes.
+     * Early data can be replayed by an attacker, so requests in it other than
+     * `GET`, `HEAD` and `OPTIONS` get `425 Too Early`.
+     *
+     * `fetch()` sends a request as early data when it resumes a session that
+     * allows it and the request is a `GET` or `HEAD` without a body. If the
+     * server rejects the early data, the request is sent again after the
+     * handshake, but only if the server presents the same certificate.
+     * @default false
+     */
+    earlyData?: boolean;
+
     /**
      * Explicitly set a server name
      */
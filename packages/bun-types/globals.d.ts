@@ -1940,6 +1940,17 @@ interface BunFetchRequestInit extends RequestInit {
    */
   verbose?: boolean;
 
+  /**
+   * Open new connections with TCP Fast Open, sending the start of the request
+   * in the SYN once the server has handed out a cookie. Linux only, and only
+   * for hosts that resolve to a single address; ignored otherwise. Connection
+   * errors may then surface on the first read instead of on connect.
+   *
+   * Not part of the Fetch API specification.
+   * @default false
+   */
+  tcpFastOpen?: boolean;
+
   /**
    * The proxy to send the request through, overriding the `http_proxy` and
    * `HTTPS_PROXY` environment variables. Accepts a URL string, a URL instance,
@@ -2153,6 +2164,23 @@ declare namespace fetch {
       https?: boolean;
     },
   ): void;
+
+  /**
+   * Client connections opened by this process that used `tcpFastOpen` or
+   * TLS early data (`tls.earlyData`).
+   *
+   * Not part of the Fetch API specification.
+   */
+  export function connectionStats(): {
+    /** Connections whose SYN carried data the server acknowledged */
+    fastOpen: number;
+    /** TLS connections that sent early data */
+    earlyData: number;
+    /** ...and the server accepted it */
+    earlyDataAccepted: number;
+    /** ...and the server rejected it, so it was sent again after the handshake */
+    earlyDataRejected: number;
+  };
 }
 //#endregion
 
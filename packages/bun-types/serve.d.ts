@@ -505,6 +505,20 @@ declare module "bun" {
      */
     publishToSelf?: boolean;
 
+    /**
+     * Share `publish()` across threads: every server in this process (for
+     * example one per `Worker`) whose websocket handler uses the same
+     * `broadcastGroup` delivers the others' published messages to its own
+     * subscribers. Each message is framed once by the publishing thread.
+     *
+     * @example
+     * ```js
+     * // in each Worker
+     * Bun.serve({ port: 3000, reusePort: true, fetch, websocket: { message, broadcastGroup: "chat" } });
+     * ```
+     */
+    broadcastGroup?: string;
+
     /**
      * Whether the server automatically sends pings to clients and responds to pings.
      *
@@ -522,8 +536,20 @@ declare module "bun" {
       | {
           /**
            * Sets the compression level.
+           *
+           * `"pooled"` compresses like `"dedicated"`, but sockets lease their
+           * sliding window from a bounded pool shared by the event loop instead
+           * of each holding one. A socket whose window went idle or was taken
+           * by a busier one starts its next message from an empty window.
+           */
+          compress?: WebSocketCompressor | "pooled" | boolean;
+          /**
+           * With `compress: "pooled"`, the most sliding windows the event loop
+           * keeps alive at once.
+           *
+           * @default 256
            */
-          compress?: WebSocketCompressor | boolean;
+          poolSize?: number;
           /**
            * Sets the decompression level.
            */
@@ -833,9 +859,13 @@ declare module "bun" {
        *
        * This allows multiple processes to bind to the same port, which is useful for load balancing.
        *
+       * Pass `"cpu"` to also steer each connection to the listener on the CPU that received it
+       * (Linux 6.2+). Each worker should be pinned to a single CPU, e.g. with `taskset -c N`;
+       * otherwise this behaves like `true`.
+       *
        * @default false
        */
-      reusePort?: boolean;
+      reusePort?: boolean | "cpu";
 
       /**
        * Whether the `IPV6_V6ONLY` flag should be set.
@@ -843,6 +873,14 @@ declare module "bun" {
        */
       ipv6Only?: boolean;
 
+      /**
+       * Accept TCP Fast Open, so a returning client's first request can arrive
+       * in its SYN. Count such connections with {@link Server.fastOpenConnections}.
+       * Linux and macOS only; ignored elsewhere.
+       * @default false
+       */
+      tcpFastOpen?: boolean;
+
       /**
        * Also listen for HTTP/3 (QUIC) on the same port. Requires {@link tls}.
        * @default false
@@ -1112,6 +1150,52 @@ declare module "bun" {
      */
     subscriberCount(topic: string): number;
 
+    /**
+     * Counters of the sliding-window pool used by `perMessageDeflate: { compress: "pooled" }`
+     * on this server's event loop. All zero when no route uses it.
+     */
+    webSocketCompressionStats(): {
+      /** Most windows alive at once */
+      capacity: number;
+      /** Windows alive now */
+      windows: number;
+      /** Connected sockets using the pool */
+      sockets: number;
+      /** Compressed messages that found their socket's window still leased */
+      hits: number;
+      /** Compressed messages that started from an empty window */
+      misses: number;
+      /** Windows taken from a socket because the pool was full or it idled */
+      evictions: number;
+      /** zlib memory held by the pool's windows */
+      windowBytes: number;
+      /** `windowBytes` divided by `sockets` */
+      bytesPerSocket: number;
+    };
+
+    /**
+     * Handshakes completed by this server's TLS contexts, including those of
+     * every `serverName`. `undefined` when the server is not using TLS.
+     */
+    tlsSessionStats():
+      | {
+          /** Handshakes that resumed a session from a ticket */
+          resumed: number;
+          /** Handshakes that negotiated a new session */
+          full: number;
+          /** Keys currently loaded from `tls.ticketKeysFile` */
+          ticketKeys: number;
+          /** Times `tls.ticketKeysFile` was re-read with new keys */
+          ticketKeyReloads: number;
+          /** Times `tls.ticketKeysFile` could not be re-read; the previous keys stay in use */
+          ticketKeyErrors: number;
+          /** Handshakes that accepted TLS early data (`tls.earlyData`) */
+          earlyData: number;
+          /** Requests in early data refused with `425 Too Early` */
+          tooEarly: number;
+        }
+      | undefined;
+
     /**
      * Returns the client IP address and port of the given Request. If the request was closed or is a unix socket, returns null.
      *
@@ -1171,6 +1255,12 @@ declare module "bun" {
      */
     readonly pendingWebSockets: number;
 
+    /**
+     * Connections accepted with data in their SYN (`tcpFastOpen`). Always `0`
+     * on platforms that cannot report it.
+     */
+    readonly fastOpenConnections: number;
+
     readonly url: URL;
 
     /**
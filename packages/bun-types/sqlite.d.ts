@@ -578,6 +578,28 @@ declare module "bun:sqlite" {
      * @link https://www.sqlite.org/c3ref/file_control.html
      */
     fileControl(zDbName: string, op: number, arg?: ArrayBufferView | number): number;
+
+    /**
+     * Open a BLOB value for incremental I/O, without reading it into memory.
+     *
+     * The handle reads and writes byte ranges of the value in `column` of the
+     * row with `rowid` in `table`. It stops working if that row is changed or
+     * deleted, and it is closed when the database is.
+     *
+     * @param table the table holding the value
+     * @param column the column holding the value
+     * @param rowid the rowid of the row holding the value
+     * @param options `writable` to allow {@link SQLiteBlob.write}; `schema` for an attached database (default `"main"`)
+     *
+     * @example
+     * ```ts
+     * using blob = db.openBlob("files", "data", id);
+     * return new Response(blob.stream());
+     * ```
+     *
+     * @link https://www.sqlite.org/c3ref/blob_open.html
+     */
+    openBlob(table: string, column: string, rowid: number | bigint, options?: { writable?: boolean; schema?: string }): SQLiteBlob;
   }
 
   /**
@@ -636,6 +658,28 @@ declare module "bun:sqlite" {
      */
     all(...params: ParamsType): ReturnType[];
 
+    /**
+     * Like {@link all}, but the query runs on a worker thread against a
+     * read-only connection to the same database file, so the event loop keeps
+     * running while it steps. Read connections are pooled per database.
+     *
+     * Only read-only statements on file-backed databases are supported. The
+     * read connections do not see uncommitted changes from this connection, or
+     * extensions and functions registered on it. In WAL mode reads and writes
+     * do not block each other.
+     *
+     * @param params optional values to bind to the statement. If omitted, the statement runs with no parameters bound.
+     *
+     * @example
+     * ```ts
+     * const stmt = db.prepare("SELECT * FROM orders WHERE region = ?");
+     *
+     * await stmt.allAsync("emea");
+     * // => [{id: 1, region: "emea"}, ...]
+     * ```
+     */
+    allAsync(...params: ParamsType): Promise<ReturnType[]>;
+
     /**
      * Execute the prepared statement and return **the first** result.
      *
@@ -712,6 +756,37 @@ declare module "bun:sqlite" {
      */
     run(...params: ParamsType): Changes;
 
+    /**
+     * Execute the prepared statement once for each row of `rows`, in a single
+     * call.
+     *
+     * `rows` is an array of parameter lists, each bound like the arguments to
+     * {@link run}, or a columnar batch shaped like the result of
+     * {@link columnar}, with one array, `Float64Array` or `BigInt64Array` per
+     * parameter.
+     *
+     * Unless `transaction` is `false`, the batch runs in a transaction of its
+     * own (a savepoint inside an open one), so if a row fails none are applied.
+     *
+     * @returns The total `changes` and the last `lastInsertRowid`
+     *
+     * @example
+     * ```ts
+     * const insert = db.prepare("INSERT INTO users (name, age) VALUES ($name, $age)");
+     * insert.runBatch([
+     *   { $name: "Alice", $age: 30 },
+     *   { $name: "Bob", $age: 25 },
+     * ]);
+     * // => { changes: 2, lastInsertRowid: 2 }
+     *
+     * insert.runBatch({ columns: { $name: ["Carol", "Dan"], $age: new Float64Array([41, 52]) } });
+     * ```
+     */
+    runBatch(
+      rows: ParamsType[] | ParamsType[number][] | Statement.ColumnarBatch,
+      options?: { transaction?: boolean },
+    ): Changes;
+
     /**
      * Execute the prepared statement and return the results as an array of arrays.
      *
@@ -774,6 +849,34 @@ declare module "bun:sqlite" {
      */
     raw(...params: ParamsType): Array<Array<Uint8Array | null>>;
 
+    /**
+     * Execute the prepared statement and return the results one column at a
+     * time instead of one row at a time.
+     *
+     * A column whose values are all numbers comes back as a `Float64Array`
+     * (or a `BigInt64Array` with `safeIntegers`), a column of text as a
+     * `string[]` and a column of blobs as a `Uint8Array[]`. A column that mixes
+     * types comes back as the array {@link all} would have built.
+     *
+     * NULLs are recorded in `nulls`, which only has an entry for columns that
+     * contained one: bit `i % 8` of byte `i >> 3` is set when row `i` is NULL.
+     * In a typed array the slot holds `0`; in a plain array it holds `null`.
+     *
+     * @param params optional values to bind to the statement. If omitted, the
+     * statement is run with the last bound values or no parameters if there are
+     * none.
+     *
+     * @example
+     * ```ts
+     * const stmt = db.prepare("SELECT id, price, name FROM products");
+     *
+     * const { length, columns, nulls } = stmt.columnar();
+     * // columns.price => Float64Array(3) [9.5, 0, 12]
+     * // nulls.price => Uint8Array(1) [2]
+     * ```
+     */
+    columnar(...params: ParamsType): Statement.ColumnarResult;
+
     /**
      * The names of the columns returned by the prepared statement.
      * @example
@@ -1255,6 +1358,33 @@ declare module "bun:sqlite" {
    */
   export var native: any;
 
+  export namespace Statement {
+    /**
+     * The value returned by {@link Statement.columnar}.
+     */
+    interface ColumnarResult {
+      /** The number of rows */
+      length: number;
+      /** One array per column, keyed by column name */
+      columns: Record<string, Float64Array | BigInt64Array | Array<string | null> | Array<Uint8Array | null> | unknown[]>;
+      /** A NULL bitmap for each column that contained a NULL */
+      nulls: Record<string, Uint8Array>;
+    }
+
+    /**
+     * The columnar input accepted by {@link Statement.runBatch}. Columns are
+     * keyed like an object of bindings; `?` and `?NNN` parameters by position
+     * from `0`.
+     */
+    interface ColumnarBatch {
+      /** The number of rows. Defaults to the length of the first column. */
+      length?: number;
+      columns: Record<string, Float64Array | BigInt64Array | ArrayLike<unknown>>;
+      /** NULL bitmaps, as in {@link ColumnarResult.nulls} */
+      nulls?: Record<string, Uint8Array>;
+    }
+  }
+
   export type SQLQueryBindings =
     | string
     | bigint
@@ -1266,6 +1396,48 @@ declare module "bun:sqlite" {
 
   export default Database;
 
+  /**
+   * An open BLOB value, from {@link Database.openBlob}. Data is copied
+   * directly between SQLite and the buffers you pass, a range at a time.
+   */
+  export class SQLiteBlob implements Disposable {
+    private constructor();
+
+    /** The size of the value in bytes. Writes cannot change it. */
+    readonly size: number;
+
+    /**
+     * Fill `buffer` with bytes starting at `offset`.
+     *
+     * @returns the number of bytes read, less than `buffer.byteLength` only at the end of the value
+     */
+    read(buffer: ArrayBufferView, offset?: number): number;
+
+    /**
+     * Overwrite bytes starting at `offset`. The write must fit within {@link size}.
+     */
+    write(data: ArrayBufferView | ArrayBufferLike, offset?: number): void;
+
+    /**
+     * Move the handle to the same column of another row, which is faster than
+     * opening a new one.
+     */
+    reopen(rowid: number | bigint): void;
+
+    /**
+     * A byte stream of the value, read `chunkSize` bytes at a time. It
+     * supports BYOB readers and can be passed to `new Response()`.
+     */
+    stream(chunkSize?: number): ReadableStream<Uint8Array>;
+
+    bytes(): Promise<Uint8Array>;
+    arrayBuffer(): Promise<ArrayBuffer>;
+    text(): Promise<string>;
+
+    close(): void;
+    [Symbol.dispose](): void;
+  }
+
   /**
    * An error from SQLite. The `name` is `"SQLiteError"`.
    */
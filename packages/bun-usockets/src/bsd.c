@@ -74,6 +74,145 @@ extern void uv__winsock_ensure(void);
 #endif
 
 
+#if defined(__linux__)
+#include <netinet/udp.h>
+#include <sched.h>
+
+#ifndef SO_INCOMING_CPU
+#define SO_INCOMING_CPU 49
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+/* UDP generic segmentation offload (Linux 4.18): one sendmsg carrying a
+ * UDP_SEGMENT cmsg hands the kernel a run of equal-sized datagrams to the same
+ * peer (only the last may be shorter), which it splits as late as the NIC
+ * allows. The segment count is the kernel's UDP_MAX_SEGMENTS on older
+ * kernels; a segment must fit the path MTU without fragmenting, so only runs
+ * of Ethernet-sized datagrams are coalesced. */
+#define BSD_UDP_GSO_MAX_SEGMENTS 64
+#define BSD_UDP_GSO_MAX_SEGMENT_SIZE 1472
+#define BSD_UDP_GSO_MAX_BYTES 64000
+
+/* -1 = not probed yet, 0 = unsupported, 1 = supported. */
+static int has_udp_gso = -1;
+
+static int bsd_udp_gso_supported(LIBUS_SOCKET_DESCRIPTOR fd) {
+    if (has_udp_gso < 0) {
+        int segment = 0;
+        socklen_t len = sizeof(segment);
+        has_udp_gso = getsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &segment, &len) == 0;
+    }
+    return has_udp_gso;
+}
+
+static size_t bsd_msghdr_length(const struct msghdr *msg) {
+    size_t length = 0;
+    for (size_t i = 0; i < msg->msg_iovlen; i++) length += msg->msg_iov[i].iov_len;
+    return length;
+}
+
+static int bsd_msghdr_same_peer(const struct msghdr *a, const struct msghdr *b) {
+    return a->msg_namelen == b->msg_namelen &&
+        (a->msg_namelen == 0 || memcmp(a->msg_name, b->msg_name, a->msg_namelen) == 0);
+}
+
+static int bsd_sendmmsg_plain(LIBUS_SOCKET_DESCRIPTOR fd, struct mmsghdr *msgs, unsigned int n, int flags) {
+    while (1) {
+        int ret = sendmmsg(fd, msgs, n, flags);
+        if (ret >= 0 || errno != EINTR) return ret;
+    }
+}
+
+int bsd_sendmmsg_gso(LIBUS_SOCKET_DESCRIPTOR fd, struct mmsghdr *msgs, unsigned int n, int flags) {
+    if (n < 2 || !bsd_udp_gso_supported(fd)) {
+        return bsd_sendmmsg_plain(fd, msgs, n, flags);
+    }
+
+    enum { BATCH = 64, IOVS = 256 };
+    struct mmsghdr out[BATCH];
+    /* How many of `msgs` each entry of `out` carries. */
+    unsigned int runs[BATCH];
+    struct iovec iov[IOVS];
+    union {
+        char buf[CMSG_SPACE(sizeof(uint16_t))];
+        struct cmsghdr align;
+    } control[BATCH];
+
+    unsigned int done = 0;
+    while (done < n) {
+        unsigned int k = 0, i = done, used_iov = 0;
+        while (i < n && k < BATCH) {
+            struct msghdr *first = &msgs[i].msg_hdr;
+            size_t segment = bsd_msghdr_length(first);
+            size_t total = segment;
+            unsigned int run = 1;
+            size_t iovlen = first->msg_iovlen;
+            if (segment && segment <= BSD_UDP_GSO_MAX_SEGMENT_SIZE && !first->msg_controllen) {
+                while (i + run < n && run < BSD_UDP_GSO_MAX_SEGMENTS) {
+                    struct msghdr *next = &msgs[i + run].msg_hdr;
+                    size_t length = bsd_msghdr_length(next);
+                    if (!length || length > segment || total + length > BSD_UDP_GSO_MAX_BYTES ||
+                        next->msg_controllen || !bsd_msghdr_same_peer(first, next) ||
+                        used_iov + iovlen + next->msg_iovlen > IOVS) break;
+                    total += length;
+                    iovlen += next->msg_iovlen;
+                    run++;
+                    /* Only the last segment may be short. */
+                    if (length < segment) break;
+                }
+            }
+
+            out[k].msg_hdr = *first;
+            out[k].msg_len = 0;
+            if (run > 1) {
+                struct iovec *dst = iov + used_iov;
+                for (unsigned int m = 0; m < run; m++) {
+                    const struct msghdr *src = &msgs[i + m].msg_hdr;
+                    memcpy(iov + used_iov, src->msg_iov, src->msg_iovlen * sizeof(struct iovec));
+                    used_iov += src->msg_iovlen;
+                }
+                out[k].msg_hdr.msg_iov = dst;
+                out[k].msg_hdr.msg_iovlen = iovlen;
+                out[k].msg_hdr.msg_control = control[k].buf;
+                out[k].msg_hdr.msg_controllen = sizeof(control[k].buf);
+                struct cmsghdr *cm = CMSG_FIRSTHDR(&out[k].msg_hdr);
+                cm->cmsg_level = IPPROTO_UDP;
+                cm->cmsg_type = UDP_SEGMENT;
+                cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t size = (uint16_t) segment;
+                memcpy(CMSG_DATA(cm), &size, sizeof(size));
+            }
+            runs[k++] = run;
+            i += run;
+        }
+
+        int ret = bsd_sendmmsg_plain(fd, out, k, flags);
+        if (ret < 0 && (errno == EIO || errno == EINVAL)) {
+            /* EIO: the route's device cannot checksum segments, which will not
+             * change, so stop coalescing. EINVAL: a segment exceeds this path's
+             * MTU. Either way send this batch as plain datagrams. */
+            if (errno == EIO) has_udp_gso = 0;
+            unsigned int batch = i - done;
+            ret = bsd_sendmmsg_plain(fd, msgs + done, batch, flags);
+            if (ret < 0) return done ? (int) done : ret;
+            done += (unsigned int) ret;
+            if ((unsigned int) ret < batch) break;
+            continue;
+        }
+        if (ret < 0) return done ? (int) done : ret;
+        for (int m = 0; m < ret; m++) done += runs[m];
+        if ((unsigned int) ret < k) break;
+    }
+    return (int) done;
+}
+#endif
+
 /* We need to emulate sendmmsg, recvmmsg on platform who don't have it */
 int bsd_sendmmsg(LIBUS_SOCKET_DESCRIPTOR fd, struct udp_sendbuf* sendbuf, int flags) {
 #if defined(_WIN32)// || defined(__APPLE__)
@@ -137,10 +276,7 @@ int bsd_sendmmsg(LIBUS_SOCKET_DESCRIPTOR fd, struct udp_sendbuf* sendbuf, int fl
 
     return sendbuf->num;
 #else
-    while (1) {
-        int ret = sendmmsg(fd, sendbuf->msgvec, sendbuf->num, flags | MSG_NOSIGNAL);
-        if (ret >= 0 || errno != EINTR) return ret;
-    }
+    return bsd_sendmmsg_gso(fd, sendbuf->msgvec, sendbuf->num, flags | MSG_NOSIGNAL);
 #endif
 }
 
@@ -303,6 +439,36 @@ int bsd_udp_packet_buffer_payload_length(struct udp_recvbuf *msgvec, int index)
 #endif
 }
 
+int bsd_udp_packet_buffer_segment_size(struct udp_recvbuf *msgvec, int index) {
+#if defined(__linux__)
+    /* Set by UDP_GRO when the kernel coalesced several datagrams from one
+     * peer into this buffer: each is this long, the last possibly shorter. */
+    struct msghdr *mh = &((struct mmsghdr *) msgvec)[index].msg_hdr;
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(mh); cm; cm = CMSG_NXTHDR(mh, cm)) {
+        if (cm->cmsg_level == IPPROTO_UDP && cm->cmsg_type == UDP_GRO) {
+            int size;
+            memcpy(&size, CMSG_DATA(cm), sizeof(size));
+            return size;
+        }
+    }
+#else
+    (void) msgvec;
+    (void) index;
+#endif
+    return 0;
+}
+
+int bsd_socket_udp_gro(LIBUS_SOCKET_DESCRIPTOR fd, int enabled) {
+#if defined(__linux__)
+    return setsockopt(fd, IPPROTO_UDP, UDP_GRO, &enabled, sizeof(enabled));
+#else
+    (void) fd;
+    (void) enabled;
+    errno = ENOPROTOOPT;
+    return -1;
+#endif
+}
+
 int bsd_udp_packet_buffer_truncated(struct udp_recvbuf *msgvec, int index) {
 #if defined(_WIN32)
     /* On Windows, WSARecvFrom signals truncation via WSAEMSGSIZE on recv,
@@ -1095,6 +1261,31 @@ static int bsd_set_reuseport(LIBUS_SOCKET_DESCRIPTOR listenFd) {
 #endif
 }
 
+/* Pin a reuseport listener to the CPU the calling thread is pinned to. Since
+ * Linux 6.2 the reuseport group prefers the listener whose SO_INCOMING_CPU
+ * matches the CPU that received the SYN, so a worker pinned to one core (and
+ * its NIC RX queue) only accepts connections that already landed there; any
+ * CPU without such a listener falls back to the usual hash. Best-effort: a
+ * thread allowed on more than one CPU leaves the listener unsteered. */
+static void bsd_set_reuseport_cpu_affine(LIBUS_SOCKET_DESCRIPTOR listenFd) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0 || CPU_COUNT(&set) != 1) {
+        return;
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            setsockopt(listenFd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu));
+            return;
+        }
+    }
+#else
+    (void) listenFd;
+#endif
+}
+
 static int bsd_set_reuse(LIBUS_SOCKET_DESCRIPTOR listenFd, int options) {
     int result = 0;
 
@@ -1127,6 +1318,10 @@ static int bsd_set_reuse(LIBUS_SOCKET_DESCRIPTOR listenFd, int options) {
 
             return result;
         }
+
+        if ((options & LIBUS_LISTEN_REUSE_PORT_CPU_AFFINE)) {
+            bsd_set_reuseport_cpu_affine(listenFd);
+        }
     }
 
     return 0;
@@ -1162,6 +1357,10 @@ inline __attribute__((always_inline)) LIBUS_SOCKET_DESCRIPTOR bsd_bind_listen_fd
     }
 #endif
 
+    if (options & LIBUS_SOCKET_FAST_OPEN) {
+        bsd_set_fast_open(listenFd);
+    }
+
     if (us_internal_bind_and_listen(listenFd, listenAddr->ai_addr, (socklen_t) listenAddr->ai_addrlen, 512, error)) {
         return LIBUS_SOCKET_ERROR;
     }
@@ -1187,6 +1386,48 @@ int bsd_set_defer_accept(LIBUS_SOCKET_DESCRIPTOR listenFd) {
 #endif
 }
 
+void bsd_set_fast_open(LIBUS_SOCKET_DESCRIPTOR listenFd) {
+#if defined(TCP_FASTOPEN)
+#if defined(__linux__)
+    /* Linux takes the queue of pending SYN-data connections; the others a flag. */
+    int qlen = 256;
+#else
+    int qlen = 1;
+#endif
+    setsockopt(listenFd, IPPROTO_TCP, TCP_FASTOPEN, (const char *) &qlen, sizeof(qlen));
+#else
+    (void) listenFd;
+#endif
+}
+
+void bsd_set_fast_open_connect(LIBUS_SOCKET_DESCRIPTOR fd) {
+#if defined(TCP_FASTOPEN_CONNECT)
+    /* connect() then returns at once and the SYN waits for the first write,
+     * carrying it (with the cookie cached from an earlier connection). */
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &one, sizeof(one));
+#else
+    (void) fd;
+#endif
+}
+
+int bsd_socket_syn_data(LIBUS_SOCKET_DESCRIPTOR fd) {
+#if defined(__linux__) && defined(TCP_INFO)
+#ifndef TCPI_OPT_SYN_DATA
+#define TCPI_OPT_SYN_DATA 32
+#endif
+    struct tcp_info info;
+    socklen_t len = sizeof(info);
+    if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) != 0) {
+        return 0;
+    }
+    return (info.tcpi_options & TCPI_OPT_SYN_DATA) != 0;
+#else
+    (void) fd;
+    return 0;
+#endif
+}
+
 // return LIBUS_SOCKET_ERROR or the fd that represents listen socket
 // listen both on ipv6 and ipv4
 int bsd_socket_export_size(void) {
@@ -2039,6 +2280,10 @@ LIBUS_SOCKET_DESCRIPTOR bsd_create_connect_socket(struct sockaddr_storage *addr,
     }
 
 #endif
+    if (options & LIBUS_SOCKET_FAST_OPEN) {
+        bsd_set_fast_open_connect(fd);
+    }
+
     int rc = bsd_do_connect_raw(fd, (struct sockaddr*) addr, addr->ss_family == AF_INET ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6));
 
     if (rc != 0) {
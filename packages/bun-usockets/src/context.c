@@ -59,9 +59,9 @@ void us_socket_group_deinit(struct us_socket_group_t *group) {
      * low-prio count must be zero or some socket/listener/DNS request still
      * holds s->group / c->group / ls->accept_group into us — that's a UAF the
      * caller must close_all() away first. iterator != NULL means we're inside
-     * a dispatch on this very group; the on_close that triggers deinit is fine
+     * close_all on this very group; the on_close that triggers deinit is fine
      * (unlink_socket already advanced iterator), but a re-entrant deinit from
-     * inside on_timeout/on_data would tear the floor out from under the sweep. */
+     * inside another handler would tear the floor out from under the walk. */
     US_ASSERT(group->head_sockets == NULL);
     US_ASSERT(group->head_connecting_sockets == NULL);
     US_ASSERT(group->head_listen_sockets == NULL);
@@ -99,8 +99,7 @@ void us_socket_group_close_all_ex(struct us_socket_group_t *group, int also_list
      * *sibling*, and the sibling is what a plain cached `next` would point at.
      * us_internal_socket_group_unlink_socket advances group->iterator past any
      * socket it unlinks, so parking the next pointer there lets a handler free
-     * it without leaving us a dangling step (same pattern as the timeout sweep
-     * in loop.c). */
+     * it without leaving us a dangling step. */
     group->iterator = group->head_sockets;
     while (group->iterator) {
         struct us_socket_t *s = group->iterator;
@@ -167,10 +166,6 @@ void us_socket_group_close_all(struct us_socket_group_t *group) {
     us_socket_group_close_all_ex(group, 1);
 }
 
-unsigned short us_socket_group_timestamp(struct us_socket_group_t *group) {
-    return group->timestamp;
-}
-
 __attribute__((always_inline)) struct us_loop_t *us_socket_group_loop(struct us_socket_group_t *group) {
     return group->loop;
 }
@@ -218,13 +213,17 @@ void us_internal_socket_group_link_socket(struct us_socket_group_t *group, struc
     group->head_sockets = s;
     us_internal_group_touched(group);
     us_internal_enable_sweep_timer(group->loop);
+    if (s->timeout_tick || s->long_timeout_tick) {
+        us_internal_socket_timeout_update(s);
+    }
 }
 
 void us_internal_socket_group_unlink_socket(struct us_socket_group_t *group, struct us_socket_t *s) {
-    /* We have to properly update the iterator used to sweep sockets for timeouts */
+    /* We have to properly update the iterator used by close_all */
     if (s == group->iterator) {
         group->iterator = s->next;
     }
+    us_internal_socket_timeout_unlink(s);
 
     struct us_socket_t* prev = s->prev;
     struct us_socket_t* next = s->next;
@@ -288,7 +287,7 @@ struct us_socket_t *us_socket_adopt(struct us_socket_t *s, struct us_socket_grou
     struct us_loop_t *loop = old_group->loop;
 
     if (s->flags.low_prio_state != 1) {
-        /* This properly updates the iterator if in on_timeout */
+        /* This properly updates the iterator if in close_all */
         us_internal_socket_group_unlink_socket(old_group, s);
     } else if (old_group != group) {
         /* Stays on the loop-wide low-prio queue, but s->group changes owner —
@@ -330,8 +329,8 @@ struct us_socket_t *us_socket_adopt(struct us_socket_t *s, struct us_socket_grou
     }
     new_s->group = group;
     new_s->kind = kind;
-    new_s->timeout = 255;
-    new_s->long_timeout = 255;
+    new_s->timeout_tick = 0;
+    new_s->long_timeout_tick = 0;
 
     if (new_s->flags.low_prio_state == 1) {
         /* update pointers in low-priority queue */
@@ -355,8 +354,8 @@ static void us_internal_init_listen_socket(struct us_listen_socket_t *ls,
     s->group = group;
     s->kind = 0; /* listener itself never dispatches */
     s->ssl = NULL;
-    s->timeout = 255;
-    s->long_timeout = 255;
+    us_internal_socket_timeout_init(s);
+    us_internal_socket_zerocopy_init(s);
     s->flags.low_prio_state = 0;
     s->flags.is_paused = 0;
     s->flags.is_ipc = 0;
@@ -365,6 +364,7 @@ static void us_internal_init_listen_socket(struct us_listen_socket_t *ls,
     s->flags.allow_half_open = (options & LIBUS_SOCKET_ALLOW_HALF_OPEN);
     s->unclassified_send_failures = 0;
     s->read_eof = 0;
+    s->fast_open_pending = 0;
     s->next = 0;
     s->prev = 0;
     s->connect_state = NULL;
@@ -378,6 +378,8 @@ static void us_internal_init_listen_socket(struct us_listen_socket_t *ls,
     ls->on_server_name = NULL;
     ls->socket_ext_size = socket_ext_size;
     ls->deferred_accept = 0;
+    ls->fast_open = (options & LIBUS_SOCKET_FAST_OPEN) != 0;
+    ls->fast_open_accepted = 0;
 
     /* Link into the group so close_all() / test-isolation can find it. */
     ls->next = group->head_listen_sockets;
@@ -447,6 +449,9 @@ struct us_listen_socket_t *us_socket_group_listen_fd(struct us_socket_group_t *g
     if (options & LIBUS_LISTEN_DEFER_ACCEPT) {
         ls->deferred_accept = bsd_set_defer_accept(fd);
     }
+    if (options & LIBUS_SOCKET_FAST_OPEN) {
+        bsd_set_fast_open(fd);
+    }
 
     return ls;
 }
@@ -476,6 +481,10 @@ struct us_listen_socket_t *us_socket_group_listen_unix(struct us_socket_group_t
     return ls;
 }
 
+unsigned long long us_listen_socket_fast_open_count(struct us_listen_socket_t *ls) {
+    return ls->fast_open_accepted;
+}
+
 void us_listen_socket_close(struct us_listen_socket_t *ls) {
     struct us_socket_t *s = &ls->s;
     if (!us_socket_is_closed(s)) {
@@ -533,8 +542,8 @@ static inline void us_internal_init_connect_socket(struct us_socket_t *s,
     s->group = group;
     s->kind = kind;
     s->ssl = NULL;
-    s->timeout = 255;
-    s->long_timeout = 255;
+    us_internal_socket_timeout_init(s);
+    us_internal_socket_zerocopy_init(s);
     s->flags.low_prio_state = 0;
     s->flags.allow_half_open = (options & LIBUS_SOCKET_ALLOW_HALF_OPEN);
     s->flags.is_paused = 0;
@@ -544,6 +553,7 @@ static inline void us_internal_init_connect_socket(struct us_socket_t *s,
     s->flags.last_write_failed = 0;
     s->unclassified_send_failures = 0;
     s->read_eof = 0;
+    s->fast_open_pending = (options & LIBUS_SOCKET_FAST_OPEN) != 0;
     s->connect_state = NULL;
     s->connect_next = NULL;
 }
@@ -649,8 +659,6 @@ void *us_socket_group_connect(struct us_socket_group_t *group, unsigned char kin
     c->loop = loop;
     c->ssl_ctx = ssl_ctx;
     if (ssl_ctx) us_internal_ssl_ctx_up_ref(ssl_ctx);
-    c->timeout = 255;
-    c->long_timeout = 255;
     c->pending_resolve_callback = 1;
     c->addrinfo_req = ai_req;
     c->port = port;
@@ -703,8 +711,15 @@ int start_connections(struct us_connecting_socket_t *c, int count) {
     for (; c->addrinfo_head != NULL && opened < count; c->addrinfo_head = c->addrinfo_head->ai_next) {
         struct sockaddr_storage addr;
         init_addr_with_port(c->addrinfo_head, c->port, &addr);
+        /* A fast-open socket is writable before its SYN is even sent, so it
+         * would win the race between addresses by default; only a lone
+         * address keeps it. */
+        int options = c->options;
+        if (c->addrinfo_head->ai_next || c->connecting_head) {
+            options &= ~LIBUS_SOCKET_FAST_OPEN;
+        }
         /* The deferred-DNS path does not carry a local binding. */
-        LIBUS_SOCKET_DESCRIPTOR connect_socket_fd = bsd_create_connect_socket(&addr, NULL, c->options);
+        LIBUS_SOCKET_DESCRIPTOR connect_socket_fd = bsd_create_connect_socket(&addr, NULL, options);
         if (connect_socket_fd == LIBUS_SOCKET_ERROR) {
             continue;
         }
@@ -718,9 +733,9 @@ int start_connections(struct us_connecting_socket_t *c, int count) {
             continue;
         }
         ++opened;
-        us_internal_init_connect_socket(s, group, c->kind, c->options);
-        s->timeout = c->timeout;
-        s->long_timeout = c->long_timeout;
+        us_internal_init_connect_socket(s, group, c->kind, options);
+        s->timeout_tick = c->timeout_tick;
+        s->long_timeout_tick = c->long_timeout_tick;
 
         us_internal_socket_group_link_socket(group, s);
 
@@ -25,19 +25,24 @@
 #include <stdatomic.h>
 #include <time.h>
 
-/* These are in sni_tree.cpp */
-void *sni_new();
-void sni_free(void *sni, void (*cb)(void *));
-int sni_add(void *sni, const char *hostname, void *user);
-void *sni_remove(void *sni, const char *hostname);
-void *sni_find(void *sni, const char *hostname);
-
 #ifdef LIBUS_USE_OPENSSL
 #include <openssl/bio.h>
 #include <openssl/dh.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/mem.h>
+#include <openssl/rand.h>
+#include <openssl/rsa.h>
+#include <openssl/sha.h>
 #include <openssl/ssl.h>
 #include <openssl/pkcs12.h>
+#ifdef __linux__
+#include <openssl/hkdf.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
 #elif LIBUS_USE_WOLFSSL
 #include <wolfssl/openssl/bio.h>
 #include <wolfssl/openssl/dh.h>
@@ -110,6 +115,10 @@ struct loop_ssl_data {
   char *ssl_spill;
   unsigned int ssl_spill_len;
   unsigned int ssl_spill_off;
+
+  /* Signatures finished by crypto workers for this loop's sockets; created by
+   * the first offloaded handshake. */
+  struct us_ssl_key_queue_t *key_queue;
 };
 
 enum {
@@ -162,6 +171,10 @@ static int us_ctx_cache_ex_idx = -1;
  * ca/caFile options or a later addCACert): the per-socket client attach must
  * not replace such a store with the process-shared default roots. */
 static int us_ctx_user_ca_ex_idx = -1;
+/* (SSL_CTX) us_ca_store_t reference of a context whose verification store is
+ * shared through the process-wide CA store cache: the store is copied before
+ * the first mutation (see us_ssl_ctx_get_own_cert_store). */
+static int us_ctx_shared_ca_ex_idx = -1;
 static int us_ssl_reneg_state_idx = -1;
 /* Per-connection async-SNI suspension state (select_certificate_cb retry). */
 static int us_ssl_sni_pending_idx = -1;
@@ -183,6 +196,19 @@ static int us_ssl_inline_reject_err_ex_idx = -1;
  * entry — see us_ssl_ctx_set_sni_policy. Absent on node:tls SecureContexts,
  * whose policy is server-level. */
 static int us_ctx_sni_policy_ex_idx = -1;
+/* (SSL_CTX) us_ssl_ctx_sessions_t: resumption counters, plus the ticket keys
+ * when the context was built with ticket_keys_file. */
+static int us_ctx_sessions_ex_idx = -1;
+/* (SSL) the default context's us_ssl_ctx_sessions_t, kept when SNI switches
+ * a connection with ticket keys to another context: BoringSSL still issues
+ * and opens tickets with the context the connection was accepted on. */
+static int us_ssl_ticket_sessions_idx = -1;
+/* (SSL) us_ssl_key_job_t of a handshake signature handed to a crypto worker,
+ * until complete() consumes it. */
+static int us_ssl_key_job_idx = -1;
+/* (SSL) us_ssl_early_data_t of a client that wrote 0-RTT data, until the
+ * handshake settles whether the server took it. */
+static int us_ssl_early_data_idx = -1;
 /* Defined in Rust (src/uws_sys/SocketKind.rs) so the ordinal tracks the enum. */
 extern const unsigned char BUN_SOCKET_KIND_BUN_SOCKET_TLS;
 extern const unsigned char BUN_SOCKET_KIND_UWS_HTTP_TLS;
@@ -201,6 +227,11 @@ static int us_ssl_new_session_ref_idx = -1;
  * 'session' event (fetch) can still cache without paying the serialized
  * pending-session queue. */
 static int us_ssl_session_sink_idx = -1;
+/* (SSL) TLS 1.3 server application traffic secret, captured from the keylog
+ * callback for kTLS (BoringSSL has no C accessor for it). Only set while
+ * BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS is on; dropped once the keys are in the
+ * kernel. */
+static int us_ssl_ktls_secret_idx = -1;
 #ifdef _WIN32
 static INIT_ONCE us_ex_idx_once = INIT_ONCE_STATIC_INIT;
 #else
@@ -260,6 +291,149 @@ static void us_ssl_reneg_state_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
   us_free(ptr);
 }
 
+/* Session ticket keys in the layout node:tls uses for `ticketKeys`: a 16-byte
+ * key name, a 16-byte HMAC secret, then a 16-byte AES-128 key. */
+#define US_SSL_TICKET_KEY_LENGTH 48
+#define US_SSL_TICKET_KEYS_MAX 8
+/* Seconds between re-reads of ticket_keys_file */
+#define US_SSL_TICKET_KEYS_RECHECK 1
+
+struct us_ssl_ticket_key_t {
+  unsigned char name[16];
+  unsigned char hmac_secret[16];
+  unsigned char aes_key[16];
+};
+
+struct us_ssl_ctx_sessions_t {
+  /* Completed server handshakes, by whether they resumed a session */
+  _Atomic uint64_t resumed;
+  _Atomic uint64_t full;
+  /* Times ticket_keys_file came back with new keys, or failed to */
+  _Atomic uint64_t ticket_key_reloads;
+  _Atomic uint64_t ticket_key_errors;
+  /* Handshakes that accepted 0-RTT data, and requests refused in it */
+  _Atomic uint64_t early_data;
+  _Atomic uint64_t too_early;
+  /* NULL unless the context was built with ticket_keys_file. The first key
+   * encrypts new tickets; the others only decrypt (and renew) older ones. */
+  char *ticket_keys_file;
+  zig_mutex_t lock;
+  time_t ticket_keys_checked;
+  unsigned int ticket_key_count;
+  struct us_ssl_ticket_key_t ticket_keys[US_SSL_TICKET_KEYS_MAX];
+};
+
+static void us_ssl_ctx_sessions_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                     int index, long argl, void *argp) {
+  (void)parent; (void)ad; (void)index; (void)argl; (void)argp;
+  struct us_ssl_ctx_sessions_t *sessions = ptr;
+  if (!sessions) return;
+  if (sessions->ticket_keys_file) us_free(sessions->ticket_keys_file);
+  OPENSSL_cleanse(sessions->ticket_keys, sizeof(sessions->ticket_keys));
+  us_free(sessions);
+}
+
+/* What a client wrote as 0-RTT data. If the server rejects it BoringSSL drops
+ * it and finishes a regular handshake, after which it is written again - but
+ * only to the certificate the resumed session was verified against: the
+ * layer above checked the peer on the session, and a full handshake may
+ * present anything. */
+struct us_ssl_early_data_t {
+  /* Leaf certificate of the resumed session */
+  CRYPTO_BUFFER *leaf;
+  unsigned char rejected;
+  unsigned int length;
+  unsigned int capacity;
+  char *data;
+};
+
+static void us_ssl_early_data_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                   int index, long argl, void *argp) {
+  (void)parent; (void)ad; (void)index; (void)argl; (void)argp;
+  struct us_ssl_early_data_t *early = ptr;
+  if (!early) return;
+  if (early->leaf) CRYPTO_BUFFER_free(early->leaf);
+  us_free(early->data);
+  us_free(early);
+}
+
+/* ── Handshake signing offload (handshake_threads) ───────────────────────── */
+
+/* Contexts built with handshake_threads install us_ssl_key_method: the
+ * handshake's one private-key signature is handed to a crypto worker (the
+ * process-wide pool in src/runtime/socket/tls_key_offload.rs) and BoringSSL
+ * returns SSL_ERROR_WANT_PRIVATE_KEY_OPERATION. The worker posts the finished
+ * job to its loop's queue and wakes the loop, which re-drives the handshake
+ * from us_internal_ssl_drain_key_jobs the same way us_socket_sni_resolve does
+ * for an async SNICallback. */
+extern void Bun__TLSKeyOffload__reserve(unsigned int threads);
+extern void Bun__TLSKeyOffload__schedule(void *job, void (*run)(void *));
+
+struct us_ssl_key_queue_t;
+
+struct us_ssl_key_job_t {
+  struct us_ssl_key_job_t *next;
+  struct us_ssl_key_queue_t *queue;
+  /* One for the SSL's ex_data slot, one for the worker and then the queue */
+  _Atomic int refs;
+  /* Loop thread only: the socket to resume, NULL once its SSL is freed */
+  struct us_socket_t *s;
+  /* Loop thread only: set before the re-drive so complete() may consume it */
+  int drained;
+  /* Worker results, published to the loop by the queue lock */
+  int ok;
+  size_t out_len;
+  EVP_PKEY *pkey;
+  uint16_t sigalg;
+  size_t in_len, max_out;
+  uint8_t *out;
+  uint8_t in[];
+};
+
+/* Per loop. The loop holds one reference and every job in flight another, so
+ * a worker finishing after the loop is gone still has a lock to take. */
+struct us_ssl_key_queue_t {
+  zig_mutex_t lock;
+  int refs;
+  /* NULL once the loop is freed */
+  struct us_loop_t *loop;
+  struct us_ssl_key_job_t *ready;
+  /* Lets the loop skip the lock on iterations with nothing to resume */
+  _Atomic int has_ready;
+};
+
+static void us_ssl_key_job_unref(struct us_ssl_key_job_t *job) {
+  if (atomic_fetch_sub(&job->refs, 1) != 1) return;
+  EVP_PKEY_free(job->pkey);
+  us_free(job);
+}
+
+/* SSL freed while the signature was in flight or not yet consumed */
+static void us_ssl_key_job_ex_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                   int index, long argl, void *argp) {
+  (void)parent; (void)ad; (void)index; (void)argl; (void)argp;
+  struct us_ssl_key_job_t *job = ptr;
+  if (!job) return;
+  job->s = NULL;
+  us_ssl_key_job_unref(job);
+}
+
+/* Workers still signing free their own jobs, and the queue with the last one */
+static void us_ssl_key_queue_close(struct us_ssl_key_queue_t *queue) {
+  Bun__lock(&queue->lock);
+  queue->loop = NULL;
+  struct us_ssl_key_job_t *job = queue->ready;
+  queue->ready = NULL;
+  int last = --queue->refs == 0;
+  Bun__unlock(&queue->lock);
+  while (job) {
+    struct us_ssl_key_job_t *next = job->next;
+    us_ssl_key_job_unref(job);
+    job = next;
+  }
+  if (last) us_free(queue);
+}
+
 /* A new resumable session is ready (for TLS 1.3, the peer's NewSessionTicket
  * was just processed; SSL_get_session() right after the handshake only returns
  * an unresumable placeholder). This callback fires from inside
@@ -306,12 +480,81 @@ static void us_ssl_session_sink_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad
   if (sink->on_free) sink->on_free(sink->owner);
   us_free(sink);
 }
+/* Traffic secrets are at most SHA-384 sized in TLS 1.3. */
+#define US_SSL_KTLS_SECRET_MAX 48
+
+struct us_ssl_ktls_secret_t {
+  uint8_t length;
+  uint8_t bytes[US_SSL_KTLS_SECRET_MAX];
+};
+static void us_ssl_ktls_secret_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                    int index, long argl, void *argp) {
+  (void)parent; (void)ad; (void)index; (void)argl; (void)argp;
+  if (!ptr) return;
+  OPENSSL_cleanse(ptr, sizeof(struct us_ssl_ktls_secret_t));
+  us_free(ptr);
+}
+
+#ifdef __linux__
+/* Set from BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS and the kernel version. */
+extern int Bun__isKernelTLSEnabled(void);
+
+/* -1 = not asked yet; cleared for the process when the kernel has no "tls"
+ * ULP (module not loaded or not built). */
+static int us_ssl_ktls_available = -1;
+
+static int us_ssl_ktls_enabled(void) {
+  if (us_ssl_ktls_available < 0) us_ssl_ktls_available = Bun__isKernelTLSEnabled() ? 1 : 0;
+  return us_ssl_ktls_available;
+}
+
+static int us_ssl_hex_nibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/* "SERVER_TRAFFIC_SECRET_0 <client random> <secret>": the key the server
+ * seals application data with after a TLS 1.3 handshake. */
+static void us_ssl_ktls_capture_secret(SSL *ssl, const char *line) {
+  static const char label[] = "SERVER_TRAFFIC_SECRET_0 ";
+  if (strncmp(line, label, sizeof(label) - 1) != 0) return;
+  const char *hex = strchr(line + sizeof(label) - 1, ' ');
+  if (!hex) return;
+  hex++;
+  size_t hex_len = strlen(hex);
+  if (!hex_len || hex_len % 2 || hex_len / 2 > US_SSL_KTLS_SECRET_MAX) return;
+
+  struct us_ssl_ktls_secret_t *secret = SSL_get_ex_data(ssl, us_ssl_ktls_secret_idx);
+  if (!secret) {
+    secret = us_malloc(sizeof(struct us_ssl_ktls_secret_t));
+    if (!secret) return;
+    SSL_set_ex_data(ssl, us_ssl_ktls_secret_idx, secret);
+  }
+  secret->length = 0;
+  for (size_t i = 0; i < hex_len / 2; i++) {
+    int hi = us_ssl_hex_nibble(hex[2 * i]), lo = us_ssl_hex_nibble(hex[2 * i + 1]);
+    if (hi < 0 || lo < 0) return;
+    secret->bytes[i] = (uint8_t)((hi << 4) | lo);
+  }
+  secret->length = (uint8_t)(hex_len / 2);
+}
+#endif
+
 /* NSS key-log lines are produced from inside SSL_do_handshake/SSL_read, so
  * they are parked on the SSL the same way new sessions are and delivered once
  * the read unwinds. The stored bytes already carry the trailing newline Node
  * appends before emitting 'keylog'. */
 static void us_ssl_keylog_cb(const SSL *cssl, const char *line) {
   SSL *ssl = (SSL *)cssl;
+#ifdef __linux__
+  /* Ahead of the opt-in check below: uWS HTTP sockets never surface keylog
+   * lines but are what kTLS is for. */
+  if (SSL_is_server(ssl) && us_ssl_ktls_enabled()) {
+    us_ssl_ktls_capture_secret(ssl, line);
+  }
+#endif
   if (!SSL_get_ex_data(ssl, us_ssl_is_socket_ex_idx)) {
     return;
   }
@@ -438,12 +681,18 @@ static void ssl_flush_pending_session(struct us_socket_t *s) {
 extern void bun_ssl_ctx_cache_on_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
                                       int index, long argl, void *argp);
 
+/* Drops a context's reference on its cached CA store (defined with the cache). */
+static void us_ca_store_ex_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                int index, long argl, void *argp);
+
 static void us_ex_idx_init(void) {
   us_ctx_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, us_ctx_ex_free);
   us_sni_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
   us_ctx_cache_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, bun_ssl_ctx_cache_on_free);
   us_ctx_user_ca_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+  us_ctx_shared_ca_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, us_ca_store_ex_free);
   us_ctx_sni_policy_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+  us_ctx_sessions_ex_idx = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_ctx_sessions_free);
   us_ssl_reneg_state_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_reneg_state_free);
   us_ssl_sni_pending_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_sni_pending_free);
   us_ssl_listener_ex_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
@@ -456,6 +705,10 @@ static void us_ex_idx_init(void) {
   us_ssl_pending_keylog_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_pending_session_free);
   us_ssl_new_session_ref_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_new_session_ref_free);
   us_ssl_session_sink_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_session_sink_free);
+  us_ssl_ktls_secret_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_ktls_secret_free);
+  us_ssl_ticket_sessions_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+  us_ssl_key_job_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_key_job_ex_free);
+  us_ssl_early_data_idx = SSL_get_ex_new_index(0, NULL, NULL, NULL, us_ssl_early_data_free);
 }
 
 #ifdef _WIN32
@@ -510,6 +763,51 @@ void *us_ssl_get_session_sink_owner(SSL *ssl) {
   return sink ? sink->owner : NULL;
 }
 
+/* ── Client early data ──────────────────────────────────────────────────── */
+
+/* Whether a client SSL offers early data when it resumes a session that
+ * allows it. Overrides the context's setting for this connection. */
+void us_ssl_set_early_data(SSL *ssl, int enabled) {
+  SSL_set_early_data_enabled(ssl, enabled);
+}
+
+static struct us_ssl_early_data_t *ssl_early_data_get(SSL *ssl, int create) {
+  us_ex_idx_ensure();
+  struct us_ssl_early_data_t *early = SSL_get_ex_data(ssl, us_ssl_early_data_idx);
+  if (early || !create) return early;
+  early = us_calloc(1, sizeof(*early));
+  /* In early data the peer chain is the resumed session's */
+  const STACK_OF(CRYPTO_BUFFER) *chain = SSL_get0_peer_certificates(ssl);
+  if (chain && sk_CRYPTO_BUFFER_num(chain) > 0) {
+    early->leaf = sk_CRYPTO_BUFFER_value(chain, 0);
+    CRYPTO_BUFFER_up_ref(early->leaf);
+  }
+  SSL_set_ex_data(ssl, us_ssl_early_data_idx, early);
+  us_internal_count_client(US_CLIENT_EARLY_DATA);
+  return early;
+}
+
+static void ssl_early_data_record(SSL *ssl, const char *data, int length) {
+  struct us_ssl_early_data_t *early = ssl_early_data_get(ssl, 1);
+  if (early->length + (unsigned int)length > early->capacity) {
+    unsigned int capacity = early->capacity ? early->capacity : 4096;
+    while (capacity < early->length + (unsigned int)length) capacity *= 2;
+    early->data = us_realloc(early->data, capacity);
+    early->capacity = capacity;
+  }
+  memcpy(early->data + early->length, data, length);
+  early->length += length;
+}
+
+/* SSL_ERROR_EARLY_DATA_REJECTED: carry on with the handshake; the recorded
+ * data goes out again once it completes (ssl_finish_early_data). */
+static void ssl_early_data_rejected(SSL *ssl) {
+  struct us_ssl_early_data_t *early = ssl_early_data_get(ssl, 1);
+  early->rejected = 1;
+  SSL_reset_early_data_reject(ssl);
+  us_internal_count_client(US_CLIENT_EARLY_DATA_REJECTED);
+}
+
 /* TLS-over-duplex / named-pipe owners (the Rust SSLWrapper): opt this SSL
  * into the parked session/keylog queues so us_ssl_new_session_cb /
  * us_ssl_keylog_cb collect them. There is no us_socket_t to flush into
@@ -664,6 +962,16 @@ static int BIO_s_custom_write(BIO *bio, const char *data, int length) {
     return length;
   }
 
+  /* The kernel owns this socket's write keys and sequence numbers (kTLS):
+   * a record BoringSSL sealed itself (a KeyUpdate answer, an alert) is out of
+   * step with them and would corrupt the stream. Nothing can be sent in its
+   * place, so the connection is over. */
+  if (loop_ssl_data->ssl_socket && loop_ssl_data->ssl_socket->ssl_ktls_tx) {
+    loop_ssl_data->ssl_socket->ssl_fatal_error = 1;
+    BIO_clear_retry_flags(bio);
+    return length;
+  }
+
   if (loop_ssl_data->ssl_write_batching) {
     /* Append the sealed record; the batch hits the kernel once, after
      * SSL_write returns. Reporting the full length keeps BoringSSL sealing
@@ -777,6 +1085,10 @@ void us_internal_ssl_socket_relocated(struct us_loop_t *loop, struct us_socket_t
   if (loop_ssl_data->ssl_last_fatal_error_owner == (void *)old_s) {
     loop_ssl_data->ssl_last_fatal_error_owner = (void *)new_s;
   }
+  if (new_s->ssl && us_ssl_key_job_idx >= 0) {
+    struct us_ssl_key_job_t *job = SSL_get_ex_data(s_ssl(new_s), us_ssl_key_job_idx);
+    if (job && job->s == old_s) job->s = new_s;
+  }
 }
 
 static int BIO_s_custom_read(BIO *bio, char *dst, int length) {
@@ -856,6 +1168,7 @@ void us_internal_free_loop_ssl_data(struct us_loop_t *loop) {
     BIO_free(loop_ssl_data->shared_rbio);
     BIO_free(loop_ssl_data->shared_wbio);
     BIO_meth_free(loop_ssl_data->shared_biom);
+    if (loop_ssl_data->key_queue) us_ssl_key_queue_close(loop_ssl_data->key_queue);
     us_free(loop_ssl_data);
     /* us_internal_init_loop_ssl_data's guard reads this: leaving it dangling
      * would hand a freed loop_ssl_data back to the next TLS socket. */
@@ -899,6 +1212,248 @@ end:
   return ret;
 }
 
+/* Process-wide cache of parsed `ca` / `ca_file_name` trust stores, shared by
+ * every SSL_CTX built on any thread (the JS thread of each Worker and the HTTP
+ * client thread). Parsing a large CA bundle costs milliseconds per context;
+ * a hit instead shares the already-built X509_STORE and duplicates the client
+ * CA name list. The SSL_CTXs themselves stay per consumer: only the parsed
+ * certificates are shared.
+ *
+ * Keyed by the SHA-256 of the CA content (the file's bytes for ca_file_name),
+ * so a rotated file is a different key. The cache holds one reference on at
+ * most US_CA_STORE_CACHE_MAX stores, most recently used first; an evicted
+ * store lives on in the contexts already using it. A shared store is never
+ * mutated: each context using it holds a reference in us_ctx_shared_ca_ex_idx
+ * and copies it before adding CAs or CRLs. */
+#define US_CA_STORE_CACHE_MAX 16
+
+struct us_ca_store_t {
+  _Atomic int refs;
+  X509_STORE *store;
+  /* The certificates in store, read by copies without taking its lock */
+  STACK_OF(X509) *certs;
+  STACK_OF(X509_NAME) *names;
+};
+
+struct us_ca_store_cache_entry_t {
+  unsigned char key[SHA256_DIGEST_LENGTH];
+  struct us_ca_store_t *shared;
+};
+
+static struct {
+  zig_mutex_t lock;
+  unsigned int count;
+  struct us_ca_store_cache_entry_t entries[US_CA_STORE_CACHE_MAX];
+  uint64_t hits;
+  uint64_t misses;
+  uint64_t evictions;
+} us_ca_store_cache;
+
+static void us_ca_store_unref(struct us_ca_store_t *shared) {
+  if (atomic_fetch_sub(&shared->refs, 1) != 1) return;
+  X509_STORE_free(shared->store);
+  sk_X509_pop_free(shared->certs, X509_free);
+  sk_X509_NAME_pop_free(shared->names, X509_NAME_free);
+  us_free(shared);
+}
+
+static void us_ca_store_ex_free(void *parent, void *ptr, CRYPTO_EX_DATA *ad,
+                                int index, long argl, void *argp) {
+  (void)parent; (void)ad; (void)index; (void)argl; (void)argp;
+  if (ptr) us_ca_store_unref(ptr);
+}
+
+/* Reads all of `path` into a us_malloc'd buffer the caller frees. Returns NULL
+ * when the file cannot be read. The CA file is read once: the cache key and
+ * the parsed store both come from these bytes, so a file rewritten in between
+ * can never be cached under the other content's key. */
+static char *us_ca_file_read(const char *path, size_t *length) {
+  FILE *file = fopen(path, "rb");
+  if (!file) return NULL;
+  size_t capacity = 16384, used = 0;
+  char *buffer = us_malloc(capacity);
+  while (buffer) {
+    used += fread(buffer + used, 1, capacity - used, file);
+    if (used < capacity) break;
+    char *grown = us_realloc(buffer, capacity * 2);
+    if (!grown) us_free(buffer);
+    buffer = grown;
+    capacity *= 2;
+  }
+  int failed = ferror(file);
+  fclose(file);
+  if (buffer && (failed || used > INT_MAX)) {
+    us_free(buffer);
+    return NULL;
+  }
+  *length = used;
+  return buffer;
+}
+
+/* Hashes the CA file bytes read by us_ca_file_read(), or the inline `ca`
+ * strings when there is no file. Returns 0 when the inline content cannot be
+ * read, in which case the context is built without the cache and reports the
+ * error itself. */
+static int us_ca_store_key(const struct us_bun_socket_context_options_t *options,
+                           const char *file, size_t file_length,
+                           unsigned char key[SHA256_DIGEST_LENGTH]) {
+  SHA256_CTX sha;
+  SHA256_Init(&sha);
+  if (options->ca_file_name) {
+    SHA256_Update(&sha, "file", 4);
+    SHA256_Update(&sha, file, file_length);
+  } else {
+    SHA256_Update(&sha, "inline", 6);
+    for (unsigned int i = 0; i < options->ca_count; i++) {
+      if (!options->ca[i]) return 0;
+      /* Length-prefixed so ["ab", "c"] and ["a", "bc"] differ */
+      uint64_t length = strlen(options->ca[i]);
+      SHA256_Update(&sha, &length, sizeof(length));
+      SHA256_Update(&sha, options->ca[i], length);
+    }
+  }
+  SHA256_Final(key, &sha);
+  return 1;
+}
+
+/* The in-memory equivalent of SSL_load_client_CA_file() followed by
+ * SSL_CTX_load_verify_locations() on the same file: certificates go into the
+ * store and, once per subject, into the client CA list; CRLs into the store.
+ * Returns 0 with *err set on failure. */
+static int us_ca_file_load(SSL_CTX *ctx, const char *content, size_t length, int *err) {
+  BIO *in = BIO_new_mem_buf(content, (int)length);
+  STACK_OF(X509_INFO) *infos = in ? PEM_X509_INFO_read_bio(in, NULL, NULL, NULL) : NULL;
+  BIO_free(in);
+  if (!infos) {
+    *err = CREATE_BUN_SOCKET_ERROR_INVALID_CA_FILE;
+    return 0;
+  }
+  X509_STORE *store = SSL_CTX_get_cert_store(ctx);
+  STACK_OF(X509_NAME) *names = sk_X509_NAME_new_null();
+  size_t certs = 0;
+  int ok = names != NULL;
+  for (size_t i = 0; ok && i < (size_t)sk_X509_INFO_num(infos); i++) {
+    X509_INFO *info = sk_X509_INFO_value(infos, i);
+    if (info->crl) ok = X509_STORE_add_crl(store, info->crl);
+    if (!ok || !info->x509) continue;
+    certs++;
+    ok = X509_STORE_add_cert(store, info->x509);
+    X509_NAME *subject = X509_get_subject_name(info->x509);
+    int seen = 0;
+    for (size_t j = 0; ok && !seen && j < (size_t)sk_X509_NAME_num(names); j++) {
+      seen = X509_NAME_cmp(sk_X509_NAME_value(names, j), subject) == 0;
+    }
+    if (ok && !seen) {
+      X509_NAME *name = X509_NAME_dup(subject);
+      ok = name != NULL && sk_X509_NAME_push(names, name);
+      if (!ok) X509_NAME_free(name);
+    }
+  }
+  sk_X509_INFO_pop_free(infos, X509_INFO_free);
+  if (!ok || certs == 0) {
+    sk_X509_NAME_pop_free(names, X509_NAME_free);
+    *err = ok ? CREATE_BUN_SOCKET_ERROR_LOAD_CA_FILE : CREATE_BUN_SOCKET_ERROR_INVALID_CA_FILE;
+    return 0;
+  }
+  SSL_CTX_set_client_CA_list(ctx, names);
+  ERR_clear_error();
+  return 1;
+}
+
+/* Points ctx at the cached store for key. Returns 0 on a miss. */
+static int us_ca_store_cache_get(SSL_CTX *ctx, const unsigned char *key) {
+  struct us_ca_store_t *shared = NULL;
+
+  Bun__lock(&us_ca_store_cache.lock);
+  for (unsigned int i = 0; i < us_ca_store_cache.count; i++) {
+    struct us_ca_store_cache_entry_t entry = us_ca_store_cache.entries[i];
+    if (memcmp(entry.key, key, SHA256_DIGEST_LENGTH) != 0) continue;
+    memmove(&us_ca_store_cache.entries[1], &us_ca_store_cache.entries[0], i * sizeof(entry));
+    us_ca_store_cache.entries[0] = entry;
+    shared = entry.shared;
+    atomic_fetch_add(&shared->refs, 1);
+    break;
+  }
+  if (shared) {
+    us_ca_store_cache.hits++;
+  } else {
+    us_ca_store_cache.misses++;
+  }
+  Bun__unlock(&us_ca_store_cache.lock);
+
+  if (!shared) return 0;
+  STACK_OF(X509_NAME) *names = SSL_dup_CA_list(shared->names);
+  if (!names) {
+    us_ca_store_unref(shared);
+    return 0;
+  }
+  X509_STORE_up_ref(shared->store);
+  SSL_CTX_set_cert_store(ctx, shared->store);
+  SSL_CTX_set_client_CA_list(ctx, names);
+  SSL_CTX_set_ex_data(ctx, us_ctx_shared_ca_ex_idx, shared);
+  return 1;
+}
+
+/* Publishes the store ctx just parsed for key, and shares it from then on. */
+static void us_ca_store_cache_put(SSL_CTX *ctx, const unsigned char *key) {
+  X509_STORE *store = SSL_CTX_get_cert_store(ctx);
+  const STACK_OF(X509_OBJECT) *objs = X509_STORE_get0_objects(store);
+  struct us_ca_store_t *shared = us_calloc(1, sizeof(*shared));
+  if (!shared) return;
+  atomic_init(&shared->refs, 2);
+  shared->certs = sk_X509_new_null();
+  shared->names = SSL_dup_CA_list(SSL_CTX_get_client_CA_list(ctx));
+  int ok = shared->certs != NULL && shared->names != NULL;
+  for (size_t i = 0; ok && i < (size_t)sk_X509_OBJECT_num(objs); i++) {
+    /* A ca file may also carry CRLs; only certificate-only stores are
+     * shared, so a copy never has anything else to carry over. */
+    X509 *cert = X509_OBJECT_get0_X509(sk_X509_OBJECT_value(objs, i));
+    ok = cert != NULL && sk_X509_push(shared->certs, cert);
+    if (ok) X509_up_ref(cert);
+  }
+  X509_STORE_up_ref(store);
+  shared->store = store;
+  if (!ok) {
+    atomic_store(&shared->refs, 1);
+    us_ca_store_unref(shared);
+    return;
+  }
+
+  struct us_ca_store_t *evicted = NULL;
+  Bun__lock(&us_ca_store_cache.lock);
+  for (unsigned int i = 0; i < us_ca_store_cache.count; i++) {
+    if (memcmp(us_ca_store_cache.entries[i].key, key, SHA256_DIGEST_LENGTH) == 0) {
+      /* Another thread built the same CAs meanwhile; keep theirs */
+      Bun__unlock(&us_ca_store_cache.lock);
+      atomic_store(&shared->refs, 1);
+      us_ca_store_unref(shared);
+      return;
+    }
+  }
+  if (us_ca_store_cache.count == US_CA_STORE_CACHE_MAX) {
+    evicted = us_ca_store_cache.entries[--us_ca_store_cache.count].shared;
+    us_ca_store_cache.evictions++;
+  }
+  memmove(&us_ca_store_cache.entries[1], &us_ca_store_cache.entries[0],
+          us_ca_store_cache.count * sizeof(us_ca_store_cache.entries[0]));
+  memcpy(us_ca_store_cache.entries[0].key, key, SHA256_DIGEST_LENGTH);
+  us_ca_store_cache.entries[0].shared = shared;
+  us_ca_store_cache.count++;
+  Bun__unlock(&us_ca_store_cache.lock);
+
+  SSL_CTX_set_ex_data(ctx, us_ctx_shared_ca_ex_idx, shared);
+  if (evicted) us_ca_store_unref(evicted);
+}
+
+void us_ca_store_cache_stats(struct us_ca_store_cache_stats_t *out) {
+  Bun__lock(&us_ca_store_cache.lock);
+  out->hits = us_ca_store_cache.hits;
+  out->misses = us_ca_store_cache.misses;
+  out->evictions = us_ca_store_cache.evictions;
+  out->entries = us_ca_store_cache.count;
+  Bun__unlock(&us_ca_store_cache.lock);
+}
+
 /* The context's own cert store for mutation: the process-shared root store and
  * the still-empty SSL_CTX_new() store are first replaced by a private full
  * default-root copy, and the context is marked so the per-socket attach keeps
@@ -911,6 +1466,21 @@ static X509_STORE *us_ssl_ctx_get_own_cert_store(SSL_CTX *ctx) {
   int store_is_shared = store != NULL && store == shared;
   X509_STORE_free(shared);
   us_ex_idx_ensure();
+  struct us_ca_store_t *cached = SSL_CTX_get_ex_data(ctx, us_ctx_shared_ca_ex_idx);
+  if (cached != NULL) {
+    /* Cached user CAs: mutate a private copy, never the shared store */
+    X509_STORE *own = X509_STORE_new();
+    if (own == NULL) {
+      return NULL;
+    }
+    for (size_t i = 0; i < sk_X509_num(cached->certs); i++) {
+      X509_STORE_add_cert(own, sk_X509_value(cached->certs, i));
+    }
+    SSL_CTX_set_cert_store(ctx, own);
+    SSL_CTX_set_ex_data(ctx, us_ctx_shared_ca_ex_idx, NULL);
+    us_ca_store_unref(cached);
+    store = own;
+  }
   int store_is_empty = 0;
   if (store != NULL && !store_is_shared) {
     const STACK_OF(X509_OBJECT) *objs = X509_STORE_get0_objects(store);
@@ -1095,6 +1665,272 @@ static void ssl_ctx_build_fail(SSL_CTX *ctx) {
   SSL_CTX_free(ctx);
 }
 
+_Static_assert(sizeof(struct us_ssl_ticket_key_t) == US_SSL_TICKET_KEY_LENGTH,
+               "ticket keys are read straight from the file");
+
+/* Reads up to US_SSL_TICKET_KEYS_MAX concatenated keys from `path`. Returns
+ * how many, or 0 when the file is unreadable, empty or not a whole number of
+ * keys. */
+static unsigned int us_ssl_ticket_keys_read(const char *path, struct us_ssl_ticket_key_t *out) {
+  unsigned char buffer[US_SSL_TICKET_KEY_LENGTH * US_SSL_TICKET_KEYS_MAX + 1];
+  FILE *file = fopen(path, "rb");
+  if (!file) return 0;
+  size_t length = fread(buffer, 1, sizeof(buffer), file);
+  fclose(file);
+  unsigned int count = 0;
+  if (length && length < sizeof(buffer) && length % US_SSL_TICKET_KEY_LENGTH == 0) {
+    count = (unsigned int)(length / US_SSL_TICKET_KEY_LENGTH);
+    memcpy(out, buffer, length);
+  }
+  OPENSSL_cleanse(buffer, sizeof(buffer));
+  return count;
+}
+
+/* Picks up keys rotated into ticket_keys_file by another process. Called with
+ * the lock held, re-reads at most every US_SSL_TICKET_KEYS_RECHECK seconds,
+ * and keeps the current keys while the file is missing or half-written. */
+static void us_ssl_ticket_keys_refresh(struct us_ssl_ctx_sessions_t *sessions) {
+  time_t now = time(NULL);
+  if (now >= sessions->ticket_keys_checked &&
+      now - sessions->ticket_keys_checked < US_SSL_TICKET_KEYS_RECHECK) {
+    return;
+  }
+  sessions->ticket_keys_checked = now;
+
+  struct us_ssl_ticket_key_t keys[US_SSL_TICKET_KEYS_MAX];
+  unsigned int count = us_ssl_ticket_keys_read(sessions->ticket_keys_file, keys);
+  if (!count) {
+    atomic_fetch_add(&sessions->ticket_key_errors, 1);
+  } else if (count != sessions->ticket_key_count ||
+             CRYPTO_memcmp(keys, sessions->ticket_keys, count * sizeof(keys[0]))) {
+    memcpy(sessions->ticket_keys, keys, count * sizeof(keys[0]));
+    sessions->ticket_key_count = count;
+    atomic_fetch_add(&sessions->ticket_key_reloads, 1);
+  }
+  OPENSSL_cleanse(keys, sizeof(keys));
+}
+
+/* Installed only on contexts built with ticket_keys_file. Tickets are sealed
+ * with the first key; a ticket under any other listed key still resumes, and
+ * returning 2 asks BoringSSL to reissue it under the current one. */
+static int us_ssl_ticket_key_cb(SSL *ssl, uint8_t *key_name, uint8_t *iv,
+                                EVP_CIPHER_CTX *cipher_ctx, HMAC_CTX *hmac_ctx,
+                                int encrypt) {
+  struct us_ssl_ctx_sessions_t *sessions = SSL_get_ex_data(ssl, us_ssl_ticket_sessions_idx);
+  if (!sessions) sessions = SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), us_ctx_sessions_ex_idx);
+  if (!sessions || !sessions->ticket_keys_file) return -1;
+
+  int result = -1;
+  Bun__lock(&sessions->lock);
+  us_ssl_ticket_keys_refresh(sessions);
+  if (encrypt) {
+    struct us_ssl_ticket_key_t *key = &sessions->ticket_keys[0];
+    if (RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_128_cbc())) &&
+        EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), NULL, key->aes_key, iv) &&
+        HMAC_Init_ex(hmac_ctx, key->hmac_secret, sizeof(key->hmac_secret), EVP_sha256(), NULL)) {
+      memcpy(key_name, key->name, sizeof(key->name));
+      result = 1;
+    }
+  } else {
+    /* An unknown name falls back to a full handshake */
+    result = 0;
+    for (unsigned int i = 0; i < sessions->ticket_key_count; i++) {
+      struct us_ssl_ticket_key_t *key = &sessions->ticket_keys[i];
+      if (CRYPTO_memcmp(key_name, key->name, sizeof(key->name))) continue;
+      result = HMAC_Init_ex(hmac_ctx, key->hmac_secret, sizeof(key->hmac_secret), EVP_sha256(), NULL) &&
+               EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), NULL, key->aes_key, iv)
+                   ? (i == 0 ? 1 : 2)
+                   : -1;
+      break;
+    }
+  }
+  Bun__unlock(&sessions->lock);
+  return result;
+}
+
+static void us_ssl_count_handshake(SSL *ssl) {
+  if (us_ctx_sessions_ex_idx < 0 || !SSL_is_server(ssl)) return;
+  struct us_ssl_ctx_sessions_t *sessions =
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), us_ctx_sessions_ex_idx);
+  if (!sessions) return;
+  atomic_fetch_add(SSL_session_reused(ssl) ? &sessions->resumed : &sessions->full, 1);
+  if (SSL_early_data_accepted(ssl)) atomic_fetch_add(&sessions->early_data, 1);
+}
+
+void us_ssl_ctx_session_stats(SSL_CTX *ctx, struct us_ssl_ctx_session_stats_t *out) {
+  memset(out, 0, sizeof(*out));
+  if (!ctx || us_ctx_sessions_ex_idx < 0) return;
+  struct us_ssl_ctx_sessions_t *sessions = SSL_CTX_get_ex_data(ctx, us_ctx_sessions_ex_idx);
+  if (!sessions) return;
+  out->resumed_handshakes = atomic_load(&sessions->resumed);
+  out->full_handshakes = atomic_load(&sessions->full);
+  out->ticket_key_reloads = atomic_load(&sessions->ticket_key_reloads);
+  out->ticket_key_errors = atomic_load(&sessions->ticket_key_errors);
+  out->early_data = atomic_load(&sessions->early_data);
+  out->too_early = atomic_load(&sessions->too_early);
+  if (sessions->ticket_keys_file) {
+    Bun__lock(&sessions->lock);
+    out->ticket_keys = sessions->ticket_key_count;
+    Bun__unlock(&sessions->lock);
+  }
+}
+
+/* What BoringSSL itself does with a loaded key (ssl_private_key_sign) */
+static int us_ssl_key_sign(EVP_PKEY *pkey, uint16_t sigalg, uint8_t *out, size_t *out_len,
+                           size_t max_out, const uint8_t *in, size_t in_len) {
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  EVP_PKEY_CTX *pctx = NULL;
+  if (!ctx) return 0;
+  int ok = EVP_DigestSignInit(ctx, &pctx, SSL_get_signature_algorithm_digest(sigalg), NULL, pkey);
+  if (ok && SSL_is_signature_algorithm_rsa_pss(sigalg)) {
+    ok = EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) &&
+         EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1 /* digest length */);
+  }
+  *out_len = max_out;
+  ok = ok && EVP_DigestSign(ctx, out, out_len, in, in_len);
+  EVP_MD_CTX_free(ctx);
+  return ok;
+}
+
+/* Runs on a crypto worker */
+static void us_ssl_key_job_run(void *ptr) {
+  struct us_ssl_key_job_t *job = ptr;
+  job->ok = us_ssl_key_sign(job->pkey, job->sigalg, job->out, &job->out_len, job->max_out,
+                            job->in, job->in_len);
+  ERR_clear_error();
+
+  struct us_ssl_key_queue_t *queue = job->queue;
+  int orphaned = 0;
+  Bun__lock(&queue->lock);
+  if (queue->loop) {
+    job->next = queue->ready;
+    queue->ready = job;
+    atomic_store_explicit(&queue->has_ready, 1, memory_order_release);
+    us_wakeup_loop(queue->loop);
+  } else {
+    orphaned = 1;
+  }
+  int last = --queue->refs == 0;
+  Bun__unlock(&queue->lock);
+  if (orphaned) us_ssl_key_job_unref(job);
+  if (last) us_free(queue);
+}
+
+static enum ssl_private_key_result_t us_ssl_key_sign_cb(SSL *ssl, uint8_t *out, size_t *out_len,
+                                                        size_t max_out, uint16_t sigalg,
+                                                        const uint8_t *in, size_t in_len) {
+  EVP_PKEY *pkey = SSL_get_privatekey(ssl);
+  if (!pkey) return ssl_private_key_failure;
+
+  /* Only SSLs driven by a us_socket_t can be resumed from the loop; the
+   * JS-stream wrapper and anything else signs inline. */
+  struct loop_ssl_data *loop_ssl_data = NULL;
+  if (us_ssl_is_socket_ex_idx >= 0 && SSL_get_ex_data(ssl, us_ssl_is_socket_ex_idx)) {
+    loop_ssl_data = BIO_get_data(SSL_get_rbio(ssl));
+  }
+  struct us_socket_t *s = loop_ssl_data ? loop_ssl_data->ssl_socket : NULL;
+  struct us_ssl_key_job_t *job = NULL;
+  if (s && s_ssl(s) == ssl && !SSL_get_ex_data(ssl, us_ssl_key_job_idx)) {
+    job = us_malloc(sizeof(struct us_ssl_key_job_t) + in_len + max_out);
+  }
+  if (!job) {
+    return us_ssl_key_sign(pkey, sigalg, out, out_len, max_out, in, in_len)
+               ? ssl_private_key_success
+               : ssl_private_key_failure;
+  }
+
+  struct us_ssl_key_queue_t *queue = loop_ssl_data->key_queue;
+  if (!queue) {
+    queue = us_calloc(1, sizeof(struct us_ssl_key_queue_t));
+    if (!queue) Bun__outOfMemory();
+    queue->refs = 1;
+    queue->loop = s->group->loop;
+    loop_ssl_data->key_queue = queue;
+  }
+
+  memset(job, 0, sizeof(*job));
+  atomic_init(&job->refs, 2);
+  job->queue = queue;
+  job->s = s;
+  EVP_PKEY_up_ref(pkey);
+  job->pkey = pkey;
+  job->sigalg = sigalg;
+  job->in_len = in_len;
+  job->max_out = max_out;
+  job->out = job->in + in_len;
+  memcpy(job->in, in, in_len);
+  SSL_set_ex_data(ssl, us_ssl_key_job_idx, job);
+
+  Bun__lock(&queue->lock);
+  queue->refs++;
+  Bun__unlock(&queue->lock);
+  Bun__TLSKeyOffload__schedule(job, us_ssl_key_job_run);
+  return ssl_private_key_retry;
+}
+
+/* Only TLS 1.2 RSA key exchange decrypts; that is rare enough to stay inline */
+static enum ssl_private_key_result_t us_ssl_key_decrypt_cb(SSL *ssl, uint8_t *out, size_t *out_len,
+                                                           size_t max_out, const uint8_t *in,
+                                                           size_t in_len) {
+  EVP_PKEY *pkey = SSL_get_privatekey(ssl);
+  RSA *rsa = pkey ? EVP_PKEY_get0_RSA(pkey) : NULL;
+  if (!rsa || !RSA_decrypt(rsa, out_len, out, max_out, in, in_len, RSA_NO_PADDING)) {
+    return ssl_private_key_failure;
+  }
+  return ssl_private_key_success;
+}
+
+static enum ssl_private_key_result_t us_ssl_key_complete_cb(SSL *ssl, uint8_t *out, size_t *out_len,
+                                                            size_t max_out) {
+  struct us_ssl_key_job_t *job = SSL_get_ex_data(ssl, us_ssl_key_job_idx);
+  if (!job) return ssl_private_key_failure;
+  /* Driven by something else (peer data) before the worker got back */
+  if (!job->drained) return ssl_private_key_retry;
+
+  SSL_set_ex_data(ssl, us_ssl_key_job_idx, NULL);
+  enum ssl_private_key_result_t result = ssl_private_key_failure;
+  if (job->ok && job->out_len <= max_out) {
+    memcpy(out, job->out, job->out_len);
+    *out_len = job->out_len;
+    result = ssl_private_key_success;
+  }
+  us_ssl_key_job_unref(job);
+  return result;
+}
+
+static const SSL_PRIVATE_KEY_METHOD us_ssl_key_method = {
+    us_ssl_key_sign_cb,
+    us_ssl_key_decrypt_cb,
+    us_ssl_key_complete_cb,
+};
+
+int us_internal_ssl_drain_key_jobs(struct us_loop_t *loop) {
+  struct loop_ssl_data *loop_ssl_data = (struct loop_ssl_data *)loop->data.ssl_data;
+  struct us_ssl_key_queue_t *queue = loop_ssl_data ? loop_ssl_data->key_queue : NULL;
+  if (!queue || !atomic_load_explicit(&queue->has_ready, memory_order_acquire)) return 0;
+
+  Bun__lock(&queue->lock);
+  struct us_ssl_key_job_t *job = queue->ready;
+  queue->ready = NULL;
+  atomic_store_explicit(&queue->has_ready, 0, memory_order_relaxed);
+  Bun__unlock(&queue->lock);
+
+  int drained = 0;
+  while (job) {
+    struct us_ssl_key_job_t *next = job->next;
+    struct us_socket_t *s = job->s;
+    job->drained = 1;
+    if (s && !us_socket_is_closed(s) && s->ssl) {
+      ssl_set_loop_data(s);
+      ssl_update_handshake(s);
+    }
+    us_ssl_key_job_unref(job);
+    job = next;
+    drained++;
+  }
+  return drained;
+}
+
 /* Exported for quic.c (lsquic configures ALPN/transport-params on the SSL_CTX
  * directly) and as the body of us_ssl_ctx_from_options. */
 SSL_CTX *us_ssl_ctx_build_raw(struct us_bun_socket_context_options_t options,
@@ -1106,6 +1942,8 @@ SSL_CTX *us_ssl_ctx_build_raw(struct us_bun_socket_context_options_t options,
   /* Register the live-count free_func first thing so every exit (including
    * build_fail) balances. The packed reneg policy reuses the same slot. */
   SSL_CTX_set_ex_data(ssl_context, us_ssl_ctx_ex_idx(), NULL);
+  struct us_ssl_ctx_sessions_t *sessions = us_calloc(1, sizeof(*sessions));
+  SSL_CTX_set_ex_data(ssl_context, us_ctx_sessions_ex_idx, sessions);
 
   /* Default options we rely on — changing these breaks the BIO logic. */
   SSL_CTX_set_read_ahead(ssl_context, 1);
@@ -1185,25 +2023,31 @@ SSL_CTX *us_ssl_ctx_build_raw(struct us_bun_socket_context_options_t options,
    * everywhere downstream — no special "owner" path. */
   ssl_ctx_drop_passphrase(ssl_context);
 
+  unsigned char ca_key[SHA256_DIGEST_LENGTH];
   if (options.ca_file_name) {
     /* An explicit CA replaces the default trust store (Node.js semantics):
      * chains must validate exclusively against the supplied CAs. The SSL_CTX
      * already owns a fresh, empty X509_STORE from SSL_CTX_new(), so
      * SSL_CTX_load_verify_locations below populates only the user's CAs. */
-    STACK_OF(X509_NAME) *ca_list = SSL_load_client_CA_file(options.ca_file_name);
-    if (ca_list == NULL) {
-      *err = CREATE_BUN_SOCKET_ERROR_LOAD_CA_FILE;
-      ssl_ctx_build_fail(ssl_context);
-      return NULL;
-    }
-    SSL_CTX_set_client_CA_list(ssl_context, ca_list);
     us_ex_idx_ensure();
     SSL_CTX_set_ex_data(ssl_context, us_ctx_user_ca_ex_idx, (void *)1);
-    if (SSL_CTX_load_verify_locations(ssl_context, options.ca_file_name, NULL) != 1) {
-      *err = CREATE_BUN_SOCKET_ERROR_INVALID_CA_FILE;
+    size_t ca_file_length = 0;
+    char *ca_file = us_ca_file_read(options.ca_file_name, &ca_file_length);
+    if (!ca_file) {
+      *err = CREATE_BUN_SOCKET_ERROR_LOAD_CA_FILE;
       ssl_ctx_build_fail(ssl_context);
       return NULL;
     }
+    us_ca_store_key(&options, ca_file, ca_file_length, ca_key);
+    if (!us_ca_store_cache_get(ssl_context, ca_key)) {
+      if (!us_ca_file_load(ssl_context, ca_file, ca_file_length, err)) {
+        us_free(ca_file);
+        ssl_ctx_build_fail(ssl_context);
+        return NULL;
+      }
+      us_ca_store_cache_put(ssl_context, ca_key);
+    }
+    us_free(ca_file);
     SSL_CTX_set_verify(ssl_context,
         options.reject_unauthorized ? (SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT)
                                     : SSL_VERIFY_PEER,
@@ -1212,22 +2056,26 @@ SSL_CTX *us_ssl_ctx_build_raw(struct us_bun_socket_context_options_t options,
   } else if (options.ca && options.ca_count > 0) {
     us_ex_idx_ensure();
     SSL_CTX_set_ex_data(ssl_context, us_ctx_user_ca_ex_idx, (void *)1);
-    /* As above: user CAs only, into the SSL_CTX's own initially-empty store —
-     * otherwise a server doing mTLS with `ca: [internalCA]` would also accept
-     * any client certificate that chains to a public root. */
-    X509_STORE *cert_store = SSL_CTX_get_cert_store(ssl_context);
-    for (unsigned int i = 0; i < options.ca_count; i++) {
-      if (!add_ca_cert_to_ctx_store(ssl_context, options.ca[i], cert_store)) {
-        *err = CREATE_BUN_SOCKET_ERROR_INVALID_CA;
-        ssl_ctx_build_fail(ssl_context);
-        return NULL;
+    int cacheable = us_ca_store_key(&options, NULL, 0, ca_key);
+    if (!cacheable || !us_ca_store_cache_get(ssl_context, ca_key)) {
+      /* As above: user CAs only, into the SSL_CTX's own initially-empty store —
+       * otherwise a server doing mTLS with `ca: [internalCA]` would also accept
+       * any client certificate that chains to a public root. */
+      X509_STORE *cert_store = SSL_CTX_get_cert_store(ssl_context);
+      for (unsigned int i = 0; i < options.ca_count; i++) {
+        if (!add_ca_cert_to_ctx_store(ssl_context, options.ca[i], cert_store)) {
+          *err = CREATE_BUN_SOCKET_ERROR_INVALID_CA;
+          ssl_ctx_build_fail(ssl_context);
+          return NULL;
+        }
+        ERR_clear_error();
       }
-      ERR_clear_error();
-      SSL_CTX_set_verify(ssl_context,
-          options.reject_unauthorized ? (SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT)
-                                      : SSL_VERIFY_PEER,
-          us_verify_callback);
+      if (cacheable) us_ca_store_cache_put(ssl_context, ca_key);
     }
+    SSL_CTX_set_verify(ssl_context,
+        options.reject_unauthorized ? (SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT)
+                                    : SSL_VERIFY_PEER,
+        us_verify_callback);
   } else {
     /* No user CA: seed the shared default root store, like Node's
      * addRootCerts() when `ca` is absent - the handshake-time auto-chain and
@@ -1326,6 +2174,31 @@ SSL_CTX *us_ssl_ctx_build_raw(struct us_bun_socket_context_options_t options,
     SSL_CTX_set_timeout(ssl_context, options.session_timeout);
   }
 
+  if (options.ticket_keys_file) {
+    sessions->ticket_keys_file = us_strdup(options.ticket_keys_file);
+    sessions->ticket_key_count =
+        us_ssl_ticket_keys_read(options.ticket_keys_file, sessions->ticket_keys);
+    if (!sessions->ticket_key_count) {
+      *err = CREATE_BUN_SOCKET_ERROR_INVALID_TICKET_KEYS;
+      ssl_ctx_build_fail(ssl_context);
+      return NULL;
+    }
+    sessions->ticket_keys_checked = time(NULL);
+    SSL_CTX_set_tlsext_ticket_key_cb(ssl_context, us_ssl_ticket_key_cb);
+  }
+
+  if (options.handshake_threads) {
+    Bun__TLSKeyOffload__reserve(options.handshake_threads);
+    SSL_CTX_set_private_key_method(ssl_context, &us_ssl_key_method);
+  }
+
+  /* Servers accept 0-RTT on resumed sessions (and mark the tickets they issue
+   * as allowing it); clients offer it on sessions that allow it. The HTTP
+   * layers decide what may run before the handshake completes. */
+  if (options.early_data) {
+    SSL_CTX_set_early_data_enabled(ssl_context, 1);
+  }
+
   if (options.allow_partial_trust_chain) {
     /* Mirrors Node's SecureContext::SetAllowPartialTrustChain, which also
      * flags only the context's own store. A store that cannot be prepared
@@ -1598,6 +2471,7 @@ void us_internal_ssl_attach(struct us_socket_t *s, SSL_CTX *ctx,
   s->ssl_in_use = 0;
   s->ssl_pending_detach = 0;
   s->ssl_pending_close_code = 0;
+  s->ssl_ktls_tx = 0;
   s->ssl_is_server = is_client ? 0 : 1;
 }
 
@@ -1758,6 +2632,9 @@ static void ssl_trigger_handshake(struct us_socket_t *s, int success) {
   if (inline_rejected) {
     success = 0;
   }
+  if (success && s->ssl) {
+    us_ssl_count_handshake(s_ssl(s));
+  }
   /* An inline-rejected handshake reports the X509 verdict node surfaces
    * through ssl.verifyError() (UNABLE_TO_VERIFY_LEAF_SIGNATURE, ...), not
    * the SSL protocol reason that may wrap it. */
@@ -1847,6 +2724,37 @@ static int ssl_renegotiate(struct us_socket_t *s) {
   return 1;
 }
 
+/* SSL_shutdown for a kTLS socket: BoringSSL cannot seal the close_notify, so
+ * it goes out as a kernel-sealed alert record, and the SSL is told it was
+ * sent (reads continue until the peer's close_notify, as before). A send that
+ * fails under backpressure drops the alert, the same tradeoff as the
+ * WANT_WRITE case in ssl_handle_shutdown. */
+static void ssl_ktls_send_close_notify(struct us_socket_t *s) {
+#ifdef __linux__
+  if (!SSL_get_quiet_shutdown(s_ssl(s)) && !us_socket_is_closed(s) &&
+      us_internal_poll_type(&s->p) != POLL_TYPE_SOCKET_SHUT_DOWN) {
+    /* TLS_SET_RECORD_TYPE; see <linux/tls.h>. */
+    unsigned char alert[2] = {1 /* warning */, 0 /* close_notify */};
+    char control[CMSG_SPACE(sizeof(unsigned char))];
+    struct iovec iov = {.iov_base = alert, .iov_len = sizeof(alert)};
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    memset(control, 0, sizeof(control));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = 282 /* SOL_TLS */;
+    cmsg->cmsg_type = 1 /* TLS_SET_RECORD_TYPE */;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = 21 /* alert */;
+    (void)sendmsg(us_poll_fd(&s->p), &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+  }
+#endif
+  SSL_set_shutdown(s_ssl(s), SSL_get_shutdown(s_ssl(s)) | SSL_SENT_SHUTDOWN);
+}
+
 /* Returns 1 if shutdown is complete (or impossible) and the TCP socket may be
  * closed; 0 if we sent close_notify but must wait for the peer's. */
 static int ssl_handle_shutdown(struct us_socket_t *s, int force_fast_shutdown) {
@@ -1856,6 +2764,11 @@ static int ssl_handle_shutdown(struct us_socket_t *s, int force_fast_shutdown) {
   int state = SSL_get_shutdown(s_ssl(s));
   int sent_shutdown = state & SSL_SENT_SHUTDOWN;
   int received_shutdown = state & SSL_RECEIVED_SHUTDOWN;
+  if (s->ssl_ktls_tx) {
+    if (!sent_shutdown) ssl_ktls_send_close_notify(s);
+    /* A second SSL_shutdown would only poll for the peer's close_notify. */
+    return received_shutdown || force_fast_shutdown;
+  }
   if (!sent_shutdown || !received_shutdown) {
     ssl_set_loop_data(s);
     int ret = SSL_shutdown(s_ssl(s));
@@ -2016,10 +2929,10 @@ static void ssl_update_handshake(struct us_socket_t *s) {
 
   if (result <= 0) {
     int err = SSL_get_error(s_ssl(s), result);
-    if (err == SSL_ERROR_PENDING_CERTIFICATE) {
-      /* Suspended by an async SNICallback: stay in HANDSHAKE_PENDING with no
-       * poll re-arm; us_socket_sni_resolve() re-drives the handshake when the
-       * JS resolution arrives. */
+    if (err == SSL_ERROR_PENDING_CERTIFICATE || err == SSL_ERROR_WANT_PRIVATE_KEY_OPERATION) {
+      /* Suspended by an async SNICallback or a signature on a crypto worker:
+       * stay in HANDSHAKE_PENDING with no poll re-arm; us_socket_sni_resolve()
+       * or us_internal_ssl_drain_key_jobs() re-drives the handshake. */
       s->ssl_handshake_state = HANDSHAKE_PENDING;
       return;
     }
@@ -2212,6 +3125,38 @@ struct us_socket_t *us_internal_ssl_on_writable(struct us_socket_t *s) {
   return s;
 }
 
+/* Once a client's handshake is done, settle the early data it wrote: count
+ * an acceptance, or write rejected data again if the server proved to be the
+ * one the session was verified against. */
+static struct us_socket_t *ssl_finish_early_data(struct us_socket_t *s) {
+  if (us_ssl_early_data_idx < 0 || !SSL_is_init_finished(s_ssl(s))) return s;
+  SSL *ssl = s_ssl(s);
+  struct us_ssl_early_data_t *early = SSL_get_ex_data(ssl, us_ssl_early_data_idx);
+  if (!early) return s;
+  SSL_set_ex_data(ssl, us_ssl_early_data_idx, NULL);
+
+  int same_peer = 0;
+  if (early->rejected) {
+    const STACK_OF(CRYPTO_BUFFER) *chain = SSL_get0_peer_certificates(ssl);
+    CRYPTO_BUFFER *leaf = chain && sk_CRYPTO_BUFFER_num(chain) > 0 ? sk_CRYPTO_BUFFER_value(chain, 0) : NULL;
+    same_peer = early->leaf && leaf &&
+                CRYPTO_BUFFER_len(leaf) == CRYPTO_BUFFER_len(early->leaf) &&
+                memcmp(CRYPTO_BUFFER_data(leaf), CRYPTO_BUFFER_data(early->leaf), CRYPTO_BUFFER_len(leaf)) == 0;
+  } else {
+    us_internal_count_client(US_CLIENT_EARLY_DATA_ACCEPTED);
+  }
+
+  int resend = early->rejected && same_peer && early->length;
+  int written = resend ? us_internal_ssl_write(s, early->data, (int)early->length) : 0;
+  int failed = early->rejected && (!same_peer || written != (int)early->length) && early->length;
+  us_ssl_early_data_free(NULL, early, NULL, 0, 0, NULL);
+  if (ssl_gone(s)) return NULL;
+  if (failed) {
+    return us_socket_close(s, 0, NULL);
+  }
+  return s;
+}
+
 struct us_socket_t *us_internal_ssl_on_data(struct us_socket_t *s, char *data, int length) {
   /* See ssl_update_handshake: start this socket's SSL processing with a clean
    * per-thread error queue so a captured reason cannot belong to another
@@ -2277,13 +3222,19 @@ restart:
 
     if (just_read <= 0) {
       int err = SSL_get_error(s_ssl(s), just_read);
+      if (err == SSL_ERROR_EARLY_DATA_REJECTED) {
+        ssl_early_data_rejected(s_ssl(s));
+        continue;
+      }
       /* SSL_ERROR_PENDING_CERTIFICATE: the handshake is suspended waiting for
        * an async SNICallback (us_select_cert_cb returned retry). Treat it
        * like WANT_READ - stop the read loop, deliver whatever was decrypted,
        * and park the socket; us_socket_sni_resolve() re-drives the handshake
-       * when the JS resolution arrives. */
+       * when the JS resolution arrives. SSL_ERROR_WANT_PRIVATE_KEY_OPERATION
+       * parks the same way until the crypto worker's signature is drained. */
       if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE &&
-          err != SSL_ERROR_PENDING_CERTIFICATE) {
+          err != SSL_ERROR_PENDING_CERTIFICATE &&
+          err != SSL_ERROR_WANT_PRIVATE_KEY_OPERATION) {
         if (err == SSL_ERROR_WANT_RENEGOTIATE) {
           if (ssl_renegotiate(s)) continue;
           if (ssl_gone(s)) return NULL;
@@ -2418,8 +3369,10 @@ restart:
   /* If the last SSL_write failed with WANT_READ and we've now read, give the
    * application a writable callback — but not if SSL_read just told us it
    * needs to write first (would recurse). Re-check s->ssl: any dispatch above may
-   * have closed and freed s->ssl. */
+   * have closed and freed s->ssl. Rejected early data goes out ahead of it. */
   if (ssl_gone(s)) return NULL;
+  s = ssl_finish_early_data(s);
+  if (!s || ssl_gone(s)) return NULL;
   s = ssl_retry_parked_write(s);
   if (!s || ssl_gone(s)) return NULL;
 
@@ -2437,7 +3390,8 @@ restart:
  * and the expensive crypto work is the first step, so deprioritising
  * mid-handshake sockets keeps fully-established ones responsive under load. */
 int us_internal_ssl_is_low_prio(struct us_socket_t *s) {
-  return SSL_in_init(s_ssl(s));
+  /* A server reading early data already answers requests */
+  return SSL_in_init(s_ssl(s)) && !SSL_in_early_data(s_ssl(s));
 }
 
 /* ── Socket-level accessors / write / shutdown ───────────────────────────── */
@@ -2486,6 +3440,11 @@ int us_internal_ssl_write(struct us_socket_t *s, const char *data, int length) {
     return 0;
   }
 
+  /* The kernel seals records for this socket; it takes plaintext. */
+  if (s->ssl_ktls_tx) {
+    return us_socket_raw_write(s, data, length);
+  }
+
   /* Called from inside SSL_read/SSL_do_handshake on this socket (an ALPN/SNI
    * callback writing): wait for the handshake, same as WANT_READ below. */
   if (s->ssl_in_use) {
@@ -2521,6 +3480,9 @@ int us_internal_ssl_write(struct us_socket_t *s, const char *data, int length) {
   while (total < length) {
     int chunk = length - total;
     if (chunk > 16384) chunk = 16384;
+    /* A client still in early data keeps what it sends, in case the server
+     * rejects it. */
+    int early = !s->ssl_is_server && SSL_in_early_data(s_ssl(s));
     /* Same deferred-close protocol as the SSL_do_handshake/SSL_read drivers. */
     s->ssl_in_use = 1;
     last_ssl_written = SSL_write(s_ssl(s), data + total, chunk);
@@ -2534,6 +3496,7 @@ int us_internal_ssl_write(struct us_socket_t *s, const char *data, int length) {
       return 0;
     }
     if (last_ssl_written <= 0) break;
+    if (early) ssl_early_data_record(s_ssl(s), data + total, last_ssl_written);
     total += last_ssl_written;
     /* A batching allocation failure marks the socket fatal from inside the BIO;
      * stop sealing records for a connection that is being torn down. */
@@ -2551,7 +3514,10 @@ int us_internal_ssl_write(struct us_socket_t *s, const char *data, int length) {
   if (total > 0) return total;
   if (last_ssl_written <= 0) {
     int err = SSL_get_error(s_ssl(s), last_ssl_written);
-    if (err == SSL_ERROR_WANT_READ) {
+    if (err == SSL_ERROR_EARLY_DATA_REJECTED) {
+      ssl_early_data_rejected(s_ssl(s));
+      s->ssl_write_wants_read = 1;
+    } else if (err == SSL_ERROR_WANT_READ) {
       s->ssl_write_wants_read = 1;
     } else if (err == SSL_ERROR_SSL || err == SSL_ERROR_SYSCALL) {
       /* SSL_write drives the handshake when it has not finished, so this is
@@ -2565,6 +3531,184 @@ int us_internal_ssl_write(struct us_socket_t *s, const char *data, int length) {
   return 0;
 }
 
+/* kTLS TX (Linux). The TLS ULP takes the write key, the implicit IV and the
+ * next record sequence number; from then on the kernel seals whatever is
+ * written to the fd, including sendfile() data. Only the server's write
+ * direction is moved: reads keep going through SSL_read, so alerts,
+ * KeyUpdates and close_notify from the peer are still handled by BoringSSL.
+ * Structures and constants are <linux/tls.h> ABI, spelled out like
+ * eventing/io_uring.c does for io_uring. */
+#ifdef __linux__
+#define US_SOL_TLS 282
+#define US_TCP_ULP 31
+#define US_TLS_TX 1
+#define US_TLS_CIPHER_AES_GCM_128 51
+#define US_TLS_CIPHER_AES_GCM_256 52
+#define US_TLS_CIPHER_CHACHA20_POLY1305 54
+
+struct us_ktls_crypto_info_t {
+  uint16_t version;
+  uint16_t cipher_type;
+  /* Cipher-specific tail: iv, key, salt, rec_seq (tls12_crypto_info_*). */
+  unsigned char material[12 + 32 + 4 + 8];
+};
+
+/* HKDF-Expand-Label (RFC 8446 7.1) with an empty context. */
+static int ssl_ktls_expand_label(const EVP_MD *md, const uint8_t *secret, size_t secret_len,
+                                 const char *label, uint8_t *out, size_t out_len) {
+  uint8_t info[2 + 1 + 6 + 8 + 1];
+  size_t label_len = strlen(label);
+  size_t n = 0;
+  info[n++] = (uint8_t)(out_len >> 8);
+  info[n++] = (uint8_t)out_len;
+  info[n++] = (uint8_t)(6 + label_len);
+  memcpy(info + n, "tls13 ", 6);
+  n += 6;
+  memcpy(info + n, label, label_len);
+  n += label_len;
+  info[n++] = 0;
+  return HKDF_expand(out, out_len, md, secret, secret_len, info, n);
+}
+
+/* Fills `info` with this SSL's current write state. Returns its length, or 0
+ * when the version or cipher has no kernel implementation (or the keys are
+ * not available). */
+static socklen_t ssl_ktls_tx_crypto_info(SSL *ssl, struct us_ktls_crypto_info_t *info) {
+  const SSL_CIPHER *cipher = SSL_get_current_cipher(ssl);
+  if (!cipher) return 0;
+  int version = SSL_version(ssl);
+  if (version != TLS1_2_VERSION && version != TLS1_3_VERSION) return 0;
+
+  size_t key_len, iv_len, salt_len;
+  uint16_t cipher_type;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+  case NID_aes_128_gcm:
+    cipher_type = US_TLS_CIPHER_AES_GCM_128;
+    key_len = 16; iv_len = 8; salt_len = 4;
+    break;
+  case NID_aes_256_gcm:
+    cipher_type = US_TLS_CIPHER_AES_GCM_256;
+    key_len = 32; iv_len = 8; salt_len = 4;
+    break;
+  case NID_chacha20_poly1305:
+    cipher_type = US_TLS_CIPHER_CHACHA20_POLY1305;
+    key_len = 32; iv_len = 12; salt_len = 0;
+    break;
+  default:
+    return 0;
+  }
+
+  /* The nonce is salt || iv: 4 + 8 bytes for AES-GCM, 12 (no salt) for
+   * ChaCha20-Poly1305. */
+  uint8_t key[32], nonce[12];
+  if (version == TLS1_3_VERSION) {
+    struct us_ssl_ktls_secret_t *secret = SSL_get_ex_data(ssl, us_ssl_ktls_secret_idx);
+    const EVP_MD *md = SSL_CIPHER_get_handshake_digest(cipher);
+    if (!secret || !secret->length || !md || secret->length != EVP_MD_size(md)) return 0;
+    if (!ssl_ktls_expand_label(md, secret->bytes, secret->length, "key", key, key_len) ||
+        !ssl_ktls_expand_label(md, secret->bytes, secret->length, "iv", nonce, sizeof(nonce))) {
+      OPENSSL_cleanse(key, sizeof(key));
+      return 0;
+    }
+  } else {
+    /* TLS 1.2 key block, AEAD suites (no MAC keys): client key, server key,
+     * client fixed IV, server fixed IV. The explicit half of the AES-GCM
+     * nonce is the record sequence number, as BoringSSL does it. */
+    size_t fixed_len = salt_len ? salt_len : iv_len;
+    uint8_t block[2 * (32 + 12)];
+    size_t block_len = SSL_get_key_block_len(ssl);
+    if (block_len != 2 * (key_len + fixed_len) || !SSL_generate_key_block(ssl, block, block_len)) return 0;
+    memcpy(key, block + key_len, key_len);
+    memcpy(nonce, block + 2 * key_len + fixed_len, fixed_len);
+    OPENSSL_cleanse(block, sizeof(block));
+  }
+
+  uint8_t rec_seq[8];
+  uint64_t seq = SSL_get_write_sequence(ssl);
+  for (int i = 7; i >= 0; i--, seq >>= 8) rec_seq[i] = (uint8_t)seq;
+  if (version == TLS1_2_VERSION && salt_len) memcpy(nonce + salt_len, rec_seq, iv_len);
+
+  memset(info, 0, sizeof(*info));
+  info->version = (uint16_t)version;
+  info->cipher_type = cipher_type;
+  unsigned char *p = info->material;
+  memcpy(p, nonce + salt_len, iv_len);
+  p += iv_len;
+  memcpy(p, key, key_len);
+  p += key_len;
+  memcpy(p, nonce, salt_len);
+  p += salt_len;
+  memcpy(p, rec_seq, sizeof(rec_seq));
+  p += sizeof(rec_seq);
+  OPENSSL_cleanse(key, sizeof(key));
+  OPENSSL_cleanse(nonce, sizeof(nonce));
+  return (socklen_t)(p - (unsigned char *)info);
+}
+#endif
+
+int us_internal_ssl_enable_ktls_tx(struct us_socket_t *s) {
+#ifdef __linux__
+  if (s->ssl_ktls_tx) return 1;
+  if (!us_ssl_ktls_enabled() || !s->ssl_is_server || s->ssl_handshake_state != HANDSHAKE_COMPLETED ||
+      s->ssl_in_use || s->ssl_write_wants_read || s->ssl_read_wants_write || us_socket_is_closed(s) ||
+      us_internal_ssl_is_shut_down(s) || SSL_in_init(s_ssl(s))) {
+    return 0;
+  }
+  struct loop_ssl_data *loop_ssl_data = (struct loop_ssl_data *)s->group->loop->data.ssl_data;
+  /* Any spill: ours must drain under the old keys first, and another
+   * socket's forces per-record write-through, which can leave part of a
+   * record inside BoringSSL. */
+  if (!loop_ssl_data || loop_ssl_data->ssl_spill_owner) return 0;
+
+  /* Everything BoringSSL already sealed has to reach the wire under its own
+   * keys first. It holds TLS 1.3 NewSessionTickets back until the first
+   * write; a zero-byte SSL_write flushes them (into the batch, so nothing
+   * is left inside BoringSSL either way). */
+  loop_ssl_data->ssl_read_input_length = 0;
+  loop_ssl_data->ssl_socket = s;
+  loop_ssl_data->ssl_write_batching = 1;
+  s->ssl_in_use = 1;
+  int flushed = SSL_write(s_ssl(s), "", 0);
+  s->ssl_in_use = 0;
+  loop_ssl_data->ssl_write_batching = 0;
+  if (s->ssl_pending_detach) {
+    loop_ssl_data->ssl_write_batch_len = 0;
+    s->ssl_pending_detach = 0;
+    us_socket_close(s, s->ssl_pending_close_code, NULL);
+    return 0;
+  }
+  if (flushed < 0) {
+    ERR_clear_error();
+  }
+  if (!ssl_flush_write_batch(loop_ssl_data, s) || s->ssl_fatal_error || flushed < 0) return 0;
+
+  struct us_ktls_crypto_info_t info;
+  socklen_t info_len = ssl_ktls_tx_crypto_info(s_ssl(s), &info);
+  if (!info_len) return 0;
+
+  LIBUS_SOCKET_DESCRIPTOR fd = us_poll_fd(&s->p);
+  /* EEXIST: a previous attempt attached the ULP but the key was refused;
+   * with no TX state configured it passes writes through untouched. */
+  if (setsockopt(fd, IPPROTO_TCP, US_TCP_ULP, "tls", sizeof("tls")) != 0 && errno != EEXIST) {
+    if (errno == ENOENT) us_ssl_ktls_available = 0;
+    OPENSSL_cleanse(&info, sizeof(info));
+    return 0;
+  }
+  int rc = setsockopt(fd, US_SOL_TLS, US_TLS_TX, &info, info_len);
+  OPENSSL_cleanse(&info, sizeof(info));
+  if (rc != 0) return 0;
+
+  s->ssl_ktls_tx = 1;
+  void *secret = SSL_get_ex_data(s_ssl(s), us_ssl_ktls_secret_idx);
+  SSL_set_ex_data(s_ssl(s), us_ssl_ktls_secret_idx, NULL);
+  us_ssl_ktls_secret_free(NULL, secret, NULL, 0, 0, NULL);
+  return 1;
+#else
+  (void)s;
+  return 0;
+#endif
+}
+
 void us_internal_ssl_shutdown(struct us_socket_t *s) {
   if (us_socket_is_closed(s) || us_internal_ssl_is_shut_down(s)) return;
 
@@ -2596,6 +3740,12 @@ void us_internal_ssl_shutdown(struct us_socket_t *s) {
     return;
   }
 
+  if (s->ssl_ktls_tx) {
+    ssl_ktls_send_close_notify(s);
+    us_internal_socket_raw_shutdown(s);
+    return;
+  }
+
     struct loop_ssl_data *loop_ssl_data = (struct loop_ssl_data *)s->group->loop->data.ssl_data;
   loop_ssl_data->ssl_read_input_length = 0;
   loop_ssl_data->ssl_socket = s;
@@ -2751,6 +3901,13 @@ void us_ssl_ctx_set_sni_policy(SSL_CTX *ctx, int request_cert, int reject_unauth
  * recorded policy (node:tls SecureContext, whose policy is server-level)
  * leaves the connection's verify mode untouched. */
 static void us_ssl_apply_selected_ctx(SSL *ssl, SSL_CTX *ctx) {
+  if (us_ctx_sessions_ex_idx >= 0 && !SSL_get_ex_data(ssl, us_ssl_ticket_sessions_idx)) {
+    struct us_ssl_ctx_sessions_t *sessions =
+        SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), us_ctx_sessions_ex_idx);
+    if (sessions && sessions->ticket_keys_file) {
+      SSL_set_ex_data(ssl, us_ssl_ticket_sessions_idx, sessions);
+    }
+  }
   SSL_set_SSL_CTX(ssl, ctx);
   if (us_ctx_sni_policy_ex_idx < 0) return;
   uintptr_t policy = (uintptr_t)SSL_CTX_get_ex_data(ctx, us_ctx_sni_policy_ex_idx);
@@ -3061,6 +4218,18 @@ void us_socket_on_server_name(struct us_socket_t *s, us_socket_server_name_cb cb
   if (ctx) SSL_CTX_set_select_certificate_cb(ctx, us_select_cert_cb);
 }
 
+int us_socket_ssl_in_early_data(struct us_socket_t *s) {
+  if (!s->ssl || !s_ssl(s)) return 0;
+  return SSL_is_server(s_ssl(s)) && SSL_in_early_data(s_ssl(s));
+}
+
+void us_socket_ssl_count_too_early(struct us_socket_t *s) {
+  if (!s->ssl || !s_ssl(s) || us_ctx_sessions_ex_idx < 0) return;
+  struct us_ssl_ctx_sessions_t *sessions =
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(s_ssl(s)), us_ctx_sessions_ex_idx);
+  if (sessions) atomic_fetch_add(&sessions->too_early, 1);
+}
+
 void *us_socket_server_name_userdata(struct us_socket_t *s) {
   if (!s->ssl || !s_ssl(s) || us_sni_ex_idx < 0) return NULL;
   return SSL_CTX_get_ex_data(SSL_get_SSL_CTX(s_ssl(s)), us_sni_ex_idx);
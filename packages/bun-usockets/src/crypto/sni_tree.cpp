@@ -15,205 +15,236 @@
  * limitations under the License.
  */
 
-/* This Server Name Indication hostname tree is written in C++ but could be ported to C.
- * Overall it looks like crap, but has no memory allocations in fast path and is O(log n). */
+/* Server Name Indication index shared by TLS listen sockets (openssl.c) and
+ * QUIC contexts (quic.c). Two flat open-addressing tables: one keyed by the
+ * whole name for exact patterns, one keyed by what follows "*." for wildcard
+ * patterns. A lookup hashes the hostname, then the hostname minus its first
+ * label, so it costs at most two probes whatever the number of names, and
+ * allocates nothing. Names are added and removed in place, without a rebuild.
+ *
+ * Matching follows RFC 6125: names compare ASCII case-insensitively, a
+ * wildcard is the whole leftmost label and stands for exactly one label, and
+ * an exact pattern wins over a wildcard. "*" alone matches single-label names.
+ * A '*' anywhere else in a pattern is literal. */
 
 #ifndef SNI_TREE_H
 #define SNI_TREE_H
 
 #ifndef LIBUS_NO_SSL
 
-#include "libusockets.h"
-#include <map>
-#include <memory>
-#include <string_view>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
-#include <cstdlib>
-#include <algorithm>
 
-/* We only handle a maximum of 10 labels per hostname */
-#define MAX_LABELS 10
+namespace {
 
-/* This cannot be shared */
-thread_local void (*sni_free_cb)(void *);
+/* Folds ASCII letters to lower case a word at a time. It also folds some
+ * punctuation onto other punctuation, which only costs a collision: names are
+ * compared with sni_equal after the hash matches. */
+constexpr uint64_t SNI_FOLD = 0x2020202020202020ull;
 
-struct sni_node {
-    /* Empty nodes must always hold null */
-    void *user = nullptr;
-    std::map<std::string_view, std::unique_ptr<sni_node>> children;
+inline uint64_t sni_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
 
-    ~sni_node() {
-        for (auto &p : children) {
-            /* The data of our string_views are managed by us_malloc */
-            us_free((void *) p.first.data());
+inline uint64_t sni_hash(const char *name, size_t length) {
+    uint64_t h = 0x9e3779b97f4a7c15ull ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, name + i, 8);
+        h = sni_mix(h ^ (word | SNI_FOLD));
+    }
+    if (i < length) {
+        uint64_t word = 0;
+        memcpy(&word, name + i, length - i);
+        h = sni_mix(h ^ (word | SNI_FOLD));
+    }
+    return h;
+}
 
-            /* Call destructor passed to sni_free only if we hold data.
-             * This is important since sni_remove does not have sni_free_cb set */
-            if (p.second.get()->user) {
-                sni_free_cb(p.second.get()->user);
-            }
-        }
+inline bool sni_equal(const char *a, const char *b, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        unsigned char x = (unsigned char) a[i], y = (unsigned char) b[i];
+        if (x == y) continue;
+        x |= 0x20;
+        if (x != (y | 0x20) || x < 'a' || x > 'z') return false;
     }
+    return true;
+}
+
+struct sni_slot {
+    uint64_t hash;
+    /* nullptr marks an empty slot */
+    char *name;
+    size_t length;
+    void *user;
 };
 
-// this can only delete ONE single node, but may cull "empty nodes with null as data"
-void *removeUser(struct sni_node *root, unsigned int label, std::string_view *labels, unsigned int numLabels) {
+/* Linear probing; removal shifts the rest of the cluster back instead of
+ * leaving tombstones, so lookups never slow down as names come and go. */
+struct sni_table {
+    sni_slot *slots = nullptr;
+    size_t mask = 0;
+    size_t count = 0;
 
-    /* If we are in the bottom (past bottom by one), there is nothing to remove */
-    if (label == numLabels) {
-        void *user = root->user;
-        /* Mark us for culling on the way up */
-        root->user = nullptr;
-        return user;
+    ~sni_table() {
+        for (size_t i = 0; slots && i <= mask; i++) {
+            delete[] slots[i].name;
+        }
+        delete[] slots;
     }
 
-    /* Is this label a child of root? */
-    auto it = root->children.find(labels[label]);
-    if (it == root->children.end()) {
-        /* We cannot continue */
-        return nullptr;
+    sni_slot *find(const char *name, size_t length, uint64_t hash) const {
+        if (!slots) return nullptr;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            sni_slot *slot = &slots[i];
+            if (!slot->name) return nullptr;
+            if (slot->hash == hash && slot->length == length && sni_equal(slot->name, name, length)) {
+                return slot;
+            }
+        }
     }
 
-    void *removedUser = removeUser(it->second.get(), label + 1, labels, numLabels);
-
-    /* On the way back up, we may cull empty nodes with no children.
-     * This ends up being where we remove all nodes */
-    if (it->second.get()->children.empty() && it->second.get()->user == nullptr) {
-
-        /* The data of our string_views are managed by us_malloc */
-        us_free((void *) it->first.data());
-
-        /* This can only happen with user set to null, otherwise we use sni_free_cb which is unset by sni_remove */
-        root->children.erase(it);
+    void place(sni_slot slot) {
+        size_t i = slot.hash & mask;
+        while (slots[i].name) i = (i + 1) & mask;
+        slots[i] = slot;
     }
 
-    return removedUser;
-}
+    void grow() {
+        size_t capacity = slots ? (mask + 1) * 2 : 16;
+        sni_slot *old = slots;
+        size_t oldCapacity = slots ? mask + 1 : 0;
+        slots = new sni_slot[capacity]();
+        mask = capacity - 1;
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (old[i].name) place(old[i]);
+        }
+        delete[] old;
+    }
 
-void *getUser(struct sni_node *root, unsigned int label, std::string_view *labels, unsigned int numLabels) {
+    /* Returns false if the name is already present */
+    bool insert(const char *name, size_t length, void *user) {
+        uint64_t hash = sni_hash(name, length);
+        if (find(name, length, hash)) return false;
+        /* Keep the load under 3/4 */
+        if (!slots || (count + 1) * 4 > (mask + 1) * 3) grow();
+        char *copy = new char[length + 1];
+        memcpy(copy, name, length);
+        copy[length] = 0;
+        place({hash, copy, length, user});
+        count++;
+        return true;
+    }
 
-    /* Do we have labels to match? Otherwise, return where we stand */
-    if (label == numLabels) {
-        return root->user;
+    void *remove(const char *name, size_t length) {
+        sni_slot *slot = find(name, length, sni_hash(name, length));
+        if (!slot) return nullptr;
+        void *user = slot->user;
+        delete[] slot->name;
+        count--;
+
+        size_t hole = (size_t) (slot - slots);
+        for (size_t i = (hole + 1) & mask; slots[i].name; i = (i + 1) & mask) {
+            size_t home = slots[i].hash & mask;
+            /* Move the entry into the hole unless its home slot lies
+             * cyclically in (hole, i], where it would no longer be found. */
+            bool stays = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+            if (!stays) {
+                slots[hole] = slots[i];
+                hole = i;
+            }
+        }
+        slots[hole] = sni_slot{};
+        return user;
     }
 
-    /* Try and match by our label */
-    auto it = root->children.find(labels[label]);
-    if (it != root->children.end()) {
-        void *user = getUser(it->second.get(), label + 1, labels, numLabels);
-        if (user) {
-            return user;
+    template <typename F>
+    void forEach(F f) const {
+        for (size_t i = 0; slots && i <= mask; i++) {
+            if (slots[i].name) f(slots[i].user);
         }
     }
+};
 
-    /* Try and match by wildcard */
-    it = root->children.find("*");
-    if (it == root->children.end()) {
-        /* Matching has failed for both label and wildcard */
-        return nullptr;
+struct sni_index {
+    sni_table exact;
+    /* Keyed by the pattern without its leading "*." ("" for "*") */
+    sni_table wildcard;
+
+    /* The table and key a pattern is stored under */
+    sni_table &tableFor(const char *&pattern, size_t &length) {
+        if (length >= 1 && pattern[0] == '*' && (length == 1 || pattern[1] == '.')) {
+            size_t skip = length == 1 ? 1 : 2;
+            pattern += skip;
+            length -= skip;
+            return wildcard;
+        }
+        return exact;
     }
+};
 
-    /* We matched by wildcard */
-    return getUser(it->second.get(), label + 1, labels, numLabels);
 }
 
 extern "C" {
 
     void *sni_new() {
-        return new sni_node;
+        return new sni_index;
     }
 
+    /* Runs cb on every remaining user, then frees the index */
     void sni_free(void *sni, void (*cb)(void *)) {
-        /* We want to run this callback for every remaining name */
-        sni_free_cb = cb;
-
-        delete (sni_node *) sni;
+        sni_index *index = (sni_index *) sni;
+        index->exact.forEach(cb);
+        index->wildcard.forEach(cb);
+        delete index;
     }
 
-    /* Returns non-null if this name already exists */
+    /* Returns non-zero if this pattern already exists */
     int sni_add(void *sni, const char *hostname, void *user) {
-        struct sni_node *root = (struct sni_node *) sni;
-
-        /* Traverse all labels in hostname */
-        for (std::string_view view(hostname, strlen(hostname)), label;
-            view.length(); view.remove_prefix(std::min(view.length(), label.length() + 1))) {
-            /* Label is the token separated by dot */
-            label = view.substr(0, view.find('.', 0));
-
-            auto it = root->children.find(label);
-            if (it == root->children.end()) {
-                /* Duplicate this label for our kept string_view of it */
-                void *labelString = us_malloc(label.length());
-                memcpy(labelString, label.data(), label.length());
-
-                it = root->children.emplace(std::string_view((char *) labelString, label.length()),
-                                            std::make_unique<sni_node>()).first; // NOLINT(clang-analyzer-unix.Malloc)
-            }
-
-            root = it->second.get();
-        }
-
-        /* We must never add multiple contexts for the same name, as that would overwrite and leak */
-        if (root->user) {
-            return 1;
-        }
-
-        root->user = user;
-
-        return 0;
+        sni_index *index = (sni_index *) sni;
+        size_t length = strlen(hostname);
+        sni_table &table = index->tableFor(hostname, length);
+        return table.insert(hostname, length, user) ? 0 : 1;
     }
 
-    /* Removes the exact match. Wildcards are treated as the verbatim asterisk char, not as an actual wildcard */
+    /* Removes the exact pattern: a wildcard pattern removes that wildcard, it
+     * does not match the names it covers */
     void *sni_remove(void *sni, const char *hostname) {
-        struct sni_node *root = (struct sni_node *) sni;
-
-        /* I guess 10 labels is an okay limit */
-        std::string_view labels[10];
-        unsigned int numLabels = 0;
-
-        /* We traverse all labels first of all */
-        for (std::string_view view(hostname, strlen(hostname)), label;
-            view.length(); view.remove_prefix(std::min(view.length(), label.length() + 1))) {
-            /* Label is the token separated by dot */
-            label = view.substr(0, view.find('.', 0));
-
-            /* Anything longer than 10 labels is forbidden */
-            if (numLabels == 10) {
-                return nullptr;
-            }
-
-            labels[numLabels++] = label;
-        }
-
-        return removeUser(root, 0, labels, numLabels);
+        sni_index *index = (sni_index *) sni;
+        size_t length = strlen(hostname);
+        sni_table &table = index->tableFor(hostname, length);
+        return table.remove(hostname, length);
     }
 
+    /* The user of the pattern matching hostname. A wildcard pattern passed
+     * as hostname finds itself, the same as an exact one. */
     void *sni_find(void *sni, const char *hostname) {
-        struct sni_node *root = (struct sni_node *) sni;
-
-        /* I guess 10 labels is an okay limit */
-        std::string_view labels[10];
-        unsigned int numLabels = 0;
+        sni_index *index = (sni_index *) sni;
+        size_t length = strlen(hostname);
+        if (!length) return nullptr;
 
-        /* We traverse all labels first of all */
-        for (std::string_view view(hostname, strlen(hostname)), label;
-            view.length(); view.remove_prefix(std::min(view.length(), label.length() + 1))) {
-            /* Label is the token separated by dot */
-            label = view.substr(0, view.find('.', 0));
-
-            /* Anything longer than 10 labels is forbidden */
-            if (numLabels == 10) {
-                return nullptr;
-            }
-
-            labels[numLabels++] = label;
+        if (sni_slot *slot = index->exact.find(hostname, length, sni_hash(hostname, length))) {
+            return slot->user;
         }
-
-        return getUser(root, 0, labels, numLabels);
+        if (!index->wildcard.count) return nullptr;
+
+        /* Everything after the first label, or "" for a single label */
+        const char *dot = (const char *) memchr(hostname, '.', length);
+        const char *rest = dot ? dot + 1 : hostname + length;
+        size_t restLength = (size_t) (hostname + length - rest);
+        sni_slot *slot = index->wildcard.find(rest, restLength, sni_hash(rest, restLength));
+        return slot ? slot->user : nullptr;
     }
 
 }
 
 #endif
 
-#endif
\ No newline at end of file
+#endif
@@ -57,6 +57,9 @@ void us_loop_run_bun_tick(struct us_loop_t *loop, const struct timespec* timeout
 
 /* Loop */
 void us_loop_free(struct us_loop_t *loop) {
+#ifdef LIBUS_USE_IO_URING
+    us_internal_io_uring_free(loop);
+#endif
     us_internal_loop_data_free(loop);
     close(loop->fd);
     us_free(loop);
@@ -72,6 +75,9 @@ struct us_poll_t *us_create_poll(struct us_loop_t *loop, int fallthrough, unsign
 
 /* Todo: this one should be us_internal_poll_free */
 void us_poll_free(struct us_poll_t *p, struct us_loop_t *loop) {
+#ifdef LIBUS_USE_IO_URING
+    us_internal_io_uring_poll_move(loop, p, NULL);
+#endif
     loop->num_polls--;
     us_free(p);
 }
@@ -80,6 +86,9 @@ void us_poll_free(struct us_poll_t *p, struct us_loop_t *loop) {
 void us_poll_init(struct us_poll_t *p, LIBUS_SOCKET_DESCRIPTOR fd, int poll_type) {
     p->state.fd = fd;
     p->state.poll_type = poll_type;
+#ifdef LIBUS_USE_IO_URING
+    p->ring_slot = 0;
+#endif
 }
 
 __attribute__((always_inline)) int us_poll_events(struct us_poll_t *p) {
@@ -186,6 +195,21 @@ static int bun_epoll_pwait2(int epfd, struct epoll_event *events, int maxevents,
 
 extern int Bun__isEpollPwait2SupportedOnLinuxKernel();
 
+/* Fetches ready polls into loop->ready_polls, sleeping in io_uring_enter
+ * instead of epoll_pwait2 when the loop has a ring. */
+static int us_internal_epoll_wait(struct us_loop_t *loop, const struct timespec *timeout) {
+#ifdef LIBUS_USE_IO_URING
+    if (loop->data.io_uring) {
+        int epoll_ready = us_internal_io_uring_wait(loop, timeout);
+        if (epoll_ready >= 0) {
+            static const struct timespec zero = {0, 0};
+            return epoll_ready ? bun_epoll_pwait2(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS, &zero) : 0;
+        }
+    }
+#endif
+    return bun_epoll_pwait2(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS, timeout);
+}
+
 #else
 
 /* kevent(2) returns EINTR when a signal is caught (XNU kqueue_scan returns
@@ -242,6 +266,9 @@ struct us_loop_t *us_create_loop(void *hint, void (*wakeup_cb)(struct us_loop_t
 #endif
 
     us_internal_loop_data_init(loop, wakeup_cb, pre_cb, post_cb);
+#ifdef LIBUS_USE_IO_URING
+    us_internal_io_uring_init(loop);
+#endif
     return loop;
 }
 
@@ -263,6 +290,13 @@ static void us_internal_dispatch_ready_polls(struct us_loop_t *loop) {
             /* A read-side FIN is EPOLLIN + recv()==0; EPOLLHUP means both directions
              * are down and is level-triggered, so tag it for the dispatch to close. */
             const int eof = (events & EPOLLHUP) ? LIBUS_POLL_HANGUP : 0;
+#ifdef LIBUS_USE_IO_URING
+            /* A socket the ring reads for is in epoll without EPOLLIN, which
+             * would otherwise ride along with these and drain the socket. */
+            if (poll->ring_slot && (error || eof)) {
+                events |= EPOLLIN;
+            }
+#endif
             events &= us_poll_events(poll);
             if (events || error || eof) {
                 us_internal_dispatch_ready_poll(poll, error, eof, events);
@@ -446,11 +480,15 @@ void us_loop_run(struct us_loop_t *loop) {
 
         /* Fetch ready polls */
 #ifdef LIBUS_USE_EPOLL
-        loop->num_ready_polls = bun_epoll_pwait2(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS, timeout);
+        loop->num_ready_polls = us_internal_epoll_wait(loop, timeout);
 #else
         loop->num_ready_polls = bun_kevent64_wait(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS, 0, timeout);
 #endif
 
+#ifdef LIBUS_USE_IO_URING
+        loop->current_ready_poll = 0;
+        us_internal_io_uring_dispatch(loop);
+#endif
         us_internal_dispatch_ready_polls(loop);
         us_internal_drain_ready_polls(loop);
         us_internal_sweep_if_due(loop);
@@ -490,6 +528,14 @@ void us_loop_run_bun_tick(struct us_loop_t *loop, const struct timespec* timeout
     struct timespec sweep_ts;
     timeout = us_internal_clamp_to_sweep(loop, timeout, &sweep_ts);
 
+#ifdef LIBUS_USE_IO_URING
+    /* The ring already received input a paused socket is now resumed for. */
+    static const struct timespec no_wait = {0, 0};
+    if (us_internal_io_uring_has_ready(loop)) {
+        timeout = &no_wait;
+    }
+#endif
+
     const unsigned int had_wakeups = __atomic_exchange_n(&loop->pending_wakeups, 0, __ATOMIC_ACQUIRE);
     const int will_idle_inside_event_loop = had_wakeups == 0 && (!timeout || (timeout->tv_nsec != 0 || timeout->tv_sec != 0));
     /* `now_ns` is the reading the JS side took to pick `timeout`
@@ -519,7 +565,7 @@ void us_loop_run_bun_tick(struct us_loop_t *loop, const struct timespec* timeout
     /* A zero timespec already has a fast path in ep_poll (fs/eventpoll.c):
      * it sets timed_out=1 (line 1952) and returns before any scheduler
      * interaction (line 1975). No equivalent of KEVENT_FLAG_IMMEDIATE needed. */
-    loop->num_ready_polls = bun_epoll_pwait2(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS, timeout);
+    loop->num_ready_polls = us_internal_epoll_wait(loop, timeout);
 #else
     loop->num_ready_polls = bun_kevent64_wait(loop->fd, loop->ready_polls, LIBUS_MAX_READY_POLLS,
         /* When we won't idle (pending wakeups or zero timeout), use KEVENT_FLAG_IMMEDIATE.
@@ -536,6 +582,10 @@ void us_loop_run_bun_tick(struct us_loop_t *loop, const struct timespec* timeout
     if (handed_off)
         mi_on_thread_idle_end();
 
+#ifdef LIBUS_USE_IO_URING
+    loop->current_ready_poll = 0;
+    us_internal_io_uring_dispatch(loop);
+#endif
     us_internal_dispatch_ready_polls(loop);
     us_internal_drain_ready_polls(loop);
     us_internal_sweep_if_due(loop);
@@ -653,6 +703,9 @@ struct us_poll_t *us_poll_resize(struct us_poll_t *p, struct us_loop_t *loop, un
     
     int events = us_poll_events(p);
 #ifdef LIBUS_USE_EPOLL
+#ifdef LIBUS_USE_IO_URING
+    us_internal_io_uring_poll_move(loop, p, new_p);
+#endif
     /* Hack: forcefully update poll by stripping away already set events */
     new_p->state.poll_type = us_internal_poll_type(new_p);
     us_poll_change(new_p, loop, events);
@@ -690,6 +743,9 @@ int us_poll_start_rc(struct us_poll_t *p, struct us_loop_t *loop, int events) {
          * spinning the loop at 100% CPU until the JS side closes the fd. */
         events |= EPOLLHUP | EPOLLERR;
     }
+#ifdef LIBUS_USE_IO_URING
+    events = us_internal_io_uring_poll_events(loop, p, events);
+#endif
     event.events = events;
     event.data.ptr = p;
     int ret;
@@ -721,6 +777,9 @@ int us_poll_change(struct us_poll_t *p, struct us_loop_t *loop, int events) {
              * EPOLLRDHUP for an already-half-closed socket or the loop spins. */
             event.events |= EPOLLHUP | EPOLLERR;
         }
+#ifdef LIBUS_USE_IO_URING
+        event.events = us_internal_io_uring_poll_events(loop, p, event.events);
+#endif
         event.data.ptr = p;
         do {
             rc = epoll_ctl(loop->fd, EPOLL_CTL_MOD, p->state.fd, &event);
@@ -750,6 +809,9 @@ void us_poll_stop(struct us_poll_t *p, struct us_loop_t *loop) {
     do {
          rc = epoll_ctl(loop->fd, EPOLL_CTL_DEL, p->state.fd, &event);
     } while (IS_EINTR(rc));
+#ifdef LIBUS_USE_IO_URING
+    us_internal_io_uring_poll_stop(loop, p);
+#endif
 #else
     /* A socket poll has a read knote in both of its modes (see kqueue_change), so there is
      * one to delete even when it was not polling for reads. */
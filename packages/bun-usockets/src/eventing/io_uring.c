@@ -0,0 +1,1008 @@
+/*
+ * Authored by Alex Hultman, 2018-2021.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// clang-format off
+#include "libusockets.h"
+#include "internal/internal.h"
+
+#ifdef LIBUS_USE_IO_URING
+
+/* An io_uring layered over the epoll loop. epoll stays the loop's source of
+ * truth: Bun's own FilePolls register on loop->fd directly, every poll keeps
+ * its epoll registration for WRITABLE and the implicit EPOLLHUP/EPOLLERR, and
+ * the loop sleeps in io_uring_enter on a one-shot POLL_ADD of the epoll fd.
+ * What moves to the ring is the read side of TCP:
+ *
+ *  - listen sockets get a multishot accept; the fds it produces queue on the
+ *    listen socket's slot and the accept loop in loop.c takes them from there;
+ *  - stream sockets get a multishot recv into a provided buffer ring and are
+ *    registered in epoll without EPOLLIN; received buffers queue on the
+ *    socket's slot and the read loop in loop.c takes them before it would
+ *    recv() itself.
+ *
+ * The ring is created with DEFER_TASKRUN, so the kernel only runs those
+ * requests inside our io_uring_enter: a direct recv() from the read loop can
+ * never race one. Anything the ring cannot do for a poll (IPC sockets that
+ * need recvmsg, fds that are not sockets, an SQ that is out of entries) puts
+ * that poll back on EPOLLIN, and a ring that cannot be set up at all leaves the
+ * loop on plain epoll. Sends stay synchronous: us_socket_write reports how many
+ * bytes the kernel took, which an asynchronous send cannot. */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* Set from BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING and the kernel version. */
+extern int Bun__isIoUringEventLoopEnabled(void);
+
+/* io_uring(7) ABI. Spelled out instead of taken from <linux/io_uring.h>: build
+ * hosts ship headers older than the 6.1 features used here, and all of it is
+ * fixed kernel ABI. */
+#ifndef SYS_io_uring_setup
+#define SYS_io_uring_setup 425
+#endif
+#ifndef SYS_io_uring_enter
+#define SYS_io_uring_enter 426
+#endif
+#ifndef SYS_io_uring_register
+#define SYS_io_uring_register 427
+#endif
+
+struct us_uring_sqring_offsets {
+    uint32_t head, tail, ring_mask, ring_entries, flags, dropped, array, resv1;
+    uint64_t user_addr;
+};
+
+struct us_uring_cqring_offsets {
+    uint32_t head, tail, ring_mask, ring_entries, overflow, cqes, flags, resv1;
+    uint64_t user_addr;
+};
+
+struct us_uring_params {
+    uint32_t sq_entries, cq_entries, flags, sq_thread_cpu, sq_thread_idle, features, wq_fd, resv[3];
+    struct us_uring_sqring_offsets sq_off;
+    struct us_uring_cqring_offsets cq_off;
+};
+
+struct us_uring_sqe {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t ioprio;
+    int32_t fd;
+    uint64_t off;
+    uint64_t addr;
+    uint32_t len;
+    uint32_t op_flags;
+    uint64_t user_data;
+    uint16_t buf_group;
+    uint16_t personality;
+    int32_t file_index;
+    uint64_t addr3;
+    uint64_t pad;
+};
+
+struct us_uring_cqe {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+};
+
+struct us_uring_buf {
+    uint64_t addr;
+    uint32_t len;
+    uint16_t bid;
+    /* The ring's tail lives in the first entry's resv. */
+    uint16_t resv;
+};
+
+struct us_uring_buf_reg {
+    uint64_t ring_addr;
+    uint32_t ring_entries;
+    uint16_t bgid;
+    uint16_t flags;
+    uint64_t resv[3];
+};
+
+struct us_uring_getevents_arg {
+    uint64_t sigmask;
+    uint32_t sigmask_sz;
+    uint32_t min_wait_usec;
+    uint64_t ts;
+};
+
+struct us_uring_probe {
+    uint8_t last_op;
+    uint8_t ops_len;
+    uint16_t resv;
+    uint32_t resv2[3];
+    struct {
+        uint8_t op;
+        uint8_t resv;
+        uint16_t flags;
+        uint32_t resv2;
+    } ops[64];
+};
+
+_Static_assert(sizeof(struct us_uring_params) == 120, "io_uring_params ABI");
+_Static_assert(sizeof(struct us_uring_sqe) == 64, "io_uring_sqe ABI");
+_Static_assert(sizeof(struct us_uring_cqe) == 16, "io_uring_cqe ABI");
+_Static_assert(sizeof(struct us_uring_buf) == 16, "io_uring_buf ABI");
+_Static_assert(sizeof(struct us_uring_buf_reg) == 40, "io_uring_buf_reg ABI");
+_Static_assert(sizeof(struct us_uring_getevents_arg) == 24, "io_uring_getevents_arg ABI");
+
+#define US_URING_OFF_SQ_RING 0ULL
+#define US_URING_OFF_SQES 0x10000000ULL
+#define US_URING_SETUP_CQSIZE (1u << 3)
+#define US_URING_SETUP_R_DISABLED (1u << 6)
+#define US_URING_SETUP_SUBMIT_ALL (1u << 7)
+#define US_URING_SETUP_SINGLE_ISSUER (1u << 12)
+#define US_URING_SETUP_DEFER_TASKRUN (1u << 13)
+#define US_URING_FEAT_SINGLE_MMAP (1u << 0)
+#define US_URING_FEAT_NODROP (1u << 1)
+#define US_URING_FEAT_EXT_ARG (1u << 8)
+#define US_URING_ENTER_GETEVENTS (1u << 0)
+#define US_URING_ENTER_EXT_ARG (1u << 3)
+#define US_URING_OP_POLL_ADD 6
+#define US_URING_OP_ACCEPT 13
+#define US_URING_OP_ASYNC_CANCEL 14
+#define US_URING_OP_RECV 27
+#define US_URING_OP_SUPPORTED (1u << 0)
+#define US_URING_SQE_BUFFER_SELECT (1u << 5)
+#define US_URING_SQE_CQE_SKIP_SUCCESS (1u << 6)
+#define US_URING_ACCEPT_MULTISHOT (1u << 0)
+#define US_URING_RECV_MULTISHOT (1u << 1)
+#define US_URING_CQE_F_BUFFER (1u << 0)
+#define US_URING_CQE_F_MORE (1u << 1)
+#define US_URING_CQE_BUFFER_SHIFT 16
+#define US_URING_REGISTER_PROBE 8
+#define US_URING_REGISTER_ENABLE_RINGS 12
+#define US_URING_REGISTER_PBUF_RING 22
+
+/* Submissions are a handful per loop iteration (re-arms and cancels); the
+ * completion queue is sized for a busy server's worth of multishot CQEs per
+ * wakeup. An overflowing CQ ends multishot requests, which are re-armed. */
+#define US_IO_URING_SQ_ENTRIES 256
+#define US_IO_URING_CQ_ENTRIES 4096
+
+/* Receive buffers handed to the kernel: a power of two of them, each with
+ * LIBUS_RECV_BUFFER_PADDING on both sides like loop->data.recv_buf, since
+ * uWS writes into the padding around the data it is given. A socket that
+ * finds the ring empty reads directly into recv_buf instead. */
+#define US_IO_URING_BUFFERS 256
+#define US_IO_URING_BUFFER_LENGTH (16 * 1024)
+#define US_IO_URING_BUFFER_STRIDE (LIBUS_RECV_BUFFER_PADDING + US_IO_URING_BUFFER_LENGTH + LIBUS_RECV_BUFFER_PADDING)
+#define US_IO_URING_BUFFER_GROUP 0
+
+/* user_data: the operation in the low two bits, the slot above them and the
+ * slot's generation in the high word. 0 is a cancel, whose completion is
+ * ignored. */
+#define US_IO_URING_OP_RECV 1
+#define US_IO_URING_OP_ACCEPT 2
+#define US_IO_URING_OP_EPOLL 3
+#define US_IO_URING_OP_MASK 3
+
+struct us_internal_io_uring_slot_t {
+    /* The poll this slot reads or accepts for; NULL once it was freed. */
+    struct us_poll_t *poll;
+    /* Buffer ids received and not yet read, oldest first, chained through
+     * ring->buf_next; -1 for none. */
+    int stash_head, stash_tail;
+    /* Accepted fds not yet taken by the accept loop, a FIFO. */
+    int *accepted;
+    unsigned int accepted_head, accepted_len, accepted_cap;
+    /* errno of a failed recv, reported once the stash is read. */
+    int error;
+    uint32_t generation;
+    uint32_t next_dirty, next_ready, next_free;
+    unsigned char op;
+    /* A multishot request is in the kernel, and whether it is being cancelled. */
+    unsigned char in_flight : 1;
+    unsigned char cancel_sent : 1;
+    /* us_poll_stop was called and no start since. */
+    unsigned char stopped : 1;
+    /* The ring saw the peer's FIN. */
+    unsigned char eof : 1;
+    /* On the dirty list: its request has to be armed or cancelled to match
+     * what the poll wants. */
+    unsigned char dirty : 1;
+    /* On the ready list: it has something for the read or accept loop. */
+    unsigned char queued : 1;
+    /* us_internal_io_uring_dispatch is inside its read or accept loop. */
+    unsigned char dispatching : 1;
+    /* The ring gave up on this poll; epoll polls it for READABLE again. */
+    unsigned char epoll_only : 1;
+};
+
+struct us_internal_io_uring_t {
+    int fd;
+    int enabled;
+
+    unsigned int *sq_khead, *sq_ktail;
+    unsigned int sq_mask, sq_entries, sq_tail;
+    struct us_uring_sqe *sqes;
+    unsigned int *cq_khead, *cq_ktail;
+    unsigned int cq_mask;
+    struct us_uring_cqe *cqes;
+    void *rings;
+    size_t rings_size, sqes_size;
+
+    /* The one-shot POLL_ADD on the epoll fd is in the kernel / completed. */
+    int epoll_armed, epoll_ready;
+
+    struct us_uring_buf *buf_ring;
+    uint16_t buf_tail;
+    char *buf_base;
+    uint32_t buf_len[US_IO_URING_BUFFERS];
+    int buf_next[US_IO_URING_BUFFERS];
+
+    /* Slot 0 is never used: p->ring_slot == 0 means the poll has none. */
+    struct us_internal_io_uring_slot_t *slots;
+    uint32_t slot_count, slot_cap, free_head;
+    uint32_t dirty_head, dirty_tail;
+    uint32_t ready_head, ready_tail, ready_count;
+};
+
+static int us_io_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags, void *arg, size_t arg_size) {
+    return (int) syscall(SYS_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size);
+}
+
+static int us_io_uring_register(int fd, unsigned int opcode, void *arg, unsigned int nr_args) {
+    return (int) syscall(SYS_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static inline char *us_io_uring_buffer(struct us_internal_io_uring_t *ring, unsigned int bid) {
+    return ring->buf_base + (size_t) bid * US_IO_URING_BUFFER_STRIDE + LIBUS_RECV_BUFFER_PADDING;
+}
+
+/* Hands buffer `bid` back to the kernel. */
+static void us_io_uring_recycle(struct us_internal_io_uring_t *ring, unsigned int bid) {
+    struct us_uring_buf *buf = &ring->buf_ring[ring->buf_tail & (US_IO_URING_BUFFERS - 1)];
+    buf->addr = (uint64_t) (uintptr_t) us_io_uring_buffer(ring, bid);
+    buf->len = US_IO_URING_BUFFER_LENGTH;
+    buf->bid = (uint16_t) bid;
+    ring->buf_tail++;
+    __atomic_store_n(&ring->buf_ring[0].resv, ring->buf_tail, __ATOMIC_RELEASE);
+}
+
+static unsigned int us_io_uring_to_submit(struct us_internal_io_uring_t *ring) {
+    return ring->sq_tail - __atomic_load_n(ring->sq_khead, __ATOMIC_ACQUIRE);
+}
+
+/* A zeroed SQE, or NULL if the queue is full even after submitting it. */
+static struct us_uring_sqe *us_io_uring_get_sqe(struct us_internal_io_uring_t *ring) {
+    if (us_io_uring_to_submit(ring) >= ring->sq_entries) {
+        __atomic_store_n(ring->sq_ktail, ring->sq_tail, __ATOMIC_RELEASE);
+        int ret;
+        do {
+            ret = us_io_uring_enter(ring->fd, us_io_uring_to_submit(ring), 0, 0, NULL, 0);
+        } while (IS_EINTR(ret));
+        if (us_io_uring_to_submit(ring) >= ring->sq_entries) {
+            return NULL;
+        }
+    }
+    struct us_uring_sqe *sqe = &ring->sqes[ring->sq_tail & ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_tail++;
+    return sqe;
+}
+
+static inline uint64_t us_io_uring_user_data(struct us_internal_io_uring_t *ring, uint32_t id, unsigned int op) {
+    return ((uint64_t) ring->slots[id].generation << 32) | ((uint64_t) id << 2) | op;
+}
+
+/* Slots */
+
+static uint32_t us_io_uring_alloc_slot(struct us_internal_io_uring_t *ring) {
+    uint32_t id = ring->free_head;
+    if (id) {
+        ring->free_head = ring->slots[id].next_free;
+    } else {
+        if (ring->slot_count == ring->slot_cap) {
+            uint32_t cap = ring->slot_cap * 2;
+            struct us_internal_io_uring_slot_t *slots = us_realloc(ring->slots, cap * sizeof(*slots));
+            if (!slots) Bun__outOfMemory();
+            ring->slots = slots;
+            ring->slot_cap = cap;
+        }
+        id = ring->slot_count++;
+        memset(&ring->slots[id], 0, sizeof(ring->slots[id]));
+    }
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    /* Keep the accept queue's allocation and the generation across reuse. */
+    int *accepted = slot->accepted;
+    unsigned int accepted_cap = slot->accepted_cap;
+    uint32_t generation = slot->generation;
+    memset(slot, 0, sizeof(*slot));
+    slot->accepted = accepted;
+    slot->accepted_cap = accepted_cap;
+    slot->generation = generation;
+    slot->stash_head = slot->stash_tail = -1;
+    return id;
+}
+
+static void us_io_uring_maybe_free_slot(struct us_internal_io_uring_t *ring, uint32_t id) {
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    if (slot->poll || slot->in_flight || slot->dirty || slot->queued || slot->dispatching) {
+        return;
+    }
+    /* Completions still carrying the old generation are recognized as stale. */
+    slot->generation++;
+    slot->next_free = ring->free_head;
+    ring->free_head = id;
+}
+
+static void us_io_uring_mark_dirty(struct us_internal_io_uring_t *ring, uint32_t id) {
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    if (slot->dirty) {
+        return;
+    }
+    slot->dirty = 1;
+    slot->next_dirty = 0;
+    if (ring->dirty_tail) {
+        ring->slots[ring->dirty_tail].next_dirty = id;
+    } else {
+        ring->dirty_head = id;
+    }
+    ring->dirty_tail = id;
+}
+
+static void us_io_uring_mark_ready(struct us_internal_io_uring_t *ring, uint32_t id) {
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    if (slot->queued) {
+        return;
+    }
+    slot->queued = 1;
+    slot->next_ready = 0;
+    if (ring->ready_tail) {
+        ring->slots[ring->ready_tail].next_ready = id;
+    } else {
+        ring->ready_head = id;
+    }
+    ring->ready_tail = id;
+    ring->ready_count++;
+}
+
+static inline int us_io_uring_slot_has_input(struct us_internal_io_uring_slot_t *slot) {
+    return slot->stash_head >= 0 || slot->accepted_len || slot->eof || slot->error;
+}
+
+/* Returns the slot's stashed buffers to the kernel and closes the fds it
+ * accepted that nobody took. */
+static void us_io_uring_drop_input(struct us_internal_io_uring_t *ring, struct us_internal_io_uring_slot_t *slot) {
+    for (int bid = slot->stash_head; bid >= 0; ) {
+        int next = ring->buf_next[bid];
+        us_io_uring_recycle(ring, (unsigned int) bid);
+        bid = next;
+    }
+    slot->stash_head = slot->stash_tail = -1;
+    for (unsigned int i = slot->accepted_head; i < slot->accepted_len; i++) {
+        bsd_close_socket(slot->accepted[i]);
+    }
+    slot->accepted_head = slot->accepted_len = 0;
+}
+
+static void us_io_uring_push_accepted(struct us_internal_io_uring_slot_t *slot, int fd) {
+    if (slot->accepted_len == slot->accepted_cap) {
+        if (slot->accepted_head) {
+            memmove(slot->accepted, slot->accepted + slot->accepted_head, (slot->accepted_len - slot->accepted_head) * sizeof(int));
+            slot->accepted_len -= slot->accepted_head;
+            slot->accepted_head = 0;
+        } else {
+            unsigned int cap = slot->accepted_cap ? slot->accepted_cap * 2 : 16;
+            int *accepted = us_realloc(slot->accepted, cap * sizeof(int));
+            if (!accepted) Bun__outOfMemory();
+            slot->accepted = accepted;
+            slot->accepted_cap = cap;
+        }
+    }
+    slot->accepted[slot->accepted_len++] = fd;
+}
+
+/* Puts p back on EPOLLIN, the registration it would have without the ring. */
+static void us_io_uring_epoll_readable(struct us_loop_t *loop, struct us_poll_t *p) {
+    struct epoll_event event;
+    event.events = us_poll_events(p);
+    if (!event.events) {
+        event.events = EPOLLHUP | EPOLLERR;
+    }
+    event.data.ptr = p;
+    int rc;
+    do {
+        rc = epoll_ctl(loop->fd, EPOLL_CTL_MOD, us_poll_fd(p), &event);
+    } while (IS_EINTR(rc));
+}
+
+static void us_io_uring_fall_back(struct us_loop_t *loop, struct us_internal_io_uring_t *ring, uint32_t id) {
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    slot->epoll_only = 1;
+    if (slot->poll && !slot->stopped) {
+        us_io_uring_epoll_readable(loop, slot->poll);
+        /* Whatever was stashed before still has to be read first. */
+        if (us_io_uring_slot_has_input(slot)) {
+            us_io_uring_mark_ready(ring, id);
+        }
+    }
+}
+
+/* Arms or cancels the slot's multishot request to match what its poll wants. */
+static void us_io_uring_reconcile(struct us_loop_t *loop, struct us_internal_io_uring_t *ring, uint32_t id) {
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    struct us_poll_t *p = slot->poll;
+    const int wants = p && !slot->stopped && !slot->epoll_only && (us_poll_events(p) & LIBUS_SOCKET_READABLE);
+
+    if (wants && slot->op == US_IO_URING_OP_RECV && ((struct us_socket_t *) p)->flags.is_ipc) {
+        /* IPC reads need recvmsg for SCM_RIGHTS. The flag is set after the
+         * poll starts, which is why this is decided here and not there. */
+        us_io_uring_fall_back(loop, ring, id);
+        return;
+    }
+
+    if (wants && !slot->in_flight && !slot->eof && !slot->error) {
+        struct us_uring_sqe *sqe = us_io_uring_get_sqe(ring);
+        if (!sqe) {
+            us_io_uring_fall_back(loop, ring, id);
+            return;
+        }
+        sqe->fd = us_poll_fd(p);
+        sqe->user_data = us_io_uring_user_data(ring, id, slot->op);
+        if (slot->op == US_IO_URING_OP_RECV) {
+            sqe->opcode = US_URING_OP_RECV;
+            sqe->ioprio = US_URING_RECV_MULTISHOT;
+            sqe->flags = US_URING_SQE_BUFFER_SELECT;
+            sqe->buf_group = US_IO_URING_BUFFER_GROUP;
+        } else {
+            sqe->opcode = US_URING_OP_ACCEPT;
+            sqe->ioprio = US_URING_ACCEPT_MULTISHOT;
+            sqe->op_flags = SOCK_CLOEXEC | SOCK_NONBLOCK;
+        }
+        slot->in_flight = 1;
+    } else if (!wants && slot->in_flight && !slot->cancel_sent) {
+        struct us_uring_sqe *sqe = us_io_uring_get_sqe(ring);
+        if (!sqe) {
+            /* Retried on the next flush. */
+            us_io_uring_mark_dirty(ring, id);
+            return;
+        }
+        sqe->opcode = US_URING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = us_io_uring_user_data(ring, id, slot->op);
+        sqe->flags = US_URING_SQE_CQE_SKIP_SUCCESS;
+        slot->cancel_sent = 1;
+    }
+
+    us_io_uring_maybe_free_slot(ring, id);
+}
+
+static void us_io_uring_flush(struct us_loop_t *loop, struct us_internal_io_uring_t *ring) {
+    /* Slots re-marked while reconciling (a cancel that found no SQE) wait for
+     * the next flush instead of spinning here. */
+    uint32_t id = ring->dirty_head;
+    ring->dirty_head = ring->dirty_tail = 0;
+    while (id) {
+        uint32_t next = ring->slots[id].next_dirty;
+        ring->slots[id].dirty = 0;
+        us_io_uring_reconcile(loop, ring, id);
+        id = next;
+    }
+}
+
+static void us_io_uring_complete(struct us_loop_t *loop, struct us_internal_io_uring_t *ring, struct us_uring_cqe *cqe) {
+    const unsigned int op = (unsigned int) (cqe->user_data & US_IO_URING_OP_MASK);
+    if (op == US_IO_URING_OP_EPOLL) {
+        ring->epoll_armed = 0;
+        ring->epoll_ready = 1;
+        return;
+    }
+    if (!op) {
+        return;
+    }
+
+    const uint32_t id = (uint32_t) cqe->user_data >> 2;
+    const int res = cqe->res;
+    const int bid = (cqe->flags & US_URING_CQE_F_BUFFER) ? (int) (cqe->flags >> US_URING_CQE_BUFFER_SHIFT) : -1;
+    struct us_internal_io_uring_slot_t *slot = id < ring->slot_count ? &ring->slots[id] : NULL;
+    if (!slot || slot->generation != (uint32_t) (cqe->user_data >> 32)) {
+        if (bid >= 0) us_io_uring_recycle(ring, (unsigned int) bid);
+        if (op == US_IO_URING_OP_ACCEPT && res >= 0) bsd_close_socket(res);
+        return;
+    }
+
+    const int more = cqe->flags & US_URING_CQE_F_MORE;
+    if (!more) {
+        slot->in_flight = 0;
+        slot->cancel_sent = 0;
+    }
+
+    struct us_poll_t *p = slot->poll;
+    if (op == US_IO_URING_OP_RECV) {
+        if (res > 0 && bid >= 0 && p) {
+            ring->buf_len[bid] = (uint32_t) res;
+            ring->buf_next[bid] = -1;
+            if (slot->stash_tail >= 0) {
+                ring->buf_next[slot->stash_tail] = bid;
+            } else {
+                slot->stash_head = bid;
+            }
+            slot->stash_tail = bid;
+            us_io_uring_mark_ready(ring, id);
+        } else {
+            if (bid >= 0) us_io_uring_recycle(ring, (unsigned int) bid);
+            if (!p || res == -ECANCELED) {
+                /* Cancelled by a pause or a stop; the stash stays. */
+            } else if (res == 0) {
+                slot->eof = 1;
+                us_io_uring_mark_ready(ring, id);
+            } else if (res == -ENOBUFS) {
+                /* Every buffer is in use: the read loop recv()s into recv_buf
+                 * and the request is re-armed below. */
+                us_io_uring_mark_ready(ring, id);
+            } else if (res == -EINVAL || res == -EOPNOTSUPP || res == -ENOTSOCK) {
+                us_io_uring_fall_back(loop, ring, id);
+            } else if (res < 0) {
+                slot->error = -res;
+                us_io_uring_mark_ready(ring, id);
+            }
+        }
+    } else {
+        if (res >= 0) {
+            if (p) {
+                us_io_uring_push_accepted(slot, res);
+                us_io_uring_mark_ready(ring, id);
+            } else {
+                bsd_close_socket(res);
+            }
+        } else if (p && (res == -EINVAL || res == -EOPNOTSUPP || res == -ENOTSOCK)) {
+            us_io_uring_fall_back(loop, ring, id);
+        }
+        /* Other errors (EMFILE, ECONNABORTED) end the multishot accept; it is
+         * re-armed below, as epoll would report the listen socket again. */
+    }
+
+    if (!more) {
+        if (p) {
+            us_io_uring_mark_dirty(ring, id);
+        } else {
+            us_io_uring_maybe_free_slot(ring, id);
+        }
+    }
+}
+
+static void us_io_uring_reap(struct us_loop_t *loop, struct us_internal_io_uring_t *ring) {
+    unsigned int head = *ring->cq_khead;
+    const unsigned int tail = __atomic_load_n(ring->cq_ktail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        us_io_uring_complete(loop, ring, &ring->cqes[head & ring->cq_mask]);
+    }
+    __atomic_store_n(ring->cq_khead, head, __ATOMIC_RELEASE);
+}
+
+/* Loop */
+
+void us_internal_io_uring_init(struct us_loop_t *loop) {
+    if (!Bun__isIoUringEventLoopEnabled()) {
+        return;
+    }
+
+    /* R_DISABLED: SINGLE_ISSUER binds the ring to the thread that enables it,
+     * and a loop may be created on another thread than the one running it.
+     * us_internal_io_uring_wait enables it on the first wait. */
+    struct us_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = US_URING_SETUP_R_DISABLED | US_URING_SETUP_SINGLE_ISSUER | US_URING_SETUP_DEFER_TASKRUN |
+                   US_URING_SETUP_SUBMIT_ALL | US_URING_SETUP_CQSIZE;
+    params.cq_entries = US_IO_URING_CQ_ENTRIES;
+    int fd = (int) syscall(SYS_io_uring_setup, US_IO_URING_SQ_ENTRIES, &params);
+    if (fd < 0) {
+        /* Too old a kernel, seccomp, or kernel.io_uring_disabled. */
+        return;
+    }
+
+    const unsigned int needed = US_URING_FEAT_SINGLE_MMAP | US_URING_FEAT_NODROP | US_URING_FEAT_EXT_ARG;
+    struct us_uring_probe probe;
+    memset(&probe, 0, sizeof(probe));
+    if ((params.features & needed) != needed ||
+        us_io_uring_register(fd, US_URING_REGISTER_PROBE, &probe, 64) != 0) {
+        close(fd);
+        return;
+    }
+    static const uint8_t ops[] = {US_URING_OP_POLL_ADD, US_URING_OP_ACCEPT, US_URING_OP_ASYNC_CANCEL, US_URING_OP_RECV};
+    for (size_t i = 0; i < sizeof(ops); i++) {
+        if (ops[i] > probe.last_op || !(probe.ops[ops[i]].flags & US_URING_OP_SUPPORTED)) {
+            close(fd);
+            return;
+        }
+    }
+
+    struct us_internal_io_uring_t *ring = us_calloc(1, sizeof(*ring));
+    if (!ring) Bun__outOfMemory();
+    ring->fd = fd;
+    ring->rings = MAP_FAILED;
+    ring->sqes = MAP_FAILED;
+    ring->buf_ring = MAP_FAILED;
+    ring->buf_base = MAP_FAILED;
+
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct us_uring_cqe);
+    ring->rings_size = sq_size > cq_size ? sq_size : cq_size;
+    ring->rings = mmap(NULL, ring->rings_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, US_URING_OFF_SQ_RING);
+    ring->sqes_size = params.sq_entries * sizeof(struct us_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, US_URING_OFF_SQES);
+    ring->buf_ring = mmap(NULL, US_IO_URING_BUFFERS * sizeof(struct us_uring_buf), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ring->buf_base = mmap(NULL, (size_t) US_IO_URING_BUFFERS * US_IO_URING_BUFFER_STRIDE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ring->slot_cap = 64;
+    ring->slot_count = 1;
+    ring->slots = us_calloc(ring->slot_cap, sizeof(*ring->slots));
+    if (ring->rings == MAP_FAILED || ring->sqes == MAP_FAILED || ring->buf_ring == MAP_FAILED ||
+        ring->buf_base == MAP_FAILED || !ring->slots) {
+        loop->data.io_uring = ring;
+        us_internal_io_uring_free(loop);
+        return;
+    }
+
+    char *base = ring->rings;
+    ring->sq_khead = (unsigned int *) (base + params.sq_off.head);
+    ring->sq_ktail = (unsigned int *) (base + params.sq_off.tail);
+    ring->sq_mask = *(unsigned int *) (base + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->sq_tail = *ring->sq_ktail;
+    /* SQE i always sits at index i of the indirection array. */
+    unsigned int *sq_array = (unsigned int *) (base + params.sq_off.array);
+    for (unsigned int i = 0; i < params.sq_entries; i++) {
+        sq_array[i] = i;
+    }
+    ring->cq_khead = (unsigned int *) (base + params.cq_off.head);
+    ring->cq_ktail = (unsigned int *) (base + params.cq_off.tail);
+    ring->cq_mask = *(unsigned int *) (base + params.cq_off.ring_mask);
+    ring->cqes = (struct us_uring_cqe *) (base + params.cq_off.cqes);
+
+    struct us_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t) (uintptr_t) ring->buf_ring;
+    reg.ring_entries = US_IO_URING_BUFFERS;
+    reg.bgid = US_IO_URING_BUFFER_GROUP;
+    if (us_io_uring_register(fd, US_URING_REGISTER_PBUF_RING, &reg, 1) != 0) {
+        loop->data.io_uring = ring;
+        us_internal_io_uring_free(loop);
+        return;
+    }
+    for (unsigned int bid = 0; bid < US_IO_URING_BUFFERS; bid++) {
+        us_io_uring_recycle(ring, bid);
+    }
+
+    loop->data.io_uring = ring;
+}
+
+void us_internal_io_uring_free(struct us_loop_t *loop) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring) {
+        return;
+    }
+    loop->data.io_uring = NULL;
+
+    /* Closing the ring cancels its requests and drops their file references. */
+    close(ring->fd);
+    if (ring->slots) {
+        for (uint32_t id = 1; id < ring->slot_count; id++) {
+            struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+            for (unsigned int i = slot->accepted_head; i < slot->accepted_len; i++) {
+                bsd_close_socket(slot->accepted[i]);
+            }
+            us_free(slot->accepted);
+            if (slot->poll) {
+                slot->poll->ring_slot = 0;
+            }
+        }
+        us_free(ring->slots);
+    }
+    if (ring->rings != MAP_FAILED) munmap(ring->rings, ring->rings_size);
+    if (ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+    if (ring->buf_ring != MAP_FAILED) munmap(ring->buf_ring, US_IO_URING_BUFFERS * sizeof(struct us_uring_buf));
+    if (ring->buf_base != MAP_FAILED) munmap(ring->buf_base, (size_t) US_IO_URING_BUFFERS * US_IO_URING_BUFFER_STRIDE);
+    us_free(ring);
+}
+
+int us_internal_io_uring_has_ready(struct us_loop_t *loop) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    return ring && ring->ready_head;
+}
+
+int us_internal_io_uring_wait(struct us_loop_t *loop, const struct timespec *timeout) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+
+    if (UNLIKELY(!ring->enabled)) {
+        if (us_io_uring_register(ring->fd, US_URING_REGISTER_ENABLE_RINGS, NULL, 0) != 0) {
+            /* Nothing was submitted yet, so nothing was received: hand every
+             * poll that gave EPOLLIN up back to epoll and drop the ring. */
+            for (uint32_t id = 1; id < ring->slot_count; id++) {
+                struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+                if (slot->poll && !slot->stopped) {
+                    us_io_uring_epoll_readable(loop, slot->poll);
+                }
+            }
+            us_internal_io_uring_free(loop);
+            return -1;
+        }
+        ring->enabled = 1;
+    }
+
+    us_io_uring_flush(loop, ring);
+    if (!ring->epoll_armed) {
+        struct us_uring_sqe *sqe = us_io_uring_get_sqe(ring);
+        if (sqe) {
+            sqe->opcode = US_URING_OP_POLL_ADD;
+            sqe->fd = loop->fd;
+            sqe->op_flags = POLLIN;
+            sqe->user_data = US_IO_URING_OP_EPOLL;
+            ring->epoll_armed = 1;
+        }
+    }
+
+    /* Without the POLL_ADD in the kernel nothing would wake us for epoll, and
+     * reaped-but-unread input must not wait behind a sleep. */
+    static const struct timespec zero = {0, 0};
+    const int epoll_unwatched = !ring->epoll_armed;
+    if (ring->ready_head || epoll_unwatched) {
+        timeout = &zero;
+    }
+    const int will_block = !timeout || timeout->tv_sec || timeout->tv_nsec;
+
+    /* Same signal handling as bun_epoll_pwait2: an empty mask for the wait,
+     * and EINTR retried against an absolute deadline. */
+    sigset_t mask;
+    sigemptyset(&mask);
+    struct timespec remaining_ts;
+    struct us_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask = (uint64_t) (uintptr_t) &mask;
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts = (uint64_t) (uintptr_t) timeout;
+    uint64_t deadline_ns = 0;
+    if (timeout && will_block) {
+        deadline_ns = us_internal_monotonic_ns() + (uint64_t) timeout->tv_sec * 1000000000ULL + (uint64_t) timeout->tv_nsec;
+    }
+
+    ring->epoll_ready = 0;
+    __atomic_store_n(ring->sq_ktail, ring->sq_tail, __ATOMIC_RELEASE);
+    for (;;) {
+        int ret = us_io_uring_enter(ring->fd, us_io_uring_to_submit(ring), will_block ? 1 : 0,
+                                    US_URING_ENTER_GETEVENTS | US_URING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        if (LIKELY(!IS_EINTR(ret))) {
+            /* ETIME is the timeout; EBUSY/EAGAIN mean completions are waiting
+             * in the overflow list, which the reap below makes room for. */
+            break;
+        }
+        if (!deadline_ns) {
+            continue;
+        }
+        uint64_t now = us_internal_monotonic_ns();
+        if (now >= deadline_ns) {
+            break;
+        }
+        uint64_t left = deadline_ns - now;
+        remaining_ts.tv_sec = (time_t) (left / 1000000000ULL);
+        remaining_ts.tv_nsec = (long) (left % 1000000000ULL);
+        arg.ts = (uint64_t) (uintptr_t) &remaining_ts;
+    }
+
+    us_io_uring_reap(loop, ring);
+    return ring->epoll_ready || epoll_unwatched;
+}
+
+void us_internal_io_uring_dispatch(struct us_loop_t *loop) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring) {
+        return;
+    }
+
+    /* One pass over what is ready now. A socket with more stashed behind the
+     * chunk it read goes to the back, after every other ready socket had its
+     * turn, like the read loop's own cap on repeated reads. */
+    for (uint32_t budget = ring->ready_count; budget && ring->ready_head; budget--) {
+        uint32_t id = ring->ready_head;
+        struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+        ring->ready_head = slot->next_ready;
+        if (!ring->ready_head) {
+            ring->ready_tail = 0;
+        }
+        ring->ready_count--;
+
+        struct us_poll_t *p = slot->poll;
+        slot->queued = 0;
+        if (!p || slot->stopped || !(us_poll_events(p) & LIBUS_SOCKET_READABLE)) {
+            /* Paused or parked: us_internal_io_uring_poll_events queues it
+             * again when reads are back on. */
+            us_io_uring_maybe_free_slot(ring, id);
+            continue;
+        }
+
+        slot->dispatching = 1;
+        us_internal_dispatch_ready_poll(p, 0, 0, LIBUS_SOCKET_READABLE);
+
+        /* The handler may have grown the table. */
+        slot = &ring->slots[id];
+        slot->dispatching = 0;
+        if (slot->poll && !slot->stopped && (slot->stash_head >= 0 || slot->accepted_len) &&
+            (us_poll_events(slot->poll) & LIBUS_SOCKET_READABLE)) {
+            us_io_uring_mark_ready(ring, id);
+        } else {
+            us_io_uring_maybe_free_slot(ring, id);
+        }
+    }
+}
+
+/* Poll */
+
+static int us_io_uring_op_for(struct us_poll_t *p, int events) {
+    switch (us_internal_poll_type(p)) {
+    case POLL_TYPE_SOCKET:
+    case POLL_TYPE_SOCKET_SHUT_DOWN:
+        return US_IO_URING_OP_RECV;
+    case POLL_TYPE_SEMI_SOCKET: {
+        /* Connecting sockets are semi-sockets too; they poll WRITABLE. */
+        if (events & LIBUS_SOCKET_WRITABLE) {
+            return 0;
+        }
+        int listening = 0;
+        socklen_t len = sizeof(listening);
+        if (getsockopt(us_poll_fd(p), SOL_SOCKET, SO_ACCEPTCONN, &listening, &len) || !listening) {
+            return 0;
+        }
+        return US_IO_URING_OP_ACCEPT;
+    }
+    default:
+        return 0;
+    }
+}
+
+int us_internal_io_uring_poll_events(struct us_loop_t *loop, struct us_poll_t *p, int events) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring) {
+        return events;
+    }
+
+    uint32_t id = p->ring_slot;
+    if (!id) {
+        if (!(events & LIBUS_SOCKET_READABLE)) {
+            return events;
+        }
+        int op = us_io_uring_op_for(p, events);
+        if (!op) {
+            return events;
+        }
+        id = us_io_uring_alloc_slot(ring);
+        ring->slots[id].poll = p;
+        ring->slots[id].op = (unsigned char) op;
+        p->ring_slot = id;
+    }
+
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    slot->stopped = 0;
+    if (slot->epoll_only) {
+        return events;
+    }
+    /* The request is armed or cancelled on the next wait, when the socket's
+     * flags (is_ipc) are final. */
+    us_io_uring_mark_dirty(ring, id);
+    if ((events & LIBUS_SOCKET_READABLE) && us_io_uring_slot_has_input(slot)) {
+        us_io_uring_mark_ready(ring, id);
+    }
+    return events & ~LIBUS_SOCKET_READABLE;
+}
+
+void us_internal_io_uring_poll_stop(struct us_loop_t *loop, struct us_poll_t *p) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring || !p->ring_slot) {
+        return;
+    }
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[p->ring_slot];
+    slot->stopped = 1;
+    if (slot->in_flight) {
+        us_io_uring_mark_dirty(ring, p->ring_slot);
+    }
+}
+
+void us_internal_io_uring_poll_move(struct us_loop_t *loop, struct us_poll_t *old_p, struct us_poll_t *new_p) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    uint32_t id = old_p->ring_slot;
+    old_p->ring_slot = 0;
+    if (!ring || !id) {
+        return;
+    }
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[id];
+    if (new_p) {
+        slot->poll = new_p;
+        new_p->ring_slot = id;
+        return;
+    }
+    slot->poll = NULL;
+    us_io_uring_drop_input(ring, slot);
+    slot->eof = 0;
+    slot->error = 0;
+    if (slot->in_flight) {
+        us_io_uring_mark_dirty(ring, id);
+    } else {
+        us_io_uring_maybe_free_slot(ring, id);
+    }
+}
+
+/* Socket */
+
+int us_internal_io_uring_recv(struct us_loop_t *loop, struct us_poll_t *p, char **data) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring || !p->ring_slot) {
+        return US_IO_URING_NOT_RECEIVED;
+    }
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[p->ring_slot];
+    int bid = slot->stash_head;
+    if (bid >= 0) {
+        slot->stash_head = ring->buf_next[bid];
+        if (slot->stash_head < 0) {
+            slot->stash_tail = -1;
+        }
+        *data = us_io_uring_buffer(ring, (unsigned int) bid);
+        return (int) ring->buf_len[bid];
+    }
+    if (slot->eof) {
+        return 0;
+    }
+    if (slot->error) {
+        errno = slot->error;
+        return LIBUS_SOCKET_ERROR;
+    }
+    return US_IO_URING_NOT_RECEIVED;
+}
+
+void us_internal_io_uring_release(struct us_loop_t *loop, char *data) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring) {
+        return;
+    }
+    uintptr_t offset = (uintptr_t) data - (uintptr_t) ring->buf_base;
+    if (offset < (uintptr_t) US_IO_URING_BUFFERS * US_IO_URING_BUFFER_STRIDE) {
+        us_io_uring_recycle(ring, (unsigned int) (offset / US_IO_URING_BUFFER_STRIDE));
+    }
+}
+
+LIBUS_SOCKET_DESCRIPTOR us_internal_io_uring_accept(struct us_loop_t *loop, struct us_poll_t *p, struct bsd_addr_t *addr) {
+    struct us_internal_io_uring_t *ring = loop->data.io_uring;
+    if (!ring || !p->ring_slot) {
+        return bsd_accept_socket(us_poll_fd(p), addr);
+    }
+    struct us_internal_io_uring_slot_t *slot = &ring->slots[p->ring_slot];
+    if (slot->accepted_head == slot->accepted_len) {
+        /* The multishot accept brings the rest on the next wait. */
+        return slot->epoll_only ? bsd_accept_socket(us_poll_fd(p), addr) : LIBUS_SOCKET_ERROR;
+    }
+    LIBUS_SOCKET_DESCRIPTOR fd = slot->accepted[slot->accepted_head++];
+    if (slot->accepted_head == slot->accepted_len) {
+        slot->accepted_head = slot->accepted_len = 0;
+    }
+    /* A multishot accept has nowhere to put each peer's address. */
+    if (bsd_remote_addr(fd, addr)) {
+        memset(&addr->mem, 0, sizeof(addr->mem));
+        addr->len = 0;
+        internal_finalize_bsd_addr(addr);
+    }
+    return fd;
+}
+
+#endif
@@ -111,6 +111,11 @@ struct us_poll_t {
         signed int fd : 27; // we could have this unsigned if we wanted to, -1 should never be used
         unsigned int poll_type : 5;
     } state;
+#ifdef LIBUS_USE_IO_URING
+    /* Index into the loop's io_uring slot table, 0 for none. Sits in the
+     * padding alignas leaves after state. */
+    unsigned int ring_slot;
+#endif
 };
 
 #undef FD_BITS
@@ -54,6 +54,12 @@ void us_internal_loop_update_pending_ready_polls(struct us_loop_t *loop,
 /* We only have one networking implementation so far */
 #include "internal/networking/bsd.h"
 
+/* On Linux an io_uring can take over accepting and reading for TCP sockets,
+ * layered over the epoll loop (eventing/io_uring.c). Opt-in at runtime. */
+#if defined(LIBUS_USE_EPOLL) && defined(__linux__) && !defined(__ANDROID__)
+#define LIBUS_USE_IO_URING
+#endif
+
 /* We have many different eventing implementations */
 #if defined(LIBUS_USE_EPOLL) || defined(LIBUS_USE_KQUEUE)
 #include "internal/eventing/epoll_kqueue.h"
@@ -159,6 +165,7 @@ extern struct addrinfo_result *Bun__addrinfo_getRequestResult(struct addrinfo_re
 #define LIBUS_POLL_EOF 1
 #define LIBUS_POLL_HANGUP 2
 void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, int events);
+/* Expires every socket timeout that is due on the loop's timeout wheel. */
 void us_internal_timer_sweep(us_loop_r loop);
 void us_internal_enable_sweep_timer(struct us_loop_t *loop);
 void us_internal_disable_sweep_timer(struct us_loop_t *loop);
@@ -170,6 +177,63 @@ long long us_internal_sweep_timeout_ns(struct us_loop_t *loop);
 void us_internal_sweep_if_due(struct us_loop_t *loop);
 #endif
 void us_internal_free_closed_sockets(us_loop_r loop);
+
+/* Socket timeouts (timeout_wheel.c). A hierarchical timing wheel per loop,
+ * ticking once per second: a socket with a short and/or long timeout armed
+ * sits in the bucket of whichever deadline comes first, so a sweep only ever
+ * touches the sockets that are expiring (plus, once per bucket span, the ones
+ * cascading down from a coarser level) instead of every socket on the loop. */
+struct us_internal_timeout_link_t {
+    struct us_internal_timeout_link_t *prev, *next;
+};
+struct us_internal_timeout_wheel_t;
+/* Absolute wheel tick `seconds` from now; 0 (= unset) for 0. Never fires
+ * early: the deadline is padded by the partial tick already elapsed. */
+uint32_t us_internal_timeout_deadline(us_loop_r loop, unsigned long long seconds);
+/* Re-buckets s after its timeout_tick/long_timeout_tick changed: unlinks it
+ * and, if either deadline is still set, links it at the earlier one. */
+void us_internal_socket_timeout_update(us_socket_r s);
+/* Drops s from the wheel without touching its deadlines. The wheel holds
+ * exactly the sockets in a group's list: us_internal_socket_group_unlink_socket
+ * calls this and us_internal_socket_group_link_socket files s again. */
+void us_internal_socket_timeout_unlink(us_socket_r s);
+void us_internal_timeout_wheel_free(us_loop_r loop);
+#ifdef LIBUS_USE_IO_URING
+/* io_uring layered over epoll (eventing/io_uring.c). A poll the ring reads or
+ * accepts for has a slot in the loop's table and is registered in epoll
+ * without EPOLLIN; what the ring receives for it waits on the slot until the
+ * read or accept loop in loop.c takes it. */
+struct us_internal_io_uring_t;
+/* us_internal_io_uring_recv: nothing from the ring, recv() directly. */
+#define US_IO_URING_NOT_RECEIVED (-2)
+/* Sets the loop's ring up when BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING asks for
+ * one and the kernel has what it needs; the loop stays plain epoll otherwise. */
+void us_internal_io_uring_init(us_loop_r loop);
+void us_internal_io_uring_free(us_loop_r loop);
+/* Submits, sleeps until a completion or the timeout and reaps. Returns
+ * whether epoll has events to harvest, or -1 if the ring was dropped and the
+ * caller has to wait on epoll itself. */
+int us_internal_io_uring_wait(us_loop_r loop, const struct timespec *timeout);
+/* Runs the read and accept loops of the polls the ring received for. */
+void us_internal_io_uring_dispatch(us_loop_r loop);
+/* Received input is waiting for a dispatch: the next wait must not block. */
+int us_internal_io_uring_has_ready(us_loop_r loop);
+/* The epoll mask for p about to poll `events`; READABLE is left out when the
+ * ring reads or accepts for p. */
+int us_internal_io_uring_poll_events(us_loop_r loop, us_poll_r p, int events);
+void us_internal_io_uring_poll_stop(us_loop_r loop, us_poll_r p);
+/* p was reallocated as new_p, or is being freed (new_p NULL). */
+void us_internal_io_uring_poll_move(us_loop_r loop, us_poll_r old_p, struct us_poll_t *new_p);
+/* The next chunk the ring received for p (*data points into a ring buffer
+ * until us_internal_io_uring_release), 0 for its EOF, LIBUS_SOCKET_ERROR with
+ * errno for its error, or US_IO_URING_NOT_RECEIVED. */
+int us_internal_io_uring_recv(us_loop_r loop, us_poll_r p, char **data);
+/* Hands a buffer us_internal_io_uring_recv returned back to the kernel; a
+ * no-op for any other pointer. */
+void us_internal_io_uring_release(us_loop_r loop, char *data);
+/* The next fd the ring accepted for listen poll p, or bsd_accept_socket. */
+LIBUS_SOCKET_DESCRIPTOR us_internal_io_uring_accept(us_loop_r loop, us_poll_r p, struct bsd_addr_t *addr);
+#endif
 void us_internal_loop_link_group(struct us_loop_t *loop, struct us_socket_group_t *group);
 void us_internal_loop_unlink_group(struct us_loop_t *loop, struct us_socket_group_t *group);
 /* Unlink the group from the loop iff every list/count is now zero. */
@@ -212,6 +276,18 @@ void us_internal_poll_set_type(struct us_poll_t *p, int poll_type);
 /* SSL loop data */
 void us_internal_init_loop_ssl_data(us_loop_r loop);
 void us_internal_free_loop_ssl_data(us_loop_r loop);
+/* Resumes handshakes whose signature a crypto worker finished. */
+int us_internal_ssl_drain_key_jobs(us_loop_r loop);
+
+/* Process-wide client connection counters (us_client_connection_stats). */
+enum us_internal_client_stat {
+  US_CLIENT_FAST_OPEN,
+  US_CLIENT_EARLY_DATA,
+  US_CLIENT_EARLY_DATA_ACCEPTED,
+  US_CLIENT_EARLY_DATA_REJECTED,
+  US_CLIENT_STAT_COUNT
+};
+void us_internal_count_client(enum us_internal_client_stat stat);
 
 /* Socket context related */
 void us_internal_socket_group_link_socket(us_socket_group_r group, us_socket_r s);
@@ -246,8 +322,17 @@ void us_internal_ssl_shutdown(us_socket_r s);
 int us_internal_ssl_write(us_socket_r s, const char *data, int length);
 unsigned int us_internal_ssl_spill_pending(us_socket_r s);
 void *us_internal_ssl_get_native_handle(us_socket_r s);
+int us_internal_ssl_enable_ktls_tx(us_socket_r s);
 struct us_bun_verify_error_t us_internal_ssl_verify_error(us_socket_r s);
 const char *us_internal_ssl_sni_servername(us_socket_r s);
+/* SNI index (crypto/sni_tree.cpp) of listen sockets and QUIC contexts.
+ * sni_add returns nonzero for a duplicate pattern; sni_find resolves a
+ * hostname, or a pattern to itself. */
+void *sni_new(void);
+void sni_free(void *sni, void (*cb)(void *));
+int sni_add(void *sni, const char *hostname, void *user);
+void *sni_remove(void *sni, const char *hostname);
+void *sni_find(void *sni, const char *hostname);
 /* SSL_CTX_free(ls->ssl_ctx) + sni_free(ls->sni). Called from us_listen_socket_close. */
 void us_internal_listen_socket_ssl_free(struct us_listen_socket_t *ls);
 /* Opaque SSL_CTX_up_ref/SSL_CTX_free so context.c needn't include OpenSSL. */
@@ -280,14 +365,12 @@ struct us_socket_flags {
 
 struct us_socket_t {
   alignas(LIBUS_EXT_ALIGNMENT) struct us_poll_t p;
-  unsigned char timeout;
-  unsigned char long_timeout;
   struct us_socket_flags flags;
   /* enum SocketKind. Selects the static dispatch arm in us_dispatch_*. */
   unsigned char kind;
-  /* SSL state. These 6 bits live in the pad-to-pointer gap before `group`, so
-   * they cost nothing on epoll/kqueue (poll=4 + 4×u8 + 1 byte bits = 9, padded
-   * to 16 anyway for the pointer). Per-socket reneg counters and SNI userdata
+  /* SSL state. These bits live in the pad-to-pointer gap before `group`, so
+   * they cost nothing on epoll/kqueue (poll=4 + 2×u8 + 2 bytes of bits + 2×u8
+   * = 10, padded to 16 anyway for the pointer). Per-socket reneg counters and SNI userdata
    * hang off SSL ex_data, allocated on first use only. */
   unsigned char ssl_handshake_state : 2;
   unsigned char ssl_write_wants_read : 1;
@@ -316,8 +399,19 @@ struct us_socket_t {
    * the driver's epilogue via ssl_pending_detach. */
   unsigned char ssl_in_use : 1;
   unsigned char ssl_pending_detach : 1;
+  /* The kernel seals this socket's outgoing records (kTLS, see
+   * us_socket_ssl_enable_ktls_tx): writes are plaintext straight to the fd
+   * and BoringSSL must never write to the wire again. */
+  unsigned char ssl_ktls_tx : 1;
   /* Peer FIN was dispatched as on_end on a half-open socket; readable interest is never re-added and on_end never re-fires. */
   unsigned char read_eof : 1;
+  /* MSG_ZEROCOPY sends (us_socket_write_zerocopy): 0 = SO_ZEROCOPY not set
+   * yet, 1 = set, 2 = unavailable or not worth it on this socket. */
+  unsigned char zerocopy_state : 2;
+  /* Connected with LIBUS_SOCKET_FAST_OPEN: the first read checks whether the
+   * SYN carried data and counts it. Spills into a third bits byte, which the
+   * pointer alignment of `group` already pads. */
+  unsigned char fast_open_pending : 1;
   /* The close code passed to the deferred close (e.g. a reset requested from
    * inside a handshake callback must still RST, not FIN, when it is finally
    * performed). */
@@ -335,8 +429,35 @@ struct us_socket_t {
   struct us_socket_t *prev, *next;
   struct us_socket_t *connect_next;
   struct us_connecting_socket_t *connect_state;
+  /* Timeout wheel bucket membership; prev == NULL while not in the wheel. */
+  struct us_internal_timeout_link_t timeout_link;
+  /* Absolute wheel ticks (us_internal_timeout_deadline), 0 = not armed. */
+  uint32_t timeout_tick;
+  uint32_t long_timeout_tick;
+  /* MSG_ZEROCOPY completion tracking. The kernel numbers each zerocopy send
+   * from 0; every id below zerocopy_done has completed, and zerocopy_ooo
+   * counts completions that arrived ahead of that prefix. */
+  uint32_t zerocopy_next;
+  uint32_t zerocopy_done;
+  uint32_t zerocopy_ooo;
 };
 
+static inline void us_internal_socket_timeout_init(struct us_socket_t *s) {
+    s->timeout_link.prev = s->timeout_link.next = NULL;
+    s->timeout_tick = 0;
+    s->long_timeout_tick = 0;
+}
+
+static inline void us_internal_socket_zerocopy_init(struct us_socket_t *s) {
+    s->zerocopy_state = 0;
+    s->zerocopy_next = s->zerocopy_done = s->zerocopy_ooo = 0;
+}
+
+/* Drains MSG_ZEROCOPY completions from the socket's error queue. Returns 1
+ * when it found only completions (the error event was not a socket error),
+ * 0 otherwise. Linux only; elsewhere nothing is ever pending. */
+int us_internal_socket_reap_zerocopy(struct us_socket_t *s);
+
 #if defined(LIBUS_USE_EPOLL) || defined(LIBUS_USE_KQUEUE)
 _Static_assert(sizeof(struct us_socket_flags) == 1, "us_socket_flags grew");
 #endif
@@ -375,9 +496,11 @@ struct us_connecting_socket_t {
      * different namespaces that overlap numerically, so consumers of `error`
      * must check this bit first. */
     unsigned int closed : 1, shutdown : 1, shutdown_read : 1, pending_resolve_callback : 1, error_is_dns : 1;
-    unsigned char timeout;
-    unsigned char long_timeout;
     unsigned char kind;
+    /* Absolute wheel ticks handed to every socket start_connections opens, so
+     * time spent resolving counts against the timeout. 0 = not armed. */
+    uint32_t timeout_tick;
+    uint32_t long_timeout_tick;
     uint16_t port;
     int error;
     struct addrinfo *addrinfo_head;
@@ -471,6 +594,10 @@ struct us_listen_socket_t {
   unsigned char accept_kind;
   /* Set when TCP_DEFER_ACCEPT/SO_ACCEPTFILTER was successfully applied. */
   unsigned char deferred_accept;
+  /* Listening with LIBUS_SOCKET_FAST_OPEN, and the accepted connections whose
+   * SYN carried data. */
+  unsigned char fast_open;
+  unsigned long long fast_open_accepted;
 };
 
 void us_internal_socket_group_link_connecting_socket(us_socket_group_r group, struct us_connecting_socket_t *c);
@@ -35,16 +35,26 @@ typedef void* zig_mutex_t;
 // IMPORTANT: When changing this, don't forget to update the Rust mirror in src/uws_sys/InternalLoopData.rs as well!
 struct us_quic_socket_context_s;
 struct us_nq_driver_s;
+struct us_internal_timeout_wheel_t;
+struct us_internal_io_uring_t;
 
 struct us_internal_loop_data_t {
 #ifdef LIBUS_USE_LIBUV
     struct us_timer_t *sweep_timer;
 #else
-    /* Absolute monotonic ns of the next sweep, or -1. Folded into the poll
-     * timeout — no timerfd, no EVFILT_TIMER. */
+    /* Absolute monotonic ns of the next tick the timeout wheel has work on,
+     * or -1 while it is empty. Folded into the poll timeout — no timerfd, no
+     * EVFILT_TIMER. */
     long long sweep_next_tick_ns;
 #endif
+    /* Live sockets on the loop; the Date header timer runs while nonzero. */
     int sweep_timer_count;
+    /* Socket timeouts, allocated on the first armed timeout (timeout_wheel.c). */
+    struct us_internal_timeout_wheel_t *timeout_wheel;
+#ifndef LIBUS_USE_LIBUV
+    /* Linux: the io_uring layered over epoll (eventing/io_uring.c), or NULL. */
+    struct us_internal_io_uring_t *io_uring;
+#endif
     struct us_internal_async *wakeup_async;
     struct us_socket_group_t *head;
     /* QUIC engines on this loop. us_quic_loop_process walks the list from
@@ -70,7 +80,6 @@ struct us_internal_loop_data_t {
      * epoll_pwait2 timeout via getTimeout() instead. */
     struct us_timer_t *quic_timer;
 #endif
-    struct us_socket_group_t *iterator;
     char *recv_buf;
     char *send_buf;
     void *ssl_data;
@@ -167,12 +167,26 @@ int bsd_udp_packet_buffer_payload_length(struct udp_recvbuf *msgvec, int index);
 char *bsd_udp_packet_buffer_payload(struct udp_recvbuf *msgvec, int index);
 char *bsd_udp_packet_buffer_peer(struct udp_recvbuf *msgvec, int index);
 int bsd_udp_packet_buffer_truncated(struct udp_recvbuf *msgvec, int index);
+/* The size of each datagram UDP_GRO coalesced into this buffer, 0 if it holds one. */
+int bsd_udp_packet_buffer_segment_size(struct udp_recvbuf *msgvec, int index);
+/* Lets recvmmsg hand back several same-peer datagrams in one buffer (Linux 5.0). */
+int bsd_socket_udp_gro(LIBUS_SOCKET_DESCRIPTOR fd, int enabled);
+#if defined(__linux__)
+/* sendmmsg that sends runs of same-peer, equal-sized datagrams as one UDP_SEGMENT
+ * (GSO) message where the kernel supports it. Returns how many of `msgs` were sent. */
+int bsd_sendmmsg_gso(LIBUS_SOCKET_DESCRIPTOR fd, struct mmsghdr *msgs, unsigned int n, int flags);
+#endif
 // int bsd_udp_packet_buffer_ecn(struct udp_recvbuf *msgvec, int index);
 
 LIBUS_SOCKET_DESCRIPTOR apple_no_sigpipe(LIBUS_SOCKET_DESCRIPTOR fd);
 LIBUS_SOCKET_DESCRIPTOR bsd_set_nonblocking(LIBUS_SOCKET_DESCRIPTOR fd);
 void bsd_socket_nodelay(LIBUS_SOCKET_DESCRIPTOR fd, int enabled);
 int bsd_set_defer_accept(LIBUS_SOCKET_DESCRIPTOR listenFd);
+/* Best-effort TCP Fast Open on a listener / a socket about to connect. */
+void bsd_set_fast_open(LIBUS_SOCKET_DESCRIPTOR listenFd);
+void bsd_set_fast_open_connect(LIBUS_SOCKET_DESCRIPTOR fd);
+/* 1 when this connection's SYN carried data the peer accepted. */
+int bsd_socket_syn_data(LIBUS_SOCKET_DESCRIPTOR fd);
 int bsd_socket_broadcast(LIBUS_SOCKET_DESCRIPTOR fd, int enabled);
 int bsd_socket_ttl_unicast(LIBUS_SOCKET_DESCRIPTOR fd, int ttl);
 int bsd_socket_ttl_multicast(LIBUS_SOCKET_DESCRIPTOR fd, int ttl);
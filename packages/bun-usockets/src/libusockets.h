@@ -96,7 +96,9 @@
 
 /* Small 16KB shared send buffer for UDP packet metadata */
 #define LIBUS_SEND_BUFFER_LENGTH (1 << 14)
-/* A timeout granularity of 4 seconds means give or take 4 seconds from set timeout */
+/* Socket timeouts fire within a second of their deadline. Under libuv the
+ * timeout wheel is swept from a repeating timer this many seconds apart
+ * instead, so they can fire up to that much late (never early). */
 #define LIBUS_TIMEOUT_GRANULARITY 4
 /* 32 byte padding of receive buffer ends */
 #define LIBUS_RECV_BUFFER_PADDING 32
@@ -160,6 +162,16 @@ enum {
      * unconnected socket it also makes the next send fail for a datagram
      * bound to a different, live peer. */
     LIBUS_UDP_LINUX_RECVERR = 128,
+    /* With LIBUS_LISTEN_REUSE_PORT: tag the listener with the CPU the listening thread is
+     * pinned to (SO_INCOMING_CPU) so that, on Linux 6.2+, the kernel hands each worker only
+     * connections received on its own core. No-op unless the thread is pinned to exactly
+     * one CPU. */
+    LIBUS_LISTEN_REUSE_PORT_CPU_AFFINE = 256,
+    /* TCP Fast Open. On a listener, accept data in the SYN from clients holding
+     * a cookie (TCP_FASTOPEN); on a connect, send the first write in the SYN
+     * (TCP_FASTOPEN_CONNECT, Linux only, single-address connects only). Best
+     * effort: a kernel without it falls back to a regular handshake. */
+    LIBUS_SOCKET_FAST_OPEN = 512,
 };
 
 /* Library types publicly available */
@@ -196,6 +208,11 @@ int us_udp_packet_buffer_payload_length(struct us_udp_packet_buffer_t *buf, int
  * 0 otherwise. Backed by MSG_TRUNC in msg_hdr.msg_flags on POSIX. */
 int us_udp_packet_buffer_truncated(struct us_udp_packet_buffer_t *buf, int index);
 
+/* On a socket with UDP_GRO enabled, the payload at `index` may be several
+ * datagrams from the same peer back to back: returns the size of each (the
+ * last may be shorter), or 0 when the payload is a single datagram. */
+int us_udp_packet_buffer_segment_size(struct us_udp_packet_buffer_t *buf, int index);
+
 /* Get the bound port in host byte order */
 int us_udp_socket_bound_port(struct us_udp_socket_t *s);
 
@@ -321,13 +338,10 @@ struct us_socket_group_t {
     struct us_listen_socket_t *head_listen_sockets;
     struct us_socket_t *iterator;
     struct us_socket_group_t *prev, *next;
-    uint32_t global_tick;
     /* Sockets currently parked in loop->data.low_prio_head with s->group == this.
      * They are NOT in head_sockets while queued, so close_all/deinit must
      * account for them separately. */
     uint16_t low_prio_count;
-    unsigned char timestamp;
-    unsigned char long_timestamp;
     unsigned char linked;
 };
 
@@ -355,7 +369,6 @@ void us_socket_group_close_all_ex(us_socket_group_r group, int also_listeners) n
  * (see close_all_ex). */
 int us_loop_close_all_groups(us_loop_r loop) nonnull_fn_decl;
 
-unsigned short us_socket_group_timestamp(us_socket_group_r group) nonnull_fn_decl;
 struct us_loop_t *us_socket_group_loop(us_socket_group_r group) nonnull_fn_decl __attribute((returns_nonnull));
 void *us_socket_group_ext(us_socket_group_r group) nonnull_fn_decl;
 struct us_socket_group_t *us_socket_group_next(us_socket_group_r group) nonnull_fn_decl;
@@ -398,6 +411,9 @@ struct us_listen_socket_t *us_socket_group_listen_fd(us_socket_group_r group,
     LIBUS_SOCKET_DESCRIPTOR fd, int backlog, int options, int socket_ext_size, int *error)
     __attribute__((nonnull(1, 8)));  /* ssl_ctx nullable */
 void us_listen_socket_close(struct us_listen_socket_t *ls) nonnull_fn_decl;
+/* Connections accepted by a LIBUS_SOCKET_FAST_OPEN listener whose SYN carried
+ * data the kernel accepted. */
+unsigned long long us_listen_socket_fast_open_count(struct us_listen_socket_t *ls) nonnull_fn_decl;
 
 /* SNI: tree hangs off the listen socket. ssl_ctx is up_ref'd; user is opaque
  * (uWS stores a per-domain HttpRouter*). user may be NULL. */
@@ -519,6 +535,18 @@ struct us_bun_socket_context_options_t {
     const char *sigalgs;
     /* Colon-separated named-group list applied via SSL_CTX_set1_groups_list. */
     const char *ecdh_curve;
+    /* File of concatenated 48-byte session ticket keys (name, HMAC secret,
+     * AES key). The first seals new tickets, the rest still open old ones;
+     * re-read as it changes so processes sharing the file rotate together. */
+    const char *ticket_keys_file;
+    /* Nonzero moves server signing off the loop onto a process-wide pool of
+     * crypto workers (sized by the first context that asks for one); the
+     * handshake resumes when the loop is woken with the signature. */
+    unsigned int handshake_threads;
+    /* Accept TLS 1.3 early data (0-RTT) on resumed sessions. Until the
+     * handshake completes such data may be a replay; see
+     * us_socket_ssl_in_early_data. */
+    int early_data;
 };
 
 enum create_bun_socket_error_t {
@@ -529,6 +557,7 @@ enum create_bun_socket_error_t {
     CREATE_BUN_SOCKET_ERROR_INVALID_CIPHERS,
     CREATE_BUN_SOCKET_ERROR_INVALID_CRL,
     CREATE_BUN_SOCKET_ERROR_INVALID_ECDH_CURVE,
+    CREATE_BUN_SOCKET_ERROR_INVALID_TICKET_KEYS,
 };
 
 /* Build an SSL_CTX from options. Returns the BoringSSL SSL_CTX*; caller owns
@@ -551,6 +580,41 @@ struct ssl_ctx_st *us_ssl_ctx_from_options(
 void us_internal_ssl_ctx_up_ref(struct ssl_ctx_st *ssl_ctx);
 void us_internal_ssl_ctx_unref(struct ssl_ctx_st *ssl_ctx);
 long us_ssl_ctx_live_count(void);
+/* Server handshakes completed on an SSL_CTX, and the state of its
+ * ticket_keys_file (ticket_keys is 0 without one). early_data counts
+ * handshakes that accepted 0-RTT data, too_early the requests answered with
+ * 425 because they were not replay-safe. */
+struct us_ssl_ctx_session_stats_t {
+    uint64_t resumed_handshakes;
+    uint64_t full_handshakes;
+    uint64_t ticket_key_reloads;
+    uint64_t ticket_key_errors;
+    uint64_t early_data;
+    uint64_t too_early;
+    uint32_t ticket_keys;
+};
+void us_ssl_ctx_session_stats(struct ssl_ctx_st *ctx, struct us_ssl_ctx_session_stats_t *out);
+/* Process-wide counts for client connections: fast_open connects whose SYN
+ * data the server acknowledged, and TLS sessions that sent early data, by
+ * whether the server accepted it. A rejected connection resends the data
+ * after the handshake. */
+struct us_client_connection_stats_t {
+    uint64_t fast_open;
+    uint64_t early_data;
+    uint64_t early_data_accepted;
+    uint64_t early_data_rejected;
+};
+void us_client_connection_stats(struct us_client_connection_stats_t *out);
+/* The process-wide cache of parsed ca/caFile trust stores: lookups that
+ * reused a store, lookups that parsed one, stores dropped to make room, and
+ * stores currently cached. */
+struct us_ca_store_cache_stats_t {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint32_t entries;
+};
+void us_ca_store_cache_stats(struct us_ca_store_cache_stats_t *out);
 /* Appends the certificates in the PEM `content` to `ctx`'s trust store;
  * returns 0 when nothing could be added. */
 int us_ssl_ctx_add_ca_cert(struct ssl_ctx_st *ctx, const char *content);
@@ -572,6 +636,10 @@ void us_ssl_set_session_sink(struct ssl_st *ssl, void *owner,
                              void (*on_new_session)(void *, struct ssl_session_st *),
                              void (*on_free)(void *));
 void *us_ssl_get_session_sink_owner(struct ssl_st *ssl);
+/* Whether a client SSL sends early data when it resumes a session that allows
+ * it. Data the server rejects is written again after the handshake, if the
+ * server presents the resumed session's leaf certificate. */
+void us_ssl_set_early_data(struct ssl_st *ssl, int enabled);
 
 /* Public interfaces for loops */
 
@@ -656,6 +724,21 @@ int us_socket_raw_write(us_socket_r s, const char *data, int length);
  * us_socket_write (their errors propagate through the SSL layer). */
 int us_socket_write_check_error(us_socket_r s, const char *data, int length, int *fatal_write_error);
 
+/* Linux, plain TCP: like us_socket_write, but sent with MSG_ZEROCOPY so the
+ * kernel transmits straight from the caller's pages. Those pages must stay
+ * alive and unmodified until us_socket_zerocopy_done() passes *id, which is
+ * set whenever bytes were written. Returns -1 without writing anything when
+ * zero-copy is not available for this socket; use us_socket_write then. */
+int us_socket_write_zerocopy(us_socket_r s, const char *nonnull_arg data, int length, unsigned int *nonnull_arg id) nonnull_fn_decl;
+/* Every us_socket_write_zerocopy id below this has completed. Completions are
+ * collected from the socket's error event, which then dispatches writable. */
+unsigned int us_socket_zerocopy_done(us_socket_r s) nonnull_fn_decl;
+/* Whether any zerocopy send on this socket has not completed yet. Closing a
+ * socket while this is true resets it instead of shutting it down
+ * gracefully, so the kernel stops reading the pages before the owner frees
+ * them. */
+int us_socket_zerocopy_pending(us_socket_r s) nonnull_fn_decl;
+
 void us_socket_timeout(us_socket_r s, unsigned int seconds) nonnull_fn_decl;
 void us_socket_long_timeout(us_socket_r s, unsigned int minutes) nonnull_fn_decl;
 
@@ -674,12 +757,26 @@ int us_socket_is_shut_down(us_socket_r s) nonnull_fn_decl;
 int us_socket_is_closed(us_socket_r s) nonnull_fn_decl;
 int us_socket_is_ssl_handshake_finished(us_socket_r s) nonnull_fn_decl;
 int us_socket_ssl_handshake_callback_has_fired(us_socket_r s) nonnull_fn_decl;
+/* 1 while a server TLS socket is reading 0-RTT data: the handshake has not
+ * completed, so the bytes read so far may be replayed by an attacker. */
+int us_socket_ssl_in_early_data(us_socket_r s) nonnull_fn_decl;
+/* Counts a request refused for arriving in early data (too_early in
+ * us_ssl_ctx_session_stats_t). */
+void us_socket_ssl_count_too_early(us_socket_r s) nonnull_fn_decl;
 /* TLS ciphertext bytes already sealed for this socket and reported as
  * written by us_socket_write(), still waiting on a writable event to reach
  * the kernel (the loop-wide spill slot owned by this socket). 0 for
  * plain-TCP sockets and for TLS sockets with nothing spilled. */
 unsigned int us_socket_ssl_spill_pending(us_socket_r s) nonnull_fn_decl;
 
+/* Linux, server-side TLS sockets with BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS:
+ * hand record encryption for everything written from now on to the kernel
+ * (kTLS TX), so the fd takes plaintext and sendfile() works on it. Returns 1
+ * once the kernel seals this socket's records, 0 when it cannot (plain TCP,
+ * handshake not finished, unsupported cipher, ciphertext still spilled, no
+ * kernel support); the socket then keeps working as before. */
+int us_socket_ssl_enable_ktls_tx(us_socket_r s) nonnull_fn_decl;
+
 struct us_socket_t *us_socket_close(us_socket_r s, int code, void *reason) __attribute__((nonnull(1)));
 
 int us_socket_local_port(us_socket_r s) nonnull_fn_decl;
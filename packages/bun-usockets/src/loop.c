@@ -72,8 +72,6 @@ void us_internal_disable_sweep_timer(struct us_loop_t *loop) {
 
 #else
 
-#define LIBUS_TIMEOUT_GRANULARITY_NS ((long long) LIBUS_TIMEOUT_GRANULARITY * 1000000000LL)
-
 uint64_t us_internal_monotonic_ns(void) {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -81,18 +79,16 @@ uint64_t us_internal_monotonic_ns(void) {
 }
 
 void us_internal_enable_sweep_timer(struct us_loop_t *loop) {
+    /* The timeout wheel schedules its own sweeps (sweep_next_tick_ns); this
+     * only counts live sockets for the Date header timer. */
     loop->data.sweep_timer_count++;
     if (loop->data.sweep_timer_count == 1) {
-        loop->data.sweep_next_tick_ns = (long long) us_internal_monotonic_ns() + LIBUS_TIMEOUT_GRANULARITY_NS;
         Bun__internal_ensureDateHeaderTimerIsEnabled(loop);
     }
 }
 
 void us_internal_disable_sweep_timer(struct us_loop_t *loop) {
     loop->data.sweep_timer_count--;
-    if (loop->data.sweep_timer_count == 0) {
-        loop->data.sweep_next_tick_ns = -1;
-    }
 }
 
 long long us_internal_sweep_timeout_ns(struct us_loop_t *loop) {
@@ -113,8 +109,7 @@ void us_internal_sweep_if_due(struct us_loop_t *loop) {
     if (now < loop->data.sweep_next_tick_ns) {
         return;
     }
-    /* Re-arm first: a timeout handler may unlink the last socket and disarm. */
-    loop->data.sweep_next_tick_ns = now + LIBUS_TIMEOUT_GRANULARITY_NS;
+    /* The sweep sets the next deadline from what is left in the wheel. */
     us_internal_timer_sweep(loop);
 }
 
@@ -158,6 +153,7 @@ void us_internal_loop_data_free(struct us_loop_t *loop) {
     us_timer_close(loop->data.sweep_timer, 0);
     if (loop->data.quic_timer) us_timer_close(loop->data.quic_timer, 0);
 #endif
+    us_internal_timeout_wheel_free(loop);
     us_internal_async_close(loop->data.wakeup_async);
 }
 
@@ -180,12 +176,6 @@ void us_internal_loop_link_group(struct us_loop_t *loop, struct us_socket_group_
 
 /* Unlink is called before the embedding owner frees its storage */
 void us_internal_loop_unlink_group(struct us_loop_t *loop, struct us_socket_group_t *group) {
-    /* If a timeout callback in us_internal_timer_sweep deinits the current group,
-     * advance the sweep iterator before group->next is cleared — otherwise the sweep
-     * walks into freed storage and skips active groups. */
-    if (group == loop->data.iterator) {
-        loop->data.iterator = group->next;
-    }
     if (loop->data.head == group) {
         loop->data.head = group->next;
         if (loop->data.head) {
@@ -227,72 +217,6 @@ int us_loop_close_all_groups(struct us_loop_t *loop) {
     return any;
 }
 
-/* This functions should never run recursively */
-void us_internal_timer_sweep(struct us_loop_t *loop) {
-    struct us_internal_loop_data_t *loop_data = &loop->data;
-    /* For all socket groups in this loop */
-    loop_data->iterator = loop_data->head;
-    while (loop_data->iterator) {
-
-        struct us_socket_group_t *group = loop_data->iterator;
-
-        /* Update this group's timestamps (this could be moved to loop and done once) */
-        group->global_tick++;
-        unsigned char short_ticks = group->timestamp = group->global_tick % 240;
-        unsigned char long_ticks = group->long_timestamp = (group->global_tick / 15) % 240;
-
-        /* Begin at head */
-        struct us_socket_t *s = group->head_sockets;
-        while (s) {
-            /* Seek until end or timeout found (tightest loop) */
-            while (1) {
-                /* We only read from 1 random cache line here */
-                if (short_ticks == s->timeout || long_ticks == s->long_timeout) {
-                    break;
-                }
-
-                /* Did we reach the end without a find? */
-                if ((s = s->next) == 0) {
-                    goto next_group;
-                }
-            }
-
-            /* Here we have a timeout to emit (slow path) */
-            group->iterator = s;
-
-            if (short_ticks == s->timeout) {
-                s->timeout = 255;
-                us_dispatch_timeout(s);
-            }
-            /* A timeout handler may have closed every socket and the owner may
-             * have deinit'd the embedding group in response (release builds —
-             * deinit() asserts iterator==NULL in debug). loop_data->iterator
-             * would have been advanced past `group` by unlink_group(); if so,
-             * `group` is freed storage and we must not touch it again. */
-            if (loop_data->iterator != group) goto outer_continue;
-
-            if (group->iterator == s && long_ticks == s->long_timeout) {
-                s->long_timeout = 255;
-                us_dispatch_long_timeout(s);
-            }
-            if (loop_data->iterator != group) goto outer_continue;
-
-            /* Check for unlink / link (if the event handler did not modify the chain, we step 1) */
-            if (s == group->iterator) {
-                s = s->next;
-            } else {
-                /* The iterator was changed by event handler */
-                s = group->iterator;
-            }
-        }
-        next_group:
-        /* Only safe to write back / step ->next if the group survived dispatch. */
-        group->iterator = 0;
-        loop_data->iterator = group->next;
-        outer_continue:;
-    }
-}
-
 /* We do not want to block the loop with tons and tons of CPU-intensive work for SSL handshakes.
  * Spread it out during many loop iterations, prioritizing already open connections, they are far
  * easier on CPU */
@@ -316,10 +240,10 @@ void us_internal_handle_low_priority_sockets(struct us_loop_t *loop) {
             continue;
         }
 
+        /* Out of the queue before linking, so the timeout wheel takes it back. */
+        s->flags.low_prio_state = 2;
         us_internal_socket_group_link_socket(s->group, s);
         us_poll_change(&s->p, s->group->loop, us_poll_events(&s->p) | LIBUS_SOCKET_READABLE);
-
-        s->flags.low_prio_state = 2;
     }
 }
 
@@ -396,6 +320,9 @@ void sweep_timer_cb(struct us_internal_callback_t *cb) {
 void us_internal_loop_pre(struct us_loop_t *loop) {
     loop->data.iteration_nr++;
     us_internal_handle_dns_results(loop);
+#ifndef LIBUS_NO_SSL
+    us_internal_ssl_drain_key_jobs(loop);
+#endif
     us_internal_handle_low_priority_sockets(loop);
     loop->data.pre_cb(loop);
 #ifdef LIBUS_USE_QUIC
@@ -410,6 +337,9 @@ void us_internal_loop_pre(struct us_loop_t *loop) {
 
 void us_internal_loop_post(struct us_loop_t *loop) {
     us_internal_handle_dns_results(loop);
+#ifndef LIBUS_NO_SSL
+    us_internal_ssl_drain_key_jobs(loop);
+#endif
 #ifdef LIBUS_USE_QUIC
     if (loop->data.quic_head) us_quic_loop_process(loop);
 #endif
@@ -431,6 +361,17 @@ void us_internal_loop_post(struct us_loop_t *loop) {
 #define us_ioctl ioctl
 #endif
 
+/* The next connection on a listening poll: from the io_uring's multishot
+ * accept when it has one, otherwise accept(). */
+static LIBUS_SOCKET_DESCRIPTOR us_internal_accept_socket(struct us_loop_t *loop, struct us_poll_t *p, struct bsd_addr_t *addr) {
+#ifdef LIBUS_USE_IO_URING
+    return us_internal_io_uring_accept(loop, p, addr);
+#else
+    (void) loop;
+    return bsd_accept_socket(us_poll_fd(p), addr);
+#endif
+}
+
 void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, int events) {
     switch (us_internal_poll_type(p)) {
     case POLL_TYPE_CALLBACK: {
@@ -474,7 +415,7 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                 struct us_loop_t *loop = accept_group->loop;
                 struct bsd_addr_t addr;
 
-                LIBUS_SOCKET_DESCRIPTOR client_fd = bsd_accept_socket(us_poll_fd(p), &addr);
+                LIBUS_SOCKET_DESCRIPTOR client_fd = us_internal_accept_socket(loop, p, &addr);
                 if (client_fd == LIBUS_SOCKET_ERROR) {
                     /* Todo: start timer here */
 
@@ -500,8 +441,8 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                         s->kind = listen_socket->accept_kind;
                         s->ssl = NULL;
                         s->connect_state = NULL;
-                        s->timeout = 255;
-                        s->long_timeout = 255;
+                        us_internal_socket_timeout_init(s);
+                        us_internal_socket_zerocopy_init(s);
                         s->flags.low_prio_state = 0;
                         s->flags.allow_half_open = listen_socket->s.flags.allow_half_open;
                         s->flags.is_paused = 0;
@@ -511,10 +452,15 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                         s->flags.last_write_failed = 0;
                         s->unclassified_send_failures = 0;
                         s->read_eof = 0;
+                        s->fast_open_pending = 0;
 
                         /* We always use nodelay */
                         bsd_socket_nodelay(client_fd, 1);
 
+                        if (listen_socket->fast_open && bsd_socket_syn_data(client_fd)) {
+                            listen_socket->fast_open_accepted++;
+                        }
+
                         us_internal_socket_group_link_socket(accept_group, s);
 
                         if (listen_socket->ssl_ctx) {
@@ -540,7 +486,7 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                             break;
                         }
 
-                    } while ((client_fd = bsd_accept_socket(us_poll_fd(p), &addr)) != LIBUS_SOCKET_ERROR);
+                    } while ((client_fd = us_internal_accept_socket(loop, p, &addr)) != LIBUS_SOCKET_ERROR);
                 }
             }
         break;
@@ -553,6 +499,16 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
             s = us_internal_socket_follow_adopted(s);
             /* The group can change after calling a callback but the loop is always the same */
             struct us_loop_t* loop = s->group->loop;
+            /* EPOLLERR also reports MSG_ZEROCOPY completions waiting on the error
+             * queue (us_socket_write_zerocopy). When that is all it carried, the
+             * event is a writable one for the layer above: it can release the
+             * buffers the kernel no longer reads from and re-run its
+             * close-after-drain gates. A real socket error stays latched in
+             * SO_ERROR, so EPOLLERR fires again for it. */
+            if (error && us_socket_zerocopy_pending(s) && us_internal_socket_reap_zerocopy(s)) {
+                error = 0;
+                events |= LIBUS_SOCKET_WRITABLE;
+            }
             /* Captured before the read loop folds recv()==0 into `eof`; error events keep the error path. */
             const int hangup = (eof & LIBUS_POLL_HANGUP) && !error;
             /* Set once recv() returns 0 below: the only proof that the peer's stream ended with a FIN. The
@@ -660,6 +616,9 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                     #endif
 
                     int length;
+                    /* Where this read's bytes are: recv_buf, or a buffer the
+                     * io_uring already filled, handed back after on_data. */
+                    char *data = loop->data.recv_buf + LIBUS_RECV_BUFFER_PADDING;
                     #if !defined(_WIN32)
                     if(s->flags.is_ipc) {
                         struct msghdr msg = {0};
@@ -717,14 +676,29 @@ void us_internal_dispatch_ready_poll(struct us_poll_t *p, int error, int eof, in
                         }
                     }else{
                     #endif
-                        length = bsd_recv(us_poll_fd(&s->p), loop->data.recv_buf + LIBUS_RECV_BUFFER_PADDING, LIBUS_RECV_BUFFER_LENGTH, recv_flags);
+                    #ifdef LIBUS_USE_IO_URING
+                        length = us_internal_io_uring_recv(loop, &s->p, &data);
+                        if (length == US_IO_URING_NOT_RECEIVED)
+                    #endif
+                        length = bsd_recv(us_poll_fd(&s->p), data, LIBUS_RECV_BUFFER_LENGTH, recv_flags);
                     #if !defined(_WIN32)
                     }
                     #endif
 
                     if (length > 0) {
-                        s = s->ssl ? us_internal_ssl_on_data(s, loop->data.recv_buf + LIBUS_RECV_BUFFER_PADDING, length)
-                                   : us_dispatch_data(s, loop->data.recv_buf + LIBUS_RECV_BUFFER_PADDING, length);
+                        /* The peer has answered, so the kernel knows whether it
+                         * took the data in our SYN. */
+                        if (s->fast_open_pending) {
+                            s->fast_open_pending = 0;
+                            if (bsd_socket_syn_data(us_poll_fd(&s->p))) {
+                                us_internal_count_client(US_CLIENT_FAST_OPEN);
+                            }
+                        }
+                        s = s->ssl ? us_internal_ssl_on_data(s, data, length)
+                                   : us_dispatch_data(s, data, length);
+                    #ifdef LIBUS_USE_IO_URING
+                        us_internal_io_uring_release(loop, data);
+                    #endif
                         /* After socket adoption, track the new socket; the old one becomes invalid */
                         s = us_internal_socket_follow_adopted(s);
                         // loop->num_ready_polls isn't accessible on Windows.
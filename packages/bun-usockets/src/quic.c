@@ -44,18 +44,13 @@ struct us_quic_hset {
     int is_server;
 };
 
-struct us_quic_sni {
-    char *name;
-    SSL_CTX *ctx;
-};
-
 struct us_quic_socket_context_s {
     struct us_loop_t *loop;
     lsquic_engine_t *engine;
     struct lsquic_engine_settings settings;
     SSL_CTX *ssl_ctx;
-    struct us_quic_sni *sni;
-    unsigned int sni_count, sni_cap;
+    /* serverName patterns to SSL_CTX (sni_tree.cpp); NULL until the first */
+    void *sni;
     int processing;
     int closing;
     int is_client;
@@ -249,7 +244,9 @@ static int us_quic_send_one(LIBUS_SOCKET_DESCRIPTOR fd, const struct lsquic_out_
 }
 
 /* lsquic hands back packets in batches; on Linux push them through one
- * sendmmsg() so a 32-packet flight is a single syscall. macOS's sendmsg_x
+ * sendmmsg() so a 32-packet flight is a single syscall, and where the kernel
+ * has UDP GSO a run of full-size packets to one peer goes down the stack as
+ * one segmented message (bsd_sendmmsg_gso). macOS's sendmsg_x
  * can't carry per-datagram addresses (which QUIC needs), so it falls back to
  * the per-packet path along with everything else non-Linux. The recv side
  * already goes through bsd_recvmmsg in loop.c. */
@@ -280,7 +277,7 @@ static int us_quic_packets_out(void *out_ctx, const struct lsquic_out_spec *spec
             if (US_FAULT_CHECK(US_FAULT_SENDMSG, fd, injected, unused)) {
                 r = (int) injected;
             } else {
-                do { r = sendmmsg(fd, mm, k, 0); } while (r < 0 && errno == EINTR);
+                r = bsd_sendmmsg_gso(fd, mm, k, 0);
             }
             (void) injected; (void) unused;
         }
@@ -297,7 +294,7 @@ static int us_quic_packets_out(void *out_ctx, const struct lsquic_out_spec *spec
          * real backpressure. EAGAIN/ENOBUFS (send buffer full) stays a
          * break — that's the backpressure lsquic's pause is for. */
         if (r < 0 && !(errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)) {
-            do { r = sendmmsg(fd, mm, k, 0); } while (r < 0 && errno == EINTR);
+            r = bsd_sendmmsg_gso(fd, mm, k, 0);
         }
         if (r < 0) break;
         sent += (unsigned) r;
@@ -342,8 +339,14 @@ static void us_quic_udp_on_data(struct us_udp_socket_t *u, void *recvbuf, int np
         char *payload = us_udp_packet_buffer_payload((struct us_udp_packet_buffer_t *) recvbuf, i);
         int len = us_udp_packet_buffer_payload_length((struct us_udp_packet_buffer_t *) recvbuf, i);
         struct sockaddr *peer = (struct sockaddr *) us_udp_packet_buffer_peer((struct us_udp_packet_buffer_t *) recvbuf, i);
-        lsquic_engine_packet_in(ctx->engine, (unsigned char *) payload, (size_t) len,
-            (struct sockaddr *) &ls->local, peer, ls, 0);
+        /* UDP_GRO may have merged a burst from this peer: feed each datagram. */
+        int segment = us_udp_packet_buffer_segment_size((struct us_udp_packet_buffer_t *) recvbuf, i);
+        if (segment <= 0) segment = len;
+        for (int off = 0; off < len && ctx->engine; off += segment) {
+            int chunk = len - off < segment ? len - off : segment;
+            lsquic_engine_packet_in(ctx->engine, (unsigned char *) payload + off, (size_t) chunk,
+                (struct sockaddr *) &ls->local, peer, ls, 0);
+        }
     }
     /* Don't process here — let loop_post run a single process_conns after
      * every poll has been dispatched so all of this iteration's writes go
@@ -373,21 +376,16 @@ static void us_quic_udp_on_close(struct us_udp_socket_t *u) {
 
 /* ───── SSL ───── */
 
-/* Exact match, then `*.tail` wildcards (matches "a.tail" but not "tail"). */
+/* Same index and matching rules as TCP listeners: exact, then a `*.tail`
+ * wildcard covering one label ("a.tail", not "b.a.tail" or "tail"). */
 static SSL_CTX *us_quic_match_sni(us_quic_socket_context_t *ctx, const char *sni) {
-    if (!sni) return ctx->ssl_ctx;
-    size_t sl = strlen(sni);
-    for (unsigned i = 0; i < ctx->sni_count; i++) {
-        if (strcmp(ctx->sni[i].name, sni) == 0) return ctx->sni[i].ctx;
-    }
-    for (unsigned i = 0; i < ctx->sni_count; i++) {
-        const char *n = ctx->sni[i].name;
-        if (n[0] == '*' && n[1] == '.') {
-            size_t tl = strlen(n + 1);
-            if (sl > tl && memcmp(sni + sl - tl, n + 1, tl) == 0) return ctx->sni[i].ctx;
-        }
-    }
-    return ctx->ssl_ctx;
+    if (!sni || !ctx->sni) return ctx->ssl_ctx;
+    SSL_CTX *match = (SSL_CTX *) sni_find(ctx->sni, sni);
+    return match ? match : ctx->ssl_ctx;
+}
+
+static void us_quic_sni_free(void *user) {
+    SSL_CTX_free((SSL_CTX *) user);
 }
 
 static SSL_CTX *us_quic_get_ssl_ctx(void *peer_ctx, const struct sockaddr *local) {
@@ -797,17 +795,9 @@ int us_quic_socket_context_add_server_name(us_quic_socket_context_t *ctx,
     us_quic_prepare_ssl_ctx(ssl, &options);
     SSL_CTX_set_verify(ssl, SSL_CTX_get_verify_mode(ssl) | SSL_CTX_get_verify_mode(ctx->ssl_ctx),
         SSL_CTX_get_verify_callback(ssl));
-    if (ctx->sni_count == ctx->sni_cap) {
-        unsigned ncap = ctx->sni_cap ? ctx->sni_cap * 2 : 4;
-        struct us_quic_sni *n = (struct us_quic_sni *) us_realloc(ctx->sni, ncap * sizeof(*n));
-        if (!n) { SSL_CTX_free(ssl); return -1; }
-        ctx->sni = n; ctx->sni_cap = ncap;
-    }
-    char *name = us_strdup(hostname);
-    if (!name) { SSL_CTX_free(ssl); return -1; }
-    ctx->sni[ctx->sni_count].name = name;
-    ctx->sni[ctx->sni_count].ctx = ssl;
-    ctx->sni_count++;
+    if (!ctx->sni) ctx->sni = sni_new();
+    /* A repeated pattern keeps its first context, as lookups always did */
+    if (sni_add(ctx->sni, hostname, ssl)) SSL_CTX_free(ssl);
     return 0;
 }
 
@@ -838,11 +828,7 @@ void us_quic_socket_context_free(us_quic_socket_context_t *ctx) {
     while (ctx->listeners) us_udp_socket_close(ctx->listeners->udp);
     if (ctx->engine) { lsquic_engine_destroy(ctx->engine); ctx->engine = NULL; }
     if (ctx->ssl_ctx) { SSL_CTX_free(ctx->ssl_ctx); ctx->ssl_ctx = NULL; }
-    for (unsigned i = 0; i < ctx->sni_count; i++) {
-        us_free(ctx->sni[i].name);
-        SSL_CTX_free(ctx->sni[i].ctx);
-    }
-    us_free(ctx->sni);
+    if (ctx->sni) { sni_free(ctx->sni, us_quic_sni_free); ctx->sni = NULL; }
     for (us_quic_listen_socket_t *ls = ctx->closed_listeners; ls; ) {
         us_quic_listen_socket_t *next = ls->next;
         us_free(ls);
@@ -888,6 +874,12 @@ static void us_quic_set_dontfrag(struct us_udp_socket_t *udp) {
     (void) on;
 }
 
+/* Linux 5.0+: let recvmmsg return a burst of datagrams from one peer in a
+ * single buffer; us_quic_udp_on_data splits it. Harmless where unsupported. */
+static void us_quic_set_gro(struct us_udp_socket_t *udp) {
+    bsd_socket_udp_gro(us_poll_fd((struct us_poll_t *) udp), 1);
+}
+
 us_quic_listen_socket_t *us_quic_socket_context_listen(
     us_quic_socket_context_t *ctx, const char *host, int port, int flags,
     unsigned int stream_ext_size)
@@ -904,6 +896,7 @@ us_quic_listen_socket_t *us_quic_socket_context_listen(
         host, (unsigned short) port, flags, &err, ls);
     if (!ls->udp) { us_free(ls); return NULL; }
     us_quic_set_dontfrag(ls->udp);
+    us_quic_set_gro(ls->udp);
 
     /* Record actual bound address — packet_in needs sa_local. */
     socklen_t sl = sizeof(ls->local);
@@ -1262,6 +1255,7 @@ static us_quic_listen_socket_t *us_quic_client_endpoint(us_quic_socket_context_t
     }
     if (!ls->udp) { us_free(ls); return NULL; }
     us_quic_set_dontfrag(ls->udp);
+    us_quic_set_gro(ls->udp);
     socklen_t sl = sizeof(ls->local);
     getsockname(us_poll_fd((struct us_poll_t *) ls->udp), (struct sockaddr *) &ls->local, &sl);
     ls->next = ctx->listeners;
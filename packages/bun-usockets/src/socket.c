@@ -21,10 +21,29 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdatomic.h>
 #include <errno.h>
 #ifndef WIN32
 #include <fcntl.h>
 #endif
+#ifdef __linux__
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#endif
+
+/* Bumped from whichever thread owns the connecting loop. */
+static _Atomic uint64_t us_client_stats[US_CLIENT_STAT_COUNT];
+
+void us_internal_count_client(enum us_internal_client_stat stat) {
+    atomic_fetch_add_explicit(&us_client_stats[stat], 1, memory_order_relaxed);
+}
+
+void us_client_connection_stats(struct us_client_connection_stats_t *out) {
+    out->fast_open = atomic_load_explicit(&us_client_stats[US_CLIENT_FAST_OPEN], memory_order_relaxed);
+    out->early_data = atomic_load_explicit(&us_client_stats[US_CLIENT_EARLY_DATA], memory_order_relaxed);
+    out->early_data_accepted = atomic_load_explicit(&us_client_stats[US_CLIENT_EARLY_DATA_ACCEPTED], memory_order_relaxed);
+    out->early_data_rejected = atomic_load_explicit(&us_client_stats[US_CLIENT_EARLY_DATA_REJECTED], memory_order_relaxed);
+}
 
 int us_socket_local_port(struct us_socket_t *s) {
     struct bsd_addr_t addr;
@@ -98,35 +117,27 @@ unsigned char us_connecting_socket_kind(struct us_connecting_socket_t *c) {
 }
 
 __attribute__((always_inline)) void us_socket_timeout(struct us_socket_t *s, unsigned int seconds) {
-    if (seconds) {
-        s->timeout = ((unsigned int)s->group->timestamp + ((seconds + 3) >> 2)) % 240;
-    } else {
-        s->timeout = 255;
-    }
+    uint32_t deadline = us_internal_timeout_deadline(s->group->loop, seconds);
+    /* Re-arming within the same second (every write on a busy socket) keeps
+     * its bucket. */
+    if (deadline == s->timeout_tick) return;
+    s->timeout_tick = deadline;
+    us_internal_socket_timeout_update(s);
 }
 
 void us_connecting_socket_timeout(struct us_connecting_socket_t *c, unsigned int seconds) {
-    if (seconds) {
-        c->timeout = ((unsigned int)c->group->timestamp + ((seconds + 3) >> 2)) % 240;
-    } else {
-        c->timeout = 255;
-    }
+    c->timeout_tick = us_internal_timeout_deadline(c->loop, seconds);
 }
 
 __attribute__((always_inline)) void us_socket_long_timeout(struct us_socket_t *s, unsigned int minutes) {
-    if (minutes) {
-        s->long_timeout = ((unsigned int)s->group->long_timestamp + minutes) % 240;
-    } else {
-        s->long_timeout = 255;
-    }
+    uint32_t deadline = us_internal_timeout_deadline(s->group->loop, (unsigned long long) minutes * 60);
+    if (deadline == s->long_timeout_tick) return;
+    s->long_timeout_tick = deadline;
+    us_internal_socket_timeout_update(s);
 }
 
 void us_connecting_socket_long_timeout(struct us_connecting_socket_t *c, unsigned int minutes) {
-    if (minutes) {
-        c->long_timeout = ((unsigned int)c->group->long_timestamp + minutes) % 240;
-    } else {
-        c->long_timeout = 255;
-    }
+    c->long_timeout_tick = us_internal_timeout_deadline(c->loop, (unsigned long long) minutes * 60);
 }
 
 __attribute__((always_inline)) void us_socket_flush(struct us_socket_t *s) {
@@ -160,6 +171,13 @@ unsigned int us_socket_ssl_spill_pending(struct us_socket_t *s) {
     return 0;
 }
 
+int us_socket_ssl_enable_ktls_tx(struct us_socket_t *s) {
+    if (s->ssl) {
+        return us_internal_ssl_enable_ktls_tx(s);
+    }
+    return 0;
+}
+
 int us_connecting_socket_is_closed(struct us_connecting_socket_t *c) {
     return c->closed;
 }
@@ -304,7 +322,19 @@ struct us_socket_t *us_internal_socket_close_raw(struct us_socket_t *s, int code
             us_poll_stop((struct us_poll_t *) s, loop);
         #endif
 
-        if (code == LIBUS_SOCKET_CLOSE_CODE_CONNECTION_RESET) {
+        /* The owner releases the buffers of in-flight MSG_ZEROCOPY sends
+         * (us_socket_write_zerocopy) from on_close. A graceful close keeps
+         * transmitting the queued sends from those pages after they are
+         * freed, so collect the completions already queued and reset if any
+         * send is still outstanding: that discards the unsent queue with
+         * the socket. */
+        int reset = code == LIBUS_SOCKET_CLOSE_CODE_CONNECTION_RESET;
+        if (!reset && us_socket_zerocopy_pending(s)) {
+            us_internal_socket_reap_zerocopy(s);
+            reset = us_socket_zerocopy_pending(s);
+        }
+
+        if (reset) {
             // Prevent entering TIME_WAIT state when forcefully closing
             struct linger l = { 1, 0 };
             setsockopt(us_poll_fd((struct us_poll_t *)s), SOL_SOCKET, SO_LINGER, (const char*)&l, sizeof(l));
@@ -448,8 +478,8 @@ struct us_socket_t *us_socket_from_fd(struct us_socket_group_t *group, unsigned
     s->group = group;
     s->kind = kind;
     s->ssl = NULL;
-    s->timeout = 255;
-    s->long_timeout = 255;
+    us_internal_socket_timeout_init(s);
+    us_internal_socket_zerocopy_init(s);
     s->flags.low_prio_state = 0;
     s->flags.allow_half_open = (options & LIBUS_SOCKET_ALLOW_HALF_OPEN) != 0;
     s->flags.is_paused = 0;
@@ -459,6 +489,7 @@ struct us_socket_t *us_socket_from_fd(struct us_socket_group_t *group, unsigned
     s->flags.last_write_failed = 0;
     s->unclassified_send_failures = 0;
     s->read_eof = 0;
+    s->fast_open_pending = 0;
     s->connect_state = NULL;
 
     /* We always use nodelay */
@@ -609,6 +640,116 @@ int us_socket_write_check_error(struct us_socket_t *s, const char *data, int len
     return written;
 }
 
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#define US_HAS_ZEROCOPY 1
+#endif
+
+int us_socket_write_zerocopy(struct us_socket_t *s, const char *data, int length, unsigned int *id) {
+#ifdef US_HAS_ZEROCOPY
+    /* TLS writes are ciphertext BoringSSL produces, not the caller's pages. */
+    if (s->ssl || s->zerocopy_state == 2 || length <= 0) {
+        return -1;
+    }
+    if (us_socket_is_closed(s) || us_socket_is_shut_down(s)) {
+        return 0;
+    }
+    if (s->zerocopy_state == 0) {
+        int one = 1;
+        if (setsockopt(us_poll_fd(&s->p), SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) != 0) {
+            s->zerocopy_state = 2;
+            return -1;
+        }
+        s->zerocopy_state = 1;
+    }
+
+    struct iovec iov = { (void *) data, (size_t) length };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    ssize_t written = bsd_sendmsg(us_poll_fd(&s->p), &msg, MSG_NOSIGNAL | MSG_DONTWAIT | MSG_ZEROCOPY);
+    if (written < 0 && errno == ENOBUFS) {
+        /* The socket's pinned-page budget (optmem_max) is used up by sends
+         * that have not completed yet; a copying send still goes through. */
+        return -1;
+    }
+    if (written > 0) {
+        *id = s->zerocopy_next++;
+    }
+    if (written != length) {
+        s->flags.last_write_failed = 1;
+        us_internal_rearm_writable(s);
+    }
+    return written < 0 ? 0 : (int) written;
+#else
+    (void) s; (void) data; (void) length; (void) id;
+    return -1;
+#endif
+}
+
+unsigned int us_socket_zerocopy_done(struct us_socket_t *s) {
+    return s->zerocopy_done;
+}
+
+int us_socket_zerocopy_pending(struct us_socket_t *s) {
+    return s->zerocopy_next != s->zerocopy_done;
+}
+
+int us_internal_socket_reap_zerocopy(struct us_socket_t *s) {
+#ifdef US_HAS_ZEROCOPY
+    int reaped = 0, only_completions = 1;
+    union {
+        char buf[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+        struct cmsghdr align;
+    } control;
+
+    while (1) {
+        struct msghdr msg = {0};
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        if (recvmsg(us_poll_fd(&s->p), &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            break;
+        }
+
+        struct cmsghdr *cm = CMSG_FIRSTHDR(&msg);
+        struct sock_extended_err *ee = NULL;
+        if (cm && ((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                   (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+            ee = (struct sock_extended_err *) CMSG_DATA(cm);
+        }
+        if (!ee || ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY || ee->ee_errno != 0) {
+            only_completions = 0;
+            continue;
+        }
+
+        /* One notification covers the inclusive id range [ee_info, ee_data]. */
+        uint32_t lo = ee->ee_info, hi = ee->ee_data;
+        reaped = 1;
+        if (lo == s->zerocopy_done) {
+            s->zerocopy_done = hi + 1;
+        } else {
+            s->zerocopy_ooo += hi - lo + 1;
+        }
+        /* Out-of-order ranges are only counted, so they can release nothing
+         * until every outstanding send has completed. */
+        if (s->zerocopy_ooo && s->zerocopy_done + s->zerocopy_ooo == s->zerocopy_next) {
+            s->zerocopy_done = s->zerocopy_next;
+            s->zerocopy_ooo = 0;
+        }
+        /* The kernel copied after all (loopback, a device without
+         * scatter-gather): zero-copy only costs the completion round trips
+         * on this path, so later writes on this socket copy. */
+        if (ee->ee_code == SO_EE_CODE_ZEROCOPY_COPIED) {
+            s->zerocopy_state = 2;
+        }
+    }
+    return reaped && only_completions;
+#else
+    (void) s;
+    return 0;
+#endif
+}
+
 int us_socket_raw_writev(struct us_socket_t *s, const struct us_iovec_t *iov, int count) {
     if (us_socket_is_closed(s) ||
         us_internal_poll_type(&s->p) == POLL_TYPE_SOCKET_SHUT_DOWN) {
@@ -0,0 +1,351 @@
+/*
+ * Authored by Alex Hultman, 2018-2021.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// clang-format off
+#include "libusockets.h"
+#include "internal/internal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* Four levels of 64 buckets; a level-n bucket spans 64^n ticks. A socket is
+ * filed at the coarsest level its deadline needs and moves down one level each
+ * time its bucket comes up (the "cascade"), so it is touched at most once per
+ * level before it expires. Layout and cascade follow the classic Linux timer
+ * wheel (kernel/timer.c before 4.8). 64^4 ticks at one tick per second is ~194
+ * days; longer deadlines are clamped to that. */
+#define US_TIMEOUT_WHEEL_BITS 6
+#define US_TIMEOUT_WHEEL_SLOTS (1u << US_TIMEOUT_WHEEL_BITS)
+#define US_TIMEOUT_WHEEL_MASK (US_TIMEOUT_WHEEL_SLOTS - 1)
+#define US_TIMEOUT_WHEEL_LEVELS 4
+#define US_TIMEOUT_WHEEL_MAX_TICKS ((1u << (US_TIMEOUT_WHEEL_BITS * US_TIMEOUT_WHEEL_LEVELS)) - 1)
+#define US_TIMEOUT_WHEEL_TICK_NS 1000000000LL
+
+struct us_internal_timeout_wheel_t {
+    /* The next tick to expire; every earlier one has been. */
+    uint32_t tick;
+    /* Sockets linked into a bucket or into `expiring`. */
+    uint32_t count;
+    /* Bit i of level n set = bucket i may be non-empty. Unlinking does not know
+     * its bucket, so bits are cleared lazily by whoever finds the bucket empty. */
+    uint64_t occupied[US_TIMEOUT_WHEEL_LEVELS];
+    /* Circular lists with sentinel heads: a socket unlinks in O(1) from
+     * whichever list it is on. */
+    struct us_internal_timeout_link_t buckets[US_TIMEOUT_WHEEL_LEVELS][US_TIMEOUT_WHEEL_SLOTS];
+    /* The bucket being expired. Its own list so a timeout handler can close or
+     * re-arm any socket still waiting in it. */
+    struct us_internal_timeout_link_t expiring;
+};
+
+static inline struct us_socket_t *us_internal_timeout_link_socket(struct us_internal_timeout_link_t *link) {
+    return (struct us_socket_t *) ((char *) link - offsetof(struct us_socket_t, timeout_link));
+}
+
+/* Wrap-safe a <= b for wheel ticks. */
+static inline int us_internal_tick_le(uint32_t a, uint32_t b) {
+    return (int32_t) (a - b) <= 0;
+}
+
+static inline void us_internal_timeout_list_init(struct us_internal_timeout_link_t *head) {
+    head->prev = head->next = head;
+}
+
+static inline int us_internal_timeout_list_empty(struct us_internal_timeout_link_t *head) {
+    return head->next == head;
+}
+
+/* Appends every entry of `from` to `to` and leaves `from` empty. */
+static void us_internal_timeout_list_splice(struct us_internal_timeout_link_t *from, struct us_internal_timeout_link_t *to) {
+    if (us_internal_timeout_list_empty(from)) {
+        return;
+    }
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    us_internal_timeout_list_init(from);
+}
+
+/* Whole seconds of monotonic time. Deadlines and sweeps read the same,
+ * uncached clock; uv_now() is only updated once per iteration and would let a
+ * deadline armed late in one land early. */
+static uint32_t us_internal_timeout_clock_tick(struct us_loop_t *loop) {
+    (void) loop;
+#ifdef LIBUS_USE_LIBUV
+    return (uint32_t) (uv_hrtime() / (uint64_t) US_TIMEOUT_WHEEL_TICK_NS);
+#else
+    return (uint32_t) (us_internal_monotonic_ns() / (uint64_t) US_TIMEOUT_WHEEL_TICK_NS);
+#endif
+}
+
+uint32_t us_internal_timeout_deadline(struct us_loop_t *loop, unsigned long long seconds) {
+    if (!seconds) {
+        return 0;
+    }
+    if (seconds > US_TIMEOUT_WHEEL_MAX_TICKS - 1) {
+        seconds = US_TIMEOUT_WHEEL_MAX_TICKS - 1;
+    }
+    /* +1: the current tick is already partly over. */
+    uint32_t deadline = us_internal_timeout_clock_tick(loop) + (uint32_t) seconds + 1;
+    return deadline ? deadline : 1;
+}
+
+/* The earlier of the two armed deadlines, or 0 when neither is. */
+static inline uint32_t us_internal_socket_next_deadline(struct us_socket_t *s) {
+    if (!s->timeout_tick) {
+        return s->long_timeout_tick;
+    }
+    if (!s->long_timeout_tick) {
+        return s->timeout_tick;
+    }
+    return us_internal_tick_le(s->timeout_tick, s->long_timeout_tick) ? s->timeout_tick : s->long_timeout_tick;
+}
+
+static struct us_internal_timeout_wheel_t *us_internal_timeout_wheel(struct us_loop_t *loop) {
+    struct us_internal_timeout_wheel_t *wheel = loop->data.timeout_wheel;
+    if (wheel) {
+        return wheel;
+    }
+    wheel = us_malloc(sizeof(struct us_internal_timeout_wheel_t));
+    if (!wheel) Bun__outOfMemory();
+    wheel->tick = us_internal_timeout_clock_tick(loop);
+    wheel->count = 0;
+    memset(wheel->occupied, 0, sizeof(wheel->occupied));
+    for (int level = 0; level < US_TIMEOUT_WHEEL_LEVELS; level++) {
+        for (unsigned slot = 0; slot < US_TIMEOUT_WHEEL_SLOTS; slot++) {
+            us_internal_timeout_list_init(&wheel->buckets[level][slot]);
+        }
+    }
+    us_internal_timeout_list_init(&wheel->expiring);
+    loop->data.timeout_wheel = wheel;
+    return wheel;
+}
+
+void us_internal_timeout_wheel_free(struct us_loop_t *loop) {
+    us_free(loop->data.timeout_wheel);
+    loop->data.timeout_wheel = NULL;
+}
+
+/* Files `link` under `deadline` and returns the tick the wheel next has to
+ * look at it: the deadline itself on level 0, the start of its bucket's span
+ * (when it cascades) above that. */
+static uint32_t us_internal_timeout_wheel_link(struct us_internal_timeout_wheel_t *wheel,
+                                               struct us_internal_timeout_link_t *link, uint32_t deadline) {
+    uint32_t delta = deadline - wheel->tick;
+    int level = 0;
+    uint32_t slot;
+    uint32_t due;
+    if ((int32_t) delta < 0) {
+        /* Already due: the bucket that expires next. */
+        slot = wheel->tick & US_TIMEOUT_WHEEL_MASK;
+        due = wheel->tick;
+    } else {
+        if (delta > US_TIMEOUT_WHEEL_MAX_TICKS) {
+            /* Expiry re-checks the socket's own deadline and files it again. */
+            deadline = wheel->tick + US_TIMEOUT_WHEEL_MAX_TICKS;
+            delta = US_TIMEOUT_WHEEL_MAX_TICKS;
+        }
+        while (level < US_TIMEOUT_WHEEL_LEVELS - 1 && (delta >> (US_TIMEOUT_WHEEL_BITS * (level + 1)))) {
+            level++;
+        }
+        unsigned shift = US_TIMEOUT_WHEEL_BITS * level;
+        slot = (deadline >> shift) & US_TIMEOUT_WHEEL_MASK;
+        due = (deadline >> shift) << shift;
+        if (!us_internal_tick_le(wheel->tick, due)) {
+            due = wheel->tick;
+        }
+    }
+
+    struct us_internal_timeout_link_t *head = &wheel->buckets[level][slot];
+    link->next = head;
+    link->prev = head->prev;
+    head->prev->next = link;
+    head->prev = link;
+    wheel->occupied[level] |= 1ull << slot;
+    wheel->count++;
+    return due;
+}
+
+static void us_internal_timeout_wheel_unlink(struct us_internal_timeout_wheel_t *wheel, struct us_internal_timeout_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = link->next = NULL;
+    wheel->count--;
+}
+
+/* Lowers the poll deadline to `tick` if the wheel now has work before the
+ * sweep it was sleeping toward. */
+static void us_internal_timeout_wheel_wake_by(struct us_loop_t *loop, uint32_t tick) {
+#ifndef LIBUS_USE_LIBUV
+    long long ns = (long long) tick * US_TIMEOUT_WHEEL_TICK_NS;
+    if (loop->data.sweep_next_tick_ns < 0 || ns < loop->data.sweep_next_tick_ns) {
+        loop->data.sweep_next_tick_ns = ns;
+    }
+#else
+    /* The libuv sweep timer repeats every LIBUS_TIMEOUT_GRANULARITY seconds. */
+    (void) loop;
+    (void) tick;
+#endif
+}
+
+void us_internal_socket_timeout_unlink(struct us_socket_t *s) {
+    if (!s->timeout_link.prev) {
+        return;
+    }
+    us_internal_timeout_wheel_unlink(s->group->loop->data.timeout_wheel, &s->timeout_link);
+}
+
+void us_internal_socket_timeout_update(struct us_socket_t *s) {
+    us_internal_socket_timeout_unlink(s);
+    /* The wheel only holds sockets that are in their group's list: a socket
+     * parked in the low-prio queue is filed when it rejoins its group
+     * (us_internal_socket_group_link_socket). */
+    if (us_socket_is_closed(s) || s->flags.low_prio_state == 1) {
+        return;
+    }
+    uint32_t deadline = us_internal_socket_next_deadline(s);
+    if (!deadline) {
+        return;
+    }
+    struct us_loop_t *loop = s->group->loop;
+    struct us_internal_timeout_wheel_t *wheel = us_internal_timeout_wheel(loop);
+    if (!wheel->count) {
+        /* Nothing is waiting, so there is nothing to expire between the last
+         * sweep and now: skip the idle ticks instead of walking them. */
+        uint32_t now = us_internal_timeout_clock_tick(loop);
+        if (us_internal_tick_le(wheel->tick, now)) {
+            wheel->tick = now;
+        }
+        memset(wheel->occupied, 0, sizeof(wheel->occupied));
+    }
+    us_internal_timeout_wheel_wake_by(loop, us_internal_timeout_wheel_link(wheel, &s->timeout_link, deadline));
+}
+
+/* Moves the level-`level` bucket for the current tick one level down (or
+ * onto level 0). Returns that bucket's index; 0 means this level wrapped too
+ * and the next level up is due as well. */
+static uint32_t us_internal_timeout_wheel_cascade(struct us_internal_timeout_wheel_t *wheel, int level) {
+    uint32_t index = (wheel->tick >> (US_TIMEOUT_WHEEL_BITS * level)) & US_TIMEOUT_WHEEL_MASK;
+    struct us_internal_timeout_link_t pending;
+    us_internal_timeout_list_init(&pending);
+    us_internal_timeout_list_splice(&wheel->buckets[level][index], &pending);
+    wheel->occupied[level] &= ~(1ull << index);
+
+    /* No callbacks run in here, so the stack sentinel never escapes. */
+    while (!us_internal_timeout_list_empty(&pending)) {
+        struct us_internal_timeout_link_t *link = pending.next;
+        us_internal_timeout_wheel_unlink(wheel, link);
+        us_internal_timeout_wheel_link(wheel, link, us_internal_socket_next_deadline(us_internal_timeout_link_socket(link)));
+    }
+    return index;
+}
+
+/* Dispatches every socket in wheel->expiring whose deadline is at or before
+ * `tick`. Handlers may close, adopt or re-arm this or any other socket; each
+ * iteration takes the list head afresh, so a nested sweep (a handler that
+ * spins the loop) simply drains what is left. */
+static void us_internal_timeout_wheel_expire(struct us_internal_timeout_wheel_t *wheel, uint32_t tick) {
+    while (!us_internal_timeout_list_empty(&wheel->expiring)) {
+        struct us_internal_timeout_link_t *link = wheel->expiring.next;
+        struct us_socket_t *s = us_internal_timeout_link_socket(link);
+        us_internal_timeout_wheel_unlink(wheel, link);
+
+        if (s->timeout_tick && us_internal_tick_le(s->timeout_tick, tick)) {
+            s->timeout_tick = 0;
+            us_dispatch_timeout(s);
+            /* Closed, or adopted into a new block that starts with no timeouts. */
+            if (us_socket_is_closed(s)) continue;
+        }
+        if (s->long_timeout_tick && us_internal_tick_le(s->long_timeout_tick, tick)) {
+            s->long_timeout_tick = 0;
+            us_dispatch_long_timeout(s);
+            if (us_socket_is_closed(s)) continue;
+        }
+        /* Files whatever is still armed (including a deadline a handler just
+         * set, which already linked it: update is idempotent). */
+        us_internal_socket_timeout_update(s);
+    }
+}
+
+/* The first tick with work on it: a level-0 bucket to expire or a bucket
+ * above that to cascade. Returns 0 when the wheel is empty. */
+static int us_internal_timeout_wheel_next_tick(struct us_internal_timeout_wheel_t *wheel, uint32_t *next) {
+    if (!wheel->count) {
+        return 0;
+    }
+    int found = 0;
+    for (int level = 0; level < US_TIMEOUT_WHEEL_LEVELS; level++) {
+        unsigned shift = US_TIMEOUT_WHEEL_BITS * level;
+        uint32_t base = wheel->tick >> shift;
+        uint32_t index = base & US_TIMEOUT_WHEEL_MASK;
+        /* Whether this level's current bucket already cascaded (we are past the
+         * start of its span). Level 0's bucket at `tick` never has. */
+        int current_done = (wheel->tick & ((1u << shift) - 1)) != 0;
+        uint64_t bits = wheel->occupied[level];
+        /* Visit buckets in the order they come up, starting at `index`. */
+        uint64_t rotated = index ? (bits >> index) | (bits << (US_TIMEOUT_WHEEL_SLOTS - index)) : bits;
+        while (rotated) {
+            unsigned j = (unsigned) __builtin_ctzll(rotated);
+            rotated &= rotated - 1;
+            unsigned slot = (index + j) & US_TIMEOUT_WHEEL_MASK;
+            if (us_internal_timeout_list_empty(&wheel->buckets[level][slot])) {
+                wheel->occupied[level] &= ~(1ull << slot);
+                continue;
+            }
+            uint32_t at = (j == 0 && current_done) ? (base + US_TIMEOUT_WHEEL_SLOTS) << shift : (base + j) << shift;
+            if (!found || !us_internal_tick_le(*next, at)) {
+                *next = at;
+                found = 1;
+            }
+            /* Later buckets on this level only come up later. */
+            if (j) break;
+        }
+    }
+    return found;
+}
+
+void us_internal_timer_sweep(struct us_loop_t *loop) {
+    struct us_internal_timeout_wheel_t *wheel = loop->data.timeout_wheel;
+    if (!wheel) {
+        return;
+    }
+    uint32_t now = us_internal_timeout_clock_tick(loop);
+    /* wheel->tick is re-read every step: a handler that spins the loop runs a
+     * nested sweep, which may have advanced it already. */
+    while (us_internal_tick_le(wheel->tick, now)) {
+        if (!wheel->count) {
+            wheel->tick = now + 1;
+            break;
+        }
+        uint32_t index = wheel->tick & US_TIMEOUT_WHEEL_MASK;
+        if (!index) {
+            for (int level = 1; level < US_TIMEOUT_WHEEL_LEVELS; level++) {
+                if (us_internal_timeout_wheel_cascade(wheel, level)) break;
+            }
+        }
+        us_internal_timeout_list_splice(&wheel->buckets[0][index], &wheel->expiring);
+        wheel->occupied[0] &= ~(1ull << index);
+        uint32_t tick = wheel->tick++;
+        us_internal_timeout_wheel_expire(wheel, tick);
+    }
+
+#ifndef LIBUS_USE_LIBUV
+    uint32_t next;
+    loop->data.sweep_next_tick_ns = us_internal_timeout_wheel_next_tick(wheel, &next)
+        ? (long long) next * US_TIMEOUT_WHEEL_TICK_NS
+        : -1;
+#endif
+}
@@ -40,6 +40,10 @@ int us_udp_packet_buffer_truncated(struct us_udp_packet_buffer_t *buf, int index
     return bsd_udp_packet_buffer_truncated((struct udp_recvbuf *)buf, index);
 }
 
+int us_udp_packet_buffer_segment_size(struct us_udp_packet_buffer_t *buf, int index) {
+    return bsd_udp_packet_buffer_segment_size((struct udp_recvbuf *)buf, index);
+}
+
 int us_udp_socket_send(struct us_udp_socket_t *s, void** payloads, size_t* lengths, void** addresses, int num) {
     if (num == 0) return 0;
     int fd = us_poll_fd((struct us_poll_t *) s);
@@ -49,6 +49,7 @@ namespace uWS {
 /* An app is a convenience wrapper of some of the most used fuctionalities and allows a
  * builder-pattern kind of init. Apps operate on the implicit thread local Loop */
 
+#include "BroadcastGroup.h"
 #include "HttpContext.h"
 #include "HttpResponse.h"
 #include "WebSocketContext.h"
@@ -86,6 +87,9 @@ namespace uWS {
         int allow_partial_trust_chain = 0;
         const char *sigalgs = nullptr;
         const char *ecdh_curve = nullptr;
+        const char *ticket_keys_file = nullptr;
+        unsigned int handshake_threads = 0;
+        int early_data = 0;
 
         /* Conversion operator used internally */
         operator struct us_bun_socket_context_options_t() const {
@@ -133,6 +137,8 @@ public:
 
     TopicTree<TopicTreeMessage, TopicTreeBigMessage> *topicTree = nullptr;
 
+    /* Our membership in a cross-thread BroadcastGroup, if any */
+    BroadcastMember *broadcastMember = nullptr;
 
     /* Server name */
     TemplatedApp &&addServerName(const std::string &hostname_pattern, SocketContextOptions options = {}, bool *success = nullptr, bool applyClientCertPolicy = false) {
@@ -207,6 +213,38 @@ public:
         return std::move(*this);
     }
 
+    /* Server handshakes summed over the app's SSL_CTX and every server name's */
+    us_ssl_ctx_session_stats_t tlsSessionStats() {
+        us_ssl_ctx_session_stats_t total = {};
+        if constexpr (SSL) {
+            auto add = [&](struct ssl_ctx_st *ctx) {
+                us_ssl_ctx_session_stats_t stats;
+                us_ssl_ctx_session_stats(ctx, &stats);
+                total.resumed_handshakes += stats.resumed_handshakes;
+                total.full_handshakes += stats.full_handshakes;
+                total.ticket_key_reloads += stats.ticket_key_reloads;
+                total.ticket_key_errors += stats.ticket_key_errors;
+                total.early_data += stats.early_data;
+                total.too_early += stats.too_early;
+                total.ticket_keys += stats.ticket_keys;
+            };
+            add(sslCtx);
+            for (auto &serverName : pendingServerNames) {
+                add(serverName.ctx);
+            }
+        }
+        return total;
+    }
+
+    /* Connections whose SYN carried data, over the app's open listeners */
+    unsigned long long fastOpenConnections() {
+        unsigned long long total = 0;
+        forEachListenSocket([&](struct us_listen_socket_t *ls) {
+            total += us_listen_socket_fast_open_count(ls);
+        });
+        return total;
+    }
+
     /* Returns the SSL_CTX* of this app, or nullptr. */
     void *getNativeHandle() {
         return sslCtx;
@@ -232,34 +270,60 @@ public:
      * Returns the worst subscriber SendStatus; no subscribers is DROPPED,
      * then BACKPRESSURE beats SUCCESS. */
     PublishStatus publish(std::string_view topic, std::string_view message, OpCode opCode, bool compress = false) {
-        /* Anything big bypasses corking efforts */
-        if (message.length() >= LoopData::CORK_BUFFER_SIZE) {
-            PublishStatus worst = PublishStatus::SUCCESS;
-            bool hasReceivers = false;
-            topicTree->publishBig(nullptr, topic, {message, opCode, compress}, [&worst, &hasReceivers](Subscriber *s, TopicTreeBigMessage &message) {
-                hasReceivers = true;
-                auto *ws = (WebSocket<SSL, true, int> *) s->user;
+        return (PublishStatus) WebSocket<SSL, true, int>::publishFrame(topicTree, nullptr, topic, message, opCode, compress, (LoopData *) us_loop_ext((us_loop_t *) Loop::get()));
+    }
 
-                /* Send will drain if needed */
-                worst = WebSocket<SSL, true, int>::worseStatus(worst, (PublishStatus) ws->send(message.message, (OpCode)message.opCode, message.compress));
+    /* Bounds the windows held by POOLED_COMPRESSOR sockets on this loop. Call after ws() */
+    TemplatedApp &&setDeflationPoolCapacity(unsigned int capacity) {
+        if (DeflationPool *deflationPool = Loop::data((us_loop_t *) Loop::get())->deflationPool) {
+            deflationPool->setCapacity(capacity);
+        }
+        return std::move(*this);
+    }
+
+    DeflationPoolStats deflationPoolStats() {
+        if (DeflationPool *deflationPool = Loop::data((us_loop_t *) Loop::get())->deflationPool) {
+            return deflationPool->getStats();
+        }
+        return {};
+    }
+
+    /* Joins the process-wide broadcast group of this name, so that publishes
+     * made through this app also reach subscribers of apps on other threads
+     * (Workers) in the same group, and theirs reach ours. Rejoining under
+     * another name switches groups; an empty name leaves. Call after ws(). */
+    TemplatedApp &&joinBroadcastGroup(std::string_view name) {
+        if (broadcastMember && broadcastMember->groupName() == name) {
+            return std::move(*this);
+        }
+        leaveBroadcastGroup();
+        if (name.empty() || !topicTree) {
+            return std::move(*this);
+        }
+
+        broadcastMember = BroadcastGroup::join(name, (us_loop_t *) Loop::get());
+        topicTree->broadcastMember = broadcastMember;
+
+        /* Frames from other threads are published into our TopicTree like
+         * our own, minus the sender exclusion */
+        Loop::get()->addPreHandler(broadcastMember, [broadcastMember = broadcastMember, topicTree = topicTree](Loop */*loop*/) {
+            broadcastMember->drain([topicTree](const std::shared_ptr<const BroadcastFrame> &frame) {
+                topicTree->publish(nullptr, frame->topic, {frame});
             });
-            return hasReceivers ? worst : PublishStatus::DROPPED;
-        } else {
-            Topic *t = topicTree->lookupTopic(topic);
-            if (!t) {
-                return PublishStatus::DROPPED;
-            }
-            topicTree->publish(nullptr, topic, {std::string(message), opCode, compress});
-            /* publish() may have synchronously drained a subscriber; check backpressure after. */
-            PublishStatus worst = PublishStatus::SUCCESS;
-            bool hasReceivers = false;
-            for (Subscriber *s : *t) {
-                hasReceivers = true;
-                auto *ws = (WebSocket<SSL, true, int> *) s->user;
-                worst = WebSocket<SSL, true, int>::worseStatus(worst, (PublishStatus) ws->sendStatus());
-            }
-            return hasReceivers ? worst : PublishStatus::DROPPED;
+        });
+        return std::move(*this);
+    }
+
+    void leaveBroadcastGroup() {
+        if (!broadcastMember) {
+            return;
+        }
+        Loop::get()->removePreHandler(broadcastMember);
+        if (topicTree) {
+            topicTree->broadcastMember = nullptr;
         }
+        BroadcastGroup::leave(broadcastMember);
+        broadcastMember = nullptr;
     }
 
     /* Returns number of subscribers for this topic, or 0 for failure.
@@ -302,6 +366,8 @@ public:
             us_internal_ssl_ctx_unref(sslCtx);
         }
 
+        leaveBroadcastGroup();
+
         /* Delete TopicTree */
         if (topicTree) {
             /* And unregister loop callbacks */
@@ -466,8 +532,11 @@ public:
                     }
                 }
 
+                /* Framed once by the publisher, for every subscriber */
+                auto status = ws->sendFrame(message.frame);
+
                 /* If we ever overstep maxBackpresure, exit immediately */
-                if (WebSocket<SSL, true, int>::SendStatus::DROPPED == ws->send(message.message, (OpCode)message.opCode, message.compress)) {
+                if (WebSocket<SSL, true, int>::SendStatus::DROPPED == status) {
                     if (needsUncork) {
                         ((AsyncSocket<SSL> *)ws)->uncork();
                         needsUncork = false;
@@ -528,6 +597,11 @@ public:
                 loopData->inflationStream = new InflationStream(CompressOptions::DEDICATED_DECOMPRESSOR);
                 loopData->deflationStream = new DeflationStream(CompressOptions::DEDICATED_COMPRESSOR);
             }
+
+            /* Sockets of every route on this loop lease from the same pool */
+            if ((behavior.compression & CompressOptions::POOLED_COMPRESSOR) && !loopData->deflationPool) {
+                loopData->deflationPool = new DeflationPool;
+            }
         }
 
         /* Copy all handlers */
@@ -104,10 +104,23 @@ public:
     void uncorkWithoutSending() {
         /* Called from close/destroy paths. Removes this socket from any cork
          * slot to prevent the drain loop from dereferencing a freed pointer. */
-        getLoopData()->unborrowCorkSlot(this);
+        LoopData *loopData = getLoopData();
+        loopData->unborrowCorkSlot(this);
+        loopData->dropPipelineBatch(this);
+    }
+
+    /* Moves the bytes batched for this socket into its backpressure buffer,
+     * ahead of whatever is still corked. The buffer is empty while batching:
+     * only corked writes join a batch. */
+    void unbatch() {
+        LoopData *loopData = getLoopData();
+        if (loopData->pipelineBatch.socket != this) return;
+        std::string &bytes = loopData->pipelineBatch.bytes;
+        getAsyncSocketData()->buffer.append(bytes.data(), bytes.length());
+        loopData->dropPipelineBatch(this);
     }
 
-    /* Cork this socket. Two sockets may be corked per-loop at once. */
+    /* Cork this socket. Up to LoopData::MAX_CORK_SLOTS sockets may be corked per-loop at once. */
     void cork() {
         LoopData *loopData = getLoopData();
 
@@ -116,15 +129,14 @@ public:
             return;
         }
 
-        /* Grab a free slot. */
+        /* Grab a free slot, growing the pool if it is still under budget. */
         if (loopData->acquireCorkSlot(this, SSL) != LoopData::INVALID_CORK_SLOT) {
             return;
         }
 
-        /* Both slots hold data from other sockets. Force-uncork the least
-         * recently used one to make room. */
-        int victimSlot = loopData->getLRUCorkSlot();
-        auto *vs = loopData->getCorkSlot(victimSlot);
+        /* Every slot holds data from other sockets and the pool is at its
+         * budget. Force-uncork the least recently used one to make room. */
+        auto *vs = loopData->evictCorkSlot();
         void *victim = vs->socket;
         bool victimSsl = vs->ssl;
         if (victimSsl) {
@@ -165,18 +177,19 @@ public:
             unsigned int ourCorkOffset = 0;
             char *ourCorkBuffer = nullptr;
             if (corked) {
+                unbatch();
                 auto *s = loopData->getCorkSlot(slot);
                 ourCorkOffset = s->offset;
                 ourCorkBuffer = s->buffer;
                 s->offset = 0;
             }
 
-            backPressure.resize(ourCorkOffset + existingBackpressure + size);
+            char *sendBuffer = backPressure.grow(ourCorkOffset + size);
 
             if (ourCorkOffset > 0) {
-                memcpy((char *) backPressure.data() + existingBackpressure, ourCorkBuffer, ourCorkOffset);
+                memcpy(sendBuffer, ourCorkBuffer, ourCorkOffset);
             }
-            return {(char *) backPressure.data() + ourCorkOffset + existingBackpressure, SendBufferAttribute::NEEDS_DRAIN};
+            return {sendBuffer + ourCorkOffset, SendBufferAttribute::NEEDS_DRAIN};
         }
     }
 
@@ -196,6 +209,11 @@ public:
      * JS-exposed bufferedAmount stay a plaintext count. */
     bool hasFullyDrained() {
         if (getAsyncSocketData()->buffer.length()) return false;
+        LoopData::PipelineBatch &batch = getLoopData()->pipelineBatch;
+        if (batch.socket == this && !batch.bytes.empty()) return false;
+        /* MSG_ZEROCOPY sends still read from pinned caller memory until the
+         * kernel completes them; closing before that would release it early. */
+        if (us_socket_zerocopy_pending((us_socket_t *) this)) return false;
         if constexpr (SSL) {
             return us_socket_ssl_spill_pending((us_socket_t *) this) == 0;
         }
@@ -255,39 +273,25 @@ public:
 
         /* Continue flushing as long as we have data in the buffer */
         while (asyncSocketData->buffer.length()) {
-            /* Get current buffer size */
-            size_t buffer_len = asyncSocketData->buffer.length();
+            /* The buffer may continue in referenced frames; write one contiguous run at a time */
+            std::string_view front = asyncSocketData->buffer.front();
 
             /* Limit write size to INT_MAX as the underlying socket API uses int for length */
-            int max_flush_len = std::min(buffer_len, (size_t)INT_MAX);
+            int max_flush_len = std::min(front.length(), (size_t)INT_MAX);
 
             /* Attempt to write data to the socket */
-            int written = us_socket_write((us_socket_t *) this, asyncSocketData->buffer.data(), max_flush_len);
+            int written = us_socket_write((us_socket_t *) this, front.data(), max_flush_len);
             total_written += written;
 
-            /* Check if we couldn't write the entire buffer */
-            if ((unsigned int) written < buffer_len) {
-                /* Remove the successfully written data from the buffer */
-                asyncSocketData->buffer.erase((size_t) written);
-
-                /* If we wrote less than we attempted, the socket buffer is likely full
-                * likely is used as an optimization hint to the compiler
-                * since written < buffer_len is very likely to be true
-                */
-                if(written < max_flush_len) {
-                    [[likely]]
-                    /* Cannot write more at this time, return what we've written so far */
-                    return total_written;
-                }
-                /* If we wrote exactly max_flush_len, we might be able to write more, so continue
-                 * This is unlikely to happen, because this would be INT_MAX bytes, which is unlikely to be written in one go
-                 * but we keep this check for completeness
-                 */
-                continue;
-            }
+            /* Remove the successfully written data from the buffer */
+            asyncSocketData->buffer.erase((size_t) written);
 
-            /* Successfully wrote the entire buffer, clear the buffer */
-            asyncSocketData->buffer.clear();
+            /* If we wrote less than we attempted, the socket buffer is likely full */
+            if (written < max_flush_len) {
+                [[likely]]
+                /* Cannot write more at this time, return what we've written so far */
+                return total_written;
+            }
         }
 
         /* Return the total number of bytes written during this flush operation */
@@ -307,17 +311,10 @@ public:
         AsyncSocketData<SSL> *asyncSocketData = getAsyncSocketData();
         /* We are limited if we have a per-socket buffer */
         if (asyncSocketData->buffer.length()) {
-            size_t buffer_len = asyncSocketData->buffer.length();
-            // we cannot not flush more than INT_MAX bytes at a time
-            int max_flush_len = std::min(buffer_len, (size_t)INT_MAX);
-
             /* Write off as much as we can */
-            int written = us_socket_write((us_socket_t *) this, asyncSocketData->buffer.data(), max_flush_len);
+            flush();
             /* On failure return, otherwise continue down the function */
-            if ((unsigned int) written < buffer_len) {
-                /* Update buffering (todo: we can do better here if we keep track of what happens to this guy later on) */
-                asyncSocketData->buffer.erase((size_t) written);
-
+            if (asyncSocketData->buffer.length()) {
                 if (optionally) {
                     /* Thankfully we can exit early here */
                     return {0, true};
@@ -327,9 +324,6 @@ public:
                     return {length, true};
                 }
             }
-
-            /* At this point we simply have no buffer and can continue as normal */
-            asyncSocketData->buffer.clear();
         }
 
         if (length) {
@@ -344,6 +338,8 @@ public:
                     ASSERT(s->offset <= LoopData::CORK_BUFFER_SIZE);
                     loopData->touchCorkSlot(slot);
                     /* Fall through to default return */
+                } else if (batchCorked(slot, src, length)) {
+                    /* Held for the write at the end of this read */
                 } else {
                     /* Chunk doesn't fit; flush cork + write the rest. */
                     return uncork(src, length, optionally);
@@ -378,6 +374,154 @@ public:
         return {length, false};
     }
 
+    /* Chunks below this go through write(): for them the copy is cheaper than
+     * pinning pages and collecting the completion. */
+    static constexpr int ZEROCOPY_MIN_LENGTH = 64 * 1024;
+
+    /* Like write(), but a large chunk on plain TCP is sent with MSG_ZEROCOPY
+     * straight from src, which pin keeps alive until the kernel completes the
+     * send (see releaseCompletedZeroCopy). Whatever cannot be sent now is left
+     * to the caller when optionally, and copied to the backpressure buffer
+     * otherwise, exactly like write(). */
+    std::pair<int, bool> writeZeroCopy(const char *src, int length, const ZeroCopyPin &pin, bool optionally = false) {
+        if (length < ZEROCOPY_MIN_LENGTH || us_socket_is_closed((us_socket_t *) this)) {
+            return write(src, length, optionally);
+        }
+
+        /* Corked and buffered bytes go out first to keep the stream in order. */
+        AsyncSocketData<SSL> *asyncSocketData = getAsyncSocketData();
+        uncork();
+        if (asyncSocketData->buffer.length()) {
+            flush();
+        }
+        if (asyncSocketData->buffer.length()) {
+            return write(src, length, optionally);
+        }
+
+        unsigned int id = 0;
+        int written = us_socket_write_zerocopy((us_socket_t *) this, src, length, &id);
+        if (written < 0) {
+            return write(src, length, optionally);
+        }
+        if (written > 0) {
+            asyncSocketData->zeroCopyPins.add(pin, id);
+        }
+        if (written < length) {
+            if (optionally) {
+                return {written, true};
+            }
+            asyncSocketData->buffer.append(src + written, (size_t) (length - written));
+            return {length, true};
+        }
+        return {length, false};
+    }
+
+    /* Like write(), but bytes that owner keeps alive and many sockets send (a
+     * published frame) are referenced from the backpressure buffer instead of
+     * copied into it when they cannot all be sent now. Corked bytes go out
+     * first, so this suits frames larger than the cork buffer. */
+    template <typename T>
+    std::pair<int, bool> writeShared(const std::shared_ptr<T> &owner, std::string_view bytes) {
+        int length = (int) bytes.length();
+        if (us_socket_is_closed((us_socket_t *) this)) {
+            return {length, false};
+        }
+
+        AsyncSocketData<SSL> *asyncSocketData = getAsyncSocketData();
+        uncork();
+        if (asyncSocketData->buffer.length()) {
+            flush();
+        }
+        if (asyncSocketData->buffer.length()) {
+            asyncSocketData->buffer.appendShared(owner, bytes);
+            return {length, true};
+        }
+
+        int written = us_socket_write((us_socket_t *) this, bytes.data(), length);
+        if (written < length) {
+            asyncSocketData->buffer.appendShared(owner, bytes.substr((size_t) std::max(written, 0)));
+            return {length, true};
+        }
+        return {length, false};
+    }
+
+    /* Drop the pins of zerocopy sends the kernel has completed. */
+    void releaseCompletedZeroCopy() {
+        AsyncSocketData<SSL> *asyncSocketData = getAsyncSocketData();
+        if (!asyncSocketData->zeroCopyPins.empty()) {
+            asyncSocketData->zeroCopyPins.release(us_socket_zerocopy_done((us_socket_t *) this));
+        }
+    }
+
+    /* Whether HttpContext is parsing a read of this socket with its pipeline
+     * batch open. The uncork after the parse then writes every response to
+     * that read at once, so a response ending inside the parse stays corked. */
+    bool isPipelineBatchOpen() {
+        LoopData::PipelineBatch &batch = getLoopData()->pipelineBatch;
+        return batch.socket == this && batch.open;
+    }
+
+    /* A corked write that does not fit the slot while this socket's pipeline
+     * batch is open: the slot's bytes join the batch and the chunk takes the
+     * emptied slot (or joins too, when larger). Returns false when the batch
+     * is not ours, closed, or full. */
+    bool batchCorked(int slot, const char *src, int length) {
+        LoopData *loopData = getLoopData();
+        LoopData::PipelineBatch &batch = loopData->pipelineBatch;
+        auto *s = loopData->getCorkSlot(slot);
+        if (batch.socket != this || !batch.open ||
+            batch.bytes.length() + s->offset + (size_t) length > LoopData::PIPELINE_BATCH_MAX) {
+            return false;
+        }
+        batch.bytes.append(s->buffer, s->offset);
+        s->offset = 0;
+        if ((unsigned int) length <= LoopData::CORK_BUFFER_SIZE) {
+            memcpy(s->buffer, src, (unsigned int) length);
+            s->offset = (unsigned int) length;
+        } else {
+            batch.bytes.append(src, (size_t) length);
+        }
+        loopData->touchCorkSlot(slot);
+        return true;
+    }
+
+    /* Writes this socket's pipeline batch followed by tail (its cork buffer).
+     * On TCP both go out in one writev without joining them; TLS gets them
+     * as one write, which it sends as one batch of records. Same return
+     * convention as write(). */
+    std::pair<int, bool> writeBatch(const char *tail, unsigned int tailLength) {
+        LoopData *loopData = getLoopData();
+        LoopData::PipelineBatch &batch = loopData->pipelineBatch;
+        loopData->corkStats.pipelineBatches++;
+        std::pair<int, bool> result;
+
+        if constexpr (!SSL) {
+            BackPressure &backPressure = getAsyncSocketData()->buffer;
+            if (!backPressure.length() && !us_socket_is_closed((us_socket_t *) this)) {
+                size_t head = batch.bytes.length();
+                int length = (int) (head + tailLength);
+                us_iovec_t iov[2] = {{batch.bytes.data(), head}, {(void *) tail, tailLength}};
+                size_t written = (size_t) us_socket_raw_writev((us_socket_t *) this, iov, tailLength ? 2 : 1);
+                if (written < head) {
+                    backPressure.append(batch.bytes.data() + written, head - written);
+                    backPressure.append(tail, tailLength);
+                } else {
+                    backPressure.append(tail + (written - head), head + tailLength - written);
+                }
+                result = {length, written < (size_t) length};
+                batch.bytes.clear();
+                if (!batch.open) batch.socket = nullptr;
+                return result;
+            }
+        }
+
+        batch.bytes.append(tail, tailLength);
+        result = write(batch.bytes.data(), (int) batch.bytes.length());
+        batch.bytes.clear();
+        if (!batch.open) batch.socket = nullptr;
+        return result;
+    }
+
     /* Uncork this socket and flush or buffer any corked and/or passed data. It is essential to remember doing this. */
     /* It does NOT count bytes written from cork buffer (they are already accounted for in the write call responsible for its corking)! */
     std::pair<int, bool> uncork(const char *src = nullptr, int length = 0, bool optionally = false) {
@@ -394,9 +538,10 @@ public:
         char *buffer = s->buffer;
         loopData->releaseCorkSlot(slot);
 
-        if (offset) {
+        bool batched = loopData->pipelineBatch.socket == this && !loopData->pipelineBatch.bytes.empty();
+        if (offset || batched) {
             /* Corked data is already accounted for via its write call */
-            auto [written, failed] = write(buffer, (int) offset, false, length);
+            auto [written, failed] = batched ? writeBatch(buffer, offset) : write(buffer, (int) offset, false, length);
 
             if (failed && optionally) {
                 /* We do not need to care for buffering here, write does that */
@@ -25,74 +25,148 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace uWS {
 
 /* Contiguous buffer with a moving head cursor: erase() bumps head,
- * append()/resize() compact into the drained head gap before growing, so
- * draining never memmoves or reallocates. */
+ * append()/grow() compact into the drained head gap before growing, so
+ * draining never memmoves or reallocates. Bytes owned by someone else (a
+ * published frame shared by many sockets) are queued by reference behind it
+ * with appendShared() instead of being copied. */
 struct BackPressure {
     BackPressure() = default;
     BackPressure(BackPressure &&other) noexcept
-        : buf(other.buf), head(other.head), tail(other.tail), cap(other.cap) {
+        : buf(other.buf), head(other.head), tail(other.tail), cap(other.cap),
+          shared(other.shared), sharedLength(other.sharedLength) {
         other.buf = nullptr;
         other.head = other.tail = other.cap = 0;
+        other.shared = nullptr;
+        other.sharedLength = 0;
     }
     BackPressure(const BackPressure &) = delete;
     BackPressure &operator=(const BackPressure &) = delete;
-    ~BackPressure() { us_free(buf); }
+    ~BackPressure() {
+        us_free(buf);
+        delete shared;
+    }
 
-    /* Unsent bytes. data() points at length() contiguous bytes. */
-    size_t length() const { return tail - head; }
+    /* Unsent bytes, copied or referenced */
+    size_t length() const { return tail - head + sharedLength; }
     size_t size() const { return length(); }
-    const char *data() const { return buf + head; }
-    /* Allocation footprint for memoryCost / GC reporting. */
+    /* The first contiguous run of unsent bytes; write this, then erase() what went out */
+    std::string_view front() const {
+        if (tail > head) return {buf + head, tail - head};
+        if (shared) return shared->front().bytes;
+        return {};
+    }
+    /* Allocation footprint for memoryCost / GC reporting. Referenced bytes
+     * belong to their owner. */
     size_t totalLength() const { return cap; }
 
     void append(const char *src, size_t n) {
         if (!n) return;
+        if (shared) {
+            /* Stay behind what is already referenced */
+            auto owned = std::make_shared<std::string>(src, n);
+            pushShared(owned, *owned);
+            return;
+        }
         ensureTailRoom(n);
         std::memcpy(buf + tail, src, n);
         tail += n;
     }
 
+    /* Queues bytes that owner keeps alive, without copying them. Short runs
+     * are cheaper to copy than to reference. */
+    template <typename T>
+    void appendShared(const std::shared_ptr<T> &owner, std::string_view bytes) {
+        if (bytes.length() < SHARED_MIN_LENGTH) {
+            append(bytes.data(), bytes.length());
+            return;
+        }
+        pushShared(owner, bytes);
+    }
+
+    /* Drops n bytes, at most front().length(), from the front */
     void erase(size_t n) {
-        head += n;
-        if (head >= tail) {
-            /* Fully drained: next append writes at offset 0 with no memmove. */
-            head = tail = 0;
-            release();
+        if (tail > head) {
+            head += n;
+            if (head >= tail) {
+                /* Fully drained: next append writes at offset 0 with no memmove. */
+                head = tail = 0;
+                release();
+            }
+            return;
+        }
+        if (!shared) return;
+        SharedChunk &chunk = shared->front();
+        chunk.bytes.remove_prefix(n);
+        sharedLength -= n;
+        if (chunk.bytes.empty()) {
+            shared->pop_front();
+            if (shared->empty()) {
+                delete shared;
+                shared = nullptr;
+            }
         }
     }
 
     void clear() {
         head = tail = 0;
         release();
+        delete shared;
+        shared = nullptr;
+        sharedLength = 0;
     }
 
     /* Make room for at least n live bytes without later realloc. */
     void reserve(size_t n) {
-        if (n > length()) ensureTailRoom(n - length());
+        if (!shared && n > length()) ensureTailRoom(n - length());
     }
 
-    /* Grow to n live bytes; caller writes into data() + old length(). */
-    void resize(size_t n) {
-        size_t live = length();
-        if (n > live) {
-            ensureTailRoom(n - live);
-            tail += n - live;
-        } else {
-            tail = head + n;
+    /* Appends n bytes for the caller to write into the returned pointer. */
+    char *grow(size_t n) {
+        if (shared) {
+            auto owned = std::make_shared<std::string>(n, '\0');
+            char *bytes = owned->data();
+            pushShared(owned, *owned);
+            return bytes;
         }
+        ensureTailRoom(n);
+        tail += n;
+        return buf + tail - n;
     }
 
 private:
     static constexpr size_t MIN_CAPACITY = 4096;
+    static constexpr size_t SHARED_MIN_LENGTH = 1024;
+
+    struct SharedChunk {
+        std::shared_ptr<const void> owner;
+        std::string_view bytes;
+    };
 
     char *buf = nullptr;
     size_t head = 0;
     size_t tail = 0;
     size_t cap = 0;
+    /* Referenced runs, in order after buf. Heap-allocated on first use so
+     * sockets that never publish pay one pointer. */
+    std::deque<SharedChunk> *shared = nullptr;
+    size_t sharedLength = 0;
+
+    template <typename T>
+    void pushShared(const std::shared_ptr<T> &owner, std::string_view bytes) {
+        if (!bytes.length()) return;
+        if (!shared) shared = new std::deque<SharedChunk>();
+        shared->push_back({owner, bytes});
+        sharedLength += bytes.length();
+    }
 
     /* Ensure [tail, tail+n) is writable. Prefers compacting into the drained
      * head gap over growing so steady-state producer/consumer never reallocs. */
@@ -135,12 +209,80 @@ private:
     }
 };
 
+/* A caller-owned buffer that MSG_ZEROCOPY sends keep reading from after the
+ * write returns. ref/deref hold it alive until the kernel is done with it. */
+struct ZeroCopyPin {
+    void *ctx = nullptr;
+    void (*ref)(void *) = nullptr;
+    void (*deref)(void *) = nullptr;
+};
+
+/* The pins a socket holds, oldest first, each with the id of the last
+ * zerocopy send that reads from it. Heap-allocated on first use so sockets
+ * that never send zero-copy pay one pointer. */
+struct ZeroCopyPins {
+    ZeroCopyPins() = default;
+    ZeroCopyPins(const ZeroCopyPins &) = delete;
+    ZeroCopyPins &operator=(const ZeroCopyPins &) = delete;
+    /* The socket is gone. us_socket_close resets a socket that still has
+     * zerocopy sends outstanding, so the kernel has discarded what it had
+     * not sent from these buffers. */
+    ~ZeroCopyPins() { releaseAll(); }
+
+    bool empty() const { return !entries || entries->empty(); }
+
+    /* Send `id` reads from pin's buffer. Consecutive sends from one buffer
+     * (a tryEnd retried from onWritable) share one ref. */
+    void add(const ZeroCopyPin &pin, unsigned int id) {
+        if (!entries) entries = new std::vector<Entry>();
+        if (!entries->empty() && entries->back().pin.ctx == pin.ctx) {
+            entries->back().lastId = id;
+            return;
+        }
+        pin.ref(pin.ctx);
+        entries->push_back({pin, id});
+    }
+
+    /* Drop the pins whose sends all have ids below `done`. */
+    void release(unsigned int done) {
+        if (!entries) return;
+        size_t n = 0;
+        /* Ids wrap at 2^32; compare by distance. */
+        while (n < entries->size() && (int) ((*entries)[n].lastId - done) < 0) n++;
+        if (!n) return;
+        std::vector<Entry> finished(entries->begin(), entries->begin() + (std::ptrdiff_t) n);
+        entries->erase(entries->begin(), entries->begin() + (std::ptrdiff_t) n);
+        if (entries->empty()) {
+            delete entries;
+            entries = nullptr;
+        }
+        for (Entry &e : finished) e.pin.deref(e.pin.ctx);
+    }
+
+    void releaseAll() {
+        std::vector<Entry> *finished = entries;
+        entries = nullptr;
+        if (!finished) return;
+        for (Entry &e : *finished) e.pin.deref(e.pin.ctx);
+        delete finished;
+    }
+
+private:
+    struct Entry {
+        ZeroCopyPin pin;
+        unsigned int lastId;
+    };
+    std::vector<Entry> *entries = nullptr;
+};
+
 /* Depending on how we want AsyncSocket to function, this will need to change */
 
 template <bool SSL>
 struct AsyncSocketData {
     /* This will do for now */
     BackPressure buffer;
+    /* Caller buffers that in-flight MSG_ZEROCOPY sends read from */
+    ZeroCopyPins zeroCopyPins;
 
     /* Allow move constructing us */
     AsyncSocketData(BackPressure &&backpressure) : buffer(std::move(backpressure)) {
@@ -0,0 +1,307 @@
+/*
+ * Authored by Alex Hultman, 2018-2021.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UWS_BROADCASTGROUP_H
+#define UWS_BROADCASTGROUP_H
+
+/* Cross-thread pub/sub: apps on different loops (one per Worker) that join
+ * the same named BroadcastGroup see each other's publishes. The publishing
+ * thread formats the WebSocket frame once (and deflates it once for shared
+ * compressor sockets) and hands a refcounted BroadcastFrame to every other
+ * member's ring; each member's loop drains its ring into its own TopicTree.
+ * Local publishes use the same BroadcastFrame, so a message is framed once
+ * however many subscribers receive it. */
+
+#include <atomic>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libusockets.h"
+#include "LoopData.h"
+#include "WebSocketProtocol.h"
+
+namespace uWS {
+
+struct BroadcastFrame {
+    std::string topic;
+    /* Complete unmasked server frame: header + payload */
+    std::string frame;
+    size_t messageLength;
+    /*OpCode*/ int opCode;
+    bool compress;
+
+private:
+    /* Same message deflated with a fresh window, or empty. Only valid for
+     * sockets on the shared compressor (no context takeover). Filled before
+     * the frame is posted to other threads, on first use otherwise */
+    mutable std::string deflatedFrame;
+    mutable bool deflated = false;
+
+public:
+    static std::shared_ptr<BroadcastFrame> create(std::string_view topic, std::string_view message, OpCode opCode, bool compress) {
+        auto frame = std::make_shared<BroadcastFrame>();
+        frame->topic = std::string(topic);
+        frame->frame.resize(protocol::messageFrameSize(message.length()));
+        frame->frame.resize(protocol::formatMessage<true>(frame->frame.data(), message.data(), message.length(), opCode, message.length(), false, true));
+        frame->messageLength = message.length();
+        frame->opCode = opCode;
+        frame->compress = compress;
+        return frame;
+    }
+
+    /* The payload, for sockets that compress with a window of their own */
+    std::string_view message() const {
+        return std::string_view(frame).substr(frame.length() - messageLength);
+    }
+
+    /* The frame deflated with the loop's shared compressor, once; empty when
+     * compression was not asked for or this loop has no compressor */
+    std::string_view deflate(LoopData *loopData) const {
+        if (!deflated) {
+            deflated = true;
+            if (compress && messageLength && opCode < 3 && loopData->deflationStream) {
+                std::string_view deflatedMessage = loopData->deflationStream->deflate(loopData->zlibContext, message(), true);
+                deflatedFrame.resize(protocol::messageFrameSize(deflatedMessage.length()));
+                deflatedFrame.resize(protocol::formatMessage<true>(deflatedFrame.data(), deflatedMessage.data(), deflatedMessage.length(), (OpCode) opCode, deflatedMessage.length(), true, true));
+            }
+        }
+        return deflatedFrame;
+    }
+};
+
+/* Bounded multi-producer single-consumer ring (Vyukov's sequence-per-cell
+ * queue). Producers claim a cell with one CAS on tail; the consumer owns head. */
+struct BroadcastRing {
+    static constexpr size_t CAPACITY = 4096;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        std::shared_ptr<const BroadcastFrame> frame;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> tail = 0;
+    alignas(64) size_t head = 0;
+
+    BroadcastRing() : cells(new Cell[CAPACITY]) {
+        for (size_t i = 0; i < CAPACITY; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(const std::shared_ptr<const BroadcastFrame> &frame) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & (CAPACITY - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.frame = frame;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                /* Full */
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::shared_ptr<const BroadcastFrame> pop() {
+        Cell &cell = cells[head & (CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+            return nullptr;
+        }
+        std::shared_ptr<const BroadcastFrame> frame = std::move(cell.frame);
+        cell.sequence.store(head + CAPACITY, std::memory_order_release);
+        head++;
+        return frame;
+    }
+};
+
+struct BroadcastGroup;
+
+/* One app's (one loop's) membership in a group */
+struct BroadcastMember {
+    friend struct BroadcastGroup;
+
+private:
+    BroadcastGroup *group;
+    us_loop_t *loop;
+    BroadcastRing ring;
+
+    /* Coalesces wakeups: set by the first producer, cleared by drain() */
+    std::atomic<bool> wakeupPending = false;
+
+    /* Taken only when the ring is full. While overflowing, producers keep
+     * appending here; drain() empties the ring under the same lock before it
+     * takes the list, so frames from one producer stay in order. */
+    std::mutex overflowMutex;
+    std::vector<std::shared_ptr<const BroadcastFrame>> overflow;
+    std::atomic<bool> overflowing = false;
+
+    BroadcastMember(BroadcastGroup *group, us_loop_t *loop) : group(group), loop(loop) {}
+
+    /* Called by other threads, under the group's shared lock */
+    void post(const std::shared_ptr<const BroadcastFrame> &frame) {
+        if (overflowing.load(std::memory_order_acquire) || !ring.push(frame)) {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflowing.store(true, std::memory_order_release);
+            overflow.push_back(frame);
+        }
+        if (!wakeupPending.exchange(true, std::memory_order_acq_rel)) {
+            us_wakeup_loop(loop);
+        }
+    }
+
+public:
+    /* Runs on our loop: hands every queued frame to cb in arrival order */
+    template <typename F>
+    void drain(F &&cb) {
+        wakeupPending.store(false, std::memory_order_release);
+        while (std::shared_ptr<const BroadcastFrame> frame = ring.pop()) {
+            cb(frame);
+        }
+        if (overflowing.load(std::memory_order_acquire)) {
+            /* A producer may have pushed to the ring after another one set
+             * overflowing, and then appended its next frame to the list.
+             * Everything claimed in the ring before we took the lock is
+             * older than the list, so take all of it first, waiting out
+             * cells whose producer has not published them yet. */
+            std::vector<std::shared_ptr<const BroadcastFrame>> frames;
+            {
+                std::lock_guard<std::mutex> lock(overflowMutex);
+                size_t end = ring.tail.load(std::memory_order_acquire);
+                while (ring.head != end) {
+                    if (std::shared_ptr<const BroadcastFrame> frame = ring.pop()) {
+                        frames.push_back(std::move(frame));
+                    }
+                }
+                frames.insert(frames.end(), std::make_move_iterator(overflow.begin()), std::make_move_iterator(overflow.end()));
+                overflow.clear();
+                overflowing.store(false, std::memory_order_release);
+            }
+            for (auto &frame : frames) {
+                cb(frame);
+            }
+        }
+    }
+
+    /* Whether publishes would reach another member */
+    bool hasPeers() const;
+
+    /* Deflates the frame if asked and queues it for every other member.
+     * Returns whether there was any other member */
+    bool publish(const std::shared_ptr<const BroadcastFrame> &frame, LoopData *loopData);
+
+    std::string_view groupName() const;
+};
+
+struct BroadcastGroup {
+    friend struct BroadcastMember;
+
+private:
+    std::string name;
+    std::shared_mutex membersMutex;
+    std::vector<BroadcastMember *> members;
+    std::atomic<size_t> memberCount = 0;
+
+    static std::mutex &registryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::map<std::string, std::unique_ptr<BroadcastGroup>, std::less<>> &registry() {
+        static std::map<std::string, std::unique_ptr<BroadcastGroup>, std::less<>> groups;
+        return groups;
+    }
+
+public:
+    static BroadcastMember *join(std::string_view name, us_loop_t *loop) {
+        std::lock_guard<std::mutex> registryLock(registryMutex());
+        auto it = registry().find(name);
+        if (it == registry().end()) {
+            auto group = std::make_unique<BroadcastGroup>();
+            group->name = std::string(name);
+            it = registry().emplace(group->name, std::move(group)).first;
+        }
+
+        BroadcastGroup *group = it->second.get();
+        BroadcastMember *member = new BroadcastMember(group, loop);
+        std::unique_lock<std::shared_mutex> lock(group->membersMutex);
+        group->members.push_back(member);
+        group->memberCount.store(group->members.size(), std::memory_order_release);
+        return member;
+    }
+
+    /* Frames still queued for this member are dropped */
+    static void leave(BroadcastMember *member) {
+        std::lock_guard<std::mutex> registryLock(registryMutex());
+        BroadcastGroup *group = member->group;
+        bool empty;
+        {
+            std::unique_lock<std::shared_mutex> lock(group->membersMutex);
+            std::erase(group->members, member);
+            group->memberCount.store(group->members.size(), std::memory_order_release);
+            empty = group->members.empty();
+        }
+        delete member;
+        if (empty) {
+            std::string name = group->name;
+            registry().erase(name);
+        }
+    }
+};
+
+inline bool BroadcastMember::hasPeers() const {
+    return group->memberCount.load(std::memory_order_acquire) >= 2;
+}
+
+inline bool BroadcastMember::publish(const std::shared_ptr<const BroadcastFrame> &frame, LoopData *loopData) {
+    if (!hasPeers()) {
+        return false;
+    }
+
+    /* Shared compressor: one deflate with a reset window serves every member.
+     * Done before other threads can see the frame */
+    frame->deflate(loopData);
+
+    std::shared_lock<std::shared_mutex> lock(group->membersMutex);
+    for (BroadcastMember *member : group->members) {
+        if (member != this) {
+            member->post(frame);
+        }
+    }
+    return true;
+}
+
+inline std::string_view BroadcastMember::groupName() const {
+    return group->name;
+}
+
+}
+
+#endif // UWS_BROADCASTGROUP_H
@@ -0,0 +1,265 @@
+/*
+ * Authored by Alex Hultman, 2018-2021.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UWS_DEFLATIONPOOL_H
+#define UWS_DEFLATIONPOOL_H
+
+/* POOLED_COMPRESSOR: sockets lease a sliding-window DeflationStream from a
+ * bounded per-loop pool when they send a compressed message, instead of owning
+ * one for their whole life. When the pool is full the least recently used
+ * lease is taken over, and leases idle for too long are freed; either way the
+ * socket's next message starts from an empty window, which any client can
+ * decode (we simply stop referring back to earlier messages). Only compressors
+ * can be pooled: dropping an inflation window would break the client's
+ * back references. */
+
+#include "PerMessageDeflate.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace uWS {
+
+struct DeflationPoolStats {
+    /* Most windows alive at once */
+    uint32_t capacity;
+    /* Windows alive now, leased or spare */
+    uint32_t windows;
+    /* Sockets currently negotiated onto the pool */
+    uint32_t sockets;
+    /* Compressed sends that found their window still leased */
+    uint64_t hits;
+    /* Compressed sends that had to start from an empty window */
+    uint64_t misses;
+    /* Windows taken from a socket, because the pool was full or it idled */
+    uint64_t evictions;
+    /* zlib state held by those windows, by zlib's own sizing formula */
+    uint64_t windowBytes;
+};
+
+struct DeflationLease;
+
+struct DeflationPool {
+    static constexpr uint32_t DEFAULT_CAPACITY = 256;
+    /* In ticks of the per-second date timer */
+    static constexpr uint32_t IDLE_TICKS = 30;
+
+private:
+    /* Doubly linked, most recently used first */
+    DeflationLease *head = nullptr, *tail = nullptr;
+    /* Windows of sockets that closed since the last tick, ready for reuse */
+    DeflationLease *spare = nullptr;
+    uint32_t ticks = 0;
+    DeflationPoolStats stats = {DEFAULT_CAPACITY, 0, 0, 0, 0, 0, 0};
+
+    void link(DeflationLease *lease);
+    void unlink(DeflationLease *lease);
+    void destroy(DeflationLease *lease);
+    void evict(DeflationLease *lease);
+
+public:
+    DeflationPool() = default;
+    DeflationPool(const DeflationPool &) = delete;
+    ~DeflationPool();
+
+    /* Sockets on the pool register so we can report memory per connection */
+    void attach() {
+        stats.sockets++;
+    }
+
+    /* Gives the socket's window back. The slot is cleared */
+    void detach(DeflationLease *&slot);
+
+    /* The socket's window, leased now if it has none. A fresh or taken over
+     * window is reset, so the caller must not assume context */
+    DeflationStream *lease(DeflationLease *&slot, CompressOptions compressOptions);
+
+    /* Frees windows that were not used for IDLE_TICKS calls */
+    void tick();
+
+    void setCapacity(uint32_t capacity);
+
+    DeflationPoolStats getStats() const {
+        return stats;
+    }
+};
+
+struct DeflationLease {
+    std::unique_ptr<DeflationStream> stream;
+    CompressOptions compressOptions;
+    /* Cleared when the window is taken from its socket */
+    DeflationLease **owner = nullptr;
+    DeflationLease *prev = nullptr, *next = nullptr;
+    uint32_t lastUse = 0;
+
+    /* Memory usage is given by 2 ^ (windowBits + 2) + 2 ^ (memLevel + 9) */
+    static uint64_t windowBytes(CompressOptions compressOptions) {
+        unsigned int windowBits = (compressOptions & _COMPRESSOR_MASK) >> 4, memLevel = compressOptions & 0xF;
+        return (1ull << (windowBits + 2)) + (1ull << (memLevel + 9)) + sizeof(DeflationStream);
+    }
+};
+
+/* Every socket has detached by the time its loop goes away */
+inline DeflationPool::~DeflationPool() {
+    for (DeflationLease *list : {head, spare}) {
+        while (list) {
+            DeflationLease *lease = list;
+            list = list->next;
+            delete lease;
+        }
+    }
+}
+
+inline void DeflationPool::link(DeflationLease *lease) {
+    lease->prev = nullptr;
+    lease->next = head;
+    if (head) {
+        head->prev = lease;
+    } else {
+        tail = lease;
+    }
+    head = lease;
+}
+
+inline void DeflationPool::unlink(DeflationLease *lease) {
+    if (lease->prev) {
+        lease->prev->next = lease->next;
+    } else {
+        head = lease->next;
+    }
+    if (lease->next) {
+        lease->next->prev = lease->prev;
+    } else {
+        tail = lease->prev;
+    }
+    lease->prev = lease->next = nullptr;
+}
+
+/* Frees a lease that is no longer linked or owned */
+inline void DeflationPool::destroy(DeflationLease *lease) {
+    stats.windows--;
+    stats.windowBytes -= DeflationLease::windowBytes(lease->compressOptions);
+    delete lease;
+}
+
+/* Takes the window from its socket, leaving the lease unlinked */
+inline void DeflationPool::evict(DeflationLease *lease) {
+    unlink(lease);
+    if (lease->owner) {
+        *lease->owner = nullptr;
+        lease->owner = nullptr;
+    }
+    stats.evictions++;
+}
+
+inline void DeflationPool::detach(DeflationLease *&slot) {
+    stats.sockets--;
+    if (!slot) {
+        return;
+    }
+    DeflationLease *lease = slot;
+    slot = nullptr;
+    unlink(lease);
+    lease->owner = nullptr;
+
+    /* Closing sockets hand their window straight to the next one */
+    lease->next = spare;
+    spare = lease;
+}
+
+inline DeflationStream *DeflationPool::lease(DeflationLease *&slot, CompressOptions compressOptions) {
+    compressOptions = (CompressOptions) (compressOptions & _COMPRESSOR_MASK);
+
+    if (slot) {
+        DeflationLease *lease = slot;
+        lease->lastUse = ticks;
+        if (lease != head) {
+            unlink(lease);
+            link(lease);
+        }
+        stats.hits++;
+        return lease->stream.get();
+    }
+
+    stats.misses++;
+
+    /* Reuse a spare window, or grow, or take the least recently used one */
+    DeflationLease *lease;
+    bool fresh = false;
+    if (spare) {
+        lease = spare;
+        spare = spare->next;
+    } else if (stats.windows < stats.capacity || !tail) {
+        lease = new DeflationLease;
+        lease->compressOptions = compressOptions;
+        lease->stream = std::make_unique<DeflationStream>(compressOptions);
+        stats.windows++;
+        stats.windowBytes += DeflationLease::windowBytes(compressOptions);
+        fresh = true;
+    } else {
+        lease = tail;
+        evict(lease);
+    }
+
+    /* Sockets negotiate their own window sizes */
+    if (lease->compressOptions != compressOptions) {
+        stats.windowBytes -= DeflationLease::windowBytes(lease->compressOptions);
+        stats.windowBytes += DeflationLease::windowBytes(compressOptions);
+        lease->compressOptions = compressOptions;
+        lease->stream = std::make_unique<DeflationStream>(compressOptions);
+    } else if (!fresh) {
+        lease->stream->reset();
+    }
+
+    lease->owner = &slot;
+    lease->lastUse = ticks;
+    link(lease);
+    slot = lease;
+    return lease->stream.get();
+}
+
+inline void DeflationPool::tick() {
+    ticks++;
+    while (tail && ticks - tail->lastUse >= IDLE_TICKS) {
+        DeflationLease *lease = tail;
+        evict(lease);
+        destroy(lease);
+    }
+    while (spare) {
+        DeflationLease *lease = spare;
+        spare = spare->next;
+        destroy(lease);
+    }
+}
+
+inline void DeflationPool::setCapacity(uint32_t capacity) {
+    stats.capacity = capacity ? capacity : 1;
+    while (stats.windows > stats.capacity && spare) {
+        DeflationLease *lease = spare;
+        spare = spare->next;
+        destroy(lease);
+    }
+    while (stats.windows > stats.capacity && tail) {
+        DeflationLease *lease = tail;
+        evict(lease);
+        destroy(lease);
+    }
+}
+
+}
+
+#endif // UWS_DEFLATIONPOOL_H
@@ -155,6 +155,11 @@ public:
     }
 
 private:
+    /* Safe methods (RFC 9110): running a replayed one changes nothing. */
+    static bool isReplaySafe(std::string_view method) {
+        return method == "GET" || method == "HEAD" || method == "OPTIONS";
+    }
+
     /* ── vtable handlers ─────────────────────────────────────────────────── */
 
     static void onHandshake(us_socket_t *s, int success, struct us_bun_verify_error_t verify_error, void * /*custom_data*/) {
@@ -338,6 +343,11 @@ private:
         /* Cork this socket */
         ((AsyncSocket<SSL> *) s)->cork();
 
+        /* Responses to all the requests in this read leave in one write, even
+         * past the cork buffer (see LoopData::PipelineBatch) */
+        LoopData *loopData = ((AsyncSocket<SSL> *) s)->getLoopData();
+        loopData->openPipelineBatch(s);
+
         /* Mark that we are inside the parser now. Save/restore the parsed
          * socket: node:http's read replay can nest a parse inside another
          * socket's dispatch. */
@@ -399,6 +409,20 @@ private:
                 nodeHttpResponseData->headersCompleted = true;
             }
 
+            /* TLS 1.3 early data can be replayed by anyone who captured it until
+             * the handshake completes; only methods that are safe to run twice
+             * may be answered before that (RFC 8470). The client retries the
+             * rest on a fresh connection. */
+            if constexpr (SSL) {
+                if (us_socket_ssl_in_early_data((us_socket_t *) s) && !isReplaySafe(httpRequest->getCaseSensitiveMethod())) {
+                    us_socket_ssl_count_too_early((us_socket_t *) s);
+                    us_socket_write((us_socket_t *) s, httpErrorResponses[HTTP_ERROR_425_TOO_EARLY].data(), (int) httpErrorResponses[HTTP_ERROR_425_TOO_EARLY].length());
+                    us_socket_shutdown((us_socket_t *) s);
+                    us_socket_close((us_socket_t *) s, 0, nullptr);
+                    return nullptr;
+                }
+            }
+
             /* Are we not ready for another request yet? Terminate the connection.
              * Important for denying async pipelining until, if ever, we want to support it.
              * Otherwise requests can get mixed up on the same connection. We still support sync pipelining. */
@@ -596,6 +620,7 @@ private:
         /* Mark that we are no longer parsing Http */
         httpContextData->flags.isParsingHttp = false;
         httpContextData->parsingSocket = prevParsingSocket;
+        loopData->closePipelineBatch(s);
         /* If we got fullptr that means the parser wants us to close the socket from error (same as calling the errorHandler) */
         if (httpErrorStatusCode) {
             /* node:http compat: parse errors surface as the server's 'clientError'
@@ -619,8 +644,15 @@ private:
             if(httpContextData->onClientError) {
                 httpContextData->onClientError(SSL, s, result.parserError, data, length);
             }
-            /* For errors, we only deliver them "at most once". We don't care if they get halfways delivered or not. */
-            us_socket_write(s, httpErrorResponses[httpErrorStatusCode].data(), (int) httpErrorResponses[httpErrorStatusCode].length());
+            /* Responses to the valid requests pipelined ahead of the bad one
+             * are still corked or batched; send them before the error, since
+             * closing drops both. */
+            ((AsyncSocket<SSL> *) s)->uncork();
+            /* For errors, we only deliver them "at most once". We don't care if they get halfways delivered or not.
+             * Behind a response that is still buffered it would land mid-response, so skip it then. */
+            if (!((AsyncSocket<SSL> *) s)->getBufferedAmount()) {
+                us_socket_write(s, httpErrorResponses[httpErrorStatusCode].data(), (int) httpErrorResponses[httpErrorStatusCode].length());
+            }
             us_socket_shutdown(s);
             /* Close any socket on HTTP errors */
             us_socket_close(s, 0, nullptr);
@@ -702,6 +734,9 @@ private:
         auto *asyncSocket = reinterpret_cast<AsyncSocket<SSL> *>(s);
         auto *httpResponseData = reinterpret_cast<HttpResponseData<SSL> *>(asyncSocket->getAsyncSocketData());
 
+        /* Zerocopy completions are delivered as writable events */
+        asyncSocket->releaseCompletedZeroCopy();
+
         /* Attempt to drain the socket buffer before triggering onWritable callback */
         size_t bufferedAmount = asyncSocket->getBufferedAmount();
         if (bufferedAmount > 0) {
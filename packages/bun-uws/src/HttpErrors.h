@@ -25,7 +25,8 @@ enum HttpError {
     HTTP_ERROR_505_HTTP_VERSION_NOT_SUPPORTED = 1,
     HTTP_ERROR_431_REQUEST_HEADER_FIELDS_TOO_LARGE = 2,
     HTTP_ERROR_400_BAD_REQUEST = 3,
-    HTTP_ERROR_413_PAYLOAD_TOO_LARGE = 4
+    HTTP_ERROR_413_PAYLOAD_TOO_LARGE = 4,
+    HTTP_ERROR_425_TOO_EARLY = 5
 };
 
 
@@ -35,7 +36,8 @@ inline constexpr std::string_view httpErrorResponses[] = {
     "HTTP/1.1 505 HTTP Version Not Supported\r\nConnection: close\r\n\r\n",
     "HTTP/1.1 431 Request Header Fields Too Large\r\nConnection: close\r\n\r\n",
     "HTTP/1.1 400 Bad Request\r\nConnection: close\r\n\r\n",
-    "HTTP/1.1 413 Payload Too Large\r\nConnection: close\r\n\r\n"
+    "HTTP/1.1 413 Payload Too Large\r\nConnection: close\r\n\r\n",
+    "HTTP/1.1 425 Too Early\r\nConnection: close\r\nContent-Length: 0\r\n\r\n"
 };
 
 
@@ -0,0 +1,151 @@
+/*
+ * Authored by Alex Hultman, 2018-2022.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UWS_HTTPHEADERINDEX_H
+#define UWS_HTTPHEADERINDEX_H
+
+/* Stage-1 index of a request head, used by HttpParser. One vector pass classifies
+ * a window of bytes into three bit masks per 64-byte block and the parser jumps
+ * between set bits instead of testing bytes one at a time:
+ *   DELIMITER  not an RFC 9110 tchar (ends the field name: ':', CR, LF, SP, ...)
+ *   CONTROL    below 0x20 (ends the field value: CR, LF, HTAB, NUL, other CTLs)
+ *   SPACE      SP (with CONTROL, ends the request-target)
+ * The kernel is highway_http_header_index (src/jsc/bindings/highway_http.cpp);
+ * builds without Highway define UWS_NO_HIGHWAY and get the same searches as
+ * scalar loops. */
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <cstring>
+
+#ifndef UWS_NO_HIGHWAY
+extern "C" void highway_http_header_index(const uint8_t *input, size_t len, uint64_t *out_masks);
+#endif
+
+namespace uWS {
+
+#ifdef UWS_NO_HIGHWAY
+/* RFC 9110 5.6.2 tchar, by byte value */
+struct HttpTokenTable {
+    bool token[256] = {};
+
+    constexpr HttpTokenTable() {
+        for (unsigned c = 0; c < 256; c++) {
+            token[c] = (c >= 'a' && c <= 'z') || c == '-' || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                || c == '!' || (c >= '#' && c <= '\'') || c == '*' || c == '+' || c == '.' || c == '^'
+                || c == '_' || c == '`' || c == '|' || c == '~';
+        }
+    }
+};
+
+inline constexpr HttpTokenTable httpTokenTable {};
+#endif
+
+struct HttpHeaderIndex {
+    enum Class : unsigned {
+        DELIMITER = 1,
+        CONTROL = 2,
+        SPACE = 4
+    };
+
+    /* 512 bytes per kernel call: a typical request head in one go, without
+     * indexing much of a large body or pipelined tail for nothing */
+    static constexpr size_t WINDOW_BLOCKS = 8;
+
+#ifndef UWS_NO_HIGHWAY
+private:
+    char *window = nullptr, *windowEnd = nullptr;
+    /* One past the fenced end[0]; nothing beyond it is ever read */
+    char *limit;
+    uint64_t masks[WINDOW_BLOCKS * 3];
+
+    void index(char *from) {
+        window = from;
+        size_t length = std::min<size_t>(WINDOW_BLOCKS * 64, (size_t) (limit - from));
+        windowEnd = from + length;
+        highway_http_header_index((const uint8_t *) from, length, masks);
+    }
+
+    template <unsigned Classes>
+    uint64_t blockMask(size_t block) const {
+        uint64_t mask = 0;
+        if constexpr (Classes & DELIMITER) mask |= masks[block * 3];
+        if constexpr (Classes & CONTROL) mask |= masks[block * 3 + 1];
+        if constexpr (Classes & SPACE) mask |= masks[block * 3 + 2];
+        return mask;
+    }
+
+public:
+    /* end[0] must be fenced with '\r' (a DELIMITER and CONTROL byte) so that
+     * every search terminates at or before it */
+    HttpHeaderIndex(char *end) : limit(end + 1) {}
+
+    /* First byte at or after p in any of Classes. Positions only move forward */
+    template <unsigned Classes>
+    char *find(char *p) {
+        static_assert(Classes & (DELIMITER | CONTROL), "a search must be able to stop at the fence");
+        if (p >= windowEnd) [[unlikely]] {
+            index(p);
+        }
+        size_t offset = (size_t) (p - window);
+        size_t block = offset / 64;
+        uint64_t bits = blockMask<Classes>(block) & (~0ull << (offset % 64));
+        while (!bits) {
+            block++;
+            if (window + block * 64 >= windowEnd) {
+                index(window + block * 64);
+                block = 0;
+            }
+            bits = blockMask<Classes>(block);
+        }
+        return window + block * 64 + __builtin_ctzll(bits);
+    }
+#else
+    /* Without a vector kernel, the same searches as plain scalar loops */
+private:
+    /* Any byte below n, a word at a time; the fence bounds the over-read to the post padding */
+    static char *findBelow(char *p, unsigned char n) {
+        for (; true; p += 8) {
+            uint64_t word;
+            memcpy(&word, p, sizeof(uint64_t));
+            if ((word - ~0ULL / 255 * n) & ~word & ~0ULL / 255 * 128) {
+                while (*(unsigned char *) p >= n) p++;
+                return p;
+            }
+        }
+    }
+
+public:
+    HttpHeaderIndex(char *) {}
+
+    template <unsigned Classes>
+    char *find(char *p) {
+        static_assert(Classes & (DELIMITER | CONTROL), "a search must be able to stop at the fence");
+        if constexpr (Classes & DELIMITER) {
+            while (httpTokenTable.token[*(unsigned char *) p]) p++;
+            return p;
+        } else {
+            return findBelow(p, (Classes & SPACE) ? 33 : 32);
+        }
+    }
+#endif
+};
+
+}
+
+#endif // UWS_HTTPHEADERINDEX_H
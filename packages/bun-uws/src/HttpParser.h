@@ -36,6 +36,7 @@
 #include <wtf/Vector.h>
 #include "MoveOnlyFunction.h"
 #include "ChunkedEncoding.h"
+#include "HttpHeaderIndex.h"
 
 #include "BloomFilter.h"
 #include "ProxyParser.h"
@@ -512,7 +513,9 @@ struct HttpResponseData;
          * Consumes the section: it is post-padded in place and the returned
          * string_views point into it, so it must outlive their use.
          * KEEP IN LOCKSTEP with getHeaders' field-line loop below (same
-         * consumeFieldName → tryConsumeFieldValue → CRLF/OWS sequence). */
+         * consumeFieldName → tryConsumeFieldValue → CRLF/OWS sequence; getHeaders
+         * finds the same stop bytes through HttpHeaderIndex's DELIMITER / CONTROL
+         * masks). */
         static unsigned parseTrailerFields(std::string &section, std::pair<std::string_view, std::string_view> *out, bool useInsecureHTTPParser = false, unsigned outCapacity = MAX_TRAILER_FIELDS) {
             if (section.size() < 4) {
                 return 0;
@@ -801,7 +804,7 @@ struct HttpResponseData;
 
 
         /* Puts method as key, target as value and returns non-null (or nullptr on error). */
-        static inline ConsumeRequestLineResult consumeRequestLine(char *data, char *end, HttpRequest::Header &header, bool useStrictMethodValidation, uint64_t maxHeaderSize) {
+        static inline ConsumeRequestLineResult consumeRequestLine(char *data, char *end, HttpHeaderIndex &index, HttpRequest::Header &header, bool useStrictMethodValidation, uint64_t maxHeaderSize) {
             /* Scan until single SP, assume next is / (origin request) */
             char *start = data;
             /* This catches the post padded CR and fails */
@@ -852,42 +855,33 @@ struct HttpResponseData;
                 }
                 /* Scan for less than 33 (catches post padded CR and fails) */
                 start = data;
-                for (; true; data += 8) {
-                    uint64_t word;
-                    memcpy(&word, data, sizeof(uint64_t));
-                    if(maxHeaderSize && (uintptr_t)(data - start) > maxHeaderSize) {
-                        return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_REQUEST_HEADER_FIELDS_TOO_LARGE);
-                    }
-                    if (hasLess(word, 33)) {
-                        while (*(unsigned char *)data > 32) data++;
-                        if(maxHeaderSize && (uintptr_t)(data - start) > maxHeaderSize) {
-                            return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_REQUEST_HEADER_FIELDS_TOO_LARGE);
-                        }
-                        /* Now we stand on space */
-                        header.value = {start, (size_t) (data - start)};
-                        auto nextPosition = data + 11;
-                        /* Check that the following is http 1.1 */
-                        if (nextPosition >= end) {
-                            /* Whatever we have must be part of the version string */
-                            if (memcmp(" HTTP/1.1\r\n", data, std::min<unsigned int>(11, (unsigned int) (end - data))) == 0) {
-                                return ConsumeRequestLineResult::shortRead(false, isConnect);
-                            } else if (memcmp(" HTTP/1.0\r\n", data, std::min<unsigned int>(11, (unsigned int) (end - data))) == 0) {
-                                /*Indicates that the request line is ancient HTTP*/
-                                return ConsumeRequestLineResult::shortRead(true, isConnect);
-                            }
-                            return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_INVALID_HTTP_VERSION);
-                        }
-                        if (memcmp(" HTTP/1.1\r\n", data, 11) == 0) {
-                            return ConsumeRequestLineResult::success(nextPosition, false, isConnect);
-                        } else if (memcmp(" HTTP/1.0\r\n", data, 11) == 0) {
-                            /*Indicates that the request line is ancient HTTP*/
-                            return ConsumeRequestLineResult::success(nextPosition, true, isConnect);
-                        }
-                        /* nextPosition < end here, so data < end: any CR is real input, not the
-                         * post-padding sentinel. Fall through to the version error. */
-                        return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_INVALID_HTTP_VERSION);
+                data = index.find<HttpHeaderIndex::CONTROL | HttpHeaderIndex::SPACE>(data);
+                if(maxHeaderSize && (uintptr_t)(data - start) > maxHeaderSize) {
+                    return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_REQUEST_HEADER_FIELDS_TOO_LARGE);
+                }
+                /* Now we stand on space */
+                header.value = {start, (size_t) (data - start)};
+                auto nextPosition = data + 11;
+                /* Check that the following is http 1.1 */
+                if (nextPosition >= end) {
+                    /* Whatever we have must be part of the version string */
+                    if (memcmp(" HTTP/1.1\r\n", data, std::min<unsigned int>(11, (unsigned int) (end - data))) == 0) {
+                        return ConsumeRequestLineResult::shortRead(false, isConnect);
+                    } else if (memcmp(" HTTP/1.0\r\n", data, std::min<unsigned int>(11, (unsigned int) (end - data))) == 0) {
+                        /*Indicates that the request line is ancient HTTP*/
+                        return ConsumeRequestLineResult::shortRead(true, isConnect);
                     }
+                    return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_INVALID_HTTP_VERSION);
                 }
+                if (memcmp(" HTTP/1.1\r\n", data, 11) == 0) {
+                    return ConsumeRequestLineResult::success(nextPosition, false, isConnect);
+                } else if (memcmp(" HTTP/1.0\r\n", data, 11) == 0) {
+                    /*Indicates that the request line is ancient HTTP*/
+                    return ConsumeRequestLineResult::success(nextPosition, true, isConnect);
+                }
+                /* nextPosition < end here, so data < end: any CR is real input, not the
+                 * post-padding sentinel. Fall through to the version error. */
+                return ConsumeRequestLineResult::error(HTTP_HEADER_PARSER_ERROR_INVALID_HTTP_VERSION);
             }
 
             /* If we stand at the post padded CR, we have fragmented input so try again later.
@@ -966,8 +960,12 @@ struct HttpResponseData;
             * for PROXY means we can end up succeeding, yet leaving bytes in the fallback buffer
             * which is then removed, and our counters to flip due to overflow and we end up with a crash */
 
+            /* Request-target, field names and field values are all found through
+             * one stage-1 index of the head (see HttpHeaderIndex.h) */
+            HttpHeaderIndex index(end);
+
             /* The request line is different from the field names / field values */
-            auto requestLineResult = consumeRequestLine(postPaddedBuffer, end, headers[0], useStrictMethodValidation, maxHeaderSize);
+            auto requestLineResult = consumeRequestLine(postPaddedBuffer, end, index, headers[0], useStrictMethodValidation, maxHeaderSize);
 
             if (requestLineResult.isErrorOrShortRead()) {
                 /* Error - invalid request line */
@@ -1026,7 +1024,7 @@ struct HttpResponseData;
             for (unsigned int i = 1; i < UWS_HTTP_MAX_HEADERS_COUNT - 1; i++) {
                 /* Lower case and consume the field name */
                 preliminaryKey = postPaddedBuffer;
-                postPaddedBuffer = consumeFieldName(postPaddedBuffer);
+                postPaddedBuffer = index.find<HttpHeaderIndex::DELIMITER>(postPaddedBuffer);
                 headers->key = std::string_view(preliminaryKey, (size_t) (postPaddedBuffer - preliminaryKey));
                 headerNread += headers->key.length();
                 if(maxHeaderSize && headerNread >= maxHeaderSize) {
@@ -1052,7 +1050,7 @@ struct HttpResponseData;
                 preliminaryValue = postPaddedBuffer;
                 /* The goal of this call is to find next "\r\n", or any invalid field value chars, fast */
                 while (true) {
-                    postPaddedBuffer = tryConsumeFieldValue(postPaddedBuffer);
+                    postPaddedBuffer = index.find<HttpHeaderIndex::CONTROL>(postPaddedBuffer);
                     const unsigned char stopByte = (unsigned char) postPaddedBuffer[0];
                     /* If this is not CR then we caught some stinky invalid char on the way */
                     if (stopByte != '\r') {
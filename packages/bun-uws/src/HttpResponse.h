@@ -118,8 +118,12 @@ public:
      * Will start timeout if stream reaches totalSize or write failure.
      * keepCorked: if true, skip the trailing uncork so the caller can batch
      * more writes (used by upgrade() to batch the handshake with the first
-     * WebSocket frames). */
-    bool internalEnd(std::string_view data, uint64_t totalSize, bool optional, bool allowContentLength = true, bool closeConnection = false, bool keepCorked = false) {
+     * WebSocket frames). The uncork is skipped too while this socket's read
+     * is being parsed with its pipeline batch open: onData's post-parse
+     * uncork sends the responses to every request in the read together.
+     * zeroCopyPin: if set, a content-length body may be sent with MSG_ZEROCOPY
+     * from data itself (AsyncSocket::writeZeroCopy). */
+    bool internalEnd(std::string_view data, uint64_t totalSize, bool optional, bool allowContentLength = true, bool closeConnection = false, bool keepCorked = false, const ZeroCopyPin *zeroCopyPin = nullptr) {
         /* Write status if not already done */
         writeStatus(HTTP_200_OK);
 
@@ -210,7 +214,7 @@ public:
                 if (closeIfDoneAndMarked(httpResponseData)) {
                     return true;
                 }
-            } else if (!keepCorked) {
+            } else if (!keepCorked && !Super::isPipelineBatchOpen()) {
                 this->uncork();
                 /* That uncork released our cork slot, so the cork() wrapper's
                  * post-uncork close gate will not run. When THIS socket is the
@@ -264,7 +268,10 @@ public:
             bool failed = false;
             while (written < data.length() && !failed) {
                 /* uSockets only deals with int sizes, so pass chunks of max signed int size */
-                auto writtenFailed = Super::write(data.data() + written, (int) std::min<size_t>(data.length() - written, INT_MAX), optional);
+                int chunkLength = (int) std::min<size_t>(data.length() - written, INT_MAX);
+                auto writtenFailed = zeroCopyPin
+                    ? Super::writeZeroCopy(data.data() + written, chunkLength, *zeroCopyPin, optional)
+                    : Super::write(data.data() + written, chunkLength, optional);
 
                 written += (size_t) writtenFailed.first;
                 failed = writtenFailed.second;
@@ -284,7 +291,7 @@ public:
                 /* We need to check if we should close this socket here now */
                 if (!Super::isCorked()) {
                     closeIfDoneAndMarked(httpResponseData);
-                }  else if (!keepCorked) {
+                }  else if (!keepCorked && !Super::isPipelineBatchOpen()) {
                     this->uncork();
                     /* Same as the chunked arm above: the cork slot is gone, so
                      * run the close gate here unless THIS socket is the one
@@ -372,6 +379,9 @@ public:
                     if (webSocketContextData->compression & DEDICATED_COMPRESSOR_3KB) {
                         compressOptions = DEDICATED_COMPRESSOR_3KB;
                     }
+
+                    /* The window size is negotiated per socket, pooling is ours */
+                    compressOptions = CompressOptions(compressOptions | (webSocketContextData->compression & CompressOptions::POOLED_COMPRESSOR));
                 }
 
                 /* Here we modify the above compression with negotiated decompressor */
@@ -392,7 +402,9 @@ public:
         /* Grab the httpContext from res */
         HttpContext<SSL> *httpContext = HttpContext<SSL>::fromSocket((struct us_socket_t *) this);
 
-        /* Move any backpressure out of HttpResponse */
+        /* Move any backpressure out of HttpResponse, behind the responses
+         * still batched for this read */
+        Super::unbatch();
         auto* responseData = getHttpResponseData();
         BackPressure backpressure(std::move(((AsyncSocketData<SSL> *) responseData)->buffer));
 
@@ -618,9 +630,11 @@ public:
     }
 
     /* Try and end the response. Returns [true, true] on success.
-     * Starts a timeout in some cases. Returns [ok, hasResponded] */
-    std::pair<bool, bool> tryEnd(std::string_view data, uintmax_t totalSize = 0, bool closeConnection = false) {
-        bool ok = internalEnd(data, totalSize, true, true, closeConnection);
+     * Starts a timeout in some cases. Returns [ok, hasResponded]
+     * With a zeroCopyPin, large plain-TCP bodies are sent without copying and
+     * data stays pinned until the kernel is done with it. */
+    std::pair<bool, bool> tryEnd(std::string_view data, uintmax_t totalSize = 0, bool closeConnection = false, const ZeroCopyPin *zeroCopyPin = nullptr) {
+        bool ok = internalEnd(data, totalSize, true, true, closeConnection, false, zeroCopyPin);
         /* internalEnd's close gate may have closed the socket (destructing the
          * ext hasResponded() reads); that only happens once the response has
          * completed, so report responded without touching it. */
@@ -62,6 +62,227 @@ private:
         explicit constexpr Node(std::string name) noexcept : name(std::move(name)) {}
     } root {"rootNode"};
 
+    /* The compiled matching tree: once routes stop changing, the Node tree is
+     * flattened into contiguous arrays so route() touches a few cache lines
+     * per segment instead of chasing unique_ptrs and comparing std::strings.
+     * Children of every node are split into the two priority groups the tree
+     * keeps them sorted in (high, then normal) and, within a group, into the
+     * static children (one perfect-hash table lookup), the parameter
+     * children in child order and the wildcard handlers. Visiting them in that order is exactly
+     * the order executeHandlers walks the sorted children in. */
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+    static constexpr uint32_t COMPILE_MIN_HANDLERS = 128;
+
+    struct CompiledGroup {
+        /* Static children: table[hash(seed, segment) & mask] is a node index
+         * or NO_NODE. mask is 0 with a one-entry table for a single child. */
+        uint32_t table = 0, mask = 0, seed = 0, numStatic = 0;
+        /* Parameter children: params[firstParam, firstParam + numParams).
+         * Siblings like :id and :name are separate nodes with separate
+         * subtrees, so each is tried in turn. */
+        uint32_t firstParam = 0, numParams = 0;
+        /* Handlers of all wildcard children, concatenated in child order */
+        uint32_t firstWildcardHandler = 0, numWildcardHandlers = 0;
+    };
+
+    struct CompiledNode {
+        uint32_t nameOffset = 0, nameLength = 0;
+        uint32_t firstHandler = 0, numHandlers = 0;
+        CompiledGroup groups[2];
+    };
+
+    struct Compiled {
+        std::vector<CompiledNode> nodes;
+        std::vector<uint32_t> tables;
+        std::vector<uint32_t> params;
+        std::vector<uint32_t> handlerIds;
+        std::string names;
+        /* Method nodes in root.children order (ANY last) */
+        std::vector<std::pair<std::string, uint32_t>> methods;
+    } compiled;
+
+public:
+    enum class CompileMode : uint8_t {
+        /* Compile once the router holds COMPILE_MIN_HANDLERS handlers */
+        AUTO,
+        ALWAYS,
+        NEVER
+    };
+
+private:
+    CompileMode compileMode = CompileMode::AUTO;
+    bool compiledValid = false;
+
+    static uint32_t segmentHash(uint32_t seed, std::string_view segment) {
+        uint32_t h = 2166136261u ^ (seed * 0x9e3779b9u);
+        for (unsigned char c : segment) {
+            h = (h ^ c) * 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    std::string_view compiledName(uint32_t node) const {
+        const CompiledNode &n = compiled.nodes[node];
+        return std::string_view(compiled.names.data() + n.nameOffset, n.nameLength);
+    }
+
+    /* Builds a collision-free table for the static children of one group,
+     * growing the table whenever a few seeds in a row fail */
+    void compileStaticTable(CompiledGroup &group, const std::vector<uint32_t> &children) {
+        group.numStatic = (uint32_t) children.size();
+        if (children.empty()) {
+            return;
+        }
+
+        uint32_t size = 1;
+        while (size < children.size() * 2 && children.size() > 1) {
+            size <<= 1;
+        }
+
+        std::vector<uint32_t> table;
+        for (uint32_t seed = 0;; seed++) {
+            if (seed && seed % 16 == 0) {
+                size <<= 1;
+            }
+            table.assign(size, NO_NODE);
+            bool collided = false;
+            for (uint32_t child : children) {
+                uint32_t &entry = table[segmentHash(seed, compiledName(child)) & (size - 1)];
+                if (entry != NO_NODE) {
+                    collided = true;
+                    break;
+                }
+                entry = child;
+            }
+            if (!collided) {
+                group.seed = seed;
+                break;
+            }
+        }
+
+        group.table = (uint32_t) compiled.tables.size();
+        group.mask = size - 1;
+        compiled.tables.insert(compiled.tables.end(), table.begin(), table.end());
+    }
+
+    /* Flattens node and its subtree, returning its index */
+    uint32_t compileNode(const Node *node) {
+        uint32_t index = (uint32_t) compiled.nodes.size();
+        compiled.nodes.emplace_back();
+
+        CompiledNode flat;
+        flat.nameOffset = (uint32_t) compiled.names.size();
+        flat.nameLength = (uint32_t) node->name.length();
+        compiled.names.append(node->name);
+        flat.firstHandler = (uint32_t) compiled.handlerIds.size();
+        flat.numHandlers = (uint32_t) node->handlers.size();
+        compiled.handlerIds.insert(compiled.handlerIds.end(), node->handlers.begin(), node->handlers.end());
+
+        std::vector<uint32_t> statics[2], params[2];
+        std::vector<const Node *> wildcards[2];
+        for (const std::unique_ptr<Node> &child : node->children) {
+            int group = child->isHighPriority ? 0 : 1;
+            if (child->name.starts_with('*')) {
+                wildcards[group].push_back(child.get());
+            } else if (child->name.starts_with(':')) {
+                params[group].push_back(compileNode(child.get()));
+            } else {
+                statics[group].push_back(compileNode(child.get()));
+            }
+        }
+
+        for (int group = 0; group < 2; group++) {
+            compileStaticTable(flat.groups[group], statics[group]);
+            flat.groups[group].firstParam = (uint32_t) compiled.params.size();
+            flat.groups[group].numParams = (uint32_t) params[group].size();
+            compiled.params.insert(compiled.params.end(), params[group].begin(), params[group].end());
+            flat.groups[group].firstWildcardHandler = (uint32_t) compiled.handlerIds.size();
+            for (const Node *wildcard : wildcards[group]) {
+                compiled.handlerIds.insert(compiled.handlerIds.end(), wildcard->handlers.begin(), wildcard->handlers.end());
+            }
+            flat.groups[group].numWildcardHandlers = (uint32_t) compiled.handlerIds.size() - flat.groups[group].firstWildcardHandler;
+        }
+
+        compiled.nodes[index] = flat;
+        return index;
+    }
+
+    void compile() {
+        compiled = {};
+        for (const std::unique_ptr<Node> &method : root.children) {
+            compiled.methods.emplace_back(method->name, compileNode(method.get()));
+        }
+        compiledValid = true;
+    }
+
+    bool useCompiled() {
+        if (!compiledValid) {
+            if (compileMode == CompileMode::NEVER || (compileMode == CompileMode::AUTO && handlers.size() < COMPILE_MIN_HANDLERS)) {
+                return false;
+            }
+            compile();
+        }
+        return true;
+    }
+
+    bool executeHandlerRange(uint32_t first, uint32_t count) {
+        for (uint32_t i = first; i < first + count; i++) {
+            if (handlers[compiled.handlerIds[i] & HANDLER_MASK](this)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Same walk as executeHandlers, over the compiled tree */
+    bool executeCompiled(uint32_t nodeIndex, int urlSegment) {
+        auto [segment, isStop] = getUrlSegment(urlSegment);
+        const CompiledNode &node = compiled.nodes[nodeIndex];
+
+        if (isStop) {
+            return executeHandlerRange(node.firstHandler, node.numHandlers);
+        }
+
+        for (const CompiledGroup &group : node.groups) {
+            if (group.numStatic) {
+                uint32_t slot = group.mask ? (segmentHash(group.seed, segment) & group.mask) : 0;
+                uint32_t child = compiled.tables[group.table + slot];
+                if (child != NO_NODE && compiledName(child) == segment && executeCompiled(child, urlSegment + 1)) {
+                    return true;
+                }
+            }
+            if (!segment.empty()) {
+                for (uint32_t i = group.firstParam; i < group.firstParam + group.numParams; i++) {
+                    routeParameters.push(segment);
+                    if (executeCompiled(compiled.params[i], urlSegment + 1)) {
+                        return true;
+                    }
+                    routeParameters.pop();
+                }
+            }
+            if (executeHandlerRange(group.firstWildcardHandler, group.numWildcardHandlers)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool routeCompiled(std::string_view method) {
+        for (auto &[name, node] : compiled.methods) {
+            if (name == method) {
+                if (executeCompiled(node, 0)) {
+                    return true;
+                }
+                break;
+            }
+        }
+
+        if (compiled.methods.empty()) [[unlikely]] {
+            return false;
+        }
+        return executeCompiled(compiled.methods.back().second, 0);
+    }
+
     /* Sort wildcards after alphanum */
     int lexicalOrder(std::string_view name) {
         if (name.empty()) {
@@ -251,12 +472,24 @@ public:
         return userData;
     }
 
+    /* Selects between the Node tree walk and the compiled tree. The compiled
+     * tree is rebuilt lazily by the first route() after any add or remove,
+     * so it only pays off once routes are frozen. */
+    void setCompileMode(CompileMode mode) {
+        compileMode = mode;
+        compiledValid = false;
+    }
+
     /* Fast path */
     bool route(std::string_view method, std::string_view url) {
         /* Reset url parsing cache */
         setUrl(url);
         routeParameters.reset();
 
+        if (useCompiled()) {
+            return routeCompiled(method);
+        }
+
         /* Begin by finding the method node */
         for (auto &p : root.children) {
             if (p->name == method) {
@@ -301,6 +534,7 @@ public:
 
         /* Alloate this handler */
         handlers.emplace_back(std::move(handler));
+        compiledValid = false;
 
         /* ANY method must be last, GET must be first */
         std::sort(root.children.begin(), root.children.end(), [](const auto &a, const auto &b) {
@@ -373,6 +607,7 @@ public:
 
         /* Now remove the actual handler */
         handlers.erase(handlers.begin() + (handler & HANDLER_MASK));
+        compiledValid = false;
 
         return true;
     }
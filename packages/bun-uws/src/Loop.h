@@ -53,17 +53,8 @@ private:
             p.second((Loop *) loop);
         }
 
-        /* Drain any leftover corks. Two slots max. */
-        for (int i = 0; i < 2; i++) {
-            bool ssl;
-            void *corkedSocket = loopData->getAnyCorkedSocket(&ssl);
-            if (!corkedSocket) break;
-            if (ssl) {
-                ((uWS::AsyncSocket<true> *) corkedSocket)->uncork();
-            } else {
-                ((uWS::AsyncSocket<false> *) corkedSocket)->uncork();
-            }
-        }
+        /* Drain corks left behind between iterations (timers, microtasks). */
+        flushCorkedSockets(loopData);
     }
 
     static void postCb(us_loop_t *loop) {
@@ -72,6 +63,21 @@ private:
         for (auto &p : loopData->postHandlers) {
             p.second((Loop *) loop);
         }
+
+        /* Handlers that corked and returned without uncorking are flushed
+         * here together, once per iteration, instead of one at a time as
+         * later cork() calls evict them. */
+        flushCorkedSockets(loopData);
+    }
+
+    static void flushCorkedSockets(LoopData *loopData) {
+        loopData->forEachCorkedSocket([](void *corkedSocket, bool ssl) {
+            if (ssl) {
+                ((uWS::AsyncSocket<true> *) corkedSocket)->uncork();
+            } else {
+                ((uWS::AsyncSocket<false> *) corkedSocket)->uncork();
+            }
+        });
     }
 
     Loop() = delete;
@@ -23,6 +23,7 @@
 #include <functional>
 #include <map>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -30,6 +31,7 @@
 
 #include "MoveOnlyFunction.h"
 #include "PerMessageDeflate.h"
+#include "DeflationPool.h"
 // clang-format off
 struct us_timer_t;
 
@@ -47,30 +49,92 @@ private:
     /* Map from void ptr to handler */
     std::map<void *, MoveOnlyFunction<void(Loop *)>> postHandlers, preHandlers;
 
-    /* Cork data: two independent slots so a nested cork (e.g. a resumed async
-     * request writing while the outer request is still corked) doesn't force
-     * the outer socket down the uncorked slow path. cork() grabs whichever
-     * slot is free; uncork() releases the slot you're in. No ordering. */
+    /* Cork data: a small pool of independent slots so a nested cork (e.g. a
+     * resumed async request writing while the outer request is still corked)
+     * or a burst of sockets written from one callback doesn't force anyone
+     * down the uncorked slow path. The pool starts at two slots and grows on
+     * demand up to CORK_POOL_BUDGET bytes of buffers; only once the budget is
+     * spent does cork() evict the least-recently-touched slot. Slot structs
+     * live in a fixed array so CorkSlot pointers stay valid while it grows;
+     * buffers are allocated the first time a slot is used and kept for the
+     * lifetime of the loop. cork() grabs any free slot; uncork() releases the
+     * slot you're in. No ordering. */
     struct CorkSlot {
         char *buffer = nullptr;
         void *socket = nullptr;
         unsigned int offset = 0;
         unsigned int ssl : 1 = 0;
+        /* Value of corkTick when this slot was last written; LRU key. */
+        uint32_t lastTouched = 0;
     };
 
-    CorkSlot corkSlots[2];
+public:
+    /* Good 16k for SSL perf. */
+    static constexpr unsigned int CORK_BUFFER_SIZE = 16 * 1024;
+
+    /* Upper bound on memory held by cork buffers per loop. */
+    static constexpr unsigned int CORK_POOL_BUDGET = 1024 * 1024;
+    static constexpr int MAX_CORK_SLOTS = CORK_POOL_BUDGET / CORK_BUFFER_SIZE;
+    static constexpr int INITIAL_CORK_SLOTS = 2;
+
+    /* Cork pool counters, never reset. evictions counts sockets force-uncorked
+     * because every slot held data; a steady climb means the budget is too
+     * small for the fan-out the app does per callback. */
+    struct CorkStats {
+        uint64_t evictions = 0;
+        uint64_t steals = 0;
+        uint64_t batchedFlushes = 0;
+        /* Writes that carried a pipeline batch (see PipelineBatch) */
+        uint64_t pipelineBatches = 0;
+        int highWater = 0;
+    } corkStats;
+
+private:
+    CorkSlot corkSlots[MAX_CORK_SLOTS];
+
+    /* Slots [0, numCorkSlots) have a buffer. */
+    int numCorkSlots = 0;
+
+    /* Number of slots with a socket; lets the end-of-iteration flush and
+     * findCorkSlot bail out early when nothing is corked. */
+    int numCorkedSlots = 0;
+
+    /* Most recently touched slot; checked first by findCorkSlot since
+     * consecutive writes nearly always target the same socket. */
+    int mruCorkSlot = 0;
+
+    uint32_t corkTick = 0;
+
+    int growCorkPool() {
+        if (numCorkSlots == MAX_CORK_SLOTS) {
+            return INVALID_CORK_SLOT;
+        }
+        corkSlots[numCorkSlots].buffer = new char[CORK_BUFFER_SIZE];
+        return numCorkSlots++;
+    }
 
-    /* 1 = slot 1 was touched most recently, 0 = slot 0. Used to pick the LRU
-     * victim when both slots have data and we must force-uncork one. */
-    unsigned int lastTouchedSlot1 : 1 = 0;
+    void occupyCorkSlot(int slot, void *socket, bool ssl) {
+        CorkSlot &s = corkSlots[slot];
+        if (!s.socket) {
+            numCorkedSlots++;
+            if (numCorkedSlots > corkStats.highWater) {
+                corkStats.highWater = numCorkedSlots;
+            }
+        }
+        s.socket = socket;
+        s.ssl = ssl;
+        s.offset = 0;
+        touchCorkSlot(slot);
+    }
 
 public:
     /* INVALID_CORK_SLOT means "not corked with us". */
     static constexpr int INVALID_CORK_SLOT = -1;
 
     LoopData() {
-        corkSlots[0].buffer = new char[CORK_BUFFER_SIZE];
-        corkSlots[1].buffer = new char[CORK_BUFFER_SIZE];
+        for (int i = 0; i < INITIAL_CORK_SLOTS; i++) {
+            growCorkPool();
+        }
         updateDate();
     }
 
@@ -81,55 +145,92 @@ public:
             delete inflationStream;
             delete deflationStream;
         }
-        delete [] corkSlots[0].buffer;
-        delete [] corkSlots[1].buffer;
+        delete deflationPool;
+        for (int i = 0; i < numCorkSlots; i++) {
+            delete [] corkSlots[i].buffer;
+        }
     }
 
     /* Returns the slot index this socket is corked in, or INVALID_CORK_SLOT. */
     int findCorkSlot(void *socket) {
-        if (corkSlots[0].socket == socket) return 0;
-        if (corkSlots[1].socket == socket) return 1;
+        if (corkSlots[mruCorkSlot].socket == socket) return mruCorkSlot;
+        if (!numCorkedSlots) return INVALID_CORK_SLOT;
+        for (int i = 0; i < numCorkSlots; i++) {
+            if (corkSlots[i].socket == socket) return i;
+        }
         return INVALID_CORK_SLOT;
     }
 
-    /* Returns a slot we can borrow: prefers a free slot, falls back to a
-     * borrowed-but-unwritten slot (offset == 0) that we can steal without
-     * flushing. Returns INVALID_CORK_SLOT only if both slots hold data. */
+    /* Returns a slot we can borrow: prefers a free slot, then grows the pool
+     * while under budget, then falls back to a borrowed-but-unwritten slot
+     * (offset == 0) that we can steal without flushing. Returns
+     * INVALID_CORK_SLOT only if the pool is full and every slot holds data. */
     int findBorrowableCorkSlot() {
-        if (corkSlots[0].socket == nullptr) return 0;
-        if (corkSlots[1].socket == nullptr) return 1;
-        if (corkSlots[0].offset == 0) return 0;
-        if (corkSlots[1].offset == 0) return 1;
+        if (numCorkedSlots < numCorkSlots) {
+            for (int i = 0; i < numCorkSlots; i++) {
+                if (corkSlots[i].socket == nullptr) return i;
+            }
+        }
+        if (numCorkSlots < MAX_CORK_SLOTS) {
+            return growCorkPool();
+        }
+        for (int i = 0; i < numCorkSlots; i++) {
+            if (corkSlots[i].offset == 0) return i;
+        }
         return INVALID_CORK_SLOT;
     }
 
     /* Borrow a slot for this socket. Returns the slot index, or
-     * INVALID_CORK_SLOT if both slots have data that must be flushed. */
+     * INVALID_CORK_SLOT if every slot has data that must be flushed. */
     int acquireCorkSlot(void *socket, bool ssl) {
         int slot = findBorrowableCorkSlot();
         if (slot != INVALID_CORK_SLOT) {
-            corkSlots[slot].socket = socket;
-            corkSlots[slot].ssl = ssl;
-            corkSlots[slot].offset = 0;
-            lastTouchedSlot1 = (slot == 1);
+            if (corkSlots[slot].socket) {
+                corkStats.steals++;
+            }
+            occupyCorkSlot(slot, socket, ssl);
         }
         return slot;
     }
 
     /* Mark a slot as recently used. Call when writing into it so LRU eviction
-     * picks the other slot. */
+     * picks another slot. */
     void touchCorkSlot(int slot) {
-        lastTouchedSlot1 = (slot == 1);
+        corkSlots[slot].lastTouched = ++corkTick;
+        mruCorkSlot = slot;
+    }
+
+    /* The pool is at its budget and every slot holds data: counts an
+     * eviction and returns the least recently touched slot. cork()
+     * force-uncorks its socket, which releases it. */
+    CorkSlot *evictCorkSlot() {
+        corkStats.evictions++;
+        return &corkSlots[getLRUCorkSlot()];
     }
 
-    /* Returns the least-recently-used slot index for force-uncork eviction. */
+    /* Returns the least-recently-used occupied slot index for force-uncork
+     * eviction. Only reached with a full pool, so the scan is off the hot
+     * path. Compares tick distances so wraparound of corkTick is harmless. */
     int getLRUCorkSlot() {
-        return lastTouchedSlot1 ? 0 : 1;
+        int victim = INVALID_CORK_SLOT;
+        uint32_t oldest = 0;
+        for (int i = 0; i < numCorkSlots; i++) {
+            if (!corkSlots[i].socket) continue;
+            uint32_t age = corkTick - corkSlots[i].lastTouched;
+            if (victim == INVALID_CORK_SLOT || age > oldest) {
+                victim = i;
+                oldest = age;
+            }
+        }
+        return victim;
     }
 
     /* Release a slot. */
     void releaseCorkSlot(int slot) {
-        ASSERT(slot == 0 || slot == 1);
+        ASSERT(slot >= 0 && slot < numCorkSlots);
+        if (corkSlots[slot].socket) {
+            numCorkedSlots--;
+        }
         corkSlots[slot].socket = nullptr;
         corkSlots[slot].offset = 0;
     }
@@ -137,34 +238,93 @@ public:
     /* Transfer ownership of a slot to a new socket (used during WebSocket
      * upgrade to hand the HTTP socket's cork buffer to the new WebSocket). */
     void transferCorkSlot(int slot, void *socket, bool ssl) {
-        ASSERT(slot == 0 || slot == 1);
+        ASSERT(slot >= 0 && slot < numCorkSlots);
         corkSlots[slot].socket = socket;
         corkSlots[slot].ssl = ssl;
     }
 
     CorkSlot *getCorkSlot(int slot) {
-        ASSERT(slot == 0 || slot == 1);
+        ASSERT(slot >= 0 && slot < numCorkSlots);
         return &corkSlots[slot];
     }
 
     bool canCork() {
-        return findBorrowableCorkSlot() != INVALID_CORK_SLOT;
+        return numCorkedSlots < MAX_CORK_SLOTS || findBorrowableCorkSlot() != INVALID_CORK_SLOT;
     }
 
     /* Remove this socket from any cork slot it occupies. Must be called from
      * socket close/destroy paths to avoid leaving a dangling pointer that the
      * drain loop would later dereference. */
     void unborrowCorkSlot(void *socket) {
-        if (corkSlots[0].socket == socket) { corkSlots[0].socket = nullptr; corkSlots[0].offset = 0; }
-        if (corkSlots[1].socket == socket) { corkSlots[1].socket = nullptr; corkSlots[1].offset = 0; }
+        int slot = findCorkSlot(socket);
+        if (slot != INVALID_CORK_SLOT) {
+            releaseCorkSlot(slot);
+        }
+    }
+
+    /* Number of sockets currently holding a cork slot. */
+    int getCorkedCount() {
+        return numCorkedSlots;
+    }
+
+    /* Number of slots with a buffer, INITIAL_CORK_SLOTS up to MAX_CORK_SLOTS. */
+    int getCorkPoolSize() {
+        return numCorkSlots;
+    }
+
+    /* Calls uncork(socket, ssl) for every occupied slot in one pass; used by
+     * the loop to flush whatever is still corked at the end of an iteration.
+     * The callback must release the slot (AsyncSocket::uncork does). */
+    template <typename F>
+    void forEachCorkedSocket(F &&uncork) {
+        if (!numCorkedSlots) return;
+        corkStats.batchedFlushes++;
+        for (int i = 0; i < numCorkSlots && numCorkedSlots; i++) {
+            if (corkSlots[i].socket) {
+                uncork(corkSlots[i].socket, (bool) corkSlots[i].ssl);
+            }
+        }
+    }
+
+    /* Upper bound on response bytes held back for one read's batch. */
+    static constexpr size_t PIPELINE_BATCH_MAX = 256 * 1024;
+
+    /* Responses to the pipelined requests of one read. While HttpContext
+     * parses a read, a write that overflows the parsing socket's cork slot
+     * moves the slot's bytes here instead of sending them, and the uncork at
+     * the end of the read writes the batch and the slot together: one writev
+     * on TCP, one batch of records on TLS. Only the outermost parse batches
+     * (node:http's read replay can nest another socket's parse). */
+    struct PipelineBatch {
+        /* The parsed socket, while the batch is open or still holds bytes */
+        void *socket = nullptr;
+        /* Whether overflowing writes may still join the batch */
+        bool open = false;
+        std::string bytes;
+    } pipelineBatch;
+
+    void openPipelineBatch(void *socket) {
+        if (!pipelineBatch.socket) {
+            pipelineBatch.socket = socket;
+            pipelineBatch.open = true;
+        }
     }
 
-    /* Legacy accessor for drain loops: returns any corked socket (slot 0 first)
-     * so the caller can uncork it. Returns nullptr if both slots are empty. */
-    void *getAnyCorkedSocket(bool *outSsl) {
-        if (corkSlots[0].socket) { *outSsl = corkSlots[0].ssl; return corkSlots[0].socket; }
-        if (corkSlots[1].socket) { *outSsl = corkSlots[1].ssl; return corkSlots[1].socket; }
-        return nullptr;
+    /* The read is parsed: what the batch holds goes out with the next uncork. */
+    void closePipelineBatch(void *socket) {
+        if (pipelineBatch.socket != socket) return;
+        pipelineBatch.open = false;
+        if (pipelineBatch.bytes.empty()) {
+            pipelineBatch.socket = nullptr;
+        }
+    }
+
+    /* Discards the batch of a socket being closed or adopted. */
+    void dropPipelineBatch(void *socket) {
+        if (pipelineBatch.socket != socket) return;
+        pipelineBatch.socket = nullptr;
+        pipelineBatch.open = false;
+        pipelineBatch.bytes.clear();
     }
 
     void updateDate() {
@@ -197,13 +357,12 @@ public:
     /* Be silent */
     bool noMark = false;
 
-    /* Good 16k for SSL perf. */
-    static constexpr unsigned int CORK_BUFFER_SIZE = 16 * 1024;
-
     /* Per message deflate data */
     ZlibContext *zlibContext = nullptr;
     InflationStream *inflationStream = nullptr;
     DeflationStream *deflationStream = nullptr;
+    /* Windows leased by POOLED_COMPRESSOR sockets */
+    DeflationPool *deflationPool = nullptr;
 };
 
 }
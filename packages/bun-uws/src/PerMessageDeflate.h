@@ -30,6 +30,7 @@ namespace uWS {
     /* Compressor mode is 8 lowest bits where HIGH4(windowBits), LOW4(memLevel).
      * Decompressor mode is 8 highest bits LOW4(windowBits).
      * If compressor or decompressor bits are 1, then they are shared.
+     * Bit 12 leases dedicated compressors from a per-loop pool (DeflationPool.h).
      * If everything is just simply 0, then everything is disabled. */
     enum CompressOptions : uint16_t {
         /* These are not actual compression options */
@@ -60,7 +61,10 @@ namespace uWS {
         DEDICATED_COMPRESSOR_128KB = 14 << 4 | 7,
         DEDICATED_COMPRESSOR_256KB = 15 << 4 | 8,
         /* Same as 256kb */
-        DEDICATED_COMPRESSOR = 15 << 4 | 8
+        DEDICATED_COMPRESSOR = 15 << 4 | 8,
+
+        /* Combined with a dedicated compressor size */
+        POOLED_COMPRESSOR = 1 << 12
     };
 }
 
@@ -92,6 +96,8 @@ struct DeflationStream {
     std::string_view deflate(ZlibContext * /*zlibContext*/, std::string_view raw, bool /*reset*/) {
         return raw;
     }
+    void reset() {
+    }
     DeflationStream(CompressOptions /*compressOptions*/) {
     }
 };
@@ -210,6 +216,11 @@ struct DeflationStream {
         };
     }
 
+    /* Forget the sliding window, as if newly constructed */
+    void reset() {
+        deflateReset(&deflationStream);
+    }
+
     ~DeflationStream() {
         deflateEnd(&deflationStream);
     }
@@ -223,7 +234,7 @@ struct InflationStream {
 
     InflationStream(CompressOptions compressOptions) {
         /* Inflation windowBits are the top 8 bits of the 16 bit compressOptions */
-        inflateInit2(&inflationStream, -(compressOptions >> 8));
+        inflateInit2(&inflationStream, -((compressOptions & _DECOMPRESSOR_MASK) >> 8));
     }
 
     ~InflationStream() {
@@ -16,34 +16,200 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <list>
-#include <unordered_set>
 #include <utility>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 #include <string_view>
 #include <functional>
-#include <set>
 #include <string>
 
 namespace uWS {
 
 struct Subscriber;
+struct Topic;
+struct BroadcastMember;
+
+/* Open-addressed (linear probing) index from a 32-bit key hash to a position
+ * in some dense array owned by the caller. The caller's eq(index) decides
+ * whether a probed position holds the key. Erase shifts later entries back
+ * instead of leaving tombstones, so lookups never degrade under churn. */
+struct FlatIndex {
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct Slot {
+        uint32_t hash;
+        uint32_t index = EMPTY;
+    };
+
+    std::vector<Slot> slots;
+    uint32_t count = 0;
+
+    template <typename Eq>
+    uint32_t find(uint32_t hash, Eq &&eq) const {
+        if (slots.empty()) {
+            return EMPTY;
+        }
+        uint32_t mask = (uint32_t) slots.size() - 1;
+        for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot &slot = slots[i];
+            if (slot.index == EMPTY) {
+                return EMPTY;
+            }
+            if (slot.hash == hash && eq(slot.index)) {
+                return slot.index;
+            }
+        }
+    }
+
+    void insert(uint32_t hash, uint32_t index) {
+        /* Keep load at or below 1/2 */
+        if ((count + 1) * 2 > slots.size()) {
+            std::vector<Slot> old = std::move(slots);
+            slots.assign(old.size() ? old.size() * 2 : 16, Slot{});
+            for (const Slot &slot : old) {
+                if (slot.index != EMPTY) {
+                    place(slot);
+                }
+            }
+        }
+        place({hash, index});
+        count++;
+    }
+
+    /* Points the entry for (hash, from) at to; used when a swap-remove moves
+     * an element within the dense array */
+    void move(uint32_t hash, uint32_t from, uint32_t to) {
+        uint32_t mask = (uint32_t) slots.size() - 1;
+        for (uint32_t i = hash & mask; slots[i].index != EMPTY; i = (i + 1) & mask) {
+            if (slots[i].index == from) {
+                slots[i].index = to;
+                return;
+            }
+        }
+    }
+
+    void erase(uint32_t hash, uint32_t index) {
+        uint32_t mask = (uint32_t) slots.size() - 1;
+        uint32_t i = hash & mask;
+        while (slots[i].index != index) {
+            if (slots[i].index == EMPTY) {
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+        /* Backward-shift deletion */
+        for (uint32_t j = (i + 1) & mask; slots[j].index != EMPTY; j = (j + 1) & mask) {
+            uint32_t home = slots[j].hash & mask;
+            /* Move j into the hole at i unless its home lies cyclically in (i, j] */
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i].index = EMPTY;
+        count--;
+    }
 
-struct Topic : std::unordered_set<Subscriber *> {
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+private:
+    void place(Slot slot) {
+        uint32_t mask = (uint32_t) slots.size() - 1;
+        uint32_t i = slot.hash & mask;
+        while (slots[i].index != EMPTY) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+};
 
-    Topic(std::string_view topic) : name(topic) {
+/* Fixed-address object pool: objects are carved from chunks that are never
+ * freed before the pool, and released objects go on a free list so their
+ * heap-backed members (vectors, strings) keep their capacity for reuse. */
+template <typename O>
+struct ObjectPool {
+    std::vector<std::unique_ptr<O[]>> chunks;
+    std::vector<O *> freeList;
+
+    O *acquire() {
+        if (freeList.empty()) {
+            size_t chunkSize = std::min<size_t>(64 << std::min<size_t>(chunks.size(), 6), 4096);
+            chunks.emplace_back(new O[chunkSize]);
+            for (size_t i = chunkSize; i-- > 0; ) {
+                freeList.push_back(&chunks.back()[i]);
+            }
+        }
+        O *o = freeList.back();
+        freeList.pop_back();
+        return o;
+    }
 
+    void release(O *o) {
+        freeList.push_back(o);
     }
+};
+
+/* Iterates a dense array by position against its live size, so removing the
+ * current element mid-iteration (swap-remove) skips one element at worst
+ * rather than reading past the end */
+template <typename Owner, typename Value, Value (*at)(const Owner *, uint32_t), uint32_t (*sizeOf)(const Owner *)>
+struct DenseIterator {
+    const Owner *owner;
+    uint32_t i;
+
+    Value operator*() const { return at(owner, i); }
+    DenseIterator &operator++() { i++; return *this; }
+    bool operator!=(const DenseIterator &) const { return i < sizeOf(owner); }
+};
+
+/* A topic's subscribers are a dense array; each entry remembers where the
+ * topic sits in that subscriber's own array so either side can swap-remove
+ * in O(1). Topics are pooled by their TopicTree and carry a small interned
+ * id that subscribers use as their lookup key. */
+struct Topic {
+    template <typename, typename> friend struct TopicTree;
+    template <typename> friend struct ObjectPool;
+    friend struct Subscriber;
+
+private:
+    struct Entry {
+        Subscriber *subscriber;
+        uint32_t slot;
+    };
+
+    std::vector<Entry> subscribers;
+    uint32_t id = 0;
+
+    Topic() = default;
+
+    static Subscriber *subscriberAt(const Topic *t, uint32_t i) { return t->subscribers[i].subscriber; }
+    static uint32_t sizeOf(const Topic *t) { return (uint32_t) t->subscribers.size(); }
+
+public:
+    using iterator = DenseIterator<Topic, Subscriber *, &Topic::subscriberAt, &Topic::sizeOf>;
 
     std::string name;
+
+    size_t size() const { return subscribers.size(); }
+    iterator begin() const { return {this, 0}; }
+    iterator end() const { return {this, 0}; }
+
+    /* 1 if s subscribes to us, otherwise 0 */
+    size_t count(Subscriber *s) const;
 };
 
 struct Subscriber {
 
     template <typename, typename> friend struct TopicTree;
+    template <typename> friend struct ObjectPool;
+    friend struct Topic;
 
 private:
     /* We use a factory */
@@ -59,10 +225,81 @@ private:
     /* This one matters the most, if it is 0 we are not in the list of drainableSubscribers */
     unsigned char numMessageIndices = 0;
 
+    /* The topics we subscribe to, each with our position in its subscriber array */
+    struct Membership {
+        Topic *topic;
+        uint32_t slot;
+    };
+    std::vector<Membership> memberships;
+
+    /* Topic id -> memberships position; only built past a handful of topics,
+     * below that a scan of memberships is cheaper */
+    static constexpr size_t INDEXED_TOPICS = 8;
+    FlatIndex topicIndex;
+
+    static uint32_t idHash(uint32_t id) {
+        return id * 0x9e3779b1u;
+    }
+
+    uint32_t findMembership(const Topic *t) const {
+        if (topicIndex.slots.empty()) {
+            for (uint32_t i = 0; i < memberships.size(); i++) {
+                if (memberships[i].topic == t) {
+                    return i;
+                }
+            }
+            return FlatIndex::EMPTY;
+        }
+        return topicIndex.find(idHash(t->id), [this, t](uint32_t i) {
+            return memberships[i].topic == t;
+        });
+    }
+
+    void addMembership(Topic *t, uint32_t slot) {
+        uint32_t index = (uint32_t) memberships.size();
+        memberships.push_back({t, slot});
+        if (!topicIndex.slots.empty()) {
+            topicIndex.insert(idHash(t->id), index);
+        } else if (memberships.size() > INDEXED_TOPICS) {
+            for (uint32_t i = 0; i < memberships.size(); i++) {
+                topicIndex.insert(idHash(memberships[i].topic->id), i);
+            }
+        }
+    }
+
+    /* Swap-removes memberships[index]; the topic side must already be gone */
+    void removeMembership(uint32_t index) {
+        uint32_t last = (uint32_t) memberships.size() - 1;
+        if (!topicIndex.slots.empty()) {
+            topicIndex.erase(idHash(memberships[index].topic->id), index);
+            if (index != last) {
+                topicIndex.move(idHash(memberships[last].topic->id), last, index);
+            }
+        }
+        if (index != last) {
+            Membership moved = memberships[last];
+            memberships[index] = moved;
+            moved.topic->subscribers[moved.slot].slot = index;
+        }
+        memberships.pop_back();
+    }
+
+    static Topic *topicAt(const Subscriber *s, uint32_t i) { return s->memberships[i].topic; }
+    static uint32_t sizeOf(const Subscriber *s) { return (uint32_t) s->memberships.size(); }
+
 public:
+    struct TopicRange {
+        using iterator = DenseIterator<Subscriber, Topic *, &Subscriber::topicAt, &Subscriber::sizeOf>;
+        const Subscriber *s;
+        iterator begin() const { return {s, 0}; }
+        iterator end() const { return {s, 0}; }
+        size_t size() const { return s->memberships.size(); }
+    };
 
-    /* We have a list of topics we subscribe to (read by WebSocket::iterateTopics) */
-    std::set<Topic *> topics;
+    /* The topics we subscribe to (read by WebSocket::iterateTopics) */
+    TopicRange topics() const {
+        return {this};
+    }
 
     /* User data */
     void *user;
@@ -72,6 +309,10 @@ public:
     }
 };
 
+inline size_t Topic::count(Subscriber *s) const {
+    return s->findMembership(this) != FlatIndex::EMPTY;
+}
+
 template <typename T, typename B>
 struct TopicTree {
 
@@ -89,14 +330,24 @@ struct TopicTree {
     /* Whomever is iterating this topic is locked to not modify its own list */
     Subscriber *iteratingSubscriber = nullptr;
 
+    /* Set while the owning app is in a cross-thread BroadcastGroup */
+    BroadcastMember *broadcastMember = nullptr;
+
 private:
 
     /* The drain callback must not publish, unsubscribe or subscribe.
      * It must only cork, uncork, send, write */
     std::function<bool(Subscriber *, T &, IteratorFlags)> cb;
 
-    /* The topics */
-    std::unordered_map<std::string_view, std::unique_ptr<Topic>> topics;
+    /* The topics, by interned id (free ids are nullptr and reused) */
+    std::vector<Topic *> topicsById;
+    std::vector<uint32_t> freeTopicIds;
+
+    /* Topic name -> id */
+    FlatIndex topicNames;
+
+    ObjectPool<Topic> topicPool;
+    ObjectPool<Subscriber> subscriberPool;
 
     /* List of subscribers that needs drainage */
     Subscriber *drainableSubscribers = nullptr;
@@ -130,6 +381,47 @@ private:
         }
     }
 
+    static uint32_t nameHash(std::string_view name) {
+        return (uint32_t) std::hash<std::string_view>()(name);
+    }
+
+    Topic *createTopic(std::string_view name) {
+        Topic *t = topicPool.acquire();
+        t->name.assign(name.data(), name.length());
+        if (freeTopicIds.empty()) {
+            t->id = (uint32_t) topicsById.size();
+            topicsById.push_back(t);
+        } else {
+            t->id = freeTopicIds.back();
+            freeTopicIds.pop_back();
+            topicsById[t->id] = t;
+        }
+        topicNames.insert(nameHash(t->name), t->id);
+        return t;
+    }
+
+    void deleteTopic(Topic *t) {
+        topicNames.erase(nameHash(t->name), t->id);
+        topicsById[t->id] = nullptr;
+        freeTopicIds.push_back(t->id);
+        /* Pooled topics keep their subscriber capacity, within reason */
+        if (t->subscribers.capacity() > 1024) {
+            std::vector<Topic::Entry>().swap(t->subscribers);
+        }
+        topicPool.release(t);
+    }
+
+    /* Swap-removes s from t's subscriber array; the membership side is left alone */
+    void removeFromTopic(Topic *t, uint32_t slot) {
+        uint32_t last = (uint32_t) t->subscribers.size() - 1;
+        if (slot != last) {
+            Topic::Entry moved = t->subscribers[last];
+            t->subscribers[slot] = moved;
+            moved.subscriber->memberships[moved.slot].slot = slot;
+        }
+        t->subscribers.pop_back();
+    }
+
     void unlinkDrainableSubscriber(Subscriber *s) {
         if (s->prev) {
             s->prev->next = s->next;
@@ -151,11 +443,10 @@ public:
 
     /* Returns nullptr if not found */
     Topic *lookupTopic(std::string_view topic) {
-        auto it = topics.find(topic);
-        if (it == topics.end()) {
-            return nullptr;
-        }
-        return it->second.get();
+        uint32_t id = topicNames.find(nameHash(topic), [this, topic](uint32_t id) {
+            return topicsById[id]->name == topic;
+        });
+        return id == FlatIndex::EMPTY ? nullptr : topicsById[id];
     }
 
     /* Subscribe fails if we already are subscribed */
@@ -165,17 +456,14 @@ public:
         /* Lookup or create new topic */
         Topic *topicPtr = lookupTopic(topic);
         if (!topicPtr) {
-            Topic *newTopic = new Topic(topic);
-            topics.insert({std::string_view(newTopic->name.data(), newTopic->name.length()), std::unique_ptr<Topic>(newTopic)});
-            topicPtr = newTopic;
+            topicPtr = createTopic(topic);
+        } else if (s->findMembership(topicPtr) != FlatIndex::EMPTY) {
+            return nullptr;
         }
 
         /* Insert us in topic, insert topic in us */
-        auto [it, inserted] = s->topics.insert(topicPtr);
-        if (!inserted) {
-            return nullptr;
-        }
-        topicPtr->insert(s);
+        topicPtr->subscribers.push_back({s, (uint32_t) s->memberships.size()});
+        s->addMembership(topicPtr, (uint32_t) topicPtr->subscribers.size() - 1);
 
         /* Success */
         return topicPtr;
@@ -192,29 +480,32 @@ public:
             return {false, false, -1};
         }
 
-        /* Erase from our list first */
-        if (s->topics.erase(topicPtr) == 0) {
+        uint32_t membership = s->findMembership(topicPtr);
+        if (membership == FlatIndex::EMPTY) {
             return {false, false, -1};
         }
 
-        /* Remove us from topic */
-        topicPtr->erase(s);
+        /* Remove us from topic, then the topic from us */
+        removeFromTopic(topicPtr, s->memberships[membership].slot);
+        s->removeMembership(membership);
 
         int newCount = topicPtr->size();
 
         /* If there is no subscriber to this topic, remove it */
         if (!topicPtr->size()) {
-            /* Unique_ptr deletes the topic */
-            topics.erase(topic);
+            deleteTopic(topicPtr);
         }
 
         /* If we don't hold any topics we are to be freed altogether */
-        return {true, s->topics.size() == 0, newCount};
+        return {true, s->memberships.size() == 0, newCount};
     }
 
     /* Factory function for creating a Subscriber */
     Subscriber *createSubscriber() {
-        return new Subscriber();
+        Subscriber *s = subscriberPool.acquire();
+        s->numMessageIndices = 0;
+        s->user = nullptr;
+        return s;
     }
 
     /* This is used to end a Subscriber, before freeing it */
@@ -226,22 +517,26 @@ public:
         }
 
         /* For all topics, unsubscribe */
-        for (Topic *topicPtr : s->topics) {
+        for (Subscriber::Membership &m : s->memberships) {
             /* If we are the last subscriber, simply remove the whole topic */
-            if (topicPtr->size() == 1) {
-                topics.erase(topicPtr->name);
+            if (m.topic->size() == 1) {
+                m.topic->subscribers.clear();
+                deleteTopic(m.topic);
             } else {
                 /* Otherwise just remove us */
-                topicPtr->erase(s);
+                removeFromTopic(m.topic, m.slot);
             }
         }
+        s->memberships.clear();
+        s->topicIndex.clear();
 
         /* We also need to unlink us */
         if (s->needsDrainage()) {
             unlinkDrainableSubscriber(s);
+            s->numMessageIndices = 0;
         }
 
-        delete s;
+        subscriberPool.release(s);
     }
 
     /* Mainly used by WebSocket::send to drain one socket before sending */
@@ -282,13 +577,13 @@ public:
     template <typename F>
     bool publishBig(Subscriber *sender, std::string_view topic, B &&bigMessage, F cb) {
         /* Do we even have this topic? */
-        auto it = topics.find(topic);
-        if (it == topics.end()) {
+        Topic *t = lookupTopic(topic);
+        if (!t) {
             return false;
         }
 
         /* For all subscribers in topic */
-        for (Subscriber *s : *it->second) {
+        for (Subscriber *s : *t) {
 
             /* If we are sender then ignore us */
             if (sender != s) {
@@ -302,8 +597,8 @@ public:
     /* Linear in number of affected subscribers */
     bool publish(Subscriber *sender, std::string_view topic, T &&message) {
         /* Do we even have this topic? */
-        auto it = topics.find(topic);
-        if (it == topics.end()) {
+        Topic *t = lookupTopic(topic);
+        if (!t) {
             return false;
         }
 
@@ -318,7 +613,8 @@ public:
         bool referencedMessage = false;
 
         /* For all subscribers in topic */
-        for (Subscriber *s : *it->second) {
+        for (const Topic::Entry &entry : t->subscribers) {
+            Subscriber *s = entry.subscriber;
 
             /* If we are sender then ignore us */
             if (sender != s) {
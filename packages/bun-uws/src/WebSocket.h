@@ -19,6 +19,7 @@
 #define UWS_WEBSOCKET_H
 
 #include "AsyncSocket.h"
+#include "BroadcastGroup.h"
 #include "WebSocketContextData.h"
 #include "WebSocketData.h"
 #include "WebSocketProtocol.h"
@@ -35,7 +36,7 @@ private:
     typedef AsyncSocket<SSL> Super;
 
     void *init(bool perMessageDeflate, CompressOptions compressOptions, BackPressure &&backpressure, void *socketData, WebSocketData::OnSocketClosedCallback onSocketClosed) {
-        new (us_socket_ext((us_socket_t *) this)) WebSocketData(perMessageDeflate, compressOptions, std::move(backpressure), socketData, onSocketClosed);
+        new (us_socket_ext((us_socket_t *) this)) WebSocketData(perMessageDeflate, compressOptions, std::move(backpressure), socketData, onSocketClosed, Super::getLoopData()->deflationPool);
         return this;
     }
 
@@ -177,9 +178,12 @@ public:
                 /* Check and correct the compress hint. It is never valid to compress 0 bytes */
                 if (message.length() && opCode < 3 && webSocketData->compressionStatus == WebSocketData::ENABLED) {
                     LoopData *loopData = Super::getLoopData();
-                    /* Compress using either shared or dedicated deflationStream */
+                    /* Compress using either shared, dedicated or pooled deflationStream */
                     if (webSocketData->deflationStream) {
                         message = webSocketData->deflationStream->deflate(loopData->zlibContext, message, false);
+                    } else if (webSocketData->deflationPool) {
+                        DeflationStream *deflationStream = webSocketData->deflationPool->lease(webSocketData->deflationLease, webSocketData->pooledCompressOptions);
+                        message = deflationStream->deflate(loopData->zlibContext, message, false);
                     } else {
                         message = loopData->deflationStream->deflate(loopData->zlibContext, message, true);
                     }
@@ -193,23 +197,81 @@ public:
             auto [sendBuffer, sendBufferAttribute] = Super::getSendBuffer(messageFrameSize);
             protocol::formatMessage<isServer>(sendBuffer, message.data(), message.length(), opCode, message.length(), compress, fin);
 
-            /* Depending on size of message we have different paths */
-            if (sendBufferAttribute == SendBufferAttribute::NEEDS_DRAIN) {
-                /* This is a drain */
-                auto[written, failed] = Super::write(nullptr, 0);
-                if (failed) {
-                    /* Return false for failure, skipping to reset the timeout below */
-                    return BACKPRESSURE;
-                }
-            } else if (sendBufferAttribute == SendBufferAttribute::NEEDS_UNCORK) {
-                /* Uncork if we came here uncorked */
-                auto [written, failed] = Super::uncork();
-                if (failed) {
-                    return BACKPRESSURE;
-                }
+            return commitSendBuffer(sendBufferAttribute);
+        }
+
+        return sent();
+    }
+
+    /* Send or buffer a frame formatted once for every receiver of a publish, here or by
+     * another thread of a BroadcastGroup. The frame is deflated once by the loop's shared
+     * compressor (15 window bits, empty window), so only sockets that would compress the
+     * same way can take it: the shared compressor, or a pooled one without a lease that
+     * negotiated the full window. The rest compress the payload themselves; a peer that
+     * asked for a smaller server_max_window_bits cannot inflate back-references past it. */
+    SendStatus sendFrame(const std::shared_ptr<const BroadcastFrame> &frame) {
+        WebSocketContextData<SSL, USERDATA> *webSocketContextData = getContextData();
+        WebSocketData *webSocketData = (WebSocketData *) Super::getAsyncSocketData();
+
+        bool deflatesItself = webSocketData->deflationStream || webSocketData->deflationLease
+            || (webSocketData->deflationPool && ((webSocketData->pooledCompressOptions & CompressOptions::_COMPRESSOR_MASK) >> 4) != 15);
+        if (frame->compress && webSocketData->compressionStatus == WebSocketData::ENABLED && deflatesItself) {
+            return send(frame->message(), (OpCode) frame->opCode, true);
+        }
+
+        if (webSocketContextData->maxBackpressure && webSocketContextData->maxBackpressure < getBufferedAmount()) {
+            if (webSocketContextData->closeOnBackpressureLimit) {
+                us_socket_shutdown_read((us_socket_t *) this);
             }
+            return DROPPED;
+        }
 
+        if (webSocketData->subscriber) {
+            webSocketContextData->topicTree->drain(webSocketData->subscriber);
+        }
+
+        std::string_view bytes = frame->frame;
+        if (webSocketData->compressionStatus == WebSocketData::ENABLED) {
+            std::string_view deflatedFrame = frame->deflate(Super::getLoopData());
+            if (deflatedFrame.length()) {
+                bytes = deflatedFrame;
+            }
+        }
+
+        /* Big frames are referenced from backpressure instead of copied into it */
+        if (bytes.length() >= LoopData::CORK_BUFFER_SIZE) {
+            auto [written, failed] = Super::writeShared(frame, bytes);
+            return failed ? BACKPRESSURE : sent();
+        }
+
+        auto [sendBuffer, sendBufferAttribute] = Super::getSendBuffer(bytes.length());
+        memcpy(sendBuffer, bytes.data(), bytes.length());
+        return commitSendBuffer(sendBufferAttribute);
+    }
+
+private:
+    /* Flushes what getSendBuffer asked us to, then counts the send as successful */
+    SendStatus commitSendBuffer(SendBufferAttribute sendBufferAttribute) {
+        /* Depending on size of message we have different paths */
+        if (sendBufferAttribute == SendBufferAttribute::NEEDS_DRAIN) {
+            /* This is a drain */
+            auto[written, failed] = Super::write(nullptr, 0);
+            if (failed) {
+                /* Return false for failure, skipping to reset the timeout below */
+                return BACKPRESSURE;
+            }
+        } else if (sendBufferAttribute == SendBufferAttribute::NEEDS_UNCORK) {
+            /* Uncork if we came here uncorked */
+            auto [written, failed] = Super::uncork();
+            if (failed) {
+                return BACKPRESSURE;
+            }
         }
+        return sent();
+    }
+
+    SendStatus sent() {
+        WebSocketContextData<SSL, USERDATA> *webSocketContextData = getContextData();
 
         /* Every successful send resets the timeout */
         if (webSocketContextData->resetIdleTimeoutOnSend) {
@@ -222,6 +284,8 @@ public:
         return SUCCESS;
     }
 
+public:
+
     /* Send websocket close frame, emit close event, send FIN if successful.
      * Will not append a close reason if code is 0 or 1005. */
     void end(int code = 0, std::string_view message = {}) {
@@ -257,7 +321,7 @@ public:
 
         /* At this point we iterate all currently held subscriptions and emit an event for all of them */
         if (webSocketData->subscriber && webSocketContextData->subscriptionHandler) {
-            for (Topic *t : webSocketData->subscriber->topics) {
+            for (Topic *t : webSocketData->subscriber->topics()) {
                 webSocketContextData->subscriptionHandler(this, t->name, (int) t->size() - 1, (int) t->size());
             }
         }
@@ -368,7 +432,7 @@ public:
             /* Lock this subscriber for unsubscription / subscription */
             webSocketContextData->topicTree->iteratingSubscriber = webSocketData->subscriber;
 
-            for (Topic *topicPtr : webSocketData->subscriber->topics) {
+            for (Topic *topicPtr : webSocketData->subscriber->topics()) {
                 cb({topicPtr->name.data(), topicPtr->name.length()});
             }
 
@@ -377,45 +441,62 @@ public:
         }
     }
 
-    /* MQTT-style publish that never delivers to this WebSocket (the sender).
-     * Returns the worst receiver SendStatus; no receivers is DROPPED.
-     * Use App::publish for an unconditional broadcast. */
-    SendStatus publish(std::string_view topic, std::string_view message, OpCode opCode = OpCode::TEXT, bool compress = false) {
-        WebSocketContextData<SSL, USERDATA> *webSocketContextData = getContextData();
+    /* Frames the message once and hands that frame to every subscriber of topic but
+     * sender, and to the other threads of the BroadcastGroup. Returns the worst receiver
+     * SendStatus; no receivers is DROPPED. Backs both publish() and App::publish. */
+    static SendStatus publishFrame(TopicTree<TopicTreeMessage, TopicTreeBigMessage> *topicTree, Subscriber *sender, std::string_view topic, std::string_view message, OpCode opCode, bool compress, LoopData *loopData) {
+        Topic *t = topicTree->lookupTopic(topic);
+        BroadcastMember *broadcastMember = topicTree->broadcastMember;
+        bool hasPeers = broadcastMember && broadcastMember->hasPeers();
+        if (!t && !hasPeers) {
+            return DROPPED;
+        }
 
-        /* A sender with no Subscriber (never subscribed to anything) still publishes; nullptr
-         * is a valid "exclude nobody" sender for TopicTree (App::publish relies on this). */
-        WebSocketData *webSocketData = (WebSocketData *) us_socket_ext((us_socket_t *) this);
-        Subscriber *sender = webSocketData->subscriber;
+        std::shared_ptr<const BroadcastFrame> frame = BroadcastFrame::create(topic, message, opCode, compress);
 
-        /* Publish as sender, does not receive its own messages even if subscribed to relevant topics */
+        /* Other threads in our broadcast group get it too; we can't see their receivers */
+        bool forwarded = hasPeers && broadcastMember->publish(frame, loopData);
+        if (!t) {
+            return forwarded ? SUCCESS : DROPPED;
+        }
+
+        SendStatus worst = SUCCESS;
+        bool hasReceivers = false;
+
+        /* Anything big bypasses corking efforts */
         if (message.length() >= LoopData::CORK_BUFFER_SIZE) {
-            SendStatus worst = SUCCESS;
-            bool hasReceivers = false;
-            webSocketContextData->topicTree->publishBig(sender, topic, {message, opCode, compress}, [&worst, &hasReceivers](Subscriber *s, TopicTreeBigMessage &message) {
+            topicTree->publishBig(sender, topic, {std::move(frame)}, [&worst, &hasReceivers](Subscriber *s, TopicTreeBigMessage &message) {
                 hasReceivers = true;
                 auto *ws = (WebSocket<SSL, true, int> *) s->user;
 
-                worst = worseStatus(worst, (SendStatus) ws->send(message.message, (OpCode)message.opCode, message.compress));
+                /* Send will drain if needed */
+                worst = worseStatus(worst, (SendStatus) ws->sendFrame(message.frame));
             });
-            return hasReceivers ? worst : DROPPED;
         } else {
-            Topic *t = webSocketContextData->topicTree->lookupTopic(topic);
-            if (!t) {
-                return DROPPED;
-            }
-            webSocketContextData->topicTree->publish(sender, topic, {std::string(message), opCode, compress});
+            topicTree->publish(sender, topic, {std::move(frame)});
             /* publish() may have synchronously drained a subscriber; check backpressure after. */
-            SendStatus worst = SUCCESS;
-            bool hasReceivers = false;
             for (Subscriber *s : *t) {
                 if (s == sender) continue;
                 hasReceivers = true;
                 auto *ws = (WebSocket<SSL, true, int> *) s->user;
                 worst = worseStatus(worst, (SendStatus) ws->sendStatus());
             }
-            return hasReceivers ? worst : DROPPED;
         }
+        return hasReceivers ? worst : (forwarded ? SUCCESS : DROPPED);
+    }
+
+    /* MQTT-style publish that never delivers to this WebSocket (the sender).
+     * Returns the worst receiver SendStatus; no receivers is DROPPED.
+     * Use App::publish for an unconditional broadcast. */
+    SendStatus publish(std::string_view topic, std::string_view message, OpCode opCode = OpCode::TEXT, bool compress = false) {
+        WebSocketContextData<SSL, USERDATA> *webSocketContextData = getContextData();
+
+        /* A sender with no Subscriber (never subscribed to anything) still publishes; nullptr
+         * is a valid "exclude nobody" sender for TopicTree (App::publish relies on this). */
+        WebSocketData *webSocketData = (WebSocketData *) us_socket_ext((us_socket_t *) this);
+
+        /* Publish as sender, does not receive its own messages even if subscribed to relevant topics */
+        return publishFrame(webSocketContextData->topicTree, webSocketData->subscriber, topic, message, opCode, compress, Super::getLoopData());
     }
 };
 
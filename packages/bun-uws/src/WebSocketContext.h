@@ -96,6 +96,10 @@ private:
 
         /* Is this a non-control frame? */
         if (opCode < 3) {
+            /* Unmasking already proved an uncompressed all-ASCII message valid UTF-8 */
+            bool validateText = opCode == 1 && (webSocketState->state.nonAscii
+                || webSocketData->compressionStatus == WebSocketData::CompressionStatus::COMPRESSED_FRAME);
+
             /* Did we get everything in one go? */
             if (!remainingBytes && fin && !webSocketData->fragmentBuffer.length()) {
 
@@ -122,7 +126,7 @@ private:
                 }
 
                 /* Check text messages for Utf-8 validity */
-                if (opCode == 1 && !protocol::isValidUtf8((unsigned char *) data, length)) {
+                if (validateText && !protocol::isValidUtf8((unsigned char *) data, length)) {
                     forceClose(webSocketState, s, ERR_INVALID_TEXT);
                     return true;
                 }
@@ -183,7 +187,7 @@ private:
                     }
 
                     /* Check text messages for Utf-8 validity */
-                    if (opCode == 1 && !protocol::isValidUtf8((unsigned char *) data, length)) {
+                    if (validateText && !protocol::isValidUtf8((unsigned char *) data, length)) {
                         forceClose(webSocketState, s, ERR_INVALID_TEXT);
                         return true;
                     }
@@ -289,7 +293,7 @@ private:
 
             /* At this point we iterate all currently held subscriptions and emit an event for all of them */
             if (webSocketData->subscriber && webSocketContextData->subscriptionHandler) {
-                for (Topic *t : webSocketData->subscriber->topics) {
+                for (Topic *t : webSocketData->subscriber->topics()) {
                     webSocketContextData->subscriptionHandler((WebSocket<SSL, isServer, USERDATA> *) s, t->name, (int) t->size() - 1, (int) t->size());
                 }
             }
@@ -22,6 +22,7 @@
 #include "AsyncSocket.h"
 
 #include "MoveOnlyFunction.h"
+#include <memory>
 #include <string_view>
 #include <vector>
 
@@ -31,16 +32,15 @@
 
 namespace uWS {
 
-/* Type queued up when publishing */
+struct BroadcastFrame;
+
+/* Type queued up when publishing. Every publish is framed once, by us or by
+ * another thread of our BroadcastGroup, and subscribers share that frame */
 struct TopicTreeMessage {
-    std::string message;
-    /*OpCode*/ int opCode;
-    bool compress;
+    std::shared_ptr<const BroadcastFrame> frame;
 };
 struct TopicTreeBigMessage {
-    std::string_view message;
-    /*OpCode*/ int opCode;
-    bool compress;
+    std::shared_ptr<const BroadcastFrame> frame;
 };
 
 template <bool, bool, typename> struct WebSocket;
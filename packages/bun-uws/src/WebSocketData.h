@@ -21,6 +21,7 @@
 #include "WebSocketProtocol.h"
 #include "AsyncSocketData.h"
 #include "PerMessageDeflate.h"
+#include "DeflationPool.h"
 #include "TopicTree.h"
 
 #include <string>
@@ -47,6 +48,11 @@ private:
 
     /* We might have a dedicated compressor */
     DeflationStream *deflationStream = nullptr;
+    /* Or lease one from the loop's pool, as long as it lets us keep it */
+    DeflationPool *deflationPool = nullptr;
+    DeflationLease *deflationLease = nullptr;
+    /* The window this socket negotiated, for leasing */
+    CompressOptions pooledCompressOptions = CompressOptions::DISABLED;
     /* And / or a dedicated decompressor */
     InflationStream *inflationStream = nullptr;
 
@@ -58,13 +64,19 @@ public:
     /* node http compatibility callbacks */
     OnSocketClosedCallback onSocketClosed = nullptr;
 
-    WebSocketData(bool perMessageDeflate, CompressOptions compressOptions, BackPressure &&backpressure, void *socketData, OnSocketClosedCallback onSocketClosed) : AsyncSocketData<false>(std::move(backpressure)), WebSocketState<true>() {
+    WebSocketData(bool perMessageDeflate, CompressOptions compressOptions, BackPressure &&backpressure, void *socketData, OnSocketClosedCallback onSocketClosed, DeflationPool *loopDeflationPool) : AsyncSocketData<false>(std::move(backpressure)), WebSocketState<true>() {
         compressionStatus = perMessageDeflate ? ENABLED : DISABLED;
 
         /* Initialize the dedicated sliding window(s) */
         if (perMessageDeflate) {
             if ((compressOptions & CompressOptions::_COMPRESSOR_MASK) != CompressOptions::SHARED_COMPRESSOR) {
-                deflationStream = new DeflationStream(compressOptions);
+                if ((compressOptions & CompressOptions::POOLED_COMPRESSOR) && loopDeflationPool) {
+                    deflationPool = loopDeflationPool;
+                    pooledCompressOptions = compressOptions;
+                    deflationPool->attach();
+                } else {
+                    deflationStream = new DeflationStream(compressOptions);
+                }
             }
             if ((compressOptions & CompressOptions::_DECOMPRESSOR_MASK) != CompressOptions::SHARED_DECOMPRESSOR) {
                 inflationStream = new InflationStream(compressOptions);
@@ -81,6 +93,10 @@ public:
             delete deflationStream;
         }
 
+        if (deflationPool) {
+            deflationPool->detach(deflationLease);
+        }
+
         if (inflationStream) {
             delete inflationStream;
         }
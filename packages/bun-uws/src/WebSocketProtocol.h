@@ -25,6 +25,8 @@
 #include <cstdlib>
 #include <string_view>
 
+#include "WebSocketUnmask.h"
+
 // bun-specific
 #include "wtf/SIMDUTF.h"
 
@@ -67,6 +69,9 @@ public:
         unsigned int spillLength : 4;
         signed int opStack : 2; // -1, 0, 1
         unsigned int lastFin : 1;
+        /* Some byte of the current data message may be non-ASCII (cleared when its first
+         * frame starts, set by unmasking) - text messages that stay ASCII skip UTF-8 validation */
+        unsigned int nonAscii : 1;
 
         // 15 bytes
         unsigned char spill[LONG_MESSAGE_HEADER - 1];
@@ -77,6 +82,7 @@ public:
             spillLength = 0;
             opStack = -1;
             lastFin = true;
+            nonAscii = true;
         }
 
     } state;
@@ -209,17 +215,7 @@ static inline size_t formatMessage(char *dst, const char *src, size_t length, Op
     memcpy(dst + headerLength, src, length);
 
     if (!isServer) {
-
-        // overwrites up to 3 bytes outside of the given buffer!
-        //WebSocketProtocol<isServer>::unmaskInplace(dst + headerLength, dst + headerLength + length, mask);
-
-        // this is not optimal
-        char *start = dst + headerLength;
-        char *stop = start + length;
-        int i = 0;
-        while (start != stop) {
-            (*start++) ^= mask[i++ % 4];
-        }
+        unmask(dst + headerLength, dst + headerLength, mask, length);
     }
     return messageLength;
 }
@@ -242,26 +238,17 @@ protected:
     static inline bool rsv1(char *frame) {return *((unsigned char *) frame) & 64;}
     static inline bool isMasked(char *frame) {return ((unsigned char *) frame)[1] & 128;}
 
-    template <int N>
-    static inline void UnrolledXor(char * __restrict data, char * __restrict mask) {
-        if constexpr (N != 1) {
-            UnrolledXor<N - 1>(data, mask);
+    /* Unmasks into place and notes whether the message stayed ASCII */
+    static inline void unmask(char *dst, char *src, char *mask, unsigned int length, WebSocketState<isServer> *wState) {
+        if (!protocol::unmask(dst, src, mask, length)) {
+            wState->state.nonAscii = true;
         }
-        data[N - 1] ^= mask[(N - 1) % 4];
     }
 
-    static inline void unmaskImprecise(char *dst, char *src, char *mask, unsigned int length) {
-        for (unsigned int n = (length >> 2) + 1; n; n--) {
-            *(dst++) = *(src++) ^ mask[0];
-            *(dst++) = *(src++) ^ mask[1];
-            *(dst++) = *(src++) ^ mask[2];
-            *(dst++) = *(src++) ^ mask[3];
-        }
-    }
-
-    static inline void unmaskImpreciseCopyMask(char *src, unsigned int length) {
+    /* Unmasks the payload over its own masking key, 4 bytes back */
+    static inline void unmaskCopyMask(char *src, unsigned int length, WebSocketState<isServer> *wState) {
         char mask[4] = {src[-4], src[-3], src[-2], src[-1]};
-        unmaskImprecise(src-4, src, mask, length);
+        unmask(src - 4, src, mask, length, wState);
     }
 
     static inline void rotateMask(unsigned int offset, char *mask) {
@@ -272,15 +259,6 @@ protected:
         mask[(3 + offset) % 4] = originalMask[3];
     }
 
-    static inline void unmaskInplace(char *data, char *stop, char *mask) {
-        while (data < stop) {
-            *(data++) ^= mask[0];
-            *(data++) ^= mask[1];
-            *(data++) ^= mask[2];
-            *(data++) ^= mask[3];
-        }
-    }
-
     template <unsigned int MESSAGE_HEADER, typename T>
     static inline bool consumeMessage(T payLength, char *&src, unsigned int &length, WebSocketState<isServer> *wState, void *user) {
         if (getOpCode(src)) {
@@ -289,6 +267,10 @@ protected:
                 return true;
             }
             wState->state.opCode[++wState->state.opStack] = (OpCode) getOpCode(src);
+            if (getOpCode(src) < 3) {
+                /* A client never unmasks, so it cannot vouch for ASCII */
+                wState->state.nonAscii = !isServer;
+            }
         } else if (wState->state.opStack == -1) {
             Impl::forceClose(wState, user);
             return true;
@@ -302,7 +284,7 @@ protected:
 
         if (payLength + MESSAGE_HEADER <= length) {
             if (isServer) {
-                unmaskImpreciseCopyMask(src + MESSAGE_HEADER, (unsigned int) payLength);
+                unmaskCopyMask(src + MESSAGE_HEADER, (unsigned int) payLength, wState);
                 if (Impl::handleFragment(src + MESSAGE_HEADER - 4, payLength, 0, wState->state.opCode[wState->state.opStack], isFin(src), wState, user)) {
                     return true;
                 }
@@ -327,7 +309,7 @@ protected:
             bool fin = isFin(src);
             if (isServer) {
                 memcpy(wState->mask, src + MESSAGE_HEADER - 4, 4);
-                unmaskImprecise(src, src + MESSAGE_HEADER, wState->mask, length - MESSAGE_HEADER);
+                unmask(src, src + MESSAGE_HEADER, wState->mask, length - MESSAGE_HEADER, wState);
                 rotateMask(4 - (length - MESSAGE_HEADER) % 4, wState->mask);
             } else {
                 src += MESSAGE_HEADER;
@@ -337,21 +319,10 @@ protected:
         }
     }
 
-    /* This one is nicely vectorized on both ARM64 and X64 - especially with -mavx */
-    static inline void unmaskAll(char * __restrict data, char * __restrict mask) {
-        for (int i = 0; i < LIBUS_RECV_BUFFER_LENGTH; i += 16) {
-            UnrolledXor<16>(data + i, mask);
-        }
-    }
-
     static inline bool consumeContinuation(char *&src, unsigned int &length, WebSocketState<isServer> *wState, void *user) {
         if (wState->remainingBytes <= length) {
             if (isServer) {
-                unsigned int n = wState->remainingBytes >> 2;
-                unmaskInplace(src, src + n * 4, wState->mask);
-                for (unsigned int i = 0, s = wState->remainingBytes % 4; i < s; i++) {
-                    src[n * 4 + i] ^= wState->mask[i];
-                }
+                unmask(src, src, wState->mask, wState->remainingBytes, wState);
             }
 
             if (Impl::handleFragment(src, wState->remainingBytes, 0, wState->state.opCode[wState->state.opStack], wState->state.lastFin, wState, user)) {
@@ -368,16 +339,7 @@ protected:
             return true;
         } else {
             if (isServer) {
-                /* No need to unmask if mask is 0 */
-                uint32_t nullmask = 0;
-                if (memcmp(wState->mask, &nullmask, sizeof(uint32_t))) {
-                    if /*constexpr*/ (LIBUS_RECV_BUFFER_LENGTH == length) {
-                        unmaskAll(src, wState->mask);
-                    } else {
-                        // Slow path
-                        unmaskInplace(src, src + ((length >> 2) + 1) * 4, wState->mask);
-                    }
-                }
+                unmask(src, src, wState->mask, length, wState);
             }
 
             wState->remainingBytes -= length;
@@ -0,0 +1,72 @@
+/*
+ * Authored by Alex Hultman, 2018-2020.
+ * Intellectual property of third-party.
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ *     http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UWS_WEBSOCKETUNMASK_H
+#define UWS_WEBSOCKETUNMASK_H
+
+/* WebSocket payload (un)masking. The same pass ORs the unmasked bytes together
+ * so the caller learns whether they were all ASCII, which for a text message
+ * means they are valid UTF-8 without a second pass. The vector kernel is
+ * highway_websocket_unmask (src/jsc/bindings/highway_strings.cpp); builds
+ * without Highway define UWS_NO_HIGHWAY and XOR a word at a time. */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#ifndef UWS_NO_HIGHWAY
+extern "C" bool highway_websocket_unmask(uint8_t *output, const uint8_t *input, size_t length, uint32_t mask);
+#endif
+
+namespace uWS {
+
+namespace protocol {
+
+/* XORs length bytes of src with the 4-byte mask into dst, which may be src or
+ * trail it. Returns whether every resulting byte is ASCII */
+static inline bool unmask(char *dst, const char *src, const char *mask, size_t length) {
+    uint32_t mask32;
+    memcpy(&mask32, mask, 4);
+#ifndef UWS_NO_HIGHWAY
+    /* Short payloads (most chat-sized messages) are faster in the word loop
+     * than through the dispatched call and its partial-vector tail */
+    if (length >= 128) {
+        return highway_websocket_unmask((uint8_t *) dst, (const uint8_t *) src, length, mask32);
+    }
+#endif
+    uint64_t mask64 = ((uint64_t) mask32 << 32) | mask32, seen = 0;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, src + i, 8);
+        word ^= mask64;
+        memcpy(dst + i, &word, 8);
+        seen |= word;
+    }
+    unsigned char seenTail = 0;
+    for (; i < length; i++) {
+        dst[i] = src[i] ^ mask[i % 4];
+        seenTail |= (unsigned char) dst[i];
+    }
+    return !(seen & 0x8080808080808080ull) && seenTail < 0x80;
+}
+
+}
+
+}
+
+#endif // UWS_WEBSOCKETUNMASK_H
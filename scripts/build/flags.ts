@@ -1677,6 +1677,16 @@ export const fileOverrides: FileOverride[] = [
     when: c => c.windows,
     desc: "Vendored electron/rcedit; VersionInfo ctor throws std::system_error caught in OnEnumResourceLanguage. Self-contained throw/catch — already excluded from PCH",
   },
+  {
+    file: "src/jsc/bindings/highway_http.cpp",
+    extraFlags: ["-O2"],
+    when: c => c.debug,
+    desc:
+      "Always optimize the HTTP request-head index kernel (debug builds use -O0 globally). uWS runs it " +
+      "on every request head it parses, and at -O0 each highway op is an outlined call passing vectors " +
+      "through the stack, the pattern that faults under the debug sanitizer set in highway_json.cpp. " +
+      "Covered by test/js/bun/http/bun-serve-headers.test.ts.",
+  },
   {
     file: "src/jsc/bindings/highway_xml.cpp",
     extraFlags: ["-O2"],
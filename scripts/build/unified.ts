@@ -141,6 +141,9 @@ const noUnify: readonly string[] = [
   "src/jsc/bindings/highway_json.cpp",
   // Sixth highway TU (XML structural indexer) — same reason.
   "src/jsc/bindings/highway_xml.cpp",
+  // Seventh highway TU (HTTP request-head indexer for uWS's HttpParser) —
+  // same reason.
+  "src/jsc/bindings/highway_http.cpp",
   // Declares its own minimal CGRect/kCFStringEncodingUTF8/kCFNumberDoubleType
   // so it doesn't pull a CoreGraphics load command; bundled with files that
   // include the real CF headers those names become ambiguous.
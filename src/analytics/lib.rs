@@ -520,6 +520,73 @@ pub mod generate_header {
             }
         }
 
+        #[unsafe(no_mangle)]
+        extern "C" fn Bun__isIoUringEventLoopEnabled() -> i32 {
+            // Android's seccomp policy blocks io_uring_setup outright.
+            #[cfg(not(target_os = "linux"))]
+            {
+                0
+            }
+            #[cfg(target_os = "linux")]
+            {
+                if !env_var::feature_flag::BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING
+                    .get()
+                    .unwrap_or(false)
+                {
+                    return 0;
+                }
+
+                // IORING_SETUP_DEFER_TASKRUN (6.1) is what keeps completions
+                // on the loop thread; multishot recv and provided buffer
+                // rings (5.19) come with it.
+                let min_io_uring = semver::Version {
+                    major: 6,
+                    minor: 1,
+                    patch: 0,
+                    ..Default::default()
+                };
+
+                match kernel_version().order(min_io_uring, b"", b"") {
+                    core::cmp::Ordering::Greater => 1,
+                    core::cmp::Ordering::Equal => 1,
+                    core::cmp::Ordering::Less => 0,
+                }
+            }
+        }
+
+        #[unsafe(no_mangle)]
+        extern "C" fn Bun__isKernelTLSEnabled() -> i32 {
+            #[cfg(not(any(target_os = "linux", target_os = "android")))]
+            {
+                0
+            }
+            #[cfg(any(target_os = "linux", target_os = "android"))]
+            {
+                if !env_var::feature_flag::BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS
+                    .get()
+                    .unwrap_or(false)
+                {
+                    return 0;
+                }
+
+                // TLS 1.3 TX landed in 5.1 and ChaCha20-Poly1305 in 5.11;
+                // older kernels refuse the key and would only waste the
+                // attempt on every large response.
+                let min_ktls = semver::Version {
+                    major: 5,
+                    minor: 11,
+                    patch: 0,
+                    ..Default::default()
+                };
+
+                match kernel_version().order(min_ktls, b"", b"") {
+                    core::cmp::Ordering::Greater => 1,
+                    core::cmp::Ordering::Equal => 1,
+                    core::cmp::Ordering::Less => 0,
+                }
+            }
+        }
+
         #[cfg(any(target_os = "linux", target_os = "android"))]
         fn for_linux() -> Platform {
             // Confusingly, the "release" tends to contain the kernel version much more frequently than the "version" field.
@@ -268,6 +268,12 @@ pub mod feature_flag {
     // the client implementation matures. `--experimental-http3-fetch` is the
     // CLI equivalent.
     new_feature_flag!(pub BUN_FEATURE_FLAG_EXPERIMENTAL_HTTP3_CLIENT, "BUN_FEATURE_FLAG_EXPERIMENTAL_HTTP3_CLIENT", {});
+    // Linux 6.1+: accept and read TCP sockets through an io_uring (multishot
+    // accept/recv into a provided buffer ring) layered over the epoll loop.
+    new_feature_flag!(pub BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING, "BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING", {});
+    // Linux 5.11+: once a TLS server connection sends a large static file,
+    // hand its record encryption to the kernel (kTLS) so sendfile() works.
+    new_feature_flag!(pub BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS, "BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS", {});
     new_feature_flag!(pub BUN_FEATURE_FLAG_FORCE_IO_POOL, "BUN_FEATURE_FLAG_FORCE_IO_POOL", {});
     new_feature_flag!(pub BUN_FEATURE_FLAG_FORCE_WINDOWS_JUNCTIONS, "BUN_FEATURE_FLAG_FORCE_WINDOWS_JUNCTIONS", {});
     new_feature_flag!(pub BUN_INSTRUMENTS, "BUN_INSTRUMENTS", {});
@@ -521,7 +521,8 @@ impl<const SSL: bool> HTTPContext<SSL> {
                     uws::create_bun_socket_error_t::invalid_crl => InitError::InvalidCRL,
                     uws::create_bun_socket_error_t::none
                     | uws::create_bun_socket_error_t::invalid_ciphers
-                    | uws::create_bun_socket_error_t::invalid_ecdh_curve => {
+                    | uws::create_bun_socket_error_t::invalid_ecdh_curve
+                    | uws::create_bun_socket_error_t::invalid_ticket_keys => {
                         InitError::FailedToOpenSocket
                     }
                 });
@@ -1034,7 +1035,7 @@ impl<const SSL: bool> HTTPContext<SSL> {
             }
         }
 
-        let socket = HTTPSocket::<SSL>::connect_group(
+        let socket = HTTPSocket::<SSL>::connect_group_with_options(
             &mut self.group,
             Self::KIND,
             if SSL { self.secure } else { None },
@@ -1047,7 +1048,11 @@ impl<const SSL: bool> HTTPContext<SSL> {
                     .cast::<HTTPClient<'static>>(),
             )
             .ptr(),
-            false,
+            if client.flags.fast_open {
+                uws::LIBUS_SOCKET_FAST_OPEN
+            } else {
+                0
+            },
         )?;
         client.allow_retry = false;
         if SSL {
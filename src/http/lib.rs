@@ -201,6 +201,8 @@ pub struct Flags {
     pub forced_protocol: Option<Protocol>,
     pub(crate) h3_retried: bool,
     pub is_node_http_client: bool,
+    /// Open new connections with TCP Fast Open (`tcpFastOpen`).
+    pub fast_open: bool,
 }
 
 impl Default for Flags {
@@ -222,6 +224,7 @@ impl Default for Flags {
             forced_protocol: None,
             h3_retried: false,
             is_node_http_client: false,
+            fast_open: false,
         }
     }
 }
@@ -284,7 +287,7 @@ pub static OVERRIDDEN_DEFAULT_USER_AGENT: std::sync::OnceLock<&'static [u8]> =
 /// absolute deadline for the header block to complete (undici `headersTimeout`
 /// semantics). 0 disables the timer (matching `disable_timeout = true`).
 /// Overridable via `BUN_CONFIG_HTTP_IDLE_TIMEOUT`. Default is 5 minutes.
-/// `HTTPThread::on_start` stores it padded for the timer-wheel sweep (see
+/// `HTTPThread::on_start` stores it rounded for the long timeout (see
 /// [`normalize_idle_timeout_seconds`]).
 pub(crate) static IDLE_TIMEOUT_SECONDS: AtomicU32 = AtomicU32::new(300);
 
@@ -294,30 +297,19 @@ pub(crate) fn idle_timeout_seconds() -> c_uint {
     IDLE_TIMEOUT_SECONDS.load(Ordering::Relaxed)
 }
 
-/// Normalise an idle timeout (seconds) for uSockets' timer wheels. The sweep
-/// phase is unrelated to when a socket arms its timer, so a timer armed for N
-/// ticks can fire up to one period (4s short wheel, 60s long wheel) before
-/// the requested duration (#39952). Pad by one period so it never fires
-/// early, and clamp so the padded value stays at the long wheel's 239 min
-/// maximum. 0 = disabled.
+/// Normalise an idle timeout (seconds) for `SocketTimeout::set_timeout`, which
+/// arms anything above 240s as whole minutes on the long timeout. Round those
+/// up to a minute so its floor division never shortens them. uSockets' timeout
+/// wheel itself never fires early (#39952). 0 = disabled.
 #[inline]
 pub fn normalize_idle_timeout_seconds(raw: u64) -> c_uint {
-    if raw == 0 {
-        return 0;
-    }
-    /// `LIBUS_TIMEOUT_GRANULARITY` (packages/bun-usockets/src/libusockets.h).
-    const SHORT_WHEEL_PERIOD_SECONDS: u64 = 4;
-    const LONG_WHEEL_PERIOD_SECONDS: u64 = 60;
-    /// `SocketTimeout::set_timeout` routes values above this to the long wheel.
-    const SHORT_WHEEL_MAX_SECONDS: u64 = 240;
-    /// The long counter wraps `% 240` minutes; one minute of pad stays below.
-    const MAX_RAW_SECONDS: u64 = 238 * LONG_WHEEL_PERIOD_SECONDS;
-    let raw = raw.min(MAX_RAW_SECONDS);
-    (if raw + SHORT_WHEEL_PERIOD_SECONDS > SHORT_WHEEL_MAX_SECONDS {
-        (raw.div_ceil(LONG_WHEEL_PERIOD_SECONDS) + 1) * LONG_WHEEL_PERIOD_SECONDS
-    } else {
-        raw + SHORT_WHEEL_PERIOD_SECONDS
-    }) as c_uint
+    /// `SocketTimeout::set_timeout` routes values above this to the long timeout.
+    const SHORT_TIMEOUT_MAX_SECONDS: u64 = 240;
+    const MAX_SECONDS: u64 = (c_uint::MAX as u64 / 60) * 60;
+    if raw <= SHORT_TIMEOUT_MAX_SECONDS {
+        return raw as c_uint;
+    }
+    raw.div_ceil(60).saturating_mul(60).min(MAX_SECONDS) as c_uint
 }
 
 pub const END_OF_CHUNKED_HTTP1_1_ENCODING_RESPONSE_BODY: &[u8] = b"0\r\n\r\n";
@@ -1872,6 +1864,7 @@ impl<'a> HTTPClient<'a> {
                                 0
                             },
                         );
+                        crate::session_cache::set_early_data(ssl_ptr, self.can_send_early_data());
                     }
                 }
             }
@@ -1952,6 +1945,19 @@ impl<'a> HTTPClient<'a> {
                 .unwrap_or(false)
     }
 
+    /// Whether the request may go out as TLS 1.3 early data (`tls.earlyData`).
+    /// A server can replay early data, so only bodiless GET/HEAD requests on
+    /// a direct HTTP/1.1 connection qualify.
+    pub(crate) fn can_send_early_data(&self) -> bool {
+        self.tls_props
+            .as_ref()
+            .is_some_and(|tls| tls.get().early_data)
+            && matches!(self.method, Method::GET | Method::HEAD)
+            && matches!(&self.state.original_request_body, HTTPRequestBody::Bytes(body) if body.is_empty())
+            && self.http_proxy.is_none()
+            && !self.can_offer_h2()
+    }
+
     pub(crate) fn alpn_offer(&self) -> AlpnOffer {
         if !self.can_offer_h2() {
             return AlpnOffer::H1;
@@ -9,7 +9,7 @@
 //! HTTP-thread-only.
 
 use core::cell::RefCell;
-use core::ffi::c_void;
+use core::ffi::{c_int, c_void};
 use core::ptr::NonNull;
 
 use bun_boringssl_sys::{SSL, SSL_SESSION, SSL_SESSION_free, SSL_set_session};
@@ -174,6 +174,7 @@ unsafe extern "C" {
         on_free: Option<extern "C" fn(*mut c_void)>,
     );
     fn us_ssl_get_session_sink_owner(ssl: *mut SSL) -> *mut c_void;
+    fn us_ssl_set_early_data(ssl: *mut SSL, enabled: c_int);
 }
 
 /// Whether this TLS client should read/write the cache. Lax verification and
@@ -188,6 +189,18 @@ pub(crate) fn eligible(client: &crate::HTTPClient<'_>) -> bool {
             .unwrap_or(false)
 }
 
+/// Let `ssl` send its first flight as TLS 1.3 early data if the session it
+/// resumes allows it. usockets writes it again after the handshake if the
+/// server rejects it.
+///
+/// # Safety
+/// `ssl` must be a live pre-handshake `SSL*`.
+pub(crate) unsafe fn set_early_data(ssl: *mut SSL, enabled: bool) {
+    debug_assert!(!ssl.is_null());
+    // SAFETY: caller contract.
+    unsafe { us_ssl_set_early_data(ssl, c_int::from(enabled)) };
+}
+
 /// Offer any cached session for this key and install an unarmed sink.
 ///
 /// # Safety
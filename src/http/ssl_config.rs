@@ -39,6 +39,12 @@ pub struct SSLConfig {
     pub allow_partial_trust_chain: bool,
     pub sigalgs: CStrPtr,
     pub ecdh_curve: CStrPtr,
+    /// Session ticket keys shared with other processes; re-read on rotation.
+    pub ticket_keys_file_name: CStrPtr,
+    /// Signs handshakes on this many crypto workers instead of the event loop; 0 = inline.
+    pub handshake_threads: u32,
+    /// Servers accept TLS 1.3 early data; clients may send it on resumed sessions.
+    pub early_data: bool,
     /// Minimum/maximum TLS protocol version (TLS1_VERSION..TLS1_3_VERSION); 0 = unset/default.
     pub ssl_min_version: i32,
     pub ssl_max_version: i32,
@@ -109,6 +115,9 @@ impl SSLConfig {
         allow_partial_trust_chain: false,
         sigalgs: core::ptr::null(),
         ecdh_curve: core::ptr::null(),
+        ticket_keys_file_name: core::ptr::null(),
+        handshake_threads: 0,
+        early_data: false,
         ssl_min_version: 0,
         ssl_max_version: 0,
         request_cert: 0,
@@ -214,6 +223,8 @@ impl SSLConfig {
         ctx_opts.client_renegotiation_limit = self.client_renegotiation_limit;
         ctx_opts.client_renegotiation_window = self.client_renegotiation_window;
         ctx_opts.session_timeout = self.session_timeout;
+        ctx_opts.handshake_threads = self.handshake_threads;
+        ctx_opts.early_data = i32::from(self.early_data);
         ctx_opts.allow_partial_trust_chain = i32::from(self.allow_partial_trust_chain);
         if !self.sigalgs.is_null() {
             ctx_opts.sigalgs = self.sigalgs;
@@ -221,6 +232,9 @@ impl SSLConfig {
         if !self.ecdh_curve.is_null() {
             ctx_opts.ecdh_curve = self.ecdh_curve;
         }
+        if !self.ticket_keys_file_name.is_null() {
+            ctx_opts.ticket_keys_file = self.ticket_keys_file_name;
+        }
         if let Some(crl) = &self.crl {
             ctx_opts.crl = crl.as_ptr();
             ctx_opts.crl_count = crl.len() as u32;
@@ -298,6 +312,11 @@ impl SSLConfig {
         }
         eq_cstr!(sigalgs);
         eq_cstr!(ecdh_curve);
+        eq_cstr!(ticket_keys_file_name);
+        if self.handshake_threads != other.handshake_threads || self.early_data != other.early_data
+        {
+            return false;
+        }
         if self.ssl_min_version != other.ssl_min_version {
             return false;
         }
@@ -373,6 +392,9 @@ impl SSLConfig {
         hasher.update(&[self.allow_partial_trust_chain as u8]);
         hash_cstr!(sigalgs);
         hash_cstr!(ecdh_curve);
+        hash_cstr!(ticket_keys_file_name);
+        hasher.update(&self.handshake_threads.to_ne_bytes());
+        hasher.update(&[self.early_data as u8]);
         hasher.update(&self.ssl_min_version.to_ne_bytes());
         hasher.update(&self.ssl_max_version.to_ne_bytes());
         hasher.update(&self.request_cert.to_ne_bytes());
@@ -414,6 +436,7 @@ impl SSLConfig {
         free_strings(&mut self.crl);
         free_string(&mut self.sigalgs);
         free_string(&mut self.ecdh_curve);
+        free_string(&mut self.ticket_keys_file_name);
         free_string(&mut self.ssl_ciphers);
         free_string(&mut self.protos);
     }
@@ -472,6 +495,9 @@ impl Clone for SSLConfig {
             allow_partial_trust_chain: self.allow_partial_trust_chain,
             sigalgs: clone_string(self.sigalgs),
             ecdh_curve: clone_string(self.ecdh_curve),
+            ticket_keys_file_name: clone_string(self.ticket_keys_file_name),
+            handshake_threads: self.handshake_threads,
+            early_data: self.early_data,
             ssl_min_version: self.ssl_min_version,
             ssl_max_version: self.ssl_max_version,
             request_cert: self.request_cert,
@@ -54,9 +54,9 @@ use bun_http::ssl_config::SSLConfig;
 bun_core::define_scoped_log!(log, WebSocketUpgradeClient, visible);
 bun_core::declare_scope!(alloc, hidden);
 
-/// Opening-handshake timeout in seconds, normalised for uSockets' timer
-/// wheel (short-timeout counter wraps at 240 ticks; `set_timeout` routes
-/// larger values onto the minute-granularity long timer). 0 disables.
+/// Opening-handshake timeout in seconds, normalised for `set_timeout`, which
+/// routes values above 240s onto the minute-granularity long timeout.
+/// 0 disables.
 #[inline]
 fn handshake_timeout_seconds() -> core::ffi::c_uint {
     bun_http::normalize_idle_timeout_seconds(
@@ -5,6 +5,7 @@ const kSafeIntegersFlag = 1 << 1;
 const kStrictFlag = 1 << 2;
 const kOwnedByDatabaseFlag = 1 << 3;
 const kPrepareOwned = Symbol("prepareOwned");
+const kBlobToken = Symbol("blob");
 
 const defineProperties = Object.defineProperties;
 const toStringTag = Symbol.toStringTag;
@@ -99,12 +100,15 @@ const constants = {
 // This is interface is the JS equivalent of what JSSQLStatement.cpp defines
 interface CppSQLStatement {
   run: (...args: TODO[]) => TODO;
+  runBatch: (changes: TODO, rows: TODO, transaction: boolean) => void;
   get: (...args: TODO[]) => TODO;
   all: (...args: TODO[]) => TODO;
+  allAsync: (...args: TODO[]) => Promise<TODO>;
   iterate: (...args: TODO[]) => TODO;
   as: (...args: TODO[]) => TODO;
   values: (...args: TODO[]) => TODO;
   raw: (...args: TODO[]) => TODO;
+  columnar: (...args: TODO[]) => TODO;
   finalize: (...args: TODO[]) => TODO;
   toString: (...args: TODO[]) => TODO;
   isFinalized: boolean;
@@ -123,6 +127,12 @@ interface CppSQL {
   serialize(handle: TODO, name: string): Buffer;
   deserialize(serialized: NodeJS.TypedArray | ArrayBufferLike, openFlags: number, deserializeFlags: number): TODO;
   fcntl(handle: TODO, ...args: TODO[]): TODO;
+  blobOpen(handle: TODO, schema: string, table: string, column: string, rowid: number | bigint, writable: boolean): number;
+  blobReopen(handle: TODO, id: number, rowid: number | bigint): number;
+  blobSize(handle: TODO, id: number): number;
+  blobRead(handle: TODO, id: number, offset: number, view: ArrayBufferView): number;
+  blobWrite(handle: TODO, id: number, offset: number, view: ArrayBufferView): void;
+  blobClose(handle: TODO, id: number): void;
   close(handle: TODO, throwOnError: boolean): void;
   setCustomSQLite(path: string): void;
 }
@@ -197,6 +207,22 @@ class Statement {
     return this.#raw.all();
   }
 
+  allAsync(...args) {
+    if (args.length === 0) return this.#raw.allAsync();
+    var arg0 = args[0];
+    return !isArray(arg0) && (!arg0 || typeof arg0 !== "object" || isTypedArray(arg0))
+      ? this.#raw.allAsync(args)
+      : this.#raw.allAsync(...args);
+  }
+
+  columnar(...args) {
+    if (args.length === 0) return this.#raw.columnar();
+    var arg0 = args[0];
+    return !isArray(arg0) && (!arg0 || typeof arg0 !== "object" || isTypedArray(arg0))
+      ? this.#raw.columnar(args)
+      : this.#raw.columnar(...args);
+  }
+
   *#iterateNoArgs() {
     for (let res = this.#raw.iterate(); res; res = this.#raw.iterate()) {
       yield res;
@@ -313,6 +339,11 @@ class Statement {
     return createChangesObject();
   }
 
+  runBatch(rows, options?) {
+    this.#raw.runBatch(internalFieldTuple, rows, options?.transaction ?? true);
+    return createChangesObject();
+  }
+
   get columnNames() {
     return this.#raw.columns;
   }
@@ -346,6 +377,144 @@ class Statement {
 
 const cachedCount = Symbol.for("Bun.Database.cache.count");
 
+function validateBlobOffset(offset) {
+  if (!Number.isInteger(offset) || offset < 0 || offset > 0xffffffff) {
+    throw new RangeError("Expected offset to be a non-negative integer");
+  }
+  return offset;
+}
+
+function toBlobView(data) {
+  if (isTypedArray(data)) return data;
+  if (data instanceof ArrayBuffer || data instanceof SharedArrayBuffer) return new Uint8Array(data);
+  throw new TypeError("Expected data to be a TypedArray, DataView or ArrayBuffer");
+}
+
+// sqlite3_blob handles dropped without close() are closed when their owner is
+// collected. Blob ids are never reused within a database, so a late close of
+// an id that is already gone is a no-op.
+const blobRegistry = new FinalizationRegistry<{ handle: number; id: number }>(({ handle, id }) =>
+  SQL.blobClose(handle, id),
+);
+
+function openBlobHandle(owner, handle, source, rowid, writable) {
+  const id = SQL.blobOpen(handle, source.schema, source.table, source.column, rowid, writable);
+  const held = { handle, id };
+  blobRegistry.register(owner, held, held);
+  return held;
+}
+
+function closeBlobHandle(held) {
+  blobRegistry.unregister(held);
+  SQL.blobClose(held.handle, held.id);
+}
+
+// An open sqlite3_blob handle from Database#openBlob(). Reads and writes go
+// directly between the blob and the caller's buffer, so a large value can be
+// streamed without ever being held in memory whole.
+class SQLiteBlob {
+  #handle;
+  #id;
+  #held;
+  #source;
+  #rowid;
+  #size;
+
+  constructor(token, handle, source, rowid, writable) {
+    if (token !== kBlobToken) {
+      throw new TypeError("SQLiteBlob can only be constructed by Database#openBlob()");
+    }
+    this.#held = openBlobHandle(this, handle, source, rowid, writable);
+    this.#handle = handle;
+    this.#id = this.#held.id;
+    this.#source = source;
+    this.#rowid = rowid;
+    this.#size = SQL.blobSize(handle, this.#id);
+  }
+
+  get size() {
+    return this.#size;
+  }
+
+  // Fills `buffer` from `offset` and returns the number of bytes read, which
+  // is less than its length only at the end of the blob.
+  read(buffer, offset = 0) {
+    return SQL.blobRead(this.#handle, this.#id, validateBlobOffset(offset), toBlobView(buffer));
+  }
+
+  write(data, offset = 0) {
+    SQL.blobWrite(this.#handle, this.#id, validateBlobOffset(offset), toBlobView(data));
+  }
+
+  reopen(rowid) {
+    this.#size = SQL.blobReopen(this.#handle, this.#id, rowid);
+    this.#rowid = rowid;
+  }
+
+  // The stream reads through a handle of its own, closed at the end of the
+  // blob, on cancel, or when the stream is collected, so it neither holds
+  // this blob open nor follows a later reopen().
+  stream(chunkSize = 65536) {
+    if (!Number.isInteger(chunkSize) || chunkSize <= 0) {
+      throw new RangeError("Expected chunkSize to be a positive integer");
+    }
+    // Throws like read() once this blob or its database has closed.
+    SQL.blobSize(this.#handle, this.#id);
+    let held;
+    let position = 0;
+    const stream = new ReadableStream({
+      type: "bytes",
+      autoAllocateChunkSize: chunkSize,
+
+      pull(controller) {
+        const request = controller.byobRequest;
+        if (request === null) return;
+        let bytesRead;
+        try {
+          bytesRead = SQL.blobRead(held.handle, held.id, position, request.view);
+        } catch (error) {
+          closeBlobHandle(held);
+          throw error;
+        }
+        position += bytesRead;
+        if (bytesRead === 0) {
+          closeBlobHandle(held);
+          controller.close();
+        }
+        request.respond(bytesRead);
+      },
+
+      cancel() {
+        closeBlobHandle(held);
+      },
+    });
+    held = openBlobHandle(stream, this.#handle, this.#source, this.#rowid, false);
+    return stream;
+  }
+
+  bytes() {
+    const bytes = new Uint8Array(this.#size);
+    this.read(bytes);
+    return Promise.resolve(bytes);
+  }
+
+  arrayBuffer() {
+    return this.bytes().then(bytes => bytes.buffer);
+  }
+
+  text() {
+    return this.bytes().then(bytes => new TextDecoder().decode(bytes));
+  }
+
+  close() {
+    closeBlobHandle(this.#held);
+  }
+
+  [Symbol.dispose]() {
+    this.close();
+  }
+}
+
 class Database implements SqliteTypes.Database {
   constructor(
     filenameGiven: string | undefined | NodeJS.TypedArray | Buffer<ArrayBufferLike>,
@@ -486,6 +655,11 @@ class Database implements SqliteTypes.Database {
     return SQL.setCustomSQLite(path);
   }
 
+  openBlob(table, column, rowid, options?) {
+    const source = { schema: options?.schema ?? "main", table, column };
+    return new SQLiteBlob(kBlobToken, this.#handle, source, rowid, !!options?.writable);
+  }
+
   fileControl(_cmd, _arg) {
     const handle = this.#handle;
 
@@ -675,4 +849,5 @@ export default {
   constants,
   default: Database,
   SQLiteError,
+  SQLiteBlob,
 };
@@ -72,6 +72,8 @@ const shellParse = $newRustFunction("shell.rs", "TestingAPIs.shellParse", 2);
 
 export const sslCtxLiveCount = $newRustFunction("SecureContext.rs", "jsLiveCount", 0);
 
+export const caStoreCacheStats = $newRustFunction("SecureContext.rs", "jsCaStoreCacheStats", 0);
+
 export const napiThreadsafeFunctionLiveCount = $newRustFunction("napi_body.rs", "jsThreadsafeFunctionLiveCount", 0);
 
 export const escapeRegExp = $newRustFunction("escapeRegExp.rs", "jsEscapeRegExp", 1);
@@ -656,6 +658,30 @@ export const structuredCloneAdvanced: (
   serializationContext: SerializationContext,
 ) => any = $newCppFunction("StructuredClone.cpp", "jsFunctionStructuredCloneAdvanced", 5);
 
+export const uwsCorkStats: () => {
+  evictions: number;
+  steals: number;
+  batchedFlushes: number;
+  pipelineBatches: number;
+  highWater: number;
+  slots: number;
+  corked: number;
+} = $newCppFunction("InternalForTesting.cpp", "jsFunction_uwsCorkStats", 0);
+
+export const uwsCorkPoolProbe: (count: number) => {
+  initialSlots: number;
+  slots: number;
+  corked: number;
+  evictions: number;
+  evicted: number[];
+} = $newCppFunction("InternalForTesting.cpp", "jsFunction_uwsCorkPoolProbe", 1);
+
+export const haveSameStructure: (a: object, b: object) => boolean = $newCppFunction(
+  "InternalForTesting.cpp",
+  "jsFunction_haveSameStructure",
+  2,
+);
+
 export const isASANEnabled: () => boolean = $newCppFunction("InternalForTesting.cpp", "jsFunction_isASANEnabled", 0);
 
 export const BunString_toThreadSafeRefCountDelta: () => number = $newCppFunction(
@@ -6,6 +6,8 @@
 #include "JavaScriptCore/JSArrayBufferView.h"
 #include "headers-handwritten.h"
 #include "webcore/HTTPHeaderMap.h"
+#include "JavaScriptCore/JSArray.h"
+#include <bun-uws/src/Loop.h>
 #include <wtf/text/StringImpl.h>
 #include <wtf/text/WTFString.h>
 
@@ -48,6 +50,15 @@ JSC_DEFINE_HOST_FUNCTION(jsFunction_hasReifiedStatic, (JSC::JSGlobalObject * glo
     return JSValue::encode(jsBoolean(false));
 }
 
+// Whether two objects currently share one Structure, so a test can check that
+// values built by the same native path end up with an identical shape.
+JSC_DEFINE_HOST_FUNCTION(jsFunction_haveSameStructure, (JSC::JSGlobalObject * globalObject, JSC::CallFrame* callFrame))
+{
+    auto* a = callFrame->argument(0).getObject();
+    auto* b = callFrame->argument(1).getObject();
+    return JSValue::encode(jsBoolean(a && b && a->structure() == b->structure()));
+}
+
 // Side-effect-free report of whether this binary was compiled with
 // AddressSanitizer. Lets the test harness detect ASAN cheaply.
 JSC_DEFINE_HOST_FUNCTION(jsFunction_isASANEnabled, (JSC::JSGlobalObject * globalObject, JSC::CallFrame* callFrame))
@@ -111,4 +122,68 @@ JSC_DEFINE_HOST_FUNCTION(jsFunction_isMemoryPressureWatcherInstalled, (JSC::JSGl
     return JSValue::encode(jsBoolean(Bun__MemoryPressure__isInstalled(defaultGlobalObject(globalObject))));
 }
 
+// Cork pool counters of this thread's uWS loop (LoopData::corkStats), plus
+// the pool's current size and the number of sockets corked right now.
+JSC_DEFINE_HOST_FUNCTION(jsFunction_uwsCorkStats, (JSC::JSGlobalObject * globalObject, JSC::CallFrame* callFrame))
+{
+    uWS::LoopData* loopData = uWS::Loop::data((us_loop_t*)uWS::Loop::get());
+    const auto& stats = loopData->corkStats;
+    auto* object = constructEmptyObject(globalObject, globalObject->objectPrototype(), 7);
+    auto& vm = globalObject->vm();
+    object->putDirect(vm, Identifier::fromString(vm, "evictions"_s), jsNumber(stats.evictions));
+    object->putDirect(vm, Identifier::fromString(vm, "steals"_s), jsNumber(stats.steals));
+    object->putDirect(vm, Identifier::fromString(vm, "batchedFlushes"_s), jsNumber(stats.batchedFlushes));
+    object->putDirect(vm, Identifier::fromString(vm, "pipelineBatches"_s), jsNumber(stats.pipelineBatches));
+    object->putDirect(vm, Identifier::fromString(vm, "highWater"_s), jsNumber(stats.highWater));
+    object->putDirect(vm, Identifier::fromString(vm, "slots"_s), jsNumber(loopData->getCorkPoolSize()));
+    object->putDirect(vm, Identifier::fromString(vm, "corked"_s), jsNumber(loopData->getCorkedCount()));
+    return JSValue::encode(object);
+}
+
+// Corks `count` stand-in sockets one after another on a fresh LoopData, the
+// way AsyncSocket::cork() does, each writing a byte so no slot can be stolen.
+// Once the pool is full, socket 0 writes again, so the evictions that follow
+// must pick sockets 1, 2, ... in LRU order. Real sockets cannot be corked
+// this many at once from JS, and the stand-ins are never dereferenced.
+JSC_DEFINE_HOST_FUNCTION(jsFunction_uwsCorkPoolProbe, (JSC::JSGlobalObject * globalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = globalObject->vm();
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    int count = callFrame->argument(0).toInt32(globalObject);
+    RETURN_IF_EXCEPTION(scope, {});
+
+    auto loopData = makeUnique<uWS::LoopData>();
+    auto socket = [](int i) { return reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1) * 16); };
+    auto write = [&](int slot) {
+        loopData->getCorkSlot(slot)->offset++;
+        loopData->touchCorkSlot(slot);
+    };
+
+    int initialSlots = loopData->getCorkPoolSize();
+    MarkedArgumentBuffer evicted;
+    for (int i = 0; i < count; i++) {
+        if (i == uWS::LoopData::MAX_CORK_SLOTS) {
+            write(loopData->findCorkSlot(socket(0)));
+        }
+        int slot = loopData->acquireCorkSlot(socket(i), false);
+        if (slot == uWS::LoopData::INVALID_CORK_SLOT) {
+            void* victim = loopData->evictCorkSlot()->socket;
+            evicted.append(jsNumber(static_cast<int>(reinterpret_cast<uintptr_t>(victim) / 16) - 1));
+            loopData->releaseCorkSlot(loopData->findCorkSlot(victim));
+            slot = loopData->acquireCorkSlot(socket(i), false);
+        }
+        write(slot);
+    }
+
+    auto* object = constructEmptyObject(globalObject, globalObject->objectPrototype(), 5);
+    object->putDirect(vm, Identifier::fromString(vm, "initialSlots"_s), jsNumber(initialSlots));
+    object->putDirect(vm, Identifier::fromString(vm, "slots"_s), jsNumber(loopData->getCorkPoolSize()));
+    object->putDirect(vm, Identifier::fromString(vm, "corked"_s), jsNumber(loopData->getCorkedCount()));
+    object->putDirect(vm, Identifier::fromString(vm, "evictions"_s), jsNumber(loopData->corkStats.evictions));
+    JSArray* evictedArray = constructArray(globalObject, static_cast<ArrayAllocationProfile*>(nullptr), evicted);
+    RETURN_IF_EXCEPTION(scope, {});
+    object->putDirect(vm, Identifier::fromString(vm, "evicted"_s), evictedArray);
+    return JSValue::encode(object);
+}
+
 }
@@ -38,6 +38,7 @@ class NapiHandleScopeImpl;
 class JSNextTickQueue;
 class Process;
 class SecureContextCache;
+class SQLiteRowShapeCache;
 class GCProfilerObserver;
 } // namespace Bun
 
@@ -829,6 +830,11 @@ public:
     // visitChildren wiring needed (and it must NOT keep its values alive).
     std::unique_ptr<Bun::SecureContextCache> m_secureContextCache;
 
+    // Row Structures shared between bun:sqlite statements, and between
+    // node:sqlite statements, keyed by prototype and column names. Weak,
+    // like m_secureContextCache.
+    std::unique_ptr<Bun::SQLiteRowShapeCache> m_sqliteRowShapeCache;
+
     // Backs node:v8's GCProfiler. Lazily created on first start(); its
     // destructor detaches from the heap so a worker that exits mid-profile
     // does not leave the observer registered.
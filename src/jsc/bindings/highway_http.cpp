@@ -0,0 +1,122 @@
+// SIMD structural indexer for HTTP/1.1 request heads ("stage 1"), runtime-dispatched via Google
+// Highway. Classifies every byte once into three bit masks per 64-byte block, which uWS's
+// HttpParser (packages/bun-uws/src/HttpParser.h) walks with count-trailing-zeros instead of
+// scanning byte by byte:
+//   delimiter  any byte that is not an RFC 9110 tchar (ends a method / field name: ':', CR, LF,
+//              SP, controls, separators, non-ASCII)
+//   control    any byte below 0x20 (ends a field value: CR, LF, HTAB, NUL and other CTLs)
+//   space      SP (with `control`, ends the request-target)
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "highway_http.cpp"
+#include <hwy/foreach_target.h>
+#include <hwy/highway.h>
+#include "highway_dispatch.h"
+
+#include <string.h>
+
+// Nibble tables for the tchar test, shared by every target. A byte is a tchar iff
+// kHttpTokenLutLo[lo] & kHttpTokenLutHi[hi] != 0: the low-nibble table holds, per low nibble,
+// one bit for every high nibble (0-7) that completes a tchar, and the high-nibble table selects
+// that bit (zero for 8-F, so non-ASCII is never a tchar).
+#ifndef BUN_HIGHWAY_HTTP_TABLES
+#define BUN_HIGHWAY_HTTP_TABLES
+namespace bun {
+
+// RFC 9110 5.6.2: tchar = "!" / "#" / "$" / "%" / "&" / "'" / "*" / "+" / "-" / "." /
+//                         "^" / "_" / "`" / "|" / "~" / DIGIT / ALPHA
+static constexpr bool IsHttpTokenByte(unsigned c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
+        || c == '!' || c == '#' || c == '$' || c == '%' || c == '&' || c == '\'' || c == '*'
+        || c == '+' || c == '-' || c == '.' || c == '^' || c == '_' || c == '`' || c == '|'
+        || c == '~';
+}
+
+struct HttpTokenLut {
+    alignas(16) uint8_t lo[16] = {};
+    alignas(16) uint8_t hi[16] = {};
+
+    constexpr HttpTokenLut()
+    {
+        for (unsigned h = 0; h < 8; h++) {
+            hi[h] = (uint8_t)(1u << h);
+            for (unsigned l = 0; l < 16; l++) {
+                if (IsHttpTokenByte(h * 16 + l)) {
+                    lo[l] |= (uint8_t)(1u << h);
+                }
+            }
+        }
+    }
+};
+
+alignas(16) static constexpr HttpTokenLut kHttpTokenLut {};
+
+} // namespace bun
+#endif
+
+HWY_BEFORE_NAMESPACE();
+namespace bun {
+namespace HWY_NAMESPACE {
+
+namespace hn = hwy::HWY_NAMESPACE;
+
+using D8 = hn::CappedTag<uint8_t, 64>;
+
+// Writes three masks per 64-byte block of `input` to `out` (delimiter, control, space), so
+// `out` must hold 3 * ceil(len / 64) words. Positions past `len` in the last block read as
+// NUL, which is a delimiter and a control byte: a search never runs off the indexed range.
+void HttpHeaderIndexImpl(const uint8_t* HWY_RESTRICT input, size_t len, uint64_t* HWY_RESTRICT out)
+{
+    const D8 d;
+    const size_t N = hn::Lanes(d);
+
+    const auto v_0f = hn::Set(d, (uint8_t)0x0f);
+    const auto lut_lo = hn::LoadDup128(d, kHttpTokenLut.lo);
+    const auto lut_hi = hn::LoadDup128(d, kHttpTokenLut.hi);
+    const auto v_zero = hn::Zero(d);
+    const auto v_ctl = hn::Set(d, (uint8_t)0x20);
+    const auto v_sp = hn::Set(d, (uint8_t)' ');
+
+    for (size_t pos = 0; pos < len; pos += 64) {
+        const uint8_t* p = input + pos;
+        uint8_t tmp[64];
+        if (len - pos < 64) {
+            memset(tmp, 0, sizeof(tmp));
+            memcpy(tmp, p, len - pos);
+            p = tmp;
+        }
+
+        uint64_t m_token = 0, m_ctl = 0, m_sp = 0;
+        for (size_t v = 0; v < 64 / N; ++v) {
+            const auto chunk = hn::LoadU(d, p + v * N);
+            const unsigned sh = (unsigned)(v * N);
+            const auto cls = hn::And(hn::TableLookupBytes(lut_lo, hn::And(chunk, v_0f)),
+                hn::TableLookupBytes(lut_hi, hn::ShiftRight<4>(chunk)));
+            m_token |= hn::BitsFromMask(d, hn::Ne(cls, v_zero)) << sh;
+            m_ctl |= hn::BitsFromMask(d, hn::Lt(chunk, v_ctl)) << sh;
+            m_sp |= hn::BitsFromMask(d, hn::Eq(chunk, v_sp)) << sh;
+        }
+
+        out[0] = ~m_token;
+        out[1] = m_ctl;
+        out[2] = m_sp;
+        out += 3;
+    }
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+} // namespace HWY_NAMESPACE
+} // namespace bun
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace bun {
+HWY_EXPORT(HttpHeaderIndexImpl);
+
+extern "C" void highway_http_header_index(const uint8_t* input, size_t len, uint64_t* out_masks)
+{
+    BUN_HWY_DISPATCH(HttpHeaderIndexImpl)(input, len, out_masks);
+}
+} // namespace bun
+#endif
@@ -2277,6 +2277,47 @@ void FillWithSkipMaskImpl(const uint8_t* HWY_RESTRICT mask, size_t mask_len, uin
     }
 }
 
+// uWS server-side unmasking. `mask` holds the 4 key bytes in memory order. `output` may equal
+// `input` or trail it (uWS unmasks a frame over its own masking key, output == input - 4): every
+// vector is loaded before the store that could overlap it, so neither pointer is HWY_RESTRICT.
+// Returns whether every unmasked byte is ASCII, which lets text frames skip UTF-8 validation
+// without a second pass over the payload.
+bool WebSocketUnmaskImpl(uint8_t* output, const uint8_t* input, size_t length, uint32_t mask)
+{
+    D8 d;
+    const hn::Repartition<uint32_t, D8> d32;
+    const size_t N = hn::Lanes(d);
+
+    // Lanes are a multiple of 4, so the key lines up with every vector
+    const auto mask_vec = hn::BitCast(d, hn::Set(d32, mask));
+    auto seen = hn::Zero(d);
+
+    size_t i = 0;
+    for (; i + 2 * N <= length; i += 2 * N) {
+        const auto a = hn::Xor(hn::LoadU(d, input + i), mask_vec);
+        const auto b = hn::Xor(hn::LoadU(d, input + i + N), mask_vec);
+        hn::StoreU(a, d, output + i);
+        hn::StoreU(b, d, output + i + N);
+        seen = hn::Or(seen, hn::Or(a, b));
+    }
+    if (i + N <= length) {
+        const auto a = hn::Xor(hn::LoadU(d, input + i), mask_vec);
+        hn::StoreU(a, d, output + i);
+        seen = hn::Or(seen, a);
+        i += N;
+    }
+
+    if (i < length) {
+        // The lanes LoadN zero-fills would read back as key bytes, so clear them
+        const size_t rest = length - i;
+        const auto a = hn::IfThenElseZero(hn::FirstN(d, rest), hn::Xor(hn::LoadN(d, input + i, rest), mask_vec));
+        hn::StoreN(a, d, output + i, rest);
+        seen = hn::Or(seen, a);
+    }
+
+    return hn::AllFalse(d, hn::Gt(seen, hn::Set(d, uint8_t { 0x7F })));
+}
+
 } // namespace HWY_NAMESPACE
 } // namespace bun
 HWY_AFTER_NAMESPACE();
@@ -2332,6 +2373,7 @@ HWY_EXPORT(MemRMem16Impl);
 HWY_EXPORT(VisibleLatin1WidthExcludeANSIImpl);
 HWY_EXPORT(VisibleLatin1WidthImpl);
 HWY_EXPORT(VisibleUTF16WidthImpl);
+HWY_EXPORT(WebSocketUnmaskImpl);
 
 } // namespace bun
 #include "BufferStringSearch.h"
@@ -2523,6 +2565,11 @@ void highway_fill_with_skip_mask(
     BUN_HWY_DISPATCH(FillWithSkipMaskImpl)(mask, mask_len, output, input, length, skip_mask);
 }
 
+bool highway_websocket_unmask(uint8_t* output, const uint8_t* input, size_t length, uint32_t mask)
+{
+    return BUN_HWY_DISPATCH(WebSocketUnmaskImpl)(output, input, length, mask);
+}
+
 void highway_bswap16(uint8_t* data, size_t len)
 {
     BUN_HWY_DISPATCH(BSwap16Impl)(data, len);
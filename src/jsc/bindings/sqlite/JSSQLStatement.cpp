@@ -51,7 +51,14 @@
 #include "wtf/LazyRef.h"
 #include "wtf/text/StringToIntegerConversion.h"
 #include <JavaScriptCore/InternalFieldTuple.h>
+#include <JavaScriptCore/JSPromise.h>
+#include <JavaScriptCore/StrongInlines.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/ThreadSafeRefCounted.h>
 #include "BunString.h"
+#include "EventLoopTaskNoContext.h"
+#include "ScriptExecutionContext.h"
+#include "SQLiteRowShape.h"
 static constexpr int32_t kSafeIntegersFlag = 1 << 1;
 static constexpr int32_t kStrictFlag = 1 << 2;
 static constexpr int32_t kOwnedByDatabaseFlag = 1 << 3;
@@ -203,6 +210,167 @@ class JSSQLStatement;
 static ASCIILiteral finalizedMessage(const JSSQLStatement* statement);
 }
 
+// Read-only connections to a database file, for Statement#allAsync(). Each
+// query checks one out for its whole run, so it steps on a work pool thread
+// without sharing anything with the connection the JS thread uses. In WAL
+// mode these readers neither block the writer nor wait for it.
+class SQLiteReadPool : public ThreadSafeRefCounted<SQLiteReadPool> {
+public:
+    static Ref<SQLiteReadPool> create(CString&& path)
+    {
+        return adoptRef(*new SQLiteReadPool(WTF::move(path)));
+    }
+
+    // JS thread. Reuses an idle connection or opens another; on failure
+    // returns nullptr and sets `error`.
+    sqlite3* acquire(WTF::String& error)
+    {
+        {
+            Locker locker { m_lock };
+            if (!m_idle.isEmpty()) {
+                sqlite3* db = m_idle.takeLast();
+                m_busy.append(db);
+                return db;
+            }
+        }
+
+        sqlite3* db = nullptr;
+        int status = sqlite3_open_v2(m_path.data(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+        if (status != SQLITE_OK) {
+            error = WTF::String::fromUTF8(db ? sqlite3_errmsg(db) : sqlite3_errstr(status));
+            if (db)
+                sqlite3_close_v2(db);
+            return nullptr;
+        }
+        sqlite3_extended_result_codes(db, 1);
+        sqlite3_db_config(db, SQLITE_DBCONFIG_DEFENSIVE, 1, NULL);
+        // Waiting out a writer's lock blocks a work pool thread, not the loop.
+        sqlite3_busy_timeout(db, busyTimeoutMs);
+
+        Locker locker { m_lock };
+        m_busy.append(db);
+        return db;
+    }
+
+    // Any thread. Keeps up to one idle connection per core.
+    void release(sqlite3* db)
+    {
+        {
+            Locker locker { m_lock };
+            m_busy.removeFirst(db);
+            if (!m_closed && m_idle.size() < static_cast<size_t>(WTF::numberOfProcessorCores())) {
+                m_idle.append(db);
+                return;
+            }
+        }
+        sqlite3_close_v2(db);
+    }
+
+    // JS thread, when the database closes: interrupts the queries still
+    // running; their connections close as they are released.
+    void close()
+    {
+        Vector<sqlite3*> idle;
+        {
+            Locker locker { m_lock };
+            m_closed = true;
+            idle = std::exchange(m_idle, {});
+            for (auto* db : m_busy)
+                sqlite3_interrupt(db);
+        }
+        for (auto* db : idle)
+            sqlite3_close_v2(db);
+    }
+
+private:
+    explicit SQLiteReadPool(CString&& path)
+        : m_path(WTF::move(path))
+    {
+    }
+
+    static constexpr int busyTimeoutMs = 5000;
+
+    const CString m_path;
+    WTF::Lock m_lock;
+    Vector<sqlite3*> m_idle WTF_GUARDED_BY_LOCK(m_lock);
+    Vector<sqlite3*> m_busy WTF_GUARDED_BY_LOCK(m_lock);
+    bool m_closed WTF_GUARDED_BY_LOCK(m_lock) = false;
+};
+
+// One Statement#allAsync() call: a statement prepared and bound on a pooled
+// connection, stepped on the work pool. Rows are materialized into one flat
+// buffer, each value a type byte followed by an int64, a double, or a uint32
+// length and that many bytes, and become JS objects back on the JS thread.
+// Whichever thread drops the last reference returns the connection.
+class SQLiteReadJob : public ThreadSafeRefCounted<SQLiteReadJob> {
+public:
+    static Ref<SQLiteReadJob> create(Ref<SQLiteReadPool>&& pool, sqlite3* db)
+    {
+        return adoptRef(*new SQLiteReadJob(WTF::move(pool), db));
+    }
+
+    ~SQLiteReadJob()
+    {
+        if (stmt)
+            sqlite3_finalize(stmt);
+        m_pool->release(db);
+    }
+
+    // Work pool thread.
+    void run()
+    {
+        columnCount = sqlite3_column_count(stmt);
+        auto append = [&](const void* data, size_t size) {
+            rows.append(std::span { static_cast<const uint8_t*>(data), size });
+        };
+        while ((status = sqlite3_step(stmt)) == SQLITE_ROW) {
+            rowCount++;
+            for (int i = 0; i < columnCount; i++) {
+                uint8_t type = sqlite3_column_type(stmt, i);
+                rows.append(type);
+                switch (type) {
+                case SQLITE_INTEGER: {
+                    int64_t value = sqlite3_column_int64(stmt, i);
+                    append(&value, sizeof(value));
+                    break;
+                }
+                case SQLITE_FLOAT: {
+                    double value = sqlite3_column_double(stmt, i);
+                    append(&value, sizeof(value));
+                    break;
+                }
+                case SQLITE3_TEXT:
+                case SQLITE_BLOB: {
+                    const void* data = type == SQLITE_BLOB ? sqlite3_column_blob(stmt, i) : sqlite3_column_text(stmt, i);
+                    uint32_t length = data ? sqlite3_column_bytes(stmt, i) : 0;
+                    append(&length, sizeof(length));
+                    append(data, length);
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    sqlite3* const db;
+    sqlite3_stmt* stmt { nullptr };
+    int status { SQLITE_OK };
+    int columnCount { 0 };
+    size_t rowCount { 0 };
+    Vector<uint8_t> rows;
+
+private:
+    SQLiteReadJob(Ref<SQLiteReadPool>&& pool, sqlite3* db)
+        : db(db)
+        , m_pool(WTF::move(pool))
+    {
+    }
+
+    const Ref<SQLiteReadPool> m_pool;
+};
+
 DECLARE_ALLOCATOR_WITH_HEAP_IDENTIFIER(VersionSqlite3);
 
 class VersionSqlite3 {
@@ -228,8 +396,49 @@ public:
 
     sqlite3* handle() const { return closed ? nullptr : db; }
 
+    // Lazily created by Statement#allAsync(); in-memory and temporary
+    // databases have no file for other connections to open.
+    RefPtr<SQLiteReadPool> readPool;
+    // allAsync() calls in flight, settled on the JS thread by id so nothing
+    // JS-visible travels with the job to the work pool.
+    struct PendingRead {
+        JSC::Strong<JSC::JSPromise> promise;
+        JSC::Strong<JSC::JSObject> statement;
+    };
+    HashMap<uint64_t, PendingRead> pendingReads;
+    uint64_t lastReadId = 0;
+
+    SQLiteReadPool* ensureReadPool()
+    {
+        if (!readPool && handle()) {
+            const char* path = sqlite3_db_filename(db, "main");
+            if (path && *path)
+                readPool = SQLiteReadPool::create(CString(path));
+        }
+        return readPool.get();
+    }
+
+    void closeReadPool()
+    {
+        if (auto pool = std::exchange(readPool, nullptr))
+            pool->close();
+    }
+
+    // Incremental BLOB handles from Database#openBlob(), by id. They keep
+    // the connection open, so every close path closes them first.
+    HashMap<uint32_t, sqlite3_blob*> blobs;
+    uint32_t lastBlobId = 0;
+
+    void closeBlobs()
+    {
+        for (auto* blob : std::exchange(blobs, {}).values())
+            sqlite3_blob_close(blob);
+    }
+
     void closeHandle()
     {
+        closeBlobs();
+        closeReadPool();
         if (db)
             sqlite3_close_v2(std::exchange(db, nullptr));
     }
@@ -311,6 +520,9 @@ extern "C" void Bun__closeAllSQLiteDatabasesForTermination(JSC::JSGlobalObject*
     for (auto& db : dbs) {
         if (db->vm != exitingVM)
             continue;
+        db->closeBlobs();
+        db->closeReadPool();
+        db->pendingReads.clear();
         if (db->db) {
             Bun__sqliteCheckpointForTermination(db->db);
             // close_v2: with unfinalized statements still alive, plain
@@ -325,6 +537,8 @@ extern "C" void Bun__closeAllSQLiteDatabasesForTermination(JSC::JSGlobalObject*
     }
 }
 
+extern "C" void ConcurrentCppTask__createAndRun(JSC::JSGlobalObject*, Bun::EventLoopTaskNoContext* task);
+
 namespace WebCore {
 using namespace JSC;
 
@@ -336,11 +550,14 @@ JSC_DECLARE_HOST_FUNCTION(jsSQLStatementIsInTransactionFunction);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementLoadExtensionFunction);
 
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRun);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRunBatch);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionGet);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionAll);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionAllAsync);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionIterate);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRows);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRawRows);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionColumnar);
 
 JSC_DECLARE_CUSTOM_GETTER(jsSqlStatementGetColumnNames);
 JSC_DECLARE_CUSTOM_GETTER(jsSqlStatementGetColumnCount);
@@ -348,6 +565,13 @@ JSC_DECLARE_CUSTOM_GETTER(jsSqlStatementGetColumnCount);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementSerialize);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementDeserialize);
 
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobOpen);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobReopen);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobSize);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobRead);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobWrite);
+JSC_DECLARE_HOST_FUNCTION(jsSQLStatementBlobClose);
+
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementSetPrototypeFunction);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementFunctionFinalize);
 JSC_DECLARE_HOST_FUNCTION(jsSQLStatementToStringFunction);
@@ -513,7 +737,9 @@ public:
 
     static void analyzeHeap(JSCell*, JSC::HeapAnalyzer&);
 
-    JSC::JSValue rebind(JSGlobalObject* globalObject, JSC::JSValue values);
+    // Binds `values` to this statement, or to `target` when given: allAsync()'s
+    // copy of it on a read connection.
+    JSC::JSValue rebind(JSGlobalObject* globalObject, JSC::JSValue values, sqlite3_stmt* target = nullptr);
 
     bool need_update() { return version_db->version.load() != version; }
     void update_version() { version = version_db->version.load(); }
@@ -672,12 +898,15 @@ static JSValue toJS(JSC::VM& vm, JSC::JSGlobalObject* globalObject, sqlite3_stmt
 
 static const HashTableValue JSSQLStatementPrototypeTableValues[] = {
     { "run"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionRun, 1 } },
+    { "runBatch"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionRunBatch, 3 } },
     { "get"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionGet, 1 } },
     { "all"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionAll, 1 } },
+    { "allAsync"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionAllAsync, 1 } },
     { "iterate"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionIterate, 1 } },
     { "as"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementSetPrototypeFunction, 1 } },
     { "values"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionRows, 1 } },
     { "raw"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionRawRows, 1 } },
+    { "columnar"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementExecuteStatementFunctionColumnar, 1 } },
     { "finalize"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementFunctionFinalize, 0 } },
     { "toString"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementToStringFunction, 0 } },
     { "columns"_s, static_cast<unsigned>(JSC::PropertyAttribute::ReadOnly | JSC::PropertyAttribute::CustomAccessor), NoIntrinsic, { HashTableValue::GetterSetterType, jsSqlStatementGetColumnNames, 0 } },
@@ -795,19 +1024,15 @@ static void initializeColumnNames(JSC::JSGlobalObject* lexicalGlobalObject, JSSQ
         }
 
         if (!anyHoles) [[likely]] {
-            PropertyOffset offset;
             JSObject* prototype = castedThis->userPrototype ? castedThis->userPrototype.get() : globalObject.objectPrototype();
-            Structure* structure = globalObject.structureCache().emptyObjectStructureForPrototype(&globalObject, prototype, columnNames->size());
-            vm.writeBarrier(castedThis, structure);
 
             // We iterated over the columns in reverse order so we need to reverse the columnNames here
-            // Importantly we reverse before adding the properties to the structure to ensure that index accesses
+            // Importantly we reverse before building the structure to ensure that index accesses
             // later refer to the correct property.
-            columnNames->data()->propertyNameVector().reverse();
-            for (const auto& propertyName : *columnNames) {
-                structure = Structure::addPropertyTransition(vm, structure, propertyName, 0, offset);
-            }
-            castedThis->_structure.set(vm, castedThis, structure);
+            auto& names = columnNames->data()->propertyNameVector();
+            names.reverse();
+            // Shared with every other bun:sqlite statement that returns these columns with this prototype.
+            castedThis->_structure.set(vm, castedThis, Bun::sqliteRowStructure(&globalObject, prototype, names.span()));
 
             // We are done.
             return;
@@ -962,8 +1187,9 @@ static JSC::JSValue rebindObject(JSC::JSGlobalObject* globalObject, SQLiteBindin
     int count = 0;
 
     // Property reads on `target` can run JS that finalizes `stmt` (statement.finalize() / db.close()); re-validate after each.
+    // `stmt` is either statement's own or allAsync()'s copy of it on a read connection.
     const auto& statementStillAlive = [&]() -> bool {
-        if (statement ? statement->stmt != stmt : versionDB->handle() != db) [[unlikely]] {
+        if (statement ? !statement->stmt : versionDB->handle() != db) [[unlikely]] {
             if (!scope.exception())
                 throwException(globalObject, scope, createError(globalObject, statement ? finalizedMessage(statement) : "Database has closed"_s));
             return false;
@@ -1160,7 +1386,7 @@ static JSC::JSValue rebindStatement(JSC::JSGlobalObject* lexicalGlobalObject, JS
         } else {
             value = array->getDirectIndex(lexicalGlobalObject, i);
             RETURN_IF_EXCEPTION(scope, {});
-            if (statement ? statement->stmt != stmt : versionDB->handle() != db) [[unlikely]] {
+            if (statement ? !statement->stmt : versionDB->handle() != db) [[unlikely]] {
                 throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, statement ? finalizedMessage(statement) : "Database has closed"_s));
                 return {};
             }
@@ -1865,6 +2091,8 @@ JSC_DEFINE_HOST_FUNCTION(jsSQLStatementCloseStatementFunction, (JSC::JSGlobalObj
     }
 
     versionDB->closed = true;
+    versionDB->closeBlobs();
+    versionDB->closeReadPool();
     if (keptAny) {
         return JSValue::encode(jsUndefined());
     }
@@ -1978,6 +2206,182 @@ JSC_DEFINE_HOST_FUNCTION(jsSQLStatementFcntlFunction, (JSC::JSGlobalObject * lex
     return JSValue::encode(jsNumber(statusCode));
 }
 
+// The blob `id` of database `handle`, or null with an exception thrown.
+static sqlite3_blob* blobForHandle(JSC::JSGlobalObject* lexicalGlobalObject, JSC::ThrowScope& scope, JSValue handleValue, JSValue idValue, sqlite3** db = nullptr)
+{
+    VersionSqlite3* versionDB = handleValue.isNumber() ? databaseForHandle(handleValue.toInt32(lexicalGlobalObject)) : nullptr;
+    if (!versionDB) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "Invalid database handle"_s));
+        return nullptr;
+    }
+    uint32_t id = idValue.isUInt32() ? idValue.asUInt32() : 0;
+    sqlite3_blob* blob = id && versionDB->handle() ? versionDB->blobs.get(id) : nullptr;
+    if (!blob) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, versionDB->handle() ? "Blob has closed"_s : "Database has closed"_s));
+        return nullptr;
+    }
+    if (db)
+        *db = versionDB->db;
+    return blob;
+}
+
+static std::optional<int64_t> blobRowid(JSC::JSGlobalObject* lexicalGlobalObject, JSC::ThrowScope& scope, JSValue value)
+{
+    if (value.isBigInt()) {
+        auto rowid = JSBigInt::toBigInt64(value);
+        RETURN_IF_EXCEPTION(scope, std::nullopt);
+        return rowid;
+    }
+    if (value.isAnyInt())
+        return value.asAnyInt();
+    throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected rowid to be an integer or bigint"_s));
+    return std::nullopt;
+}
+
+// blobOpen(handle, schema, table, column, rowid, writable): the id of a new
+// sqlite3_blob handle on one value.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobOpen, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    JSValue dbNumber = callFrame->argument(0);
+    VersionSqlite3* versionDB = dbNumber.isNumber() ? databaseForHandle(dbNumber.toInt32(lexicalGlobalObject)) : nullptr;
+    if (!versionDB) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "Invalid database handle"_s));
+        return {};
+    }
+
+    auto schema = callFrame->argument(1).toWTFString(lexicalGlobalObject).utf8();
+    RETURN_IF_EXCEPTION(scope, {});
+    auto table = callFrame->argument(2).toWTFString(lexicalGlobalObject).utf8();
+    RETURN_IF_EXCEPTION(scope, {});
+    auto column = callFrame->argument(3).toWTFString(lexicalGlobalObject).utf8();
+    RETURN_IF_EXCEPTION(scope, {});
+    auto rowid = blobRowid(lexicalGlobalObject, scope, callFrame->argument(4));
+    RETURN_IF_EXCEPTION(scope, {});
+    bool writable = callFrame->argument(5).toBoolean(lexicalGlobalObject);
+
+    sqlite3* db = versionDB->handle();
+    if (!db) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "Database has closed"_s));
+        return {};
+    }
+
+    sqlite3_blob* blob = nullptr;
+    if (sqlite3_blob_open(db, schema.data(), table.data(), column.data(), *rowid, writable ? 1 : 0, &blob) != SQLITE_OK) {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+        return {};
+    }
+
+    uint32_t id = ++versionDB->lastBlobId;
+    if (!id) [[unlikely]]
+        id = ++versionDB->lastBlobId;
+    versionDB->blobs.set(id, blob);
+    return JSValue::encode(jsNumber(id));
+}
+
+// blobReopen(handle, id, rowid): points the blob at the same column of another row.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobReopen, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    auto rowid = blobRowid(lexicalGlobalObject, scope, callFrame->argument(2));
+    RETURN_IF_EXCEPTION(scope, {});
+    sqlite3* db = nullptr;
+    sqlite3_blob* blob = blobForHandle(lexicalGlobalObject, scope, callFrame->argument(0), callFrame->argument(1), &db);
+    RETURN_IF_EXCEPTION(scope, {});
+
+    if (sqlite3_blob_reopen(blob, *rowid) != SQLITE_OK) {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+        return {};
+    }
+    return JSValue::encode(jsNumber(sqlite3_blob_bytes(blob)));
+}
+
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobSize, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    sqlite3_blob* blob = blobForHandle(lexicalGlobalObject, scope, callFrame->argument(0), callFrame->argument(1));
+    RETURN_IF_EXCEPTION(scope, {});
+    return JSValue::encode(jsNumber(sqlite3_blob_bytes(blob)));
+}
+
+// blobRead(handle, id, offset, view): reads straight into `view`, up to its
+// length or the end of the blob, and returns the number of bytes read.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobRead, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    sqlite3* db = nullptr;
+    sqlite3_blob* blob = blobForHandle(lexicalGlobalObject, scope, callFrame->argument(0), callFrame->argument(1), &db);
+    RETURN_IF_EXCEPTION(scope, {});
+
+    JSValue offsetValue = callFrame->argument(2);
+    auto* view = dynamicDowncast<JSC::JSArrayBufferView>(callFrame->argument(3));
+    if (!offsetValue.isUInt32() || !view || view->isDetached()) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected an offset and a TypedArray"_s));
+        return {};
+    }
+
+    size_t size = sqlite3_blob_bytes(blob);
+    size_t offset = std::min<size_t>(offsetValue.asUInt32(), size);
+    size_t length = std::min(view->byteLength(), size - offset);
+    if (length && sqlite3_blob_read(blob, view->vector(), static_cast<int>(length), static_cast<int>(offset)) != SQLITE_OK) {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+        return {};
+    }
+    return JSValue::encode(jsNumber(length));
+}
+
+// blobWrite(handle, id, offset, view): overwrites bytes in place. SQLite
+// cannot grow a blob this way, so the write must fit.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobWrite, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+
+    sqlite3* db = nullptr;
+    sqlite3_blob* blob = blobForHandle(lexicalGlobalObject, scope, callFrame->argument(0), callFrame->argument(1), &db);
+    RETURN_IF_EXCEPTION(scope, {});
+
+    JSValue offsetValue = callFrame->argument(2);
+    auto* view = dynamicDowncast<JSC::JSArrayBufferView>(callFrame->argument(3));
+    if (!offsetValue.isUInt32() || !view || view->isDetached()) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected an offset and a TypedArray"_s));
+        return {};
+    }
+
+    size_t offset = offsetValue.asUInt32();
+    size_t length = view->byteLength();
+    if (offset + length > static_cast<size_t>(sqlite3_blob_bytes(blob))) {
+        throwRangeError(lexicalGlobalObject, scope, "Cannot write past the end of a blob"_s);
+        return {};
+    }
+    if (length && sqlite3_blob_write(blob, view->vector(), static_cast<int>(length), static_cast<int>(offset)) != SQLITE_OK) {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+        return {};
+    }
+    return JSValue::encode(jsUndefined());
+}
+
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementBlobClose, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    JSValue dbNumber = callFrame->argument(0);
+    JSValue idValue = callFrame->argument(1);
+    VersionSqlite3* versionDB = dbNumber.isNumber() ? databaseForHandle(dbNumber.toInt32(lexicalGlobalObject)) : nullptr;
+    // no-op if already closed, with or without the database
+    if (versionDB && idValue.isUInt32() && idValue.asUInt32()) {
+        if (auto* blob = versionDB->blobs.take(idValue.asUInt32()))
+            sqlite3_blob_close(blob);
+    }
+    return JSValue::encode(jsUndefined());
+}
+
 /* Hash table for constructor */
 static const HashTableValue JSSQLStatementConstructorTableValues[] = {
     { "open"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementOpenStatementFunction, 2 } },
@@ -1990,6 +2394,12 @@ static const HashTableValue JSSQLStatementConstructorTableValues[] = {
     { "serialize"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementSerialize, 1 } },
     { "deserialize"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementDeserialize, 2 } },
     { "fcntl"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementFcntlFunction, 2 } },
+    { "blobOpen"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobOpen, 6 } },
+    { "blobReopen"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobReopen, 3 } },
+    { "blobSize"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobSize, 2 } },
+    { "blobRead"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobRead, 4 } },
+    { "blobWrite"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobWrite, 4 } },
+    { "blobClose"_s, static_cast<unsigned>(JSC::PropertyAttribute::Function), NoIntrinsic, { HashTableValue::NativeFunctionType, jsSQLStatementBlobClose, 2 } },
 };
 
 const ClassInfo JSSQLStatementConstructor::s_info = { "SQLStatement"_s, &Base::s_info, nullptr, nullptr, CREATE_METHOD_TABLE(JSSQLStatementConstructor) };
@@ -2325,71 +2735,298 @@ JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionAll, (JSC::JSGlob
     RELEASE_AND_RETURN(scope, JSC::JSValue::encode(result));
 }
 
-JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionGet, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+// Reads the value SQLiteReadJob::run() wrote for one column, like toJS().
+template<bool useBigInt64>
+static JSValue toJSFromReadBuffer(JSC::VM& vm, JSC::JSGlobalObject* globalObject, std::span<const uint8_t>& buffer)
 {
+    auto throwScope = DECLARE_THROW_SCOPE(vm);
+    auto take = [&](void* out, size_t size) {
+        memcpy(out, buffer.data(), size);
+        buffer = buffer.subspan(size);
+    };
+    uint8_t type = buffer[0];
+    buffer = buffer.subspan(1);
 
-    auto& vm = JSC::getVM(lexicalGlobalObject);
-    auto scope = DECLARE_THROW_SCOPE(vm);
-    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
-
-    CHECK_THIS
+    switch (type) {
+    case SQLITE_INTEGER: {
+        int64_t value;
+        take(&value, sizeof(value));
+        if constexpr (!useBigInt64) {
+            return jsNumber(value);
+        } else {
+            auto bint = JSC::JSBigInt::createFrom(globalObject, value);
+            RETURN_IF_EXCEPTION(throwScope, {});
+            return bint;
+        }
+    }
+    case SQLITE_FLOAT: {
+        double value;
+        take(&value, sizeof(value));
+        return jsNumber(value);
+    }
+    case SQLITE3_TEXT:
+    case SQLITE_BLOB: {
+        uint32_t len;
+        take(&len, sizeof(len));
+        auto bytes = buffer.first(len);
+        buffer = buffer.subspan(len);
 
-    auto* stmt = castedThis->stmt;
-    CHECK_PREPARED
+        if (type == SQLITE_BLOB) {
+            auto* array = JSC::JSUint8Array::createUninitialized(globalObject, globalObject->m_typedArrayUint8.get(globalObject), len);
+            RETURN_IF_EXCEPTION(throwScope, {});
+            if (len)
+                memcpy(array->vector(), bytes.data(), len);
+            return array;
+        }
 
-    int statusCode = sqlite3_reset(stmt);
-    if (statusCode != SQLITE_OK) [[unlikely]] {
-        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
-        return {};
+        if (len == 0) [[unlikely]] {
+            return jsEmptyString(vm);
+        }
+        if (len < 64) {
+            return jsString(vm, WTF::String::fromUTF8ReplacingInvalidSequences({ bytes.data(), bytes.size() }));
+        }
+        auto encoded = Bun__encoding__toStringUTF8(bytes.data(), len, globalObject);
+        RETURN_IF_EXCEPTION(throwScope, {});
+        return JSC::JSValue::decode(encoded);
     }
-
-    if (callFrame->argumentCount() > 0) {
-        auto arg0 = callFrame->argument(0);
-        DO_REBIND(arg0);
+    default:
+        return jsNull();
     }
+}
 
-    int status = sqlite3_step(stmt);
-    if (!sqlite3_stmt_readonly(stmt)) {
-        castedThis->version_db->version++;
-    }
+// One row of a SQLiteReadJob, shaped like constructResultObject()'s.
+template<bool useBigInt64>
+static JSC::JSValue constructResultObjectFromReadBuffer(JSC::JSGlobalObject* lexicalGlobalObject, JSSQLStatement* castedThis, int columnCount, std::span<const uint8_t>& buffer)
+{
+    auto& columnNames = castedThis->columnNames->data()->propertyNameVector();
+    int count = columnNames.size();
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
 
-    if (!castedThis->hasExecuted || castedThis->need_update()) {
-        initializeColumnNames(lexicalGlobalObject, castedThis);
-        RETURN_IF_EXCEPTION(scope, {});
+    JSC::JSObject* result;
+    auto* structure = castedThis->_structure.get();
+    if (structure) {
+        result = JSC::constructEmptyObject(vm, structure);
+    } else if (count <= JSFinalObject::maxInlineCapacity) {
+        result = JSC::JSFinalObject::create(vm, castedThis->_prototype.get()->structure());
+    } else {
+        JSObject* prototype = castedThis->userPrototype ? castedThis->userPrototype.get() : lexicalGlobalObject->objectPrototype();
+        result = JSC::JSFinalObject::create(vm, JSC::JSFinalObject::createStructure(vm, lexicalGlobalObject, prototype, JSFinalObject::maxInlineCapacity));
     }
 
-    JSValue result = jsNull();
-    if (status == SQLITE_ROW) {
-        bool useBigInt64 = castedThis->useBigInt64;
-
-        result = useBigInt64 ? constructResultObject<true>(lexicalGlobalObject, castedThis)
-                             : constructResultObject<false>(lexicalGlobalObject, castedThis);
+    // Every column is in the buffer, duplicates included, so read them all.
+    for (int i = 0, j = 0; i < columnCount; i++) {
+        auto value = toJSFromReadBuffer<useBigInt64>(vm, lexicalGlobalObject, buffer);
         RETURN_IF_EXCEPTION(scope, {});
-        while (status == SQLITE_ROW) {
-            status = sqlite3_step(stmt);
-        }
+        if (!castedThis->validColumns.get(i))
+            continue;
+        if (structure)
+            result->putDirectOffset(vm, j, value);
+        else
+            result->putDirect(vm, columnNames[j], value, 0);
+        j++;
     }
 
-    if (status == SQLITE_DONE || status == SQLITE_OK) {
-        RELEASE_AND_RETURN(scope, JSValue::encode(result));
-    } else {
-        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
-        sqlite3_reset(stmt);
-        return {};
-    }
+    RELEASE_AND_RETURN(scope, result);
 }
 
-JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRows, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+// JS thread, once the job has stepped to the end: settles its promise.
+static void settleReadJob(JSC::JSGlobalObject* lexicalGlobalObject, VersionSqlite3* versionDB, uint64_t id, SQLiteReadJob& job)
 {
+    auto pending = versionDB->pendingReads.take(id);
+    if (!pending.promise)
+        return;
 
     auto& vm = JSC::getVM(lexicalGlobalObject);
     auto scope = DECLARE_THROW_SCOPE(vm);
-    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+    JSC::JSPromise* promise = pending.promise.get();
+    auto* castedThis = uncheckedDowncast<JSSQLStatement>(pending.statement.get());
 
-    CHECK_THIS;
-
-    auto* stmt = castedThis->stmt;
-    CHECK_PREPARED
+    if (job.status != SQLITE_DONE) {
+        promise->reject(vm, createSQLiteError(lexicalGlobalObject, job.db));
+        return;
+    }
+    if (!castedThis->stmt) {
+        promise->reject(vm, createError(lexicalGlobalObject, finalizedMessage(castedThis)));
+        return;
+    }
+
+    auto rejectWithPending = [&] {
+        if (!vm.isTerminationException(scope.exception()))
+            promise->rejectWithCaughtException(vm, scope);
+    };
+
+    if (!castedThis->hasExecuted || castedThis->need_update()) {
+        initializeColumnNames(lexicalGlobalObject, castedThis);
+        if (scope.exception()) [[unlikely]]
+            return rejectWithPending();
+    }
+    // The job prepared its own copy, which sees a schema change this
+    // statement has not been re-prepared for yet.
+    if (sqlite3_column_count(castedThis->stmt) != job.columnCount) [[unlikely]] {
+        promise->reject(vm, createError(lexicalGlobalObject, "The database schema changed while the query ran"_s));
+        return;
+    }
+
+    JSC::JSArray* resultArray = JSC::constructEmptyArray(lexicalGlobalObject, static_cast<ArrayAllocationProfile*>(nullptr), 0);
+    if (scope.exception()) [[unlikely]]
+        return rejectWithPending();
+
+    std::span<const uint8_t> buffer = job.rows.span();
+    bool useBigInt64 = castedThis->useBigInt64;
+    for (size_t row = 0; row < job.rowCount; row++) {
+        JSC::JSValue result = useBigInt64 ? constructResultObjectFromReadBuffer<true>(lexicalGlobalObject, castedThis, job.columnCount, buffer)
+                                          : constructResultObjectFromReadBuffer<false>(lexicalGlobalObject, castedThis, job.columnCount, buffer);
+        if (scope.exception()) [[unlikely]]
+            return rejectWithPending();
+        resultArray->push(lexicalGlobalObject, result);
+        if (scope.exception()) [[unlikely]]
+            return rejectWithPending();
+    }
+
+    promise->resolve(lexicalGlobalObject, vm, resultArray);
+}
+
+// all(), but stepping happens on the work pool against a read-only
+// connection to the same file, and the rows come back as a Promise.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionAllAsync, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+
+    CHECK_THIS
+
+    auto* stmt = castedThis->stmt;
+    CHECK_PREPARED
+
+    VersionSqlite3* versionDB = castedThis->version_db;
+    if (!versionDB->handle()) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "Database has closed"_s));
+        return {};
+    }
+    if (!sqlite3_stmt_readonly(stmt)) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "allAsync() only runs read-only statements"_s));
+        return {};
+    }
+    SQLiteReadPool* pool = versionDB->ensureReadPool();
+    if (!pool) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "allAsync() needs a database stored in a file"_s));
+        return {};
+    }
+
+    WTF::String openError;
+    sqlite3* reader = pool->acquire(openError);
+    if (!reader) {
+        throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, openError));
+        return {};
+    }
+    Ref job = SQLiteReadJob::create(*pool, reader);
+
+    if (sqlite3_prepare_v3(reader, sqlite3_sql(stmt), -1, 0, &job->stmt, nullptr) != SQLITE_OK) {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, reader));
+        return {};
+    }
+
+    if (callFrame->argumentCount() > 0) {
+        auto arg0 = callFrame->argument(0);
+        if (!arg0.isObject()) {
+            throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected object or array"_s));
+            return {};
+        }
+        JSC::JSValue reb = castedThis->rebind(lexicalGlobalObject, arg0, job->stmt);
+        RETURN_IF_EXCEPTION(scope, {});
+        if (!reb.isNumber()) [[unlikely]] {
+            return JSValue::encode(reb);
+        }
+        // A getter may have closed the database, and with it the pool.
+        if (!versionDB->handle()) [[unlikely]] {
+            throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, "Database has closed"_s));
+            return {};
+        }
+    }
+
+    auto* globalObject = static_cast<Zig::GlobalObject*>(lexicalGlobalObject);
+    JSC::JSPromise* promise = JSC::JSPromise::create(vm, globalObject->promiseStructure());
+    uint64_t id = ++versionDB->lastReadId;
+    versionDB->pendingReads.add(id, VersionSqlite3::PendingRead { { vm, promise }, { vm, castedThis } });
+
+    auto* context = globalObject->scriptExecutionContext();
+    ConcurrentCppTask__createAndRun(globalObject, new Bun::EventLoopTaskNoContext([job = WTF::move(job), versionDB, id, contextIdentifier = context->identifier(), loopKind = context->currentLoopKind()]() mutable {
+        job->run();
+        ScriptExecutionContext::postTaskTo(contextIdentifier, loopKind, [job = WTF::move(job), versionDB, id](ScriptExecutionContext& context) {
+            settleReadJob(context.jsGlobalObject(), versionDB, id, job.get());
+        });
+    }));
+
+    RELEASE_AND_RETURN(scope, JSValue::encode(promise));
+}
+
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionGet, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+
+    CHECK_THIS
+
+    auto* stmt = castedThis->stmt;
+    CHECK_PREPARED
+
+    int statusCode = sqlite3_reset(stmt);
+    if (statusCode != SQLITE_OK) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
+        return {};
+    }
+
+    if (callFrame->argumentCount() > 0) {
+        auto arg0 = callFrame->argument(0);
+        DO_REBIND(arg0);
+    }
+
+    int status = sqlite3_step(stmt);
+    if (!sqlite3_stmt_readonly(stmt)) {
+        castedThis->version_db->version++;
+    }
+
+    if (!castedThis->hasExecuted || castedThis->need_update()) {
+        initializeColumnNames(lexicalGlobalObject, castedThis);
+        RETURN_IF_EXCEPTION(scope, {});
+    }
+
+    JSValue result = jsNull();
+    if (status == SQLITE_ROW) {
+        bool useBigInt64 = castedThis->useBigInt64;
+
+        result = useBigInt64 ? constructResultObject<true>(lexicalGlobalObject, castedThis)
+                             : constructResultObject<false>(lexicalGlobalObject, castedThis);
+        RETURN_IF_EXCEPTION(scope, {});
+        while (status == SQLITE_ROW) {
+            status = sqlite3_step(stmt);
+        }
+    }
+
+    if (status == SQLITE_DONE || status == SQLITE_OK) {
+        RELEASE_AND_RETURN(scope, JSValue::encode(result));
+    } else {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
+        sqlite3_reset(stmt);
+        return {};
+    }
+}
+
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRows, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+
+    CHECK_THIS;
+
+    auto* stmt = castedThis->stmt;
+    CHECK_PREPARED
 
     int statusCode = sqlite3_reset(stmt);
     if (statusCode != SQLITE_OK) [[unlikely]] {
@@ -2559,6 +3196,255 @@ JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRawRows, (JSC::JS
     RELEASE_AND_RETURN(scope, JSC::JSValue::encode(result));
 }
 
+// One column of a columnar() result while its rows are stepped. Numbers
+// stay native until the end; text and blobs go straight into a JS array. A
+// column whose values do not share one kind falls back to a plain array of
+// what all() would have produced.
+struct ColumnarColumn {
+    enum class Kind : uint8_t {
+        Empty, // only NULLs so far
+        Double,
+        BigInt,
+        Text,
+        Blob,
+        Values,
+    };
+
+    Kind kind { Kind::Empty };
+    Vector<double> doubles;
+    Vector<int64_t> ints;
+    JSC::JSArray* values { nullptr };
+    // Bit `row % 8` of byte `row / 8` is set for NULL; empty until the first one.
+    Vector<uint8_t> nulls;
+
+    bool isNull(size_t row) const { return row / 8 < nulls.size() && (nulls[row / 8] >> (row % 8)) & 1; }
+
+    void setNull(size_t row)
+    {
+        growNulls(row / 8 + 1);
+        nulls[row / 8] |= 1 << (row % 8);
+    }
+
+    // Appends zero bytes up to `size`. Vector::fill() would clear the bits
+    // already set, and grow() leaves the new bytes uninitialized.
+    void growNulls(size_t size)
+    {
+        while (nulls.size() < size)
+            nulls.append(0);
+    }
+};
+
+static ColumnarColumn::Kind columnarKind(int type, bool useBigInt64)
+{
+    switch (type) {
+    case SQLITE_INTEGER:
+        return useBigInt64 ? ColumnarColumn::Kind::BigInt : ColumnarColumn::Kind::Double;
+    case SQLITE_FLOAT:
+        return ColumnarColumn::Kind::Double;
+    case SQLITE3_TEXT:
+        return ColumnarColumn::Kind::Text;
+    default:
+        return ColumnarColumn::Kind::Blob;
+    }
+}
+
+// Gives `column` its first kind once `rows` leading NULLs have been seen.
+static void startColumnarColumn(JSC::JSGlobalObject* globalObject, JSC::ThrowScope& scope, MarkedArgumentBuffer& arrays, ColumnarColumn& column, ColumnarColumn::Kind kind, size_t rows)
+{
+    column.kind = kind;
+    switch (kind) {
+    case ColumnarColumn::Kind::Double:
+        column.doubles.fill(0, rows);
+        return;
+    case ColumnarColumn::Kind::BigInt:
+        column.ints.fill(0, rows);
+        return;
+    default:
+        column.values = JSC::constructEmptyArray(globalObject, static_cast<ArrayAllocationProfile*>(nullptr), 0);
+        RETURN_IF_EXCEPTION(scope, );
+        arrays.append(column.values);
+        for (size_t row = 0; row < rows; row++) {
+            column.values->push(globalObject, jsNull());
+            RETURN_IF_EXCEPTION(scope, );
+        }
+    }
+}
+
+// Converts what `column` holds so far into a plain array.
+static void demoteColumnarColumn(JSC::JSGlobalObject* globalObject, JSC::ThrowScope& scope, MarkedArgumentBuffer& arrays, ColumnarColumn& column, size_t rows)
+{
+    auto kind = std::exchange(column.kind, ColumnarColumn::Kind::Values);
+    if (kind == ColumnarColumn::Kind::Text || kind == ColumnarColumn::Kind::Blob)
+        return;
+
+    column.values = JSC::constructEmptyArray(globalObject, static_cast<ArrayAllocationProfile*>(nullptr), 0);
+    RETURN_IF_EXCEPTION(scope, );
+    arrays.append(column.values);
+    for (size_t row = 0; row < rows; row++) {
+        JSValue value = jsNull();
+        if (!column.isNull(row)) {
+            if (kind == ColumnarColumn::Kind::Double) {
+                value = jsNumber(column.doubles[row]);
+            } else {
+                value = JSC::JSBigInt::createFrom(globalObject, column.ints[row]);
+                RETURN_IF_EXCEPTION(scope, );
+            }
+        }
+        column.values->push(globalObject, value);
+        RETURN_IF_EXCEPTION(scope, );
+    }
+    column.doubles.clear();
+    column.ints.clear();
+}
+
+template<typename TypedArray, typename T>
+static JSC::JSValue columnarTypedArray(JSC::JSGlobalObject* globalObject, JSC::Structure* structure, const Vector<T>& data)
+{
+    auto* array = TypedArray::createUninitialized(globalObject, structure, data.size());
+    if (array && !data.isEmpty())
+        memcpy(array->typedVector(), data.span().data(), data.sizeInBytes());
+    return array;
+}
+
+// { length, columns: { name: Float64Array | BigInt64Array | string[] | Uint8Array[] }, nulls: { name: Uint8Array } }
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionColumnar, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+
+    CHECK_THIS
+
+    auto* stmt = castedThis->stmt;
+    CHECK_PREPARED
+    int statusCode = sqlite3_reset(stmt);
+
+    if (statusCode != SQLITE_OK) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
+        return {};
+    }
+
+    if (callFrame->argumentCount() > 0) {
+        auto arg0 = callFrame->argument(0);
+        DO_REBIND(arg0);
+    }
+
+    int status = sqlite3_step(stmt);
+    if (!sqlite3_stmt_readonly(stmt)) {
+        castedThis->version_db->version++;
+    }
+
+    if (!castedThis->hasExecuted || castedThis->need_update()) {
+        initializeColumnNames(lexicalGlobalObject, castedThis);
+        RETURN_IF_EXCEPTION(scope, {});
+    }
+
+    int columnCount = sqlite3_column_count(stmt);
+    bool useBigInt64 = castedThis->useBigInt64;
+    Vector<ColumnarColumn> columns(columnCount);
+    MarkedArgumentBuffer arrays;
+    size_t rows = 0;
+
+    for (; status == SQLITE_ROW; rows++, status = sqlite3_step(stmt)) {
+        for (int i = 0; i < columnCount; i++) {
+            auto& column = columns[i];
+            int type = sqlite3_column_type(stmt, i);
+
+            if (type == SQLITE_NULL) {
+                column.setNull(rows);
+                switch (column.kind) {
+                case ColumnarColumn::Kind::Empty:
+                    break;
+                case ColumnarColumn::Kind::Double:
+                    column.doubles.append(0);
+                    break;
+                case ColumnarColumn::Kind::BigInt:
+                    column.ints.append(0);
+                    break;
+                default:
+                    column.values->push(lexicalGlobalObject, jsNull());
+                    RETURN_IF_EXCEPTION(scope, {});
+                }
+                continue;
+            }
+
+            auto kind = columnarKind(type, useBigInt64);
+            if (column.kind == ColumnarColumn::Kind::Empty) {
+                startColumnarColumn(lexicalGlobalObject, scope, arrays, column, kind, rows);
+                RETURN_IF_EXCEPTION(scope, {});
+            } else if (column.kind != kind && column.kind != ColumnarColumn::Kind::Values) [[unlikely]] {
+                demoteColumnarColumn(lexicalGlobalObject, scope, arrays, column, rows);
+                RETURN_IF_EXCEPTION(scope, {});
+            }
+
+            switch (column.kind) {
+            case ColumnarColumn::Kind::Double:
+                column.doubles.append(type == SQLITE_INTEGER ? static_cast<double>(sqlite3_column_int64(stmt, i)) : sqlite3_column_double(stmt, i));
+                break;
+            case ColumnarColumn::Kind::BigInt:
+                column.ints.append(sqlite3_column_int64(stmt, i));
+                break;
+            default: {
+                JSValue value = useBigInt64 ? toJS<true>(vm, lexicalGlobalObject, stmt, i) : toJS<false>(vm, lexicalGlobalObject, stmt, i);
+                RETURN_IF_EXCEPTION(scope, {});
+                column.values->push(lexicalGlobalObject, value);
+                RETURN_IF_EXCEPTION(scope, {});
+            }
+            }
+        }
+    }
+
+    if (status != SQLITE_DONE && status != SQLITE_OK) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, sqlite3_db_handle(stmt)));
+        sqlite3_reset(stmt);
+        return {};
+    }
+
+    auto* globalObject = static_cast<Zig::GlobalObject*>(lexicalGlobalObject);
+    JSObject* columnsObject = JSC::constructEmptyObject(lexicalGlobalObject);
+    JSObject* nullsObject = JSC::constructEmptyObject(lexicalGlobalObject);
+    auto& columnNames = castedThis->columnNames->data()->propertyNameVector();
+    for (int i = 0, j = 0; i < columnCount; i++) {
+        if (!castedThis->validColumns.get(i))
+            continue;
+        const auto& name = columnNames[j++];
+        auto& column = columns[i];
+
+        JSValue value;
+        switch (column.kind) {
+        case ColumnarColumn::Kind::Empty:
+            startColumnarColumn(lexicalGlobalObject, scope, arrays, column, ColumnarColumn::Kind::Values, rows);
+            RETURN_IF_EXCEPTION(scope, {});
+            value = column.values;
+            break;
+        case ColumnarColumn::Kind::Double:
+            value = columnarTypedArray<JSC::JSFloat64Array>(lexicalGlobalObject, globalObject->typedArrayStructureWithTypedArrayType<TypedArrayType::TypeFloat64>(), column.doubles);
+            RETURN_IF_EXCEPTION(scope, {});
+            break;
+        case ColumnarColumn::Kind::BigInt:
+            value = columnarTypedArray<JSC::JSBigInt64Array>(lexicalGlobalObject, globalObject->typedArrayStructureWithTypedArrayType<TypedArrayType::TypeBigInt64>(), column.ints);
+            RETURN_IF_EXCEPTION(scope, {});
+            break;
+        default:
+            value = column.values;
+        }
+        columnsObject->putDirect(vm, name, value, 0);
+
+        if (!column.nulls.isEmpty()) {
+            column.growNulls((rows + 7) / 8);
+            JSValue bitmap = columnarTypedArray<JSC::JSUint8Array>(lexicalGlobalObject, globalObject->m_typedArrayUint8.get(globalObject), column.nulls);
+            RETURN_IF_EXCEPTION(scope, {});
+            nullsObject->putDirect(vm, name, bitmap, 0);
+        }
+    }
+
+    JSObject* result = JSC::constructEmptyObject(lexicalGlobalObject, lexicalGlobalObject->objectPrototype(), 3);
+    result->putDirect(vm, vm.propertyNames->length, jsNumber(rows), 0);
+    result->putDirect(vm, Identifier::fromString(vm, "columns"_s), columnsObject, 0);
+    result->putDirect(vm, Identifier::fromString(vm, "nulls"_s), nullsObject, 0);
+    RELEASE_AND_RETURN(scope, JSValue::encode(result));
+}
+
 JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRun, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
 {
 
@@ -2626,6 +3512,308 @@ JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRun, (JSC::JSGlob
     RELEASE_AND_RETURN(scope, JSC::JSValue::encode(jsUndefined()));
 }
 
+// runBatch() rows that are plain objects of one shape, which is what an
+// ingestion loop usually produces. The offset of every parameter is looked up
+// once per Structure, after which binding a row reads its slots directly and
+// runs no JS.
+struct RunBatchShape {
+    JSC::Structure* structure { nullptr };
+    Vector<JSC::PropertyOffset> offsets;
+
+    bool matches(JSC::JSObject* row) const { return structure && row->structure() == structure; }
+
+    // Leaves `structure` null if some parameter needs the generic path: a
+    // missing key, an accessor, an index, or a dictionary object.
+    void update(JSC::VM& vm, JSC::JSObject* row, SQLiteBindingsMap& bindings, sqlite3_stmt* stmt)
+    {
+        structure = nullptr;
+        JSC::Structure* candidate = row->structure();
+        bindings.ensureNamesLoaded(vm, stmt);
+        if (candidate->isDictionary() || !row->canUseFastGetOwnProperty(*candidate) || bindings.hasOutOfOrderNames || bindings.isOnlyIndexed || bindings.bindingNames.size() != bindings.count)
+            return;
+
+        offsets.resize(bindings.count);
+        for (size_t i = 0; i < bindings.count; i++) {
+            const auto& name = bindings.bindingNames[i];
+            unsigned attributes;
+            JSC::PropertyOffset offset = name.isEmpty() ? JSC::invalidOffset : candidate->get(vm, name, attributes);
+            if (!JSC::isValidOffset(offset) || (attributes & JSC::PropertyAttribute::AccessorOrCustomAccessorOrValue))
+                return;
+            offsets[i] = offset;
+        }
+        structure = candidate;
+    }
+};
+
+// One parameter's column when runBatch() is given { length, columns, nulls },
+// the shape Statement#columnar() returns.
+struct RunBatchColumn {
+    JSC::JSObject* values { nullptr };
+    JSC::JSUint8Array* nulls { nullptr };
+
+    bool isNull(size_t row) const
+    {
+        return nulls && row / 8 < nulls->length() && (static_cast<const uint8_t*>(nulls->vector())[row / 8] >> (row % 8)) & 1;
+    }
+};
+
+// The key a parameter's column is stored under: its name, less the prefix
+// in strict mode, or its position for "?" and "?NNN".
+static JSC::Identifier runBatchColumnKey(JSC::VM& vm, sqlite3_stmt* stmt, int i, bool trimLeadingPrefix)
+{
+    const char* name = sqlite3_bind_parameter_name(stmt, i + 1);
+    if (!name)
+        return JSC::Identifier::from(vm, i);
+    if (trimLeadingPrefix || name[0] == '?')
+        name += 1;
+    size_t length = strlen(name);
+    if (length && name[0] >= '0' && name[0] <= '9') {
+        if (auto index = WTF::parseInteger<uint32_t>(StringView({ reinterpret_cast<const unsigned char*>(name), length }), 10); index && *index)
+            return JSC::Identifier::from(vm, *index - 1);
+    }
+    return JSC::Identifier::fromString(vm, WTF::String::fromUTF8ReplacingInvalidSequences({ reinterpret_cast<const unsigned char*>(name), length }));
+}
+
+// Binds row `row` of a columnar batch. A column element is read like an
+// array element, so holes and accessors can run JS; the caller checks that
+// the statement survived.
+static bool bindColumnarRow(JSC::JSGlobalObject* globalObject, JSC::ThrowScope& scope, sqlite3* db, sqlite3_stmt* stmt, const Vector<RunBatchColumn>& columns, size_t row, bool safeIntegers)
+{
+    for (size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+        JSValue value;
+        if (column.isNull(row)) {
+            value = jsNull();
+        } else if (auto* doubles = dynamicDowncast<JSC::JSFloat64Array>(column.values); doubles && row < doubles->length()) {
+            value = jsNumber(doubles->typedVector()[row]);
+        } else if (auto* ints = dynamicDowncast<JSC::JSBigInt64Array>(column.values); ints && row < ints->length()) {
+            if (sqlite3_bind_int64(stmt, i + 1, ints->typedVector()[row]) != SQLITE_OK) [[unlikely]] {
+                throwException(globalObject, scope, createError(globalObject, WTF::String::fromUTF8(sqlite3_errmsg(db))));
+                return false;
+            }
+            continue;
+        } else if (auto* array = dynamicDowncast<JSC::JSArray>(column.values); array && array->canGetIndexQuickly(static_cast<unsigned>(row))) {
+            value = array->getIndexQuickly(row);
+        } else {
+            value = column.values->get(globalObject, static_cast<unsigned>(row));
+            RETURN_IF_EXCEPTION(scope, false);
+        }
+        if (!rebindValue(globalObject, db, stmt, i + 1, value, scope, safeIntegers))
+            return false;
+    }
+    return true;
+}
+
+// runBatch(changes, rows, transaction): binds and steps every row in one call.
+// `rows` is an array of parameter arrays or objects, or { length, columns,
+// nulls } with one array or typed array per parameter. With `transaction`,
+// the batch runs in a transaction of its own (a savepoint if one is already
+// open), so a failing row leaves the database as it was.
+JSC_DEFINE_HOST_FUNCTION(jsSQLStatementExecuteStatementFunctionRunBatch, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
+{
+    auto& vm = JSC::getVM(lexicalGlobalObject);
+    auto scope = DECLARE_THROW_SCOPE(vm);
+    auto castedThis = dynamicDowncast<JSSQLStatement>(callFrame->thisValue());
+
+    CHECK_THIS
+
+    auto* stmt = castedThis->stmt;
+    CHECK_PREPARED
+
+    JSValue diffValue = callFrame->argument(0);
+    JSValue rowsValue = callFrame->argument(1);
+    bool useTransaction = callFrame->argument(2).toBoolean(lexicalGlobalObject);
+
+    JSC::JSArray* rows = dynamicDowncast<JSC::JSArray>(rowsValue);
+    JSC::JSObject* batch = rows ? nullptr : rowsValue.getObject();
+    if (!rows && (!batch || batch->inherits<JSC::JSArrayBufferView>())) [[unlikely]] {
+        throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected an array of rows or { columns }"_s));
+        return {};
+    }
+
+    auto* db = sqlite3_db_handle(stmt);
+    auto* versionDB = castedThis->version_db;
+    bool safeIntegers = castedThis->useBigInt64;
+    int paramCount = sqlite3_bind_parameter_count(stmt);
+
+    // Reading rows and columns can run JS (getters, holes that reach the
+    // prototype), which can finalize the statement or close the database.
+    const auto& detached = [&]() -> bool {
+        if (castedThis->stmt == stmt && versionDB->handle() == db) [[likely]]
+            return false;
+        if (!scope.exception())
+            throwException(lexicalGlobalObject, scope, createError(lexicalGlobalObject, castedThis->stmt == stmt ? "Database has closed"_s : finalizedMessage(castedThis)));
+        return true;
+    };
+
+    // Columnar input is resolved to one column per parameter up front, so
+    // the loop below does no property lookups. The columns hold raw pointers
+    // the GC does not see, and binding can run JS that drops the batch's own
+    // references, so each one is also kept alive in `rooted`.
+    size_t length = 0;
+    Vector<RunBatchColumn> columns;
+    MarkedArgumentBuffer rooted;
+    if (rows) {
+        length = rows->length();
+    } else {
+        JSValue columnsValue = batch->get(lexicalGlobalObject, Identifier::fromString(vm, "columns"_s));
+        RETURN_IF_EXCEPTION(scope, {});
+        JSValue nullsValue = batch->get(lexicalGlobalObject, Identifier::fromString(vm, "nulls"_s));
+        RETURN_IF_EXCEPTION(scope, {});
+        JSValue lengthValue = batch->get(lexicalGlobalObject, vm.propertyNames->length);
+        RETURN_IF_EXCEPTION(scope, {});
+        auto* columnsObject = columnsValue.getObject();
+        if (!columnsObject) [[unlikely]] {
+            throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, "Expected rows.columns to be an object"_s));
+            return {};
+        }
+        auto* nullsObject = nullsValue.getObject();
+
+        bool hasLength = !lengthValue.isUndefined();
+        if (hasLength) {
+            double requested = lengthValue.toNumber(lexicalGlobalObject);
+            RETURN_IF_EXCEPTION(scope, {});
+            if (!(requested >= 0 && requested <= static_cast<double>(std::numeric_limits<uint32_t>::max())) || requested != std::trunc(requested)) [[unlikely]] {
+                throwRangeError(lexicalGlobalObject, scope, "Expected rows.length to be a non-negative integer"_s);
+                return {};
+            }
+            length = static_cast<size_t>(requested);
+        }
+
+        columns.reserveInitialCapacity(paramCount);
+        for (int i = 0; i < paramCount; i++) {
+            auto key = runBatchColumnKey(vm, stmt, i, castedThis->m_bindingNames.trimLeadingPrefix);
+            JSValue values = columnsObject->get(lexicalGlobalObject, key);
+            RETURN_IF_EXCEPTION(scope, {});
+            RunBatchColumn column;
+            column.values = values.getObject();
+            if (!column.values || (column.values->inherits<JSC::JSArrayBufferView>() && !column.values->inherits<JSC::JSFloat64Array>() && !column.values->inherits<JSC::JSBigInt64Array>())) [[unlikely]] {
+                throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, makeString("Expected column \""_s, key.string(), "\" to be an array, Float64Array or BigInt64Array"_s)));
+                return {};
+            }
+            rooted.append(column.values);
+            if (nullsObject) {
+                JSValue bitmap = nullsObject->get(lexicalGlobalObject, key);
+                RETURN_IF_EXCEPTION(scope, {});
+                column.nulls = dynamicDowncast<JSC::JSUint8Array>(bitmap);
+                if (column.nulls)
+                    rooted.append(column.nulls);
+            }
+
+            uint64_t columnLength = toLength(lexicalGlobalObject, column.values);
+            RETURN_IF_EXCEPTION(scope, {});
+            if (!hasLength && i == 0) {
+                length = static_cast<size_t>(columnLength);
+            } else if (columnLength < length) [[unlikely]] {
+                throwRangeError(lexicalGlobalObject, scope, makeString("Column \""_s, key.string(), "\" has "_s, columnLength, " values, expected "_s, length));
+                return {};
+            }
+            columns.append(column);
+        }
+
+        if (detached()) [[unlikely]]
+            return {};
+    }
+
+    const char* begin = nullptr;
+    const char* commit = nullptr;
+    const char* rollback = nullptr;
+    if (useTransaction && length > 0) {
+        if (sqlite3_get_autocommit(db)) {
+            begin = "BEGIN";
+            commit = "COMMIT";
+            rollback = "ROLLBACK";
+        } else {
+            begin = "SAVEPOINT \"\t_bs_batch\t\"";
+            commit = "RELEASE \"\t_bs_batch\t\"";
+            rollback = "ROLLBACK TO \"\t_bs_batch\t\"; RELEASE \"\t_bs_batch\t\"";
+        }
+        if (sqlite3_exec(db, begin, nullptr, nullptr, nullptr) != SQLITE_OK) [[unlikely]] {
+            throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+            return {};
+        }
+    }
+
+    // Undoes the batch, unless JS run while binding closed the database.
+    const auto& fail = [&](bool sqliteError) -> JSC::EncodedJSValue {
+        if (sqliteError && !scope.exception())
+            throwException(lexicalGlobalObject, scope, createSQLiteError(lexicalGlobalObject, db));
+        if (castedThis->stmt == stmt)
+            sqlite3_reset(stmt);
+        if (rollback && versionDB->handle() == db)
+            sqlite3_exec(db, rollback, nullptr, nullptr, nullptr);
+        return {};
+    };
+
+    if (!sqlite3_stmt_readonly(stmt)) {
+        castedThis->version_db->version++;
+    }
+
+    int total_changes_before = sqlite3_total_changes(db);
+    RunBatchShape shape;
+
+    for (size_t r = 0; r < length; r++) {
+        if (rows) {
+            JSValue row = rows->canGetIndexQuickly(static_cast<unsigned>(r)) ? rows->getIndexQuickly(r) : rows->get(lexicalGlobalObject, static_cast<unsigned>(r));
+            if (scope.exception() || detached()) [[unlikely]]
+                return fail(false);
+            auto* object = row.getObject();
+            if (!object) [[unlikely]] {
+                throwException(lexicalGlobalObject, scope, createTypeError(lexicalGlobalObject, makeString("Expected row "_s, r, " to be an object or array"_s)));
+                return fail(false);
+            }
+
+            if (!isJSArray(object) && !shape.matches(object))
+                shape.update(vm, object, castedThis->m_bindingNames, stmt);
+
+            if (shape.matches(object)) [[likely]] {
+                for (int i = 0; i < paramCount; i++) {
+                    if (!rebindValue(lexicalGlobalObject, db, stmt, i + 1, object->getDirect(shape.offsets[i]), scope, safeIntegers))
+                        return fail(false);
+                }
+            } else {
+                JSC::JSValue bound = castedThis->rebind(lexicalGlobalObject, object);
+                if (scope.exception() || detached() || !bound.isNumber()) [[unlikely]]
+                    return fail(false);
+            }
+        } else {
+            if (!bindColumnarRow(lexicalGlobalObject, scope, db, stmt, columns, r, safeIntegers) || scope.exception() || detached())
+                return fail(false);
+        }
+
+        int status = sqlite3_step(stmt);
+        while (status == SQLITE_ROW)
+            status = sqlite3_step(stmt);
+        if (status != SQLITE_DONE && status != SQLITE_OK) [[unlikely]]
+            return fail(true);
+        sqlite3_reset(stmt);
+    }
+
+    int64_t last_insert_rowid = sqlite3_last_insert_rowid(db);
+    int changes = sqlite3_total_changes(db) - total_changes_before;
+
+    if (commit && sqlite3_exec(db, commit, nullptr, nullptr, nullptr) != SQLITE_OK) [[unlikely]]
+        return fail(true);
+
+    if (!castedThis->hasExecuted || castedThis->need_update()) {
+        initializeColumnNames(lexicalGlobalObject, castedThis);
+        RETURN_IF_EXCEPTION(scope, {});
+    }
+
+    if (auto* diff = dynamicDowncast<JSC::InternalFieldTuple>(diffValue)) {
+        diff->putInternalField(vm, 0, JSC::jsNumber(changes));
+        if (castedThis->useBigInt64) {
+            JSValue lastRowIdBigInt = JSBigInt::createFrom(lexicalGlobalObject, last_insert_rowid);
+            RETURN_IF_EXCEPTION(scope, {});
+            diff->putInternalField(vm, 1, lastRowIdBigInt);
+        } else {
+            diff->putInternalField(vm, 1, JSC::jsNumber(last_insert_rowid));
+        }
+    }
+
+    RELEASE_AND_RETURN(scope, JSC::JSValue::encode(jsUndefined()));
+}
+
 JSC_DEFINE_HOST_FUNCTION(jsSQLStatementToStringFunction, (JSC::JSGlobalObject * lexicalGlobalObject, JSC::CallFrame* callFrame))
 {
     auto& vm = JSC::getVM(lexicalGlobalObject);
@@ -2910,13 +4098,15 @@ void JSSQLStatement::analyzeHeap(JSCell* cell, HeapAnalyzer& analyzer)
     Base::analyzeHeap(cell, analyzer);
 }
 
-JSC::JSValue JSSQLStatement::rebind(JSC::JSGlobalObject* lexicalGlobalObject, JSC::JSValue values)
+JSC::JSValue JSSQLStatement::rebind(JSC::JSGlobalObject* lexicalGlobalObject, JSC::JSValue values, sqlite3_stmt* target)
 {
     auto& vm = JSC::getVM(lexicalGlobalObject);
     auto scope = DECLARE_THROW_SCOPE(vm);
     auto* stmt = this->stmt;
+    if (!target)
+        target = stmt;
 
-    auto val = rebindStatement(lexicalGlobalObject, values, scope, sqlite3_db_handle(stmt), this->version_db, stmt, this->m_bindingNames, this->useBigInt64, this);
+    auto val = rebindStatement(lexicalGlobalObject, values, scope, sqlite3_db_handle(target), this->version_db, target, this->m_bindingNames, this->useBigInt64, this);
     RETURN_IF_EXCEPTION(scope, {});
 
     // A getter invoked while binding can finalize this statement; the callers
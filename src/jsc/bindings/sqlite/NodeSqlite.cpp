@@ -43,6 +43,7 @@ static constexpr bool lazy_sqlite3_has_session = true;
 #endif
 
 #include "NodeSqlite.h"
+#include "SQLiteRowShape.h"
 
 #include "ZigGlobalObject.h"
 #include "ErrorCode.h"
@@ -2496,27 +2497,25 @@ void JSStatementSync::invalidateRowStructure()
 // the column set is too wide for JSFinalObject's inline capacity —
 // callers fall back to the generic rowToObject() in that case.
 //
-// The cache is keyed on m_resetGeneration rather than just the
-// column count. sqlite3_prepare_v2 transparently re-prepares on
-// SQLITE_SCHEMA, so after `ALTER TABLE … RENAME COLUMN` the same
-// statement can return the *same* column count with *different*
-// names — a count-only key would serve a stale {oldName: value}
-// structure forever (bun:sqlite defends the same technique with a
-// per-db write-version; keying on reset-generation gives the same
-// correctness for the simpler cost of rebuilding once per
-// run/get/all/iterate rather than once per schema change). Within
-// a single .all() / .iterate() the generation is constant, so the
-// hot loop still hits the cache for every row after the first.
+// The cache is keyed on the statement's re-prepare count rather than
+// just the column count. sqlite3_prepare_v2 transparently re-prepares
+// on SQLITE_SCHEMA, so after `ALTER TABLE … RENAME COLUMN` the same
+// statement can return the *same* column count with *different* names;
+// SQLITE_STMTSTATUS_REPREPARE counts exactly those re-prepares. Unlike
+// the reset generation it survives run/get/all/iterate, so a statement
+// called once per row in a loop builds its shape once rather than per
+// call.
 Structure* JSStatementSync::ensureRowStructure(JSGlobalObject* globalObject)
 {
     auto& vm = getVM(globalObject);
     int count = sqlite3_column_count(m_stmt);
-    if (m_rowResetGeneration == m_resetGeneration && m_rowColumnCount == count && m_rowStructure) {
+    int reprepareCount = sqlite3_stmt_status(m_stmt, SQLITE_STMTSTATUS_REPREPARE, 0);
+    if (m_rowReprepareCount == reprepareCount && m_rowColumnCount == count && m_rowStructure) {
         return m_rowStructure.get();
     }
     invalidateRowStructure();
     m_rowColumnCount = count;
-    m_rowResetGeneration = m_resetGeneration;
+    m_rowReprepareCount = reprepareCount;
     if (count <= 0 || static_cast<unsigned>(count) > JSFinalObject::maxInlineCapacity) {
         return nullptr;
     }
@@ -2561,18 +2560,12 @@ Structure* JSStatementSync::ensureRowStructure(JSGlobalObject* globalObject)
         m_columnOffsets.append(off);
     }
 
-    // StructureCache::emptyObjectStructureForPrototype requires a
-    // non-null prototype, but node:sqlite rows have [[Prototype]] ===
-    // null (the tests assert it). Build the null-proto shape directly
-    // and let the statement's own WriteBarrier keep it alive; the
-    // per-property transition chain is still cached on the Structure
-    // itself, so subsequent statements with the same column set share
-    // it via transition lookup.
-    Structure* structure = JSFinalObject::createStructure(vm, globalObject, jsNull(), static_cast<unsigned>(names.size()));
-    for (const auto& id : names) {
-        PropertyOffset offset;
-        structure = Structure::addPropertyTransition(vm, structure, id, 0, offset);
-    }
+    // node:sqlite rows have [[Prototype]] === null (the tests assert
+    // it). The shared cache hands every node:sqlite statement with this
+    // column set the same null-prototype Structure; bun:sqlite rows have
+    // a prototype, so they never land on it. The statement's own
+    // WriteBarrier keeps it alive while it is in use.
+    Structure* structure = Bun::sqliteRowStructure(globalObject, nullptr, names.span());
     m_rowStructure.set(vm, this, structure);
     return structure;
 }
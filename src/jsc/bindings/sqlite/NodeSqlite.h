@@ -411,8 +411,9 @@ public:
     // object's inline storage, we precompute one null-prototype Structure
     // with a slot per distinct column name and then fill each row via
     // putDirectOffset instead of running the generic put machinery per
-    // cell. Built lazily on the first step() that yields columns;
-    // invalidated when the statement is reset with a different shape.
+    // cell. Built lazily on the first step() that yields columns, from
+    // the Structure cache shared with bun:sqlite (SQLiteRowShape.h);
+    // rebuilt when SQLite re-prepares the statement.
     JSC::Structure* ensureRowStructure(JSC::JSGlobalObject*);
     void invalidateRowStructure();
     // Per-result-column index into the structure's inline slots.
@@ -437,14 +438,12 @@ private:
     // JSSQLStatement).
     size_t m_extraMemorySize = 0;
     int m_rowColumnCount = -1;
-    // Reset-generation the cached row structure was built at. Column
-    // *count* alone isn't a sufficient shape key: sqlite3_prepare_v2
-    // transparently re-prepares on SQLITE_SCHEMA, so after an ALTER
-    // TABLE … RENAME COLUMN the same statement returns the same
-    // count with different names. Keying on reset-generation rebuilds
-    // once per run/get/all/iterate — still O(1) per .all() — instead
-    // of serving stale property names forever.
-    unsigned m_rowResetGeneration = 0;
+    // SQLITE_STMTSTATUS_REPREPARE when the cached row structure was
+    // built. Column *count* alone isn't a sufficient shape key:
+    // sqlite3_prepare_v2 transparently re-prepares on SQLITE_SCHEMA, so
+    // after an ALTER TABLE … RENAME COLUMN the same statement returns
+    // the same count with different names.
+    int m_rowReprepareCount = -1;
     // Open-generation this statement was prepared on. After db.close()
     // + db.open() the JSDatabaseSync may even get the *same* sqlite3*
     // back (allocator reuse — ABA), so compare the generation counter
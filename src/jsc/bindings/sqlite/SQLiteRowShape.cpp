@@ -0,0 +1,51 @@
+#include "root.h"
+#include "SQLiteRowShape.h"
+#include "ZigGlobalObject.h"
+#include <JavaScriptCore/StructureCache.h>
+#include <JavaScriptCore/WeakGCMapInlines.h>
+#include <wtf/HexNumber.h>
+#include <wtf/text/StringBuilder.h>
+
+namespace Bun {
+using namespace JSC;
+
+Structure* SQLiteRowShapeCache::get(JSGlobalObject* globalObject, JSObject* prototype, std::span<const Identifier> names)
+{
+    ASSERT(names.size() <= JSFinalObject::maxInlineCapacity);
+
+    // Column names come from C strings, so they cannot contain a NUL.
+    StringBuilder key;
+    key.append(hex(reinterpret_cast<uintptr_t>(globalObject)), ':', hex(reinterpret_cast<uintptr_t>(prototype)));
+    for (const auto& name : names) {
+        key.append('\0');
+        key.append(name.string());
+    }
+    String keyString = key.toString();
+
+    // A live entry keeps its global object and prototype alive, so neither
+    // address in a key can have been reused by another object.
+    if (auto* structure = m_map.get(keyString))
+        return structure;
+
+    auto& vm = globalObject->vm();
+    unsigned capacity = static_cast<unsigned>(names.size());
+    Structure* structure = prototype
+        ? globalObject->structureCache().emptyObjectStructureForPrototype(globalObject, prototype, capacity)
+        : JSFinalObject::createStructure(vm, globalObject, jsNull(), capacity);
+    for (const auto& name : names) {
+        PropertyOffset offset;
+        structure = Structure::addPropertyTransition(vm, structure, name, 0, offset);
+    }
+    m_map.set(WTF::move(keyString), Weak<Structure>(structure));
+    return structure;
+}
+
+Structure* sqliteRowStructure(JSGlobalObject* lexicalGlobalObject, JSObject* prototype, std::span<const Identifier> names)
+{
+    auto& cache = defaultGlobalObject(lexicalGlobalObject)->m_sqliteRowShapeCache;
+    if (!cache)
+        cache = makeUnique<SQLiteRowShapeCache>(lexicalGlobalObject->vm());
+    return cache->get(lexicalGlobalObject, prototype, names);
+}
+
+} // namespace Bun
@@ -0,0 +1,41 @@
+#pragma once
+
+// Row Structures for bun:sqlite (JSSQLStatement.cpp) and node:sqlite
+// (NodeSqlite.cpp). A row object's shape depends only on its prototype and
+// its column names, so every statement returning the same columns with the
+// same prototype builds its rows from one Structure with an inline slot per
+// name and fills them with putDirectOffset. bun:sqlite rows inherit from
+// Object.prototype (or the class given to as()) and node:sqlite rows have a
+// null prototype, so the two bindings never share an entry. Looking a shape up costs one hash of the names instead of
+// a walk of the property transitions, and statements re-run or re-prepared
+// with the same columns land on the same Structure, which keeps property
+// access on their rows monomorphic.
+//
+// Entries are weak: a shape is kept while some statement or row still uses it.
+
+#include "root.h"
+#include <JavaScriptCore/WeakGCMap.h>
+
+namespace Bun {
+
+class SQLiteRowShapeCache {
+    WTF_DEPRECATED_MAKE_FAST_ALLOCATED(SQLiteRowShapeCache);
+
+public:
+    explicit SQLiteRowShapeCache(JSC::VM& vm)
+        : m_map(vm)
+    {
+    }
+
+    JSC::Structure* get(JSC::JSGlobalObject*, JSC::JSObject* prototype, std::span<const JSC::Identifier> names);
+
+private:
+    JSC::WeakGCMap<WTF::String, JSC::Structure> m_map;
+};
+
+// The Structure for a row with `prototype` (null for a null-prototype row)
+// and one property per entry of `names`, in slot order. `names` must be
+// distinct and fit in JSFinalObject's inline storage.
+JSC::Structure* sqliteRowStructure(JSC::JSGlobalObject*, JSC::JSObject* prototype, std::span<const JSC::Identifier> names);
+
+} // namespace Bun
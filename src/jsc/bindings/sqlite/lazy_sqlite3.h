@@ -111,6 +111,13 @@ typedef int (*lazy_sqlite3_backup_step_type)(sqlite3_backup*, int nPage);
 typedef int (*lazy_sqlite3_backup_finish_type)(sqlite3_backup*);
 typedef int (*lazy_sqlite3_backup_remaining_type)(sqlite3_backup*);
 typedef int (*lazy_sqlite3_backup_pagecount_type)(sqlite3_backup*);
+typedef void (*lazy_sqlite3_interrupt_type)(sqlite3*);
+typedef int (*lazy_sqlite3_blob_open_type)(sqlite3*, const char* zDb, const char* zTable, const char* zColumn, sqlite3_int64 iRow, int flags, sqlite3_blob** ppBlob);
+typedef int (*lazy_sqlite3_blob_reopen_type)(sqlite3_blob*, sqlite3_int64);
+typedef int (*lazy_sqlite3_blob_close_type)(sqlite3_blob*);
+typedef int (*lazy_sqlite3_blob_bytes_type)(sqlite3_blob*);
+typedef int (*lazy_sqlite3_blob_read_type)(sqlite3_blob*, void* Z, int N, int iOffset);
+typedef int (*lazy_sqlite3_blob_write_type)(sqlite3_blob*, const void* z, int n, int iOffset);
 typedef int (*lazy_sqlite3session_create_type)(sqlite3*, const char* zDb, sqlite3_session** ppSession);
 typedef void (*lazy_sqlite3session_delete_type)(sqlite3_session*);
 typedef int (*lazy_sqlite3session_attach_type)(sqlite3_session*, const char* zTab);
@@ -212,6 +219,13 @@ inline lazy_sqlite3_backup_step_type lazy_sqlite3_backup_step;
 inline lazy_sqlite3_backup_finish_type lazy_sqlite3_backup_finish;
 inline lazy_sqlite3_backup_remaining_type lazy_sqlite3_backup_remaining;
 inline lazy_sqlite3_backup_pagecount_type lazy_sqlite3_backup_pagecount;
+inline lazy_sqlite3_interrupt_type lazy_sqlite3_interrupt;
+inline lazy_sqlite3_blob_open_type lazy_sqlite3_blob_open;
+inline lazy_sqlite3_blob_reopen_type lazy_sqlite3_blob_reopen;
+inline lazy_sqlite3_blob_close_type lazy_sqlite3_blob_close;
+inline lazy_sqlite3_blob_bytes_type lazy_sqlite3_blob_bytes;
+inline lazy_sqlite3_blob_read_type lazy_sqlite3_blob_read;
+inline lazy_sqlite3_blob_write_type lazy_sqlite3_blob_write;
 inline lazy_sqlite3session_create_type lazy_sqlite3session_create;
 inline lazy_sqlite3session_delete_type lazy_sqlite3session_delete;
 inline lazy_sqlite3session_attach_type lazy_sqlite3session_attach;
@@ -308,6 +322,13 @@ inline lazy_sqlite3changeset_apply_type lazy_sqlite3changeset_apply;
 #define sqlite3_backup_finish lazy_sqlite3_backup_finish
 #define sqlite3_backup_remaining lazy_sqlite3_backup_remaining
 #define sqlite3_backup_pagecount lazy_sqlite3_backup_pagecount
+#define sqlite3_interrupt lazy_sqlite3_interrupt
+#define sqlite3_blob_open lazy_sqlite3_blob_open
+#define sqlite3_blob_reopen lazy_sqlite3_blob_reopen
+#define sqlite3_blob_close lazy_sqlite3_blob_close
+#define sqlite3_blob_bytes lazy_sqlite3_blob_bytes
+#define sqlite3_blob_read lazy_sqlite3_blob_read
+#define sqlite3_blob_write lazy_sqlite3_blob_write
 #define sqlite3session_create lazy_sqlite3session_create
 #define sqlite3session_delete lazy_sqlite3session_delete
 #define sqlite3session_attach lazy_sqlite3session_attach
@@ -444,6 +465,13 @@ inline int lazyLoadSQLite()
     lazy_sqlite3_backup_finish = (lazy_sqlite3_backup_finish_type)dlsym(sqlite3_handle, "sqlite3_backup_finish");
     lazy_sqlite3_backup_remaining = (lazy_sqlite3_backup_remaining_type)dlsym(sqlite3_handle, "sqlite3_backup_remaining");
     lazy_sqlite3_backup_pagecount = (lazy_sqlite3_backup_pagecount_type)dlsym(sqlite3_handle, "sqlite3_backup_pagecount");
+    lazy_sqlite3_interrupt = (lazy_sqlite3_interrupt_type)dlsym(sqlite3_handle, "sqlite3_interrupt");
+    lazy_sqlite3_blob_open = (lazy_sqlite3_blob_open_type)dlsym(sqlite3_handle, "sqlite3_blob_open");
+    lazy_sqlite3_blob_reopen = (lazy_sqlite3_blob_reopen_type)dlsym(sqlite3_handle, "sqlite3_blob_reopen");
+    lazy_sqlite3_blob_close = (lazy_sqlite3_blob_close_type)dlsym(sqlite3_handle, "sqlite3_blob_close");
+    lazy_sqlite3_blob_bytes = (lazy_sqlite3_blob_bytes_type)dlsym(sqlite3_handle, "sqlite3_blob_bytes");
+    lazy_sqlite3_blob_read = (lazy_sqlite3_blob_read_type)dlsym(sqlite3_handle, "sqlite3_blob_read");
+    lazy_sqlite3_blob_write = (lazy_sqlite3_blob_write_type)dlsym(sqlite3_handle, "sqlite3_blob_write");
     lazy_sqlite3session_create = (lazy_sqlite3session_create_type)dlsym(sqlite3_handle, "sqlite3session_create");
     lazy_sqlite3session_delete = (lazy_sqlite3session_delete_type)dlsym(sqlite3_handle, "sqlite3session_delete");
     lazy_sqlite3session_attach = (lazy_sqlite3session_attach_type)dlsym(sqlite3_handle, "sqlite3session_attach");
@@ -315,6 +315,9 @@ pub struct SSLConfig {
     pub session_timeout: i32,
     pub sigalgs: GenOpt<GenString>,
     pub ecdh_curve: GenOpt<GenString>,
+    pub ticket_keys_file: GenOpt<GenString>,
+    pub handshake_threads: u32,
+    pub early_data: bool,
 }
 
 // ── refcount release on drop ──────────────────────────────────────────────
@@ -413,6 +416,7 @@ impl Drop for SSLConfig {
         release_gen_opt_string(&self.ciphers);
         release_gen_opt_string(&self.sigalgs);
         release_gen_opt_string(&self.ecdh_curve);
+        release_gen_opt_string(&self.ticket_keys_file);
     }
 }
 
@@ -567,6 +571,9 @@ struct ExternSSLConfig {
     session_timeout: i32,
     sigalgs: RawWTFStringImpl,
     ecdh_curve: RawWTFStringImpl,
+    ticket_keys_file: RawWTFStringImpl,
+    handshake_threads: u32,
+    early_data: bool,
 }
 
 // safe: same handle/out-param contract as
@@ -606,6 +613,9 @@ impl SSLConfig {
             session_timeout: ext.session_timeout,
             sigalgs: adopt_opt_string(ext.sigalgs),
             ecdh_curve: adopt_opt_string(ext.ecdh_curve),
+            ticket_keys_file: adopt_opt_string(ext.ticket_keys_file),
+            handshake_threads: ext.handshake_threads,
+            early_data: ext.early_data,
         }
     }
 
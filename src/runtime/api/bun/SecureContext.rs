@@ -54,6 +54,26 @@ pub(crate) fn js_live_count(_global: &JSGlobalObject, _callframe: &CallFrame) ->
     Ok(JSValue::js_number(c::us_ssl_ctx_live_count() as f64))
 }
 
+/// Exposed via `bun:internal-for-testing`: counters of the process-wide cache
+/// of parsed `ca`/`caFile` trust stores in usockets.
+#[bun_jsc::host_fn]
+pub(crate) fn js_ca_store_cache_stats(
+    global: &JSGlobalObject,
+    _callframe: &CallFrame,
+) -> JsResult<JSValue> {
+    let stats = uws::ca_store_cache_stats();
+    let object = JSValue::create_empty_object(global, 4);
+    object.put(global, b"hits", JSValue::js_number(stats.hits as f64));
+    object.put(global, b"misses", JSValue::js_number(stats.misses as f64));
+    object.put(
+        global,
+        b"evictions",
+        JSValue::js_number(stats.evictions as f64),
+    );
+    object.put(global, b"entries", JSValue::js_number(stats.entries as f64));
+    Ok(object)
+}
+
 impl SecureContext {
     // Note: no `#[bun_jsc::host_fn]` here — the `Free` shim it emits calls
     // a bare `constructor(...)` which cannot resolve inside an `impl`. The
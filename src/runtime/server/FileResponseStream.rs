@@ -178,7 +178,7 @@ impl FileResponseStream {
         if use_sendfile {
             this_ref.sendfile.set(Sendfile {
                 #[cfg(any(target_os = "linux", target_os = "android"))]
-                socket_fd: opts.resp.get_native_handle(),
+                socket_fd: opts.resp.get_socket_fd(),
                 offset: opts.offset,
                 remain: opts.length.expect("can_sendfile gates None"),
                 #[cfg(any(target_os = "linux", target_os = "android"))]
@@ -439,7 +439,7 @@ impl FileResponseStream {
                 self.as_ptr(),
             );
         }
-        self.resp.get().mark_needs_more();
+        self.resp.get().mark_sendfile_needs_more();
         true
     }
 
@@ -619,9 +619,10 @@ fn can_sendfile(resp: AnyResponse, file_type: FileType, length: Option<u64>) ->
     }
     #[cfg(any(target_os = "linux", target_os = "android"))]
     {
-        // sendfile() needs a real socket fd; SSL writes go through BIO and H3
-        // through lsquic stream frames — neither has one.
-        if !matches!(resp, AnyResponse::TCP(_)) {
+        // sendfile() needs a real socket fd; H3 writes go through lsquic
+        // stream frames, and SSL writes through BIO unless the kernel seals
+        // the records (kTLS, below).
+        if matches!(resp, AnyResponse::H3(_)) {
             return false;
         }
         if file_type != FileType::File {
@@ -629,6 +630,11 @@ fn can_sendfile(resp: AnyResponse, file_type: FileType, length: Option<u64>) ->
         }
         let Some(len) = length else { return false };
         // Below ~1MB the syscall + dual-readiness overhead doesn't pay off.
-        len >= (1 << 20)
+        if len < (1 << 20) {
+            return false;
+        }
+        // Last: switching a TLS connection to kTLS is not undone, so only do
+        // it for a response that is going to be sent with sendfile().
+        matches!(resp, AnyResponse::TCP(_)) || resp.enable_ktls_tx()
     }
 }
@@ -1647,7 +1647,7 @@ where
 
         let bytes = &bytes_[bytes_.len().min(write_offset)..];
         // SAFETY: FFI handle
-        if resp.try_end(bytes, bytes_.len(), self.should_close_connection()) {
+        if self.try_end_blob(resp, bytes, bytes_.len()) {
             self.detach_response();
             self.end_request_streaming_and_drain();
             self.deref();
@@ -1663,6 +1663,16 @@ where
         }
     }
 
+    /// `try_end` for a slice of `self.blob`, zero-copy when the body can be
+    /// pinned (see `AnyBlob::zero_copy_pin`).
+    fn try_end_blob(&self, resp: uws::AnyResponse, bytes: &[u8], total: usize) -> bool {
+        let close_connection = self.should_close_connection();
+        match self.blob.get().zero_copy_pin() {
+            Some(pin) => resp.try_end_zero_copy(bytes, total, close_connection, pin),
+            None => resp.try_end(bytes, total, close_connection),
+        }
+    }
+
     pub(crate) fn send_writable_bytes_for_complete_response_buffer(
         &self,
         write_offset_: u64,
@@ -3925,7 +3935,7 @@ where
         let bytes: &[u8] = unsafe { bun_ptr::detach_lifetime(self.blob.get().slice()) };
         if let Some(resp) = self.resp.get() {
             // SAFETY: FFI handle
-            if !resp.try_end(bytes, bytes.len(), self.should_close_connection()) {
+            if !self.try_end_blob(resp, bytes, bytes.len()) {
                 self.flags.set_has_marked_pending(true);
                 // SAFETY: FFI handle
                 resp.on_writable(
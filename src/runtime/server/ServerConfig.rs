@@ -58,9 +58,13 @@ pub struct ServerConfig {
     pub(crate) websocket: Option<WebSocketServerContext>,
 
     pub(crate) reuse_port: bool,
+    /// `reusePort: "cpu"` — steer each connection to the listener pinned to the CPU that received it.
+    pub(crate) reuse_port_cpu_affine: bool,
     pub(crate) id: Box<[u8]>,
     pub(crate) allow_hot: bool,
     pub(crate) ipv6_only: bool,
+    /// `tcpFastOpen` — accept data carried in the SYN (TCP_FASTOPEN).
+    pub(crate) tcp_fast_open: bool,
     pub(crate) http3: bool,
     pub(crate) http1: bool,
 
@@ -92,9 +96,11 @@ impl Default for ServerConfig {
             is_node_http_server: false,
             websocket: None,
             reuse_port: false,
+            reuse_port_cpu_affine: false,
             id: Box::default(),
             allow_hot: true,
             ipv6_only: false,
+            tcp_fast_open: false,
             http3: false,
             http1: true,
             had_routes_object: false,
@@ -290,9 +296,11 @@ impl ServerConfig {
             is_node_http_server: self.is_node_http_server,
             websocket: self.websocket.take(),
             reuse_port: self.reuse_port,
+            reuse_port_cpu_affine: self.reuse_port_cpu_affine,
             id: core::mem::take(&mut self.id),
             allow_hot: self.allow_hot,
             ipv6_only: self.ipv6_only,
+            tcp_fast_open: self.tcp_fast_open,
             http3: self.http3,
             http1: self.http1,
             had_routes_object: self.had_routes_object,
@@ -628,10 +636,18 @@ impl ServerConfig {
             bun_uws_sys::LIBUS_LISTEN_EXCLUSIVE_PORT
         };
 
+        if self.reuse_port && self.reuse_port_cpu_affine {
+            out |= bun_uws_sys::LIBUS_LISTEN_REUSE_PORT_CPU_AFFINE;
+        }
+
         if self.ipv6_only {
             out |= bun_uws_sys::LIBUS_SOCKET_IPV6_ONLY;
         }
 
+        if self.tcp_fast_open {
+            out |= bun_uws_sys::LIBUS_SOCKET_FAST_OPEN;
+        }
+
         out
     }
 }
@@ -1312,7 +1328,18 @@ impl ServerConfig {
         }
 
         if let Some(dev) = arg.get(global, "reusePort")? {
-            args.reuse_port = dev.to_boolean();
+            if dev.is_string() {
+                let mode = dev.to_slice(global)?;
+                if mode.slice() != b"cpu" {
+                    return Err(global.throw_invalid_arguments(format_args!(
+                        "Expected reusePort to be a boolean or \"cpu\"",
+                    )));
+                }
+                args.reuse_port = true;
+                args.reuse_port_cpu_affine = true;
+            } else {
+                args.reuse_port = dev.to_boolean();
+            }
         }
         if global.has_exception() {
             return Err(JsError::Thrown);
@@ -1325,6 +1352,13 @@ impl ServerConfig {
             return Err(JsError::Thrown);
         }
 
+        if let Some(dev) = arg.get(global, "tcpFastOpen")? {
+            args.tcp_fast_open = dev.to_boolean();
+        }
+        if global.has_exception() {
+            return Err(JsError::Thrown);
+        }
+
         if let Some(v) = arg.get(global, "http3")? {
             args.http3 = v.to_boolean();
         }
@@ -478,7 +478,11 @@ impl StaticRoute {
         let off = usize::try_from((all_bytes.len() as u64).min(write_offset)).unwrap();
         let bytes = &all_bytes[off..];
 
-        resp.try_end(bytes, all_bytes.len(), resp.should_close_connection())
+        let close_connection = resp.should_close_connection();
+        match blob.zero_copy_pin() {
+            Some(pin) => resp.try_end_zero_copy(bytes, all_bytes.len(), close_connection, pin),
+            None => resp.try_end(bytes, all_bytes.len(), close_connection),
+        }
     }
 
     fn do_write_status(&self, status: u16, resp: AnyResponse) {
@@ -14,6 +14,12 @@ pub struct WebSocketServerContext {
     pub(crate) send_pings_automatically: bool,
     pub(crate) reset_idle_timeout_on_send: bool,
     pub(crate) close_on_backpressure_limit: bool,
+    /// Name of the cross-thread pub/sub group (`websocket.broadcastGroup`);
+    /// empty when publishes stay on this thread.
+    pub(crate) broadcast_group: Box<[u8]>,
+    /// `perMessageDeflate.poolSize`: most compressor windows the loop keeps
+    /// for `compress: "pooled"`; 0 keeps the uws default.
+    pub(crate) deflation_pool_size: u32,
 }
 
 pub struct Handler {
@@ -187,6 +193,7 @@ bun_core::comptime_string_map! {
         b"disable" => 0,
         b"shared" => uws::SHARED_COMPRESSOR,
         b"dedicated" => uws::DEDICATED_COMPRESSOR,
+        b"pooled" => uws::DEDICATED_COMPRESSOR | uws::POOLED_COMPRESSOR,
         b"3KB" => uws::DEDICATED_COMPRESSOR_3KB,
         b"4KB" => uws::DEDICATED_COMPRESSOR_4KB,
         b"8KB" => uws::DEDICATED_COMPRESSOR_8KB,
@@ -241,6 +248,8 @@ pub(crate) fn on_create(
         send_pings_automatically: true,
         reset_idle_timeout_on_send: true,
         close_on_backpressure_limit: false,
+        broadcast_group: Box::default(),
+        deflation_pool_size: 0,
     };
 
     if let Some(per_message_deflate) = object.get(global_object, "perMessageDeflate")? {
@@ -275,13 +284,13 @@ pub(crate) fn on_create(
                     let key = compression.get_zig_string(global_object)?;
                     let Some(v) = lookup_zig_string(&COMPRESS_TABLE, &key) else {
                         return Err(global_object.throw_invalid_arguments(format_args!(
-                            "WebSocketServerContext expects a valid compress option, either disable \"shared\" \"dedicated\" \"3KB\" \"4KB\" \"8KB\" \"16KB\" \"32KB\" \"64KB\" \"128KB\" or \"256KB\""
+                            "WebSocketServerContext expects a valid compress option, either disable \"shared\" \"dedicated\" \"pooled\" \"3KB\" \"4KB\" \"8KB\" \"16KB\" \"32KB\" \"64KB\" \"128KB\" or \"256KB\""
                         )));
                     };
                     server.compression |= v;
                 } else {
                     return Err(global_object.throw_invalid_arguments(format_args!(
-                        "websocket expects a valid compress option, either disable \"shared\" \"dedicated\" \"3KB\" \"4KB\" \"8KB\" \"16KB\" \"32KB\" \"64KB\" \"128KB\" or \"256KB\""
+                        "websocket expects a valid compress option, either disable \"shared\" \"dedicated\" \"pooled\" \"3KB\" \"4KB\" \"8KB\" \"16KB\" \"32KB\" \"64KB\" \"128KB\" or \"256KB\""
                     )));
                 }
             }
@@ -309,6 +318,18 @@ pub(crate) fn on_create(
                     )));
                 }
             }
+
+            if let Some(value) = per_message_deflate.get(global_object, "poolSize")? {
+                if !value.is_undefined_or_null() {
+                    if !value.is_any_int() || value.to_int64() < 1 {
+                        return Err(global_object.throw_invalid_arguments(format_args!(
+                            "websocket expects perMessageDeflate.poolSize to be a positive integer"
+                        )));
+                    }
+
+                    server.deflation_pool_size = value.to_int64().min(u32::MAX as i64) as u32;
+                }
+            }
         }
     }
 
@@ -381,6 +402,19 @@ pub(crate) fn on_create(
         }
     }
 
+    if let Some(value) = object.get(global_object, "broadcastGroup")? {
+        if !value.is_undefined_or_null() {
+            if !value.is_string() {
+                return Err(global_object.throw_invalid_arguments(format_args!(
+                    "websocket expects broadcastGroup to be a string"
+                )));
+            }
+
+            let name = value.to_slice(global_object)?;
+            server.broadcast_group = Box::<[u8]>::from(name.slice());
+        }
+    }
+
     if let Some(value) = object.get(global_object, "publishToSelf")? {
         if !value.is_undefined_or_null() {
             if !value.is_boolean() {
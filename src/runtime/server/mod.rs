@@ -2644,6 +2644,21 @@ impl<const SSL: bool, const DEBUG: bool> NewServer<SSL, DEBUG> {
             }
         }
 
+        // Needs the TopicTree that `app.ws` creates, so it comes after every
+        // ws route. A reload without the option leaves the group.
+        app.join_broadcast_group(
+            websocket_ptr
+                .as_ref()
+                .map_or(&b""[..], |websocket| &websocket.broadcast_group[..]),
+        );
+
+        // The pool only exists once a `compress: "pooled"` ws route was added.
+        if let Some(websocket) = websocket_ptr.as_ref() {
+            if websocket.deflation_pool_size > 0 {
+                app.set_deflation_pool_capacity(websocket.deflation_pool_size);
+            }
+        }
+
         // --- 9. Consolidated "/*" HTTP fallback registration ---
         let ud = self_ptr.cast::<c_void>();
         let has_node_http = !self.config.on_node_http_request.is_empty();
@@ -24,6 +24,14 @@ function generate(name) {
         fn: "doSubscriberCount",
         length: 1,
       },
+      webSocketCompressionStats: {
+        fn: "doWebSocketCompressionStats",
+        length: 0,
+      },
+      tlsSessionStats: {
+        fn: "doTlsSessionStats",
+        length: 0,
+      },
       reload: {
         fn: "doReload",
         length: 2,
@@ -61,6 +69,9 @@ function generate(name) {
       pendingWebSockets: {
         getter: "getPendingWebSockets",
       },
+      fastOpenConnections: {
+        getter: "getFastOpenConnections",
+      },
       ref: {
         fn: "doRef",
       },
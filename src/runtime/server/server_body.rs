@@ -1477,6 +1477,107 @@ where
         )))
     }
 
+    /// Counters of the `compress: "pooled"` window pool on this server's loop.
+    #[bun_jsc::host_fn(method)]
+    pub(crate) fn do_web_socket_compression_stats(
+        &mut self,
+        global: &JSGlobalObject,
+        _callframe: &CallFrame,
+    ) -> JsResult<JSValue> {
+        if self.app.is_none() {
+            return Ok(JSValue::UNDEFINED);
+        }
+
+        let stats = self.app_mut().deflation_pool_stats();
+        let per_socket = if stats.sockets > 0 {
+            stats.window_bytes as f64 / f64::from(stats.sockets)
+        } else {
+            0.0
+        };
+
+        let object = JSValue::create_empty_object(global, 8);
+        object.put(
+            global,
+            b"capacity",
+            JSValue::js_number(f64::from(stats.capacity)),
+        );
+        object.put(
+            global,
+            b"windows",
+            JSValue::js_number(f64::from(stats.windows)),
+        );
+        object.put(
+            global,
+            b"sockets",
+            JSValue::js_number(f64::from(stats.sockets)),
+        );
+        object.put(global, b"hits", JSValue::js_number(stats.hits as f64));
+        object.put(global, b"misses", JSValue::js_number(stats.misses as f64));
+        object.put(
+            global,
+            b"evictions",
+            JSValue::js_number(stats.evictions as f64),
+        );
+        object.put(
+            global,
+            b"windowBytes",
+            JSValue::js_number(stats.window_bytes as f64),
+        );
+        object.put(global, b"bytesPerSocket", JSValue::js_number(per_socket));
+        Ok(object)
+    }
+
+    /// Resumed vs. full handshakes of this server's TLS contexts.
+    #[bun_jsc::host_fn(method)]
+    pub(crate) fn do_tls_session_stats(
+        &mut self,
+        global: &JSGlobalObject,
+        _callframe: &CallFrame,
+    ) -> JsResult<JSValue> {
+        if !SSL || self.app.is_none() {
+            return Ok(JSValue::UNDEFINED);
+        }
+
+        let stats = self.app_mut().tls_session_stats();
+        let object = JSValue::create_empty_object(global, 7);
+        object.put(
+            global,
+            b"resumed",
+            JSValue::js_number(stats.resumed_handshakes as f64),
+        );
+        object.put(
+            global,
+            b"full",
+            JSValue::js_number(stats.full_handshakes as f64),
+        );
+        object.put(
+            global,
+            b"ticketKeys",
+            JSValue::js_number(f64::from(stats.ticket_keys)),
+        );
+        object.put(
+            global,
+            b"ticketKeyReloads",
+            JSValue::js_number(stats.ticket_key_reloads as f64),
+        );
+        object.put(
+            global,
+            b"ticketKeyErrors",
+            JSValue::js_number(stats.ticket_key_errors as f64),
+        );
+        object.put(
+            global,
+            b"earlyData",
+            JSValue::js_number(stats.early_data as f64),
+        );
+        object.put(
+            global,
+            b"tooEarly",
+            JSValue::js_number(stats.too_early as f64),
+        );
+        Ok(object)
+    }
+
     // ── host_fn.wrapInstanceMethod hand-expansions ───────────────────────
     //
     // NOTE: the `#[bun_jsc::host_fn(method)]` proc-macro that will eventually
@@ -2651,6 +2752,15 @@ where
         JSValue::js_number((self.pending_requests.get() as u32 & 0x7FFF_FFFF) as i32 as f64)
     }
 
+    /// Connections whose SYN carried data, over this server's `tcpFastOpen` listeners.
+    #[bun_jsc::host_fn(getter)]
+    pub(crate) fn get_fast_open_connections(&mut self, _: &JSGlobalObject) -> JSValue {
+        if self.app.is_none() {
+            return JSValue::js_number(0.0);
+        }
+        JSValue::js_number(self.app_mut().fast_open_connections() as f64)
+    }
+
     #[bun_jsc::host_fn(getter)]
     pub(crate) fn get_pending_web_sockets(&self, _: &JSGlobalObject) -> JSValue {
         JSValue::js_number((self.active_sockets_count() as u32 & 0x7FFF_FFFF) as i32 as f64)
@@ -112,5 +112,19 @@ export const SSLConfig = b.dictionary(
       type: b.String.nullable,
       internalName: "ecdh_curve",
     },
+    ticketKeysFile: {
+      type: b.String.nullable,
+      internalName: "ticket_keys_file",
+    },
+    handshakeThreads: {
+      type: b.u32,
+      default: 0,
+      internalName: "handshake_threads",
+    },
+    earlyData: {
+      type: b.bool,
+      default: false,
+      internalName: "early_data",
+    },
   },
 );
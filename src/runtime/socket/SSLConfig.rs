@@ -177,6 +177,8 @@ impl SSLConfigFromJs for SSLConfig {
         result.ssl_min_version = generated.ssl_min_version;
         result.ssl_max_version = generated.ssl_max_version;
         result.session_timeout = generated.session_timeout;
+        result.handshake_threads = generated.handshake_threads;
+        result.early_data = generated.early_data;
         result.allow_partial_trust_chain = generated.allow_partial_trust_chain;
         if let Some(sigalgs) = generated.sigalgs.get() {
             result.sigalgs = zbox_into_raw(&sigalgs.to_owned_slice_z());
@@ -200,6 +202,8 @@ impl SSLConfigFromJs for SSLConfig {
             || result.ssl_min_version != 0
             || result.ssl_max_version != 0
             || result.session_timeout != 0
+            || result.handshake_threads != 0
+            || result.early_data
             || result.allow_partial_trust_chain;
 
         result.ca = handle_file_for_field(global, "ca", &generated.ca)?;
@@ -217,6 +221,8 @@ impl SSLConfigFromJs for SSLConfig {
             || !result.sigalgs.is_null()
             || !result.ecdh_curve.is_null()
             || result.session_timeout != 0
+            || result.handshake_threads != 0
+            || result.early_data
             || result.allow_partial_trust_chain;
 
         if let Some(key_file) = generated.key_file.get() {
@@ -231,6 +237,11 @@ impl SSLConfigFromJs for SSLConfig {
             result.ca_file_name = handle_path(global, "caFile", &ca_file)?;
             result.requires_custom_request_ctx = true;
         }
+        if let Some(ticket_keys_file) = generated.ticket_keys_file.get() {
+            result.ticket_keys_file_name =
+                handle_path(global, "ticketKeysFile", &ticket_keys_file)?;
+            result.requires_custom_request_ctx = true;
+        }
 
         let protocols: *const c_char = match &generated.alpn_protocols {
             jsc::generated::SSLConfigAlpnProtocols::None => core::ptr::null(),
@@ -68,6 +68,8 @@ pub mod uws_handlers;
 #[path = "uws_jsc.rs"]
 pub mod uws_jsc;
 
+pub mod tls_key_offload;
+
 #[path = "SSLConfig.rs"]
 pub mod ssl_config;
 pub use ssl_config::{SSLConfig, SSLConfigFromJs, resolve_reject_unauthorized, tls_true_defaults};
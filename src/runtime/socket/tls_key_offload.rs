@@ -0,0 +1,66 @@
+//! Crypto workers behind `tls.handshakeThreads`.
+//!
+//! usockets installs a private-key method on contexts that ask for offload and
+//! hands each handshake signature to [`Bun__TLSKeyOffload__schedule`]. The job
+//! posts its own result back to the socket's loop, so this side only owns the
+//! threads.
+
+use core::ffi::c_void;
+use std::sync::OnceLock;
+use std::sync::atomic::{AtomicU32, Ordering};
+
+use bun_threading::ThreadPool;
+use bun_threading::thread_pool::{self, Batch, Node, Task};
+
+/// Largest `handshakeThreads` asked for before the first signature. The pool
+/// size is fixed once it starts.
+static THREADS: AtomicU32 = AtomicU32::new(0);
+static POOL: OnceLock<ThreadPool> = OnceLock::new();
+
+#[repr(C)]
+struct KeyJob {
+    task: Task,
+    job: *mut c_void,
+    run: unsafe extern "C" fn(*mut c_void),
+}
+
+unsafe fn callback(task: *mut Task) {
+    // SAFETY: `task` is the `task` field of a `KeyJob` leaked in `schedule`;
+    // the pool runs each task exactly once.
+    let this = unsafe { Box::from_raw(bun_core::from_field_ptr!(KeyJob, task, task)) };
+    // SAFETY: usockets passed `run` together with the job it owns.
+    unsafe { (this.run)(this.job) };
+}
+
+#[cold]
+fn create() -> ThreadPool {
+    ThreadPool::init(thread_pool::Config {
+        max_threads: THREADS.load(Ordering::Relaxed).max(1),
+        stack_size: thread_pool::DEFAULT_THREAD_STACK_SIZE,
+    })
+}
+
+/// Called for every SSL_CTX built with `handshake_threads`.
+#[unsafe(no_mangle)]
+pub extern "C" fn Bun__TLSKeyOffload__reserve(threads: u32) {
+    THREADS.fetch_max(threads, Ordering::Relaxed);
+}
+
+/// # Safety
+/// `run(job)` must be sound to call once on any thread.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn Bun__TLSKeyOffload__schedule(
+    job: *mut c_void,
+    run: unsafe extern "C" fn(*mut c_void),
+) {
+    let task = Box::into_raw(Box::new(KeyJob {
+        task: Task {
+            node: Node::default(),
+            callback,
+        },
+        job,
+        run,
+    }));
+    // SAFETY: `task` is a live heap allocation now owned by the pool.
+    POOL.get_or_init(create).schedule(Batch::from(unsafe { &raw mut (*task).task }));
+}
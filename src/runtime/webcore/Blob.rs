@@ -6370,6 +6370,20 @@ impl Any {
             Any::WTFStringImpl(_) | Any::InternalBlob(_) => false,
         }
     }
+
+    /// A pin that lets uWS send these bytes with MSG_ZEROCOPY
+    /// (`AnyResponse::try_end_zero_copy`). Only a Blob over a shared bytes
+    /// store has one: the other variants are owned by whoever holds this
+    /// `Any`, which may drop them before the kernel has sent them.
+    pub(crate) fn zero_copy_pin(&self) -> Option<bun_uws::ZeroCopyPin> {
+        match self {
+            Any::Blob(b) => b
+                .store()
+                .filter(|s| matches!(s.data, store::Data::Bytes(_)))
+                .map(|s| store::zero_copy_pin(s)),
+            Any::WTFStringImpl(_) | Any::InternalBlob(_) => None,
+        }
+    }
 }
 
 // ─── Any: JSC-integration (to_js/from_js paths) ──────────────────────────────
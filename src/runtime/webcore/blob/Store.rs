@@ -543,3 +543,22 @@ pub(crate) extern "C" fn BlobArrayBuffer_deallocator(
     // owns one outstanding reference being released here.
     unsafe { Store::deref(NonNull::new_unchecked(blob.cast::<Store>())) };
 }
+
+/// `uws::ZeroCopyPin` over a `Blob.Store`: uWS keeps the store (and so its
+/// bytes) alive while MSG_ZEROCOPY sends of a response body still read from it.
+pub(crate) fn zero_copy_pin(store: &Store) -> bun_uws::ZeroCopyPin {
+    unsafe extern "C" fn pin_ref(ctx: *mut c_void) {
+        // SAFETY: `ctx` is the `Store` the pin was made from; uWS takes its
+        // ref during the `try_end_zero_copy` call, while the caller's is held.
+        unsafe { (*ctx.cast::<Store>()).ref_() };
+    }
+    unsafe extern "C" fn pin_deref(ctx: *mut c_void) {
+        // SAFETY: releases the reference `pin_ref` took.
+        unsafe { Store::deref(NonNull::new_unchecked(ctx.cast::<Store>())) };
+    }
+    bun_uws::ZeroCopyPin {
+        ctx: core::ptr::from_ref(store).cast_mut().cast::<c_void>(),
+        ref_: pin_ref,
+        deref: pin_deref,
+    }
+}
@@ -311,6 +311,42 @@ fn bun_fetch_preconnect(
     Ok(JSValue::UNDEFINED)
 }
 
+// ──────────────────────────────────────────────────────────────────────────
+// Bun__fetchConnectionStats
+// ──────────────────────────────────────────────────────────────────────────
+
+/// `fetch.connectionStats()` — process-wide counts of client connections
+/// that used `tcpFastOpen` or TLS early data.
+#[bun_jsc::host_fn(export = "Bun__fetchConnectionStats")]
+fn bun_fetch_connection_stats(
+    global_object: &JSGlobalObject,
+    _callframe: &CallFrame,
+) -> JsResult<JSValue> {
+    let stats = bun_uws::client_connection_stats();
+    let object = JSValue::create_empty_object(global_object, 4);
+    object.put(
+        global_object,
+        b"fastOpen",
+        JSValue::js_number(stats.fast_open as f64),
+    );
+    object.put(
+        global_object,
+        b"earlyData",
+        JSValue::js_number(stats.early_data as f64),
+    );
+    object.put(
+        global_object,
+        b"earlyDataAccepted",
+        JSValue::js_number(stats.early_data_accepted as f64),
+    );
+    object.put(
+        global_object,
+        b"earlyDataRejected",
+        JSValue::js_number(stats.early_data_rejected as f64),
+    );
+    Ok(object)
+}
+
 // ──────────────────────────────────────────────────────────────────────────
 // StringOrURL helper
 // ──────────────────────────────────────────────────────────────────────────
@@ -429,6 +465,7 @@ fn fetch_impl<const ALLOW_GET_BODY: bool>(
     let mut disable_timeout = false;
     let mut idle_timeout_seconds: Option<core::ffi::c_uint> = None;
     let mut disable_keepalive = false;
+    let mut tcp_fast_open = false;
     let mut disable_decompression = false;
     let mut compress: Option<compress_body::CompressOption> = None;
     let mut max_redirects: Option<u8> = None;
@@ -959,6 +996,29 @@ fn fetch_impl<const ALLOW_GET_BODY: bool>(
         break 'extract_disable_keepalive disable_keepalive;
     };
 
+    // tcpFastOpen: boolean | undefined;
+    'extract_tcp_fast_open: {
+        let objects_to_try = [
+            options_object.unwrap_or_default(),
+            request_init_object.unwrap_or_default(),
+        ];
+
+        for obj in objects_to_try {
+            if !obj.is_empty() {
+                if let Some(fast_open_value) = obj.get(global_this, "tcpFastOpen")? {
+                    if fast_open_value.is_boolean() {
+                        tcp_fast_open = fast_open_value.as_boolean();
+                        break 'extract_tcp_fast_open;
+                    }
+                }
+
+                if global_this.has_exception() {
+                    return Ok(JSValue::ZERO);
+                }
+            }
+        }
+    }
+
     if global_this.has_exception() {
         return Ok(JSValue::ZERO);
     }
@@ -2091,6 +2151,7 @@ fn fetch_impl<const ALLOW_GET_BODY: bool>(
         hostname: hostname.take(),
         upgraded_connection,
         forced_protocol,
+        tcp_fast_open,
         is_node_http_client: ALLOW_GET_BODY,
         compress,
         check_server_identity: if check_server_identity.is_empty_or_undefined_or_null() {
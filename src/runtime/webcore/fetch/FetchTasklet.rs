@@ -2178,6 +2178,7 @@ impl FetchTasklet {
         let http_client = fetch_tasklet.http.as_mut().unwrap();
         http_client.client.flags.is_streaming_request_body = is_stream;
         http_client.client.flags.forced_protocol = fetch_options.forced_protocol;
+        http_client.client.flags.fast_open = fetch_options.tcp_fast_open;
         http_client.client.flags.is_node_http_client = fetch_options.is_node_http_client;
         fetch_tasklet.is_waiting_request_stream_start = is_stream;
         if is_stream {
@@ -2793,6 +2794,8 @@ pub struct FetchOptions {
     pub(crate) ssl_config: Option<http::ssl_config::SharedPtr>,
     pub(crate) upgraded_connection: bool,
     pub(crate) forced_protocol: Option<http::Protocol>,
+    /// `tcpFastOpen` — send the first bytes of a new connection in its SYN.
+    pub(crate) tcp_fast_open: bool,
     pub(crate) is_node_http_client: bool,
     pub(crate) compress: Option<http::compress_body::CompressOption>,
 }
@@ -151,6 +151,14 @@ pub(crate) fn create_bun_socket_error_to_js(
                 format_args!("Failed to set ECDH curve"),
             )
             .to_js(),
+        E::invalid_ticket_keys => global
+            .err(
+                ErrorCode::ERR_INVALID_ARG_VALUE,
+                format_args!(
+                    "ticketKeysFile must contain one or more 48-byte session ticket keys"
+                ),
+            )
+            .to_js(),
     }
 }
 
@@ -81,16 +81,21 @@ pub const DEDICATED_COMPRESSOR_64KB: i32 = 214;
 pub const DEDICATED_COMPRESSOR_128KB: i32 = 231;
 pub const DEDICATED_COMPRESSOR_256KB: i32 = 248;
 pub const DEDICATED_COMPRESSOR: i32 = 248;
+/// Or'd into a dedicated compressor: its window is leased from a per-loop pool.
+pub const POOLED_COMPRESSOR: i32 = 4096;
 
 pub use bun_uws_sys::{
     LIBUS_LISTEN_DEFAULT, LIBUS_LISTEN_EXCLUSIVE_PORT, LIBUS_LISTEN_REUSE_ADDR,
-    LIBUS_LISTEN_REUSE_PORT, LIBUS_SOCKET_ALLOW_HALF_OPEN, LIBUS_SOCKET_IPV6_ONLY,
+    LIBUS_LISTEN_REUSE_PORT, LIBUS_SOCKET_ALLOW_HALF_OPEN, LIBUS_SOCKET_FAST_OPEN,
+    LIBUS_SOCKET_IPV6_ONLY,
 };
 
 // Re-export the `_sys` definitions so higher tiers see one type. `to_js`
 // (`createBunSocketErrorToJS` / `verifyErrorToJS`) live as extension traits
 // in the *_jsc crate.
 pub use bun_uws_sys::{Opcode, SendStatus, create_bun_socket_error_t, us_bun_verify_error_t};
+pub use bun_uws_sys::{ca_store_cache_stats, us_ca_store_cache_stats_t};
+pub use bun_uws_sys::{client_connection_stats, us_client_connection_stats_t};
 
 /// Owned socket-address shape (boxed IP). Distinct from the sys type by
 /// design — that one stores the IP text inline as returned from
@@ -1458,3 +1463,6 @@ pub type Response<const SSL: bool> = bun_uws_sys::response::Response<SSL>;
 pub use bun_uws_sys::AnyResponse;
 
 pub use bun_uws_sys::response::WriteResult;
+
+/// Keeps a response body alive for MSG_ZEROCOPY sends (`AnyResponse::try_end_zero_copy`).
+pub use bun_uws_sys::ZeroCopyPin;
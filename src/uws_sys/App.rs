@@ -321,6 +321,75 @@ impl<const SSL: bool> App<SSL> {
         }
     }
 
+    /// Joins the process-wide broadcast group `name` so `publish` also reaches
+    /// subscribers of servers on other threads in the same group. An empty
+    /// name leaves the current group.
+    pub fn join_broadcast_group(&mut self, name: &[u8]) {
+        // SAFETY: self is a valid app; name valid for the call.
+        unsafe {
+            c::uws_app_join_broadcast_group(
+                Self::SSL_FLAG,
+                std::ptr::from_mut::<Self>(self).cast::<uws_app_t>(),
+                name.as_ptr(),
+                name.len(),
+            )
+        }
+    }
+
+    /// Bounds the sliding windows held by `POOLED_COMPRESSOR` WebSockets on
+    /// this thread's loop. No-op until a pooled `ws` route exists.
+    pub fn set_deflation_pool_capacity(&mut self, capacity: u32) {
+        // SAFETY: self is a valid app.
+        unsafe {
+            c::uws_app_set_deflation_pool_capacity(
+                Self::SSL_FLAG,
+                std::ptr::from_mut::<Self>(self).cast::<uws_app_t>(),
+                capacity,
+            )
+        }
+    }
+
+    /// Counters of this loop's compressor pool; all zero without one.
+    pub fn deflation_pool_stats(&mut self) -> c::uws_deflation_pool_stats_t {
+        let mut stats = c::uws_deflation_pool_stats_t::default();
+        // SAFETY: self is a valid app; stats is a valid out-param.
+        unsafe {
+            c::uws_app_deflation_pool_stats(
+                Self::SSL_FLAG,
+                std::ptr::from_mut::<Self>(self).cast::<uws_app_t>(),
+                &mut stats,
+            )
+        };
+        stats
+    }
+
+    /// Resumed vs. full TLS handshakes across this app's `SSL_CTX`s, with the
+    /// state of their `ticketKeysFile`; all zero for plain HTTP.
+    pub fn tls_session_stats(&mut self) -> c::us_ssl_ctx_session_stats_t {
+        let mut stats = c::us_ssl_ctx_session_stats_t::default();
+        // SAFETY: self is a valid app; stats is a valid out-param.
+        unsafe {
+            c::uws_app_tls_session_stats(
+                Self::SSL_FLAG,
+                std::ptr::from_mut::<Self>(self).cast::<uws_app_t>(),
+                &mut stats,
+            )
+        };
+        stats
+    }
+
+    /// Connections accepted with data in the SYN, summed over every listener
+    /// started with `LIBUS_SOCKET_FAST_OPEN`.
+    pub fn fast_open_connections(&mut self) -> u64 {
+        // SAFETY: self is a valid app.
+        unsafe {
+            c::uws_app_fast_open_connections(
+                Self::SSL_FLAG,
+                std::ptr::from_mut::<Self>(self).cast::<uws_app_t>(),
+            )
+        }
+    }
+
     pub fn publish(
         &mut self,
         topic: &[u8],
@@ -607,6 +676,28 @@ pub mod c {
             topic: *const u8,
             topic_length: usize,
         ) -> c_uint;
+        pub(crate) fn uws_app_join_broadcast_group(
+            ssl: i32,
+            app: *mut uws_app_t,
+            name: *const u8,
+            name_length: usize,
+        );
+        pub(crate) fn uws_app_set_deflation_pool_capacity(
+            ssl: i32,
+            app: *mut uws_app_t,
+            capacity: u32,
+        );
+        pub(crate) fn uws_app_deflation_pool_stats(
+            ssl: i32,
+            app: *mut uws_app_t,
+            out: *mut uws_deflation_pool_stats_t,
+        );
+        pub(crate) fn uws_app_tls_session_stats(
+            ssl: i32,
+            app: *mut uws_app_t,
+            out: *mut us_ssl_ctx_session_stats_t,
+        );
+        pub(crate) fn uws_app_fast_open_connections(ssl: i32, app: *mut uws_app_t) -> u64;
         pub(crate) fn uws_publish(
             ssl: i32,
             app: *mut uws_app_t,
@@ -644,6 +735,31 @@ pub mod c {
         pub(crate) safe fn uws_app_clear_routes(ssl_flag: c_int, app: &mut uws_app_t);
     }
 
+    #[repr(C)]
+    #[derive(Clone, Copy, Default)]
+    pub struct uws_deflation_pool_stats_t {
+        pub capacity: u32,
+        pub windows: u32,
+        pub sockets: u32,
+        pub hits: u64,
+        pub misses: u64,
+        pub evictions: u64,
+        pub window_bytes: u64,
+    }
+
+    /// `struct us_ssl_ctx_session_stats_t` (libusockets.h).
+    #[repr(C)]
+    #[derive(Clone, Copy, Default)]
+    pub struct us_ssl_ctx_session_stats_t {
+        pub resumed_handshakes: u64,
+        pub full_handshakes: u64,
+        pub ticket_key_reloads: u64,
+        pub ticket_key_errors: u64,
+        pub early_data: u64,
+        pub too_early: u64,
+        pub ticket_keys: u32,
+    }
+
     #[repr(C)]
     #[derive(Clone, Copy)]
     pub struct uws_app_listen_config_t {
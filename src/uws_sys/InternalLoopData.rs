@@ -29,6 +29,12 @@ pub struct InternalLoopData {
     #[cfg(not(windows))]
     pub sweep_next_tick_ns: i64,
     pub sweep_timer_count: i32,
+    /// `us_internal_timeout_wheel_t *` — socket timeouts (timeout_wheel.c).
+    pub(crate) timeout_wheel: *mut c_void,
+    /// `us_internal_io_uring_t *` — Linux io_uring reads/accepts layered over
+    /// epoll (eventing/io_uring.c); null unless enabled.
+    #[cfg(not(windows))]
+    pub(crate) io_uring: *mut c_void,
     pub wakeup_async: *mut us_internal_async,
     pub head: *mut SocketGroup,
     pub quic_head: *mut c_void,
@@ -37,7 +43,6 @@ pub struct InternalLoopData {
     pub(crate) nq_head: *mut c_void,
     #[cfg(windows)]
     pub quic_timer: *mut Timer,
-    pub iterator: *mut SocketGroup,
     pub recv_buf: *mut u8,
     pub send_buf: *mut u8,
     pub ssl_data: *mut c_void,
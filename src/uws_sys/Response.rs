@@ -31,6 +31,16 @@ pub struct SocketAddress {
     pub is_ipv6: bool,
 }
 
+/// A buffer that MSG_ZEROCOPY sends keep reading from after the write that
+/// queued them returns (`uWS::ZeroCopyPin`). uWS calls `ref_` when it starts
+/// relying on `ctx` and `deref` once the kernel is done with it.
+#[derive(Clone, Copy)]
+pub struct ZeroCopyPin {
+    pub ctx: *mut c_void,
+    pub ref_: unsafe extern "C" fn(*mut c_void),
+    pub deref: unsafe extern "C" fn(*mut c_void),
+}
+
 impl SocketAddress {
     pub(crate) fn new(ip: &[u8], port: i32, is_ipv6: bool) -> SocketAddress {
         let ip = &ip[..ip.len().min(64)];
@@ -135,6 +145,33 @@ impl<const SSL: bool> Response<SSL> {
         }
     }
 
+    /// `try_end` whose body may be sent with MSG_ZEROCOPY straight from
+    /// `data` (plain TCP, large bodies). uWS holds `pin` until the kernel has
+    /// completed those sends, which can be after the response has finished.
+    pub(crate) fn try_end_zero_copy(
+        &mut self,
+        data: &[u8],
+        total: usize,
+        close_: bool,
+        pin: ZeroCopyPin,
+    ) -> bool {
+        // SAFETY: self is a live opaque uws_res handle owned by uWS; `pin`'s
+        // callbacks accept `pin.ctx` for as long as uWS holds a ref on it.
+        unsafe {
+            c::uws_res_try_end_zerocopy(
+                Self::ssl_flag(),
+                self.downcast(),
+                data.as_ptr(),
+                data.len(),
+                total,
+                close_,
+                pin.ctx,
+                pin.ref_,
+                pin.deref,
+            )
+        }
+    }
+
     pub(crate) fn is_connect_request(&mut self) -> bool {
         c::uws_res_is_connect_request(Self::ssl_flag(), self.as_raw())
     }
@@ -850,6 +887,23 @@ impl AnyResponse {
         any_dispatch!(self, |r| r.try_end(data, total_size, close_connection))
     }
 
+    /// See `Response::try_end_zero_copy`. TLS and HTTP/3 bodies are encrypted
+    /// copies anyway, so they take `try_end` and never touch `pin`.
+    pub fn try_end_zero_copy(
+        self,
+        data: &[u8],
+        total_size: usize,
+        close_connection: bool,
+        pin: ZeroCopyPin,
+    ) -> bool {
+        match self {
+            AnyResponse::TCP(ptr) => {
+                TCPResponse::as_handle(ptr).try_end_zero_copy(data, total_size, close_connection, pin)
+            }
+            AnyResponse::SSL(_) | AnyResponse::H3(_) => self.try_end(data, total_size, close_connection),
+        }
+    }
+
     pub fn pause(self) {
         any_dispatch!(self, |r| r.pause())
     }
@@ -893,6 +947,46 @@ impl AnyResponse {
         any_dispatch!(self, |r| r.prepare_for_sendfile())
     }
 
+    /// The connection's TCP fd. Unlike `get_native_handle`, which is the
+    /// `SSL*` for TLS responses.
+    pub fn get_socket_fd(self) -> Fd {
+        match self {
+            AnyResponse::H3(_) => bun_core::Fd::INVALID,
+            AnyResponse::SSL(ptr) => {
+                us_socket_t::opaque_mut(TLSResponse::as_handle(ptr).downcast_socket()).get_fd()
+            }
+            AnyResponse::TCP(ptr) => {
+                us_socket_t::opaque_mut(TCPResponse::as_handle(ptr).downcast_socket()).get_fd()
+            }
+        }
+    }
+
+    /// Hands record encryption for the rest of this TLS connection to the
+    /// kernel (see `us_socket_t::enable_ktls_tx`), so the fd can be written
+    /// directly. `false` for TCP and HTTP/3, and when it is not possible.
+    pub fn enable_ktls_tx(self) -> bool {
+        match self {
+            AnyResponse::SSL(ptr) => {
+                us_socket_t::opaque_mut(TLSResponse::as_handle(ptr).downcast_socket())
+                    .enable_ktls_tx()
+            }
+            AnyResponse::TCP(_) | AnyResponse::H3(_) => false,
+        }
+    }
+
+    /// `mark_needs_more` for a `sendfile()` that came up short: the fd was
+    /// written directly, so a kTLS response needs the same writable re-arm as
+    /// plain TCP.
+    pub fn mark_sendfile_needs_more(self) {
+        match self {
+            AnyResponse::SSL(ptr) => {
+                us_socket_t::opaque_mut(TLSResponse::as_handle(ptr).downcast_socket())
+                    .send_file_needs_more()
+            }
+            AnyResponse::TCP(_) | AnyResponse::H3(_) => self.mark_needs_more(),
+        }
+    }
+
     pub fn on_writable<U: 'static, H>(self, _handler: H, optional_data: *mut U)
     where
         H: Fn(*mut U, u64, AnyResponse) -> bool + Copy + 'static,
@@ -1219,6 +1313,17 @@ pub mod c {
             total: usize,
             close: bool,
         ) -> bool;
+        pub(crate) fn uws_res_try_end_zerocopy(
+            ssl: i32,
+            res: *mut uws_res,
+            data: *const u8,
+            length: usize,
+            total: usize,
+            close: bool,
+            pin_ctx: *mut c_void,
+            pin_ref: unsafe extern "C" fn(*mut c_void),
+            pin_deref: unsafe extern "C" fn(*mut c_void),
+        ) -> bool;
         pub(crate) safe fn uws_res_end_stream(ssl: i32, res: &mut uws_res, close_connection: bool);
         pub(crate) safe fn uws_res_prepare_for_sendfile(ssl: i32, res: &mut uws_res);
         pub(crate) safe fn uws_res_get_native_handle(ssl: i32, res: &mut uws_res) -> *mut Socket;
@@ -124,6 +124,9 @@ pub struct BunSocketContextOptions {
     pub allow_partial_trust_chain: i32,
     pub sigalgs: *const c_char,
     pub ecdh_curve: *const c_char,
+    pub ticket_keys_file: *const c_char,
+    pub handshake_threads: u32,
+    pub early_data: i32,
 }
 
 impl Default for BunSocketContextOptions {
@@ -155,6 +158,9 @@ impl Default for BunSocketContextOptions {
             allow_partial_trust_chain: 0,
             sigalgs: ptr::null(),
             ecdh_curve: ptr::null(),
+            ticket_keys_file: ptr::null(),
+            handshake_threads: 0,
+            early_data: 0,
         }
     }
 }
@@ -260,6 +266,11 @@ impl BunSocketContextOptions {
         h.update(bun_core::bytes_of(&self.allow_partial_trust_chain));
         feed_z(&mut h, self.sigalgs);
         feed_z(&mut h, self.ecdh_curve);
+        // Path only: the SSL_CTX re-reads rotated keys itself, so a rotation
+        // must not rebuild it (and reset its resumption counters).
+        feed_z(&mut h, self.ticket_keys_file);
+        h.update(bun_core::bytes_of(&self.handshake_threads));
+        h.update(bun_core::bytes_of(&self.early_data));
         let mut out = [0u8; 32];
         h.final_(&mut out);
         out
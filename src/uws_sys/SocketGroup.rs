@@ -4,8 +4,8 @@
 //! unused kinds cost nothing.
 //!
 //! `#[repr(C)]` so field order/padding match the C definition exactly — this is
-//! read/written directly by C (loop.c walks `head_sockets`/`iterator`,
-//! context.c flips `linked`).
+//! read/written directly by C (context.c walks `head_sockets`/`iterator` and
+//! flips `linked`).
 
 use core::ffi::{c_char, c_int, c_void};
 use core::ptr;
@@ -29,13 +29,10 @@ pub struct SocketGroup {
     pub iterator: *mut us_socket_t,
     pub prev: *mut SocketGroup,
     pub next: *mut SocketGroup,
-    pub global_tick: u32,
     /// Sockets currently parked in `loop.data.low_prio_head` with
     /// `s->group == this`. They are NOT in `head_sockets` while queued, so
     /// `close_all`/`destroy` must account for them separately.
     pub low_prio_count: u16,
-    pub timestamp: u8,
-    pub long_timestamp: u8,
     pub linked: u8,
 }
 
@@ -59,9 +56,9 @@ pub struct VTable {
 }
 
 // Must match `struct us_socket_group_t` in libusockets.h.
-// 9 ptrs + u32 + u16 + 3×u8, padded to 8-byte alignment.
+// 9 ptrs + u16 + u8, padded to pointer alignment.
 const _: () = assert!(
-    core::mem::size_of::<SocketGroup>() == 9 * core::mem::size_of::<*mut c_void>() + 16,
+    core::mem::size_of::<SocketGroup>() == 9 * core::mem::size_of::<*mut c_void>() + 8,
     "SocketGroup layout drifted from us_socket_group_t"
 );
 const _: () = assert!(
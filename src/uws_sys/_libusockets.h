@@ -48,7 +48,10 @@ enum uws_compress_options_t : int32_t {
     DEDICATED_COMPRESSOR_128KB = 14 << 4 | 7,
     DEDICATED_COMPRESSOR_256KB = 15 << 4 | 8,
     /* Same as 256kb */
-    DEDICATED_COMPRESSOR = 15 << 4 | 8
+    DEDICATED_COMPRESSOR = 15 << 4 | 8,
+
+    /* Combined with a dedicated compressor: lease its window from a per-loop pool */
+    POOLED_COMPRESSOR = 1 << 12
 };
 
 enum uws_opcode_t : int32_t {
@@ -64,6 +67,16 @@ enum uws_sendstatus_t : uint32_t { BACKPRESSURE,
     SUCCESS,
     DROPPED };
 
+typedef struct {
+    uint32_t capacity;
+    uint32_t windows;
+    uint32_t sockets;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t window_bytes;
+} uws_deflation_pool_stats_t;
+
 typedef struct {
 
     int port;
@@ -30,6 +30,8 @@ pub const LIBUS_LISTEN_REUSE_PORT: core::ffi::c_int = 4;
 pub const LIBUS_SOCKET_IPV6_ONLY: core::ffi::c_int = 8;
 pub const LIBUS_LISTEN_REUSE_ADDR: core::ffi::c_int = 16;
 pub const LIBUS_LISTEN_DISALLOW_REUSE_PORT_FAILURE: core::ffi::c_int = 32;
+pub const LIBUS_LISTEN_REUSE_PORT_CPU_AFFINE: core::ffi::c_int = 256;
+pub const LIBUS_SOCKET_FAST_OPEN: core::ffi::c_int = 512;
 
 /// BoringSSL `SSL_CTX` (alias so callers don't need a direct boringssl dep).
 pub type SslCtx = bun_boringssl_sys::SSL_CTX;
@@ -110,6 +112,7 @@ pub enum create_bun_socket_error_t {
     invalid_ciphers,
     invalid_crl,
     invalid_ecdh_curve,
+    invalid_ticket_keys,
 }
 
 impl create_bun_socket_error_t {
@@ -122,6 +125,7 @@ impl create_bun_socket_error_t {
             Self::invalid_ciphers => Some(b"Invalid ciphers"),
             Self::invalid_crl => Some(b"Invalid CRL"),
             Self::invalid_ecdh_curve => Some(b"Failed to set ECDH curve"),
+            Self::invalid_ticket_keys => Some(b"Invalid session ticket keys file"),
         }
     }
 }
@@ -169,6 +173,50 @@ bun_core::opaque_extern!(
     pub UpgradedDuplex, pub WindowsNamedPipe,
 );
 
+/// `struct us_client_connection_stats_t` — client connections, process-wide,
+/// whose SYN carried data or that sent TLS 1.3 early data.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct us_client_connection_stats_t {
+    pub fast_open: u64,
+    pub early_data: u64,
+    pub early_data_accepted: u64,
+    pub early_data_rejected: u64,
+}
+
+unsafe extern "C" {
+    fn us_client_connection_stats(out: *mut us_client_connection_stats_t);
+}
+
+pub fn client_connection_stats() -> us_client_connection_stats_t {
+    let mut stats = us_client_connection_stats_t::default();
+    // SAFETY: `stats` is a valid out-param.
+    unsafe { us_client_connection_stats(&mut stats) };
+    stats
+}
+
+/// `struct us_ca_store_cache_stats_t` — the process-wide cache of parsed
+/// `ca`/`caFile` trust stores shared by every `SSL_CTX` build.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct us_ca_store_cache_stats_t {
+    pub hits: u64,
+    pub misses: u64,
+    pub evictions: u64,
+    pub entries: u32,
+}
+
+unsafe extern "C" {
+    fn us_ca_store_cache_stats(out: *mut us_ca_store_cache_stats_t);
+}
+
+pub fn ca_store_cache_stats() -> us_ca_store_cache_stats_t {
+    let mut stats = us_ca_store_cache_stats_t::default();
+    // SAFETY: `stats` is a valid out-param.
+    unsafe { us_ca_store_cache_stats(&mut stats) };
+    stats
+}
+
 pub mod socket_transfer {
     use super::LIBUS_SOCKET_DESCRIPTOR;
     use core::ffi::{c_char, c_int, c_uint, c_void};
@@ -487,7 +535,7 @@ pub use connecting_socket::ConnectingSocket;
 pub use listen_socket::ListenSocket;
 pub use request::{AnyRequest, Request};
 pub use response::c::uws_res;
-pub use response::{AnyResponse, SocketAddress, WebSocketUpgradeContext};
+pub use response::{AnyResponse, SocketAddress, WebSocketUpgradeContext, ZeroCopyPin};
 pub use socket_context::BunSocketContextOptions;
 pub use socket_group::ConnectResult;
 pub use socket_group::SocketGroup;
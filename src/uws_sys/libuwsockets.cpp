@@ -33,6 +33,9 @@ extern "C"
   void uws_loop_date_header_timer_update(us_loop_t *loop) {
     uWS::LoopData *loopData = uWS::Loop::data(loop);
     loopData->updateDate();
+    if (loopData->deflationPool) {
+      loopData->deflationPool->tick();
+    }
   }
 
   uws_app_t *uws_create_app(int ssl, struct us_bun_socket_context_options_t options)
@@ -576,6 +579,39 @@ extern "C"
     uWS::App *uwsApp = (uWS::App *)app;
     return uwsApp->numSubscribers(stringViewFromC(topic, topic_length));
   }
+  void uws_app_join_broadcast_group(int ssl, uws_app_t *app, const char *name, size_t name_length)
+  {
+    if (ssl)
+    {
+      uWS::SSLApp *uwsApp = (uWS::SSLApp *)app;
+      uwsApp->joinBroadcastGroup(stringViewFromC(name, name_length));
+      return;
+    }
+    uWS::App *uwsApp = (uWS::App *)app;
+    uwsApp->joinBroadcastGroup(stringViewFromC(name, name_length));
+  }
+  void uws_app_set_deflation_pool_capacity(int ssl, uws_app_t *app, uint32_t capacity)
+  {
+    if (ssl)
+    {
+      uWS::SSLApp *uwsApp = (uWS::SSLApp *)app;
+      uwsApp->setDeflationPoolCapacity(capacity);
+      return;
+    }
+    uWS::App *uwsApp = (uWS::App *)app;
+    uwsApp->setDeflationPoolCapacity(capacity);
+  }
+  void uws_app_deflation_pool_stats(int ssl, uws_app_t *app, uws_deflation_pool_stats_t *out)
+  {
+    uWS::DeflationPoolStats stats = ssl ? ((uWS::SSLApp *)app)->deflationPoolStats() : ((uWS::App *)app)->deflationPoolStats();
+    out->capacity = stats.capacity;
+    out->windows = stats.windows;
+    out->sockets = stats.sockets;
+    out->hits = stats.hits;
+    out->misses = stats.misses;
+    out->evictions = stats.evictions;
+    out->window_bytes = stats.windowBytes;
+  }
   uws_sendstatus_t uws_publish(int ssl, uws_app_t *app, const char *topic,
                                size_t topic_length, const char *message,
                                size_t message_length, uws_opcode_t opcode, bool compress)
@@ -602,6 +638,14 @@ extern "C"
     uWS::App *uwsApp = (uWS::App *)app;
     return uwsApp->getNativeHandle();
   }
+  void uws_app_tls_session_stats(int ssl, uws_app_t *app, struct us_ssl_ctx_session_stats_t *out)
+  {
+    *out = ssl ? ((uWS::SSLApp *)app)->tlsSessionStats() : ((uWS::App *)app)->tlsSessionStats();
+  }
+  unsigned long long uws_app_fast_open_connections(int ssl, uws_app_t *app)
+  {
+    return ssl ? ((uWS::SSLApp *)app)->fastOpenConnections() : ((uWS::App *)app)->fastOpenConnections();
+  }
   void uws_remove_server_name(int ssl, uws_app_t *app,
                               const char *hostname_pattern)
   {
@@ -1895,6 +1939,29 @@ __attribute__((callback (corker, ctx)))
     }
   }
 
+  /* tryEnd with a pin on `bytes`: plain-TCP bodies may then be sent with
+   * MSG_ZEROCOPY, and uWS holds the pin until the kernel has completed them.
+   * TLS bodies are ciphertext copies, so they take the regular path. */
+  bool uws_res_try_end_zerocopy(int ssl, uws_res_r res, const char *bytes, size_t len,
+                                size_t total_len, bool close, void *pin_ctx,
+                                void (*pin_ref)(void *), void (*pin_deref)(void *))
+  {
+    if (ssl)
+    {
+      return uws_res_try_end(ssl, res, bytes, len, total_len, close);
+    }
+
+    uWS::HttpResponse<false> *uwsRes = (uWS::HttpResponse<false> *)res;
+    uWS::ZeroCopyPin pin{pin_ctx, pin_ref, pin_deref};
+    auto pair = uwsRes->tryEnd(stringViewFromC(bytes, len), total_len, close, &pin);
+    /* See uws_res_try_end. */
+    if (pair.first && !us_socket_is_closed((struct us_socket_t *)res)) {
+      uwsRes->clearOnWritableAndAborted();
+    }
+
+    return pair.first;
+  }
+
   /* Returns the whole flags word: it no longer fits in a byte (HttpResponseData
    * carries the framing and node:http bits above bit 7), and Rust's State
    * mirrors it as a u32. */
@@ -751,6 +751,19 @@ impl<const IS_SSL: bool> NewSocketHandler<IS_SSL> {
         } else {
             0
         };
+        Self::connect_group_with_options(g, kind, ssl_ctx, raw_host, port, owner, opts)
+    }
+
+    /// [`connect_group`](Self::connect_group) with raw `LIBUS_SOCKET_*` flags.
+    pub fn connect_group_with_options<Owner>(
+        g: &mut SocketGroup,
+        kind: SocketKind,
+        ssl_ctx: Option<*mut SslCtx>,
+        raw_host: &[u8],
+        port: c_int,
+        owner: *mut Owner,
+        opts: c_int,
+    ) -> Result<Self, ConnectError> {
         // getaddrinfo doesn't understand bracketed IPv6 literals; URL parsing
         // leaves them in (`[::1]`), so strip here like the old connectAnon did.
         let host =
@@ -442,6 +442,14 @@ impl us_socket_t {
         c::us_socket_sendfile_needs_more(self);
     }
 
+    /// Moves TLS record encryption for this socket's writes into the kernel
+    /// (kTLS), after which its fd takes plaintext and `sendfile()` works on
+    /// it. `false` for plain TCP and whenever it is not possible; the socket
+    /// keeps working through BoringSSL then.
+    pub(crate) fn enable_ktls_tx(&mut self) -> bool {
+        c::us_socket_ssl_enable_ktls_tx(self) > 0
+    }
+
     pub fn get_fd(&self) -> Fd {
         let raw = c::us_socket_get_fd(self);
         // LIBUS_SOCKET_DESCRIPTOR is `c_int` on POSIX, `SOCKET` (`usize`) on
@@ -576,6 +584,7 @@ mod c {
         pub(super) safe fn us_socket_shutdown_read(s: &mut us_socket_t);
         pub(super) safe fn us_socket_is_shut_down(s: &us_socket_t) -> i32;
         pub(super) safe fn us_socket_sendfile_needs_more(socket: &mut us_socket_t);
+        pub(super) safe fn us_socket_ssl_enable_ktls_tx(s: &mut us_socket_t) -> i32;
         pub(super) safe fn us_socket_get_fd(s: &us_socket_t) -> LIBUS_SOCKET_DESCRIPTOR;
         pub(super) safe fn us_socket_verify_error(s: &us_socket_t) -> us_bun_verify_error_t;
         pub(super) safe fn us_socket_get_error(s: &us_socket_t) -> c_int;
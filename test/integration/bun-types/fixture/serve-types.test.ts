@@ -674,6 +674,14 @@ test("reusePort: true", {
   },
 });
 
+test("reusePort: cpu", {
+  reusePort: "cpu",
+  port: 0,
+  fetch() {
+    return new Response("reusePort cpu");
+  },
+});
+
 test("ipv6Only: false (default)", {
   ipv6Only: false,
   port: 0,
@@ -721,6 +721,55 @@ describe("many route params", () => {
   });
 });
 
+// uWS walks its route tree directly below 128 handlers and a flattened copy of
+// it from there on, so the same table is served once on its own and once
+// padded past that threshold.
+describe("sibling route params match the same with many routes", () => {
+  const table: ServeOptions["routes"] = {
+    "/users/:id/posts": req => Response.json({ route: "posts", params: req.params }),
+    "/users/:name/profile": req => Response.json({ route: "profile", params: req.params }),
+    "/users/:id/posts/:post": req => Response.json({ route: "post", params: req.params }),
+    "/users/me": () => Response.json({ route: "me" }),
+    "/files/*": () => Response.json({ route: "files" }),
+  };
+  const urls = [
+    "/users/1/posts",
+    "/users/alice/profile",
+    "/users/1/posts/2",
+    "/users/me",
+    "/users/me/profile",
+    "/users/1/missing",
+    "/files/a/b",
+    "/nothing",
+  ];
+
+  async function responses(routes: ServeOptions["routes"]) {
+    using server = Bun.serve({ port: 0, fetch: () => Response.json({ route: "fallback" }), routes });
+    const results: Record<string, unknown> = {};
+    for (const url of urls) {
+      const res = await fetch(new URL(url, server.url));
+      results[url] = [res.status, await res.json()];
+    }
+    return results;
+  }
+
+  it("through the tree walk and the compiled tree", async () => {
+    const padding = Object.fromEntries(Array.from({ length: 200 }, (_, i) => [`/pad${i}/:id`, () => new Response()]));
+    const tree = await responses(table);
+    expect(tree).toEqual({
+      "/users/1/posts": [200, { route: "posts", params: { id: "1" } }],
+      "/users/alice/profile": [200, { route: "profile", params: { name: "alice" } }],
+      "/users/1/posts/2": [200, { route: "post", params: { id: "1", post: "2" } }],
+      "/users/me": [200, { route: "me" }],
+      "/users/me/profile": [200, { route: "profile", params: { name: "me" } }],
+      "/users/1/missing": [200, { route: "fallback" }],
+      "/files/a/b": [200, { route: "files" }],
+      "/nothing": [200, { route: "fallback" }],
+    });
+    expect(await responses({ ...padding, ...table })).toEqual(tree);
+  });
+});
+
 it("throws a validation error when a route parameter name starts with a number", () => {
   expect(() => {
     Bun.serve({
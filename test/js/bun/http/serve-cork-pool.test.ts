@@ -0,0 +1,26 @@
+// The uWS cork pool (LoopData in packages/bun-uws/src/LoopData.h) starts with
+// two 16 KB slots and grows up to its 1 MB budget (64 slots). Only then does
+// cork() evict, taking the least recently written socket.
+import { uwsCorkPoolProbe, uwsCorkStats } from "bun:internal-for-testing";
+import { expect, test } from "bun:test";
+
+test("the cork pool grows to its budget before evicting, then evicts in LRU order", () => {
+  expect(uwsCorkPoolProbe(64)).toEqual({ initialSlots: 2, slots: 64, corked: 64, evictions: 0, evicted: [] });
+  // Socket 0 writes again once the pool is full, so it outlives 1, 2 and 3.
+  expect(uwsCorkPoolProbe(67)).toEqual({ initialSlots: 2, slots: 64, corked: 64, evictions: 3, evicted: [1, 2, 3] });
+});
+
+test("the loop's cork stats count corked requests", async () => {
+  using server = Bun.serve({ port: 0, fetch: () => new Response("ok") });
+  const before = uwsCorkStats();
+  expect(before.slots).toBeGreaterThanOrEqual(2);
+  expect(before.slots).toBeLessThanOrEqual(64);
+
+  const responses = await Promise.all(Array.from({ length: 8 }, () => fetch(server.url)));
+  for (const res of responses) expect(await res.text()).toBe("ok");
+
+  const after = uwsCorkStats();
+  expect(after.highWater).toBeGreaterThanOrEqual(1);
+  expect(after.highWater).toBeLessThanOrEqual(after.slots);
+  expect(after.evictions).toBe(before.evictions);
+});
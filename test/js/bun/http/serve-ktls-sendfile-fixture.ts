@@ -0,0 +1,54 @@
+// Serves a large file over HTTPS (sendfile-sized, so kTLS is attempted when
+// BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS is set) and fetches it back over each
+// protocol version and kernel-supported cipher, twice per keep-alive
+// connection so the second response goes out entirely kernel-sealed.
+import { tempDir, tls } from "harness";
+import { createHash } from "node:crypto";
+import https from "node:https";
+import { join } from "node:path";
+
+const body = Buffer.alloc(4 * 1024 * 1024 + 123);
+for (let i = 0; i < body.length; i++) body[i] = (i * 31 + (i >> 12)) & 0xff;
+const expected = createHash("sha256").update(body).digest("hex");
+using dir = tempDir("ktls-sendfile", { "body.bin": body });
+const path = join(String(dir), "body.bin");
+
+using server = Bun.serve({
+  port: 0,
+  hostname: "127.0.0.1",
+  tls,
+  fetch() {
+    return new Response(Bun.file(path));
+  },
+});
+
+const variants = [
+  { minVersion: "TLSv1.3", maxVersion: "TLSv1.3" },
+  { maxVersion: "TLSv1.2", ciphers: "ECDHE-RSA-AES128-GCM-SHA256" },
+  { maxVersion: "TLSv1.2", ciphers: "ECDHE-RSA-AES256-GCM-SHA384" },
+  { maxVersion: "TLSv1.2", ciphers: "ECDHE-RSA-CHACHA20-POLY1305" },
+] as const;
+
+function get(agent: https.Agent) {
+  const { promise, resolve, reject } = Promise.withResolvers<string>();
+  https
+    .get({ host: "127.0.0.1", port: server.port, path: "/", agent, rejectUnauthorized: false }, res => {
+      const hash = createHash("sha256");
+      res.on("data", chunk => hash.update(chunk));
+      res.on("end", () => resolve(hash.digest("hex")));
+      res.on("error", reject);
+    })
+    .on("error", reject);
+  return promise;
+}
+
+for (const variant of variants) {
+  const agent = new https.Agent({ keepAlive: true, maxSockets: 1, ...variant });
+  for (let i = 0; i < 2; i++) {
+    const got = await get(agent);
+    if (got !== expected) throw new Error(`${JSON.stringify(variant)} request ${i}: body mismatch`);
+  }
+  agent.destroy();
+}
+
+console.log("ok");
@@ -0,0 +1,21 @@
+import { describe, expect, test } from "bun:test";
+import { bunEnv, bunExe, isLinux } from "harness";
+import { join } from "node:path";
+
+// BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS lets Bun.serve send large static files
+// over HTTPS with sendfile() by moving record encryption into the kernel.
+// Kernels without the "tls" module (or older than 5.11) keep sealing records
+// in BoringSSL, so this passes either way; it guards that opting in never
+// changes the bytes a client receives.
+describe.skipIf(!isLinux)("kTLS sendfile", () => {
+  test.each(["0", "1"])("BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS=%s", async flag => {
+    await using proc = Bun.spawn({
+      cmd: [bunExe(), join(import.meta.dir, "serve-ktls-sendfile-fixture.ts")],
+      env: { ...bunEnv, BUN_FEATURE_FLAG_EXPERIMENTAL_KTLS: flag },
+      stdout: "pipe",
+      stderr: "pipe",
+    });
+    const [stdout, stderr, exitCode] = await Promise.all([proc.stdout.text(), proc.stderr.text(), proc.exited]);
+    expect({ stdout: stdout.trim(), stderr, exitCode }).toEqual({ stdout: "ok", stderr: "", exitCode: 0 });
+  }, 60_000);
+});
@@ -0,0 +1,34 @@
+import { expect, test } from "bun:test";
+import { isWindows } from "harness";
+
+test.skipIf(isWindows)('reusePort: "cpu" lets several servers share a port', async () => {
+  await using first = Bun.serve({
+    hostname: "127.0.0.1",
+    port: 0,
+    reusePort: "cpu",
+    fetch: () => new Response("first"),
+  });
+  await using second = Bun.serve({
+    hostname: "127.0.0.1",
+    port: first.port,
+    reusePort: "cpu",
+    fetch: () => new Response("second"),
+  });
+
+  expect(second.port).toBe(first.port);
+  for (let i = 0; i < 8; i++) {
+    const body = await fetch(first.url).then(res => res.text());
+    expect(["first", "second"]).toContain(body);
+  }
+});
+
+test("reusePort rejects unknown strings", () => {
+  expect(() =>
+    Bun.serve({
+      port: 0,
+      // @ts-expect-error
+      reusePort: "numa",
+      fetch: () => new Response(),
+    }),
+  ).toThrow('Expected reusePort to be a boolean or "cpu"');
+});
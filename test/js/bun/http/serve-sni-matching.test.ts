@@ -0,0 +1,133 @@
+// Which certificate a TLS listener serves for a given SNI name. TCP listeners
+// (Bun.serve, node:tls) and HTTP/3 share one index (usockets sni_tree.cpp), so
+// the same table of names is checked over both transports:
+//   - an exact pattern wins over a wildcard
+//   - names compare ASCII case-insensitively
+//   - "*.tail" covers exactly one label: not "a.b.tail" and not "tail" itself
+//   - a '*' that is not the whole leftmost label is literal
+//   - a repeated serverName keeps the first certificate
+import { describe, expect, test } from "bun:test";
+import { readFileSync } from "fs";
+import { connect, QuicEndpoint } from "node:quic";
+import { join } from "path";
+import * as tls from "tls";
+
+const keysDir = join(import.meta.dir, "..", "..", "node", "test", "fixtures", "keys");
+const agent = (n: number) => ({
+  key: readFileSync(join(keysDir, `agent${n}-key.pem`), "utf8"),
+  cert: readFileSync(join(keysDir, `agent${n}-cert.pem`), "utf8"),
+});
+
+// The first entry is the default certificate for names nothing else matches.
+const serverNames = [
+  { serverName: "default.test", ...agent(1) },
+  { serverName: "exact.example.com", ...agent(2) },
+  { serverName: "*.example.com", ...agent(3) },
+  { serverName: "a.*.example.org", ...agent(4) },
+  { serverName: "Mixed.Example.NET", ...agent(4) },
+  { serverName: "dup.example.net", ...agent(2) },
+  { serverName: "dup.example.net", ...agent(3) },
+];
+
+const expected: Record<string, string> = {
+  "exact.example.com": "agent2",
+  "other.example.com": "agent3",
+  "EXACT.Example.COM": "agent2",
+  "Other.EXAMPLE.com": "agent3",
+  "mixed.example.net": "agent4",
+  "a.b.example.com": "agent1",
+  "example.com": "agent1",
+  "a.b.example.org": "agent1",
+  "a.*.example.org": "agent4",
+  "dup.example.net": "agent2",
+  "unknown.test": "agent1",
+};
+
+const commonName = (subject: string) => /CN=([^\n,]+)/.exec(subject)?.[1];
+
+async function tcpCommonName(port: number, servername: string) {
+  const socket = tls.connect({ port, host: "127.0.0.1", servername, rejectUnauthorized: false });
+  try {
+    await new Promise<void>((resolve, reject) => {
+      socket.on("secureConnect", resolve);
+      socket.on("error", reject);
+    });
+    return socket.getPeerCertificate().subject.CN;
+  } finally {
+    socket.destroy();
+  }
+}
+
+async function quicCommonName(port: number, servername: string) {
+  await using endpoint = new QuicEndpoint();
+  const client = await connect(`127.0.0.1:${port}`, {
+    endpoint,
+    servername,
+    verifyPeer: "manual",
+    transportParams: { maxIdleTimeout: 5 },
+    onerror() {},
+  });
+  try {
+    await client.opened;
+    return commonName(client.peerCertificate.subject);
+  } finally {
+    if (!client.destroyed) client.close().catch(() => {});
+  }
+}
+
+describe("Bun.serve serverName matching", () => {
+  test("over TCP", async () => {
+    using server = Bun.serve({ port: 0, tls: serverNames, fetch: () => new Response("ok") });
+    const served: Record<string, string | undefined> = {};
+    for (const name of Object.keys(expected)) served[name] = await tcpCommonName(server.port, name);
+    expect(served).toEqual(expected);
+  });
+
+  test("over HTTP/3", async () => {
+    await using server = Bun.serve({ port: 0, tls: serverNames, http3: true, fetch: () => new Response("ok") });
+    const served: Record<string, string | undefined> = {};
+    for (const name of Object.keys(expected)) served[name] = await quicCommonName(server.port, name);
+    expect(served).toEqual(expected);
+  });
+});
+
+test("tls.Server.addContext replaces a pattern and survives churn", async () => {
+  const server = tls.createServer(agent(1));
+  await new Promise<void>(resolve => server.listen(0, "127.0.0.1", resolve));
+  try {
+    const { port } = server.address() as { port: number };
+    const sni = (name: string) => tcpCommonName(port, name);
+
+    server.addContext("*.example.com", agent(3));
+    expect(await sni("a.example.com")).toBe("agent3");
+
+    // Re-adding a pattern removes the old entry first, so the new one wins.
+    server.addContext("*.example.com", agent(4));
+    expect(await sni("a.example.com")).toBe("agent4");
+
+    // Enough names to grow the index several times, then replace every third
+    // one in place so removals shift entries around the table.
+    for (let i = 0; i < 300; i++) server.addContext(`host${i}.churn.test`, agent(2));
+    for (let i = 0; i < 300; i += 3) server.addContext(`host${i}.churn.test`, agent(3));
+
+    expect({
+      host0: await sni("host0.churn.test"),
+      host1: await sni("host1.churn.test"),
+      host2: await sni("host2.churn.test"),
+      host297: await sni("host297.churn.test"),
+      host299: await sni("HOST299.churn.test"),
+      host300: await sni("host300.churn.test"),
+      wildcard: await sni("b.example.com"),
+    }).toEqual({
+      host0: "agent3",
+      host1: "agent2",
+      host2: "agent2",
+      host297: "agent3",
+      host299: "agent2",
+      host300: "agent1",
+      wildcard: "agent4",
+    });
+  } finally {
+    server.close();
+  }
+});
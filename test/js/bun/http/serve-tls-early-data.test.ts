@@ -0,0 +1,77 @@
+import { expect, test } from "bun:test";
+import { readFileSync } from "fs";
+import { tls as cert } from "harness";
+
+// net.ipv4.tcp_fastopen: bit 0 enables it for connects, bit 1 for listeners.
+// Without both, loopback connections never carry data in the SYN.
+const tcpFastOpenEnabled = (() => {
+  try {
+    return (parseInt(readFileSync("/proc/sys/net/ipv4/tcp_fastopen", "utf8")) & 3) === 3;
+  } catch {
+    return false;
+  }
+})();
+
+function serve(options: Partial<Bun.ServeOptions> = {}) {
+  return Bun.serve({
+    port: 0,
+    tls: { ...cert, earlyData: true },
+    // Connection: close makes every fetch open (and resume) a new connection.
+    fetch: req => new Response(req.method, { headers: { Connection: "close" } }),
+    ...options,
+  });
+}
+
+test("fetch sends a resumed GET as early data and the server answers it", async () => {
+  using server = serve();
+  const before = fetch.connectionStats();
+  const get = () =>
+    fetch(`https://localhost:${server.port}/`, { tls: { ca: cert.cert, earlyData: true } }).then(r => r.text());
+
+  expect(await get()).toBe("GET");
+  expect(await get()).toBe("GET");
+
+  expect(server.tlsSessionStats()).toMatchObject({ resumed: 1, full: 1, earlyData: 1, tooEarly: 0 });
+  const after = fetch.connectionStats();
+  expect(after.earlyData - before.earlyData).toBe(1);
+  expect(after.earlyDataAccepted - before.earlyDataAccepted).toBe(1);
+  expect(after.earlyDataRejected - before.earlyDataRejected).toBe(0);
+});
+
+test("fetch waits for the handshake before sending a POST", async () => {
+  using server = serve();
+  const post = () =>
+    fetch(`https://localhost:${server.port}/`, {
+      method: "POST",
+      body: "x",
+      tls: { ca: cert.cert, earlyData: true },
+    }).then(r => r.text());
+
+  expect(await post()).toBe("POST");
+  expect(await post()).toBe("POST");
+  expect(server.tlsSessionStats()).toMatchObject({ resumed: 1, earlyData: 0, tooEarly: 0 });
+});
+
+test("early data is off unless both sides ask for it", async () => {
+  using server = serve({ tls: cert });
+  const get = () =>
+    fetch(`https://localhost:${server.port}/`, { tls: { ca: cert.cert, earlyData: true } }).then(r => r.text());
+
+  expect(await get()).toBe("GET");
+  expect(await get()).toBe("GET");
+  expect(server.tlsSessionStats()).toMatchObject({ resumed: 1, earlyData: 0 });
+});
+
+test.skipIf(!tcpFastOpenEnabled)("tcpFastOpen connections are counted on both ends", async () => {
+  using server = serve({ tls: undefined, tcpFastOpen: true });
+  const before = fetch.connectionStats();
+
+  // The first connection fetches a cookie; later ones carry data in the SYN.
+  for (let i = 0; i < 3; i++) {
+    expect(await fetch(`http://127.0.0.1:${server.port}/`, { tcpFastOpen: true }).then(r => r.text())).toBe("GET");
+  }
+
+  const sent = fetch.connectionStats().fastOpen - before.fastOpen;
+  expect(sent).toBeGreaterThan(0);
+  expect(server.fastOpenConnections).toBe(sent);
+});
@@ -0,0 +1,53 @@
+import { expect, test } from "bun:test";
+import { tls as cert } from "harness";
+import * as tls from "tls";
+
+function handshake(port: number, options: tls.ConnectionOptions = {}) {
+  return new Promise<string>((resolve, reject) => {
+    const socket = tls.connect({ port, host: "127.0.0.1", rejectUnauthorized: false, ...options });
+    let response = "";
+    socket.on("secureConnect", () => socket.write("GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n"));
+    socket.on("data", chunk => (response += chunk));
+    socket.on("close", () => resolve(response));
+    socket.on("error", reject);
+  });
+}
+
+test.each(["TLSv1.2", "TLSv1.3"] as const)("handshakeThreads signs %s handshakes off the loop", async version => {
+  using server = Bun.serve({
+    port: 0,
+    tls: { ...cert, handshakeThreads: 2 },
+    fetch: () => new Response("ok"),
+  });
+
+  // Many fresh handshakes at once, so several wait on the workers together.
+  const responses = await Promise.all(
+    Array.from({ length: 64 }, () => handshake(server.port, { minVersion: version, maxVersion: version })),
+  );
+  for (const response of responses) {
+    expect(response).toStartWith("HTTP/1.1 200");
+    expect(response).toEndWith("ok");
+  }
+  expect(server.tlsSessionStats()).toMatchObject({ full: 64 });
+});
+
+test("handshakeThreads works with fetch and a socket closed mid-handshake", async () => {
+  using server = Bun.serve({
+    port: 0,
+    tls: { ...cert, handshakeThreads: 1 },
+    fetch: () => new Response("ok"),
+  });
+
+  // Clients that give up while their signature is on a worker must not
+  // disturb the ones that wait.
+  for (let i = 0; i < 16; i++) {
+    const socket = tls.connect({ port: server.port, host: "127.0.0.1", rejectUnauthorized: false });
+    socket.on("error", () => {});
+    setImmediate(() => socket.destroy());
+  }
+
+  const responses = await Promise.all(
+    Array.from({ length: 16 }, () => fetch(server.url, { tls: { rejectUnauthorized: false } }).then(r => r.text())),
+  );
+  expect(responses).toEqual(Array(16).fill("ok"));
+});
@@ -0,0 +1,85 @@
+import { expect, test } from "bun:test";
+import { randomBytes } from "crypto";
+import { renameSync, writeFileSync } from "fs";
+import { tempDirWithFiles, tls as cert } from "harness";
+import { join } from "path";
+import * as tls from "tls";
+
+// Makes a request and returns the last session the server sent, and whether
+// the handshake resumed `session`.
+async function request(port: number, session?: Buffer) {
+  const socket = tls.connect({ port, host: "127.0.0.1", rejectUnauthorized: false, session });
+  let ticket: Buffer | undefined;
+  socket.on("session", s => (ticket = s));
+  socket.resume();
+  await new Promise<void>((resolve, reject) => {
+    socket.on("secureConnect", resolve);
+    socket.on("error", reject);
+  });
+  const reused = socket.isSessionReused();
+  socket.write("GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n");
+  await new Promise<void>(resolve => socket.on("close", () => resolve()));
+  return { reused, ticket: ticket! };
+}
+
+function serve(ticketKeysFile: string) {
+  return Bun.serve({
+    port: 0,
+    tls: { ...cert, ticketKeysFile },
+    fetch: () => new Response("ok"),
+  });
+}
+
+test("servers sharing ticketKeysFile resume each other's sessions", async () => {
+  const dir = tempDirWithFiles("ticket-keys", {});
+  const keysFile = join(dir, "keys");
+  const first = randomBytes(48);
+  writeFileSync(keysFile, first);
+
+  using a = serve(keysFile);
+  using b = serve(keysFile);
+
+  const fresh = await request(a.port);
+  expect(fresh.reused).toBe(false);
+  expect(fresh.ticket).toBeDefined();
+  expect((await request(b.port, fresh.ticket)).reused).toBe(true);
+
+  expect(a.tlsSessionStats()).toEqual({
+    resumed: 0,
+    full: 1,
+    ticketKeys: 1,
+    ticketKeyReloads: 0,
+    ticketKeyErrors: 0,
+    earlyData: 0,
+    tooEarly: 0,
+  });
+  expect(b.tlsSessionStats()).toMatchObject({ resumed: 1, full: 0, ticketKeys: 1 });
+
+  // Rotate: a new primary key, the old one kept for decryption.
+  writeFileSync(keysFile + ".tmp", Buffer.concat([randomBytes(48), first]));
+  renameSync(keysFile + ".tmp", keysFile);
+  await Bun.sleep(1100);
+
+  const old = await request(b.port, fresh.ticket);
+  expect(old.reused).toBe(true);
+  expect(b.tlsSessionStats()).toMatchObject({ resumed: 2, ticketKeys: 2, ticketKeyReloads: 1 });
+
+  // Once the old key is dropped its tickets no longer resume.
+  writeFileSync(keysFile + ".tmp", randomBytes(48));
+  renameSync(keysFile + ".tmp", keysFile);
+  await Bun.sleep(1100);
+  expect((await request(a.port, fresh.ticket)).reused).toBe(false);
+  expect(a.tlsSessionStats()).toMatchObject({ resumed: 0, full: 2, ticketKeys: 1, ticketKeyReloads: 1 });
+});
+
+test("rejects a ticketKeysFile that is not a whole number of keys", () => {
+  const dir = tempDirWithFiles("ticket-keys", {});
+  const keysFile = join(dir, "keys");
+  writeFileSync(keysFile, randomBytes(47));
+  expect(() => serve(keysFile)).toThrow();
+});
+
+test("tlsSessionStats is undefined without TLS", () => {
+  using server = Bun.serve({ port: 0, fetch: () => new Response("ok") });
+  expect(server.tlsSessionStats()).toBeUndefined();
+});
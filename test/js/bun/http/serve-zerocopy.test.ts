@@ -0,0 +1,25 @@
+import { expect, test } from "bun:test";
+
+// Blob-backed bodies of 64 KB and up are sent with MSG_ZEROCOPY on Linux. The
+// kernel may report the send as copied (loopback does), which turns zero-copy
+// off for that connection; either way every byte must arrive intact.
+test.each([64 * 1024, 512 * 1024, 4 * 1024 * 1024])("large Blob body of %d bytes arrives intact", async size => {
+  const bytes = new Uint8Array(size);
+  for (let i = 0; i < size; i++) bytes[i] = (i * 31 + (i >> 8)) & 0xff;
+  const blob = new Blob([bytes]);
+
+  await using server = Bun.serve({
+    port: 0,
+    routes: { "/static": new Response(blob) },
+    fetch: () => new Response(blob),
+  });
+
+  const responses = await Promise.all(
+    Array.from({ length: 8 }, (_, i) => fetch(new URL(i % 2 ? "/static" : "/", server.url))),
+  );
+  for (const res of responses) {
+    const body = new Uint8Array(await res.arrayBuffer());
+    expect(body.length).toBe(size);
+    expect(Buffer.from(body).equals(Buffer.from(bytes))).toBe(true);
+  }
+});
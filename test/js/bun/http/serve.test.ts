@@ -22,6 +22,7 @@ import { connect } from "net";
 import { join, resolve } from "path";
 // import { renderToReadableStream } from "react-dom/server";
 // import app_jsx from "./app.jsx";
+import { uwsCorkStats } from "bun:internal-for-testing";
 import { heapStats } from "bun:jsc";
 import { spawn } from "child_process";
 import net from "node:net";
@@ -4688,3 +4689,82 @@ it("serves a TLS connection whose handshake completes after a graceful stop()",
     raw.destroy();
   }
 });
+
+// Responses to requests pipelined in one read are written together once the
+// read is parsed, even when they overflow the cork buffer; they must still
+// arrive whole and in request order.
+describe.each([false, true])("pipelined responses past the cork buffer (tls: %p)", useTls => {
+  function pipelineServer() {
+    return Bun.serve({
+      port: 0,
+      ...(useTls ? { tls } : {}),
+      fetch(req) {
+        const i = Number(new URL(req.url).pathname.slice(1));
+        return new Response(String.fromCharCode(97 + i).repeat(6000 + i * 1000));
+      },
+    });
+  }
+
+  // Sends `requests` in one write and returns everything read until close.
+  async function exchange(port: number, requests: string) {
+    const socket = useTls
+      ? nodeTls.connect({ port, host: "127.0.0.1", rejectUnauthorized: false })
+      : net.connect(port, "127.0.0.1");
+    const chunks: Buffer[] = [];
+    socket.on("data", d => chunks.push(d));
+    await new Promise<void>((resolve, reject) => {
+      socket.on(useTls ? "secureConnect" : "connect", () => socket.write(requests));
+      socket.on("close", () => resolve());
+      socket.on("error", reject);
+    });
+    return Buffer.concat(chunks).toString();
+  }
+
+  function get(count: number) {
+    let requests = "";
+    for (let i = 0; i < count; i++) {
+      requests += `GET /${i} HTTP/1.1\r\nHost: localhost\r\n${i === count - 1 ? "Connection: close\r\n" : ""}\r\n`;
+    }
+    return requests;
+  }
+
+  const bodiesOf = (text: string) =>
+    text
+      .split("HTTP/1.1 200 OK")
+      .slice(1)
+      .map(response => response.slice(response.indexOf("\r\n\r\n") + 4));
+  const body = (i: number) => String.fromCharCode(97 + i).repeat(6000 + i * 1000);
+
+  it("arrive in request order", async () => {
+    using server = pipelineServer();
+    const count = 12;
+    expect(bodiesOf(await exchange(server.port, get(count)))).toEqual(Array.from({ length: count }, (_, i) => body(i)));
+  });
+
+  it("leave in one write per read", async () => {
+    // Each response fits the cork buffer on its own, so before batching every
+    // one of them was sent as soon as it ended.
+    using server = Bun.serve({
+      port: 0,
+      ...(useTls ? { tls } : {}),
+      fetch: req => new Response(new URL(req.url).pathname.slice(1).padEnd(1024, ".")),
+    });
+    const count = 32;
+    const before = uwsCorkStats().pipelineBatches;
+    const text = await exchange(server.port, get(count));
+    expect(bodiesOf(text)).toEqual(Array.from({ length: count }, (_, i) => String(i).padEnd(1024, ".")));
+    // 32 KB of responses: one batched write per read, and the requests
+    // (about 1.5 KB) reach the server in one or a few reads.
+    const batches = uwsCorkStats().pipelineBatches - before;
+    expect(batches).toBeGreaterThanOrEqual(1);
+    expect(batches).toBeLessThanOrEqual(4);
+  });
+
+  it("are sent before the error for a malformed request behind them", async () => {
+    using server = pipelineServer();
+    const text = await exchange(server.port, get(3).replace("Connection: close\r\n", "") + "NOT HTTP\r\n\r\n");
+    const error = text.indexOf("HTTP/1.1 4");
+    expect(bodiesOf(text.slice(0, error))).toEqual([body(0), body(1), body(2)]);
+    expect(text.slice(error)).toMatch(/^HTTP\/1\.1 4\d\d [^\r]*\r\nConnection: close\r\n/);
+  });
+});
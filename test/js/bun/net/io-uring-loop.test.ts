@@ -0,0 +1,20 @@
+import { describe, expect, test } from "bun:test";
+import { bunEnv, bunExe, isLinux } from "harness";
+import { join } from "node:path";
+
+// BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING moves TCP accept and reads onto an
+// io_uring layered over the epoll loop. Kernels older than 6.1 (or sandboxes
+// that block io_uring_setup) keep plain epoll, so this passes either way; it
+// guards that opting in never changes what a program observes.
+describe.skipIf(!isLinux)("io_uring event loop", () => {
+  test.each(["0", "1"])("BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING=%s", async flag => {
+    await using proc = Bun.spawn({
+      cmd: [bunExe(), join(import.meta.dir, "io-uring-loop-fixture.ts")],
+      env: { ...bunEnv, BUN_FEATURE_FLAG_EXPERIMENTAL_IO_URING: flag },
+      stdout: "pipe",
+      stderr: "pipe",
+    });
+    const [stdout, stderr, exitCode] = await Promise.all([proc.stdout.text(), proc.stderr.text(), proc.exited]);
+    expect({ stdout: stdout.trim(), stderr, exitCode }).toEqual({ stdout: "ok", stderr: "", exitCode: 0 });
+  }, 60_000);
+});
@@ -352,6 +352,34 @@ describe.concurrent("socket", () => {
     }
   }, 60_000);
 
+  // Socket timeouts live on a one-second timing wheel: never early, and no
+  // longer rounded up to the old 4s sweep. libuv still sweeps every 4s.
+  it.skipIf(isWindows)("timeout(1) fires between 1 and 2 seconds after it is armed", async () => {
+    using server = Bun.listen({
+      hostname: "127.0.0.1",
+      port: 0,
+      socket: { data() {} },
+    });
+    const { promise, resolve } = Promise.withResolvers<number>();
+    let armedAt = 0;
+    const client = await connect({
+      hostname: server.hostname,
+      port: server.port,
+      socket: {
+        timeout() {
+          resolve(performance.now() - armedAt);
+        },
+        data() {},
+      },
+    });
+    armedAt = performance.now();
+    client.timeout(1);
+    const elapsed = await promise;
+    client.end();
+    expect(elapsed).toBeGreaterThanOrEqual(1000);
+    expect(elapsed).toBeLessThan(2500);
+  });
+
   it("should allow large amounts of data to be sent and received", async () => {
     const { stderr, exitCode } = await bunRun(fileURLToPath(new URL("./socket-huge-fixture.js", import.meta.url)));
     if (exitCode !== 0) console.error(stderr);
@@ -1,4 +1,5 @@
 import { spawnSync } from "bun";
+import { haveSameStructure } from "bun:internal-for-testing";
 import { constants, Database, SQLiteError } from "bun:sqlite";
 import { describe, expect, it } from "bun:test";
 import { existsSync, readdirSync, readFileSync, realpathSync, rmSync, statSync, writeFileSync } from "fs";
@@ -67,6 +68,20 @@ describe("as", () => {
       "Expected a constructor prototype to be an object",
     );
   });
+
+  it("shares a row shape between statements with the same columns and class", () => {
+    class Row {}
+    using a = new Database(":memory:");
+    using b = new Database(":memory:");
+    const first = a.query("SELECT 1 AS id, 'x' AS name").get();
+    expect(haveSameStructure(first, a.prepare("SELECT 2 AS id, 'y' AS name").get())).toBe(true);
+    expect(haveSameStructure(first, b.prepare("SELECT 3 AS id, 'z' AS name").all()[0])).toBe(true);
+    expect(haveSameStructure(first, a.query("SELECT 4 AS name, 'w' AS id").get())).toBe(false);
+
+    const typed = a.query("SELECT 5 AS id, 'v' AS name").as(Row).get();
+    expect(haveSameStructure(first, typed)).toBe(false);
+    expect(haveSameStructure(typed, b.query("SELECT 6 AS id, 'u' AS name").as(Row).get())).toBe(true);
+  });
 });
 
 describe("safeIntegers", () => {
@@ -2753,3 +2768,355 @@ it("exec/run with an embedded NUL byte in the SQL string does not hang", async (
     exitCode: 0,
   });
 });
+
+describe("allAsync", () => {
+  function openReports() {
+    const dir = tempDir("sqlite-all-async", {});
+    const db = new Database(path.join(String(dir), "reports.db"));
+    db.run("PRAGMA journal_mode = WAL");
+    db.run("CREATE TABLE orders (id INTEGER PRIMARY KEY, region TEXT, total REAL, note BLOB)");
+    const insert = db.prepare("INSERT INTO orders (region, total, note) VALUES (?, ?, ?)");
+    db.transaction(() => {
+      for (let i = 0; i < 1000; i++) insert.run(i % 2 ? "emea" : "apac", i / 4, i % 10 ? null : new Uint8Array([i & 0xff]));
+    })();
+    return { db, [Symbol.dispose]: () => (db.close(), dir[Symbol.dispose]()) };
+  }
+
+  it("resolves to what all() returns", async () => {
+    using reports = openReports();
+    const { db } = reports;
+    const stmt = db.prepare("SELECT id, region, total, note, 'x' || id AS label FROM orders WHERE region = $region");
+    const rows = await stmt.allAsync({ $region: "emea" });
+    expect(rows).toHaveLength(500);
+    expect(rows).toEqual(stmt.all({ $region: "emea" }));
+
+    const grouped = db.query("SELECT region, count(*) AS n FROM orders GROUP BY region ORDER BY region");
+    expect(await grouped.allAsync()).toEqual([
+      { region: "apac", n: 500 },
+      { region: "emea", n: 500 },
+    ]);
+
+    class Order {}
+    const typed = db.query("SELECT id FROM orders WHERE id = ?").as(Order).safeIntegers(true);
+    const [order] = await typed.allAsync(7);
+    expect(order).toBeInstanceOf(Order);
+    expect(order.id).toBe(7n);
+  });
+
+  it("runs queries concurrently and sees committed writes", async () => {
+    using reports = openReports();
+    const { db } = reports;
+    const count = db.query("SELECT count(*) AS n FROM orders");
+    const before = count.allAsync();
+    db.run("INSERT INTO orders (region, total) VALUES ('amer', 1)");
+    const results = await Promise.all([before, count.allAsync(), count.allAsync()]);
+    expect(results[1]).toEqual([{ n: 1001 }]);
+    expect(results[2]).toEqual([{ n: 1001 }]);
+    expect([1000, 1001]).toContain(results[0][0].n);
+  });
+
+  it("rejects with SQLiteError and refuses what it cannot run", async () => {
+    using reports = openReports();
+    const { db } = reports;
+    expect(() => db.prepare("DELETE FROM orders").allAsync()).toThrow("read-only");
+    expect(() => new Database(":memory:").query("SELECT 1").allAsync()).toThrow("file");
+    expect(() => db.query("SELECT ?1 AS a").allAsync(1, 2)).toThrow("expected 1 values");
+    const err = await db
+      .query("SELECT abs(-9223372036854775807 - 1)")
+      .allAsync()
+      .catch(e => e);
+    expect(err).toBeInstanceOf(SQLiteError);
+    expect(err.message).toContain("integer overflow");
+
+    const stmt = db.prepare("SELECT * FROM orders");
+    const pending = stmt.allAsync();
+    stmt.finalize();
+    await expect(pending).rejects.toThrow("Statement has finalized");
+  });
+});
+
+describe("columnar", () => {
+  it("returns one array per column with null bitmaps", () => {
+    using db = new Database(":memory:");
+    db.run("CREATE TABLE t (id INTEGER, price REAL, name TEXT, data BLOB, mixed, empty)");
+    const insert = db.prepare("INSERT INTO t VALUES (?, ?, ?, ?, ?, NULL)");
+    insert.run(1, 9.5, "a", new Uint8Array([1]), 1);
+    insert.run(2, null, "b", null, "two");
+    insert.run(3, 12, null, new Uint8Array([3]), null);
+
+    const { length, columns, nulls } = db.query("SELECT * FROM t ORDER BY id").columnar();
+    expect(length).toBe(3);
+    expect(columns.id).toEqual(new Float64Array([1, 2, 3]));
+    expect(columns.price).toEqual(new Float64Array([9.5, 0, 12]));
+    expect(columns.name).toEqual(["a", "b", null]);
+    expect(columns.data).toEqual([new Uint8Array([1]), null, new Uint8Array([3])]);
+    expect(columns.mixed).toEqual([1, "two", null]);
+    expect(columns.empty).toEqual([null, null, null]);
+    expect(Object.keys(nulls).sort()).toEqual(["data", "empty", "mixed", "name", "price"]);
+    expect(nulls.price).toEqual(new Uint8Array([0b010]));
+    expect(nulls.name).toEqual(new Uint8Array([0b100]));
+    expect(nulls.empty).toEqual(new Uint8Array([0b111]));
+  });
+
+  it("keeps null bits across bitmap bytes", () => {
+    using db = new Database(":memory:");
+    const { length, columns, nulls } = db
+      .query(
+        "WITH RECURSIVE s(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM s WHERE n < 20) SELECT CASE WHEN n % 3 = 0 THEN NULL ELSE n END AS v FROM s",
+      )
+      .columnar();
+    expect(length).toBe(20);
+    expect(columns.v[19]).toBe(20);
+    // Rows 2, 5, 8, 11, 14 and 17 are NULL.
+    expect(nulls.v).toEqual(new Uint8Array([0b00100100, 0b01001001, 0b00000010]));
+  });
+
+  it("uses BigInt64Array with safeIntegers and binds parameters", () => {
+    using db = new Database(":memory:", { safeIntegers: true });
+    const { length, columns, nulls } = db
+      .query("WITH RECURSIVE s(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM s WHERE n < ?) SELECT n FROM s")
+      .columnar(20);
+    expect(length).toBe(20);
+    expect(columns.n).toBeInstanceOf(BigInt64Array);
+    expect(columns.n[19]).toBe(20n);
+    expect(nulls).toEqual({});
+
+    const none = db.query("SELECT 1 AS a WHERE 0").columnar();
+    expect(none).toEqual({ length: 0, columns: { a: [] }, nulls: {} });
+  });
+});
+
+describe("runBatch", () => {
+  it("binds arrays and objects of any shape", () => {
+    using db = new Database(":memory:");
+    db.run("CREATE TABLE t (id INTEGER PRIMARY KEY, name TEXT, score REAL)");
+    const named = db.prepare("INSERT INTO t (name, score) VALUES ($name, $score)");
+    const rows = Array.from({ length: 1000 }, (_, i) => ({ $name: "n" + i, $score: i / 2 }));
+    rows[500] = { $score: 1, $name: "reordered" };
+    rows[501] = {
+      get $name() {
+        return "getter";
+      },
+      $score: 2,
+    };
+    expect(named.runBatch(rows)).toEqual({ changes: 1000, lastInsertRowid: 1000 });
+
+    const positional = db.prepare("INSERT INTO t (name, score) VALUES (?, ?)");
+    expect(positional.runBatch([["x", 1], ["y", null]])).toEqual({ changes: 2, lastInsertRowid: 1002 });
+
+    expect(db.query("SELECT count(*) AS n, sum(score) AS s FROM t").get()).toEqual({ n: 1002, s: 249253.5 });
+    expect(db.query("SELECT name FROM t WHERE id IN (501, 502, 1002)").values()).toEqual([["reordered"], ["getter"], ["y"]]);
+    expect(named.runBatch([])).toEqual({ changes: 0, lastInsertRowid: 1002 });
+  });
+
+  it("takes what columnar() returns", () => {
+    using db = new Database(":memory:", { strict: true });
+    db.run("CREATE TABLE src (a INTEGER, b TEXT)");
+    db.run("CREATE TABLE dst (a INTEGER, b TEXT)");
+    db.prepare("INSERT INTO src VALUES (?, ?)").runBatch([
+      [1, "one"],
+      [null, "two"],
+      [3, null],
+    ]);
+    const insert = db.prepare("INSERT INTO dst VALUES ($a, $b)");
+    expect(insert.runBatch(db.query("SELECT a, b FROM src").columnar())).toEqual({ changes: 3, lastInsertRowid: 3 });
+    expect(db.query("SELECT * FROM dst").all()).toEqual(db.query("SELECT * FROM src").all());
+
+    db.prepare("INSERT INTO dst VALUES (?1, ?2)").runBatch({ length: 2, columns: { 0: new Float64Array([7, 8, 9]), 1: ["x", "y"] } });
+    expect(db.query("SELECT a, b FROM dst WHERE a > 3").values()).toEqual([
+      [7, "x"],
+      [8, "y"],
+    ]);
+    expect(() => insert.runBatch({ length: 4, columns: { a: [1], b: [1] } })).toThrow("expected 4");
+    expect(() => insert.runBatch({ columns: { a: new Uint8Array(1), b: [1] } })).toThrow("Float64Array");
+  });
+
+  it("keeps columns alive when binding drops the batch's references", () => {
+    using db = new Database(":memory:", { strict: true });
+    db.run("CREATE TABLE t (a INTEGER, b REAL)");
+    const length = 1000;
+    const a = Array.from({ length }, (_, i) => i);
+    const batch = {
+      length,
+      columns: { a, b: new Float64Array(length).map((_, i) => i / 2) },
+      nulls: { b: new Uint8Array(length / 8).fill(0x01) },
+    };
+    Object.defineProperty(a, 1, {
+      get() {
+        batch.columns = batch.nulls = null;
+        Bun.gc(true);
+        new Float64Array(length).fill(-1);
+        return 1;
+      },
+    });
+    db.prepare("INSERT INTO t VALUES ($a, $b)").runBatch(batch);
+    expect(db.query("SELECT b FROM t WHERE a IN (0, 1, 2, 9, 999) ORDER BY a").values()).toEqual([[null], [0.5], [1], [4.5], [499.5]]);
+  });
+
+  it("rolls back the whole batch when a row fails", () => {
+    using db = new Database(":memory:");
+    db.run("CREATE TABLE t (id INTEGER PRIMARY KEY)");
+    const insert = db.prepare("INSERT INTO t VALUES (?)");
+    expect(() => insert.runBatch([[1], [2], [2]])).toThrow(SQLiteError);
+    expect(db.query("SELECT count(*) AS n FROM t").get()).toEqual({ n: 0 });
+    expect(db.inTransaction).toBe(false);
+
+    db.transaction(() => {
+      insert.run(10);
+      expect(() => insert.runBatch([[1], [1]])).toThrow(SQLiteError);
+      expect(db.inTransaction).toBe(true);
+    })();
+    expect(db.query("SELECT id FROM t").values()).toEqual([[10]]);
+
+    expect(() => insert.runBatch([[1], [1]], { transaction: false })).toThrow(SQLiteError);
+    expect(db.query("SELECT id FROM t").values()).toEqual([[1], [10]]);
+  });
+
+  it("stops when reading a row finalizes the statement or closes the database", () => {
+    using db = new Database(":memory:");
+    db.run("CREATE TABLE t (a INTEGER)");
+
+    let insert = db.prepare("INSERT INTO t VALUES ($a)");
+    const finalizing = {
+      get $a() {
+        insert.finalize();
+        return 2;
+      },
+    };
+    expect(() => insert.runBatch([{ $a: 1 }, finalizing, { $a: 3 }])).toThrow("Statement has finalized");
+    expect(db.query("SELECT count(*) AS n FROM t").get()).toEqual({ n: 0 });
+    expect(db.inTransaction).toBe(false);
+
+    // A hole reads through to the prototype, which can run a getter too.
+    insert = db.prepare("INSERT INTO t VALUES (?)");
+    const rows = [[1], , [3]];
+    Object.setPrototypeOf(
+      rows,
+      Object.create(Array.prototype, {
+        1: {
+          get() {
+            insert.finalize();
+            return [2];
+          },
+        },
+      }),
+    );
+    expect(() => insert.runBatch(rows)).toThrow("Statement has finalized");
+    expect(db.query("SELECT count(*) AS n FROM t").get()).toEqual({ n: 0 });
+
+    insert = db.prepare("INSERT INTO t VALUES ($a)");
+    const closing = {
+      get $a() {
+        db.close();
+        return 2;
+      },
+    };
+    expect(() => insert.runBatch([{ $a: 1 }, closing])).toThrow("Database has closed");
+  });
+});
+
+describe("openBlob", () => {
+  const data = new Uint8Array(300_000).map((_, i) => i * 7);
+
+  function openFiles() {
+    const db = new Database(":memory:");
+    db.run("CREATE TABLE files (name TEXT, data BLOB)");
+    db.run("INSERT INTO files VALUES ('a', ?), ('b', ?)", [data, new Uint8Array([1, 2, 3])]);
+    return db;
+  }
+
+  it("reads ranges and streams without loading the value", async () => {
+    using db = openFiles();
+    using blob = db.openBlob("files", "data", 1);
+    expect(blob.size).toBe(data.length);
+
+    const buffer = new Uint8Array(10);
+    expect(blob.read(buffer, 1000)).toBe(10);
+    expect(buffer).toEqual(data.subarray(1000, 1010));
+    expect(blob.read(buffer, data.length - 4)).toBe(4);
+    expect(blob.read(buffer, data.length)).toBe(0);
+
+    const chunks = [];
+    for await (const chunk of blob.stream(65536)) chunks.push(chunk.length);
+    expect(chunks).toEqual([65536, 65536, 65536, 65536, 37856]);
+    expect(await new Response(blob.stream()).bytes()).toEqual(data);
+    expect(await blob.bytes()).toEqual(data);
+
+    blob.reopen(2);
+    expect(blob.size).toBe(3);
+    expect(await blob.bytes()).toEqual(new Uint8Array([1, 2, 3]));
+  });
+
+  it("writes in place when writable", () => {
+    using db = openFiles();
+    db.run("INSERT INTO files VALUES ('c', zeroblob(8))");
+    expect(() => db.openBlob("files", "data", 3).write(new Uint8Array(1))).toThrow(SQLiteError);
+
+    const blob = db.openBlob("files", "data", 3, { writable: true });
+    blob.write(new Uint8Array([1, 2]), 2);
+    blob.write(new Uint8Array([9]).buffer);
+    expect(() => blob.write(new Uint8Array(2), 7)).toThrow("past the end");
+    expect(db.query("SELECT data FROM files WHERE rowid = 3").values()).toEqual([[new Uint8Array([9, 0, 1, 2, 0, 0, 0, 0])]]);
+
+    // Changing the row invalidates the handle.
+    db.run("UPDATE files SET data = x'00' WHERE rowid = 3");
+    expect(() => blob.read(new Uint8Array(1))).toThrow(SQLiteError);
+    blob.close();
+    expect(() => blob.read(new Uint8Array(1))).toThrow("Blob has closed");
+  });
+
+  it("is closed with the database", () => {
+    using db = openFiles();
+    expect(() => db.openBlob("files", "missing", 1)).toThrow(SQLiteError);
+    expect(() => db.openBlob("files", "data", 99)).toThrow(SQLiteError);
+    const blob = db.openBlob("files", "data", 2);
+    db.close();
+    expect(() => blob.read(new Uint8Array(1))).toThrow("Database has closed");
+    blob.close();
+  });
+
+  // An open blob handle keeps its table locked against DROP TABLE.
+  function dropFiles(db) {
+    db.run("CREATE TABLE IF NOT EXISTS files (name TEXT, data BLOB)");
+    db.run("DROP TABLE files");
+  }
+
+  it("closes the stream's handle at the end and on cancel", async () => {
+    using db = openFiles();
+    const blob = db.openBlob("files", "data", 1);
+    const stream = blob.stream();
+    blob.close();
+    expect(() => blob.stream()).toThrow("Blob has closed");
+    expect(() => dropFiles(db)).toThrow("locked");
+    expect(await new Response(stream).bytes()).toEqual(data);
+    dropFiles(db);
+
+    db.run("CREATE TABLE files (data BLOB)");
+    db.run("INSERT INTO files VALUES (?)", [data]);
+    using partial = db.openBlob("files", "data", 1);
+    const reader = partial.stream().getReader();
+    partial.close();
+    expect((await reader.read()).value.length).toBe(65536);
+    await reader.cancel();
+    dropFiles(db);
+  });
+
+  it("closes handles that are dropped without close()", async () => {
+    using db = openFiles();
+    (() => {
+      db.openBlob("files", "data", 1);
+      db.openBlob("files", "data", 2).stream();
+    })();
+    for (let i = 0; i < 100; i++) {
+      Bun.gc(true);
+      await Bun.sleep(1);
+      try {
+        dropFiles(db);
+        return;
+      } catch (error) {
+        expect(error.message).toContain("locked");
+      }
+    }
+    dropFiles(db);
+  });
+});
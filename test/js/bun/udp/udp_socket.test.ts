@@ -643,3 +643,32 @@ test("sendMany() sends every packet of a larger-than-one-batch call", async () =
     server.close();
   }
 });
+
+// On Linux, runs of same-peer, equal-size datagrams in one sendMany go out as
+// a single UDP_SEGMENT (GSO) send; the receiver must still see each datagram
+// with its own size and bytes, including a shorter one that ends a run.
+test("sendMany() keeps datagram boundaries for runs of equal-size payloads", async () => {
+  const sizes = [...Array(40).fill(1200), 600, ...Array(30).fill(1000), 1200, 64];
+  const payloads = sizes.map((size, i) => Buffer.alloc(size, i));
+  const { promise, resolve } = Promise.withResolvers<Buffer[]>();
+  const received: Buffer[] = [];
+  const server = await udpSocket({
+    binaryType: "buffer",
+    socket: {
+      data(_socket, data) {
+        received.push(Buffer.from(data));
+        if (received.length === sizes.length) resolve(received);
+      },
+    },
+  });
+  const client = await udpSocket({ connect: { port: server.port, hostname: "127.0.0.1" } });
+  try {
+    expect(client.sendMany(payloads)).toBe(sizes.length);
+    const got = await promise;
+    expect(got.map(b => b.length)).toEqual(sizes);
+    expect(got.map(b => b[0])).toEqual(sizes.map((_, i) => i));
+  } finally {
+    client.close();
+    server.close();
+  }
+});
@@ -0,0 +1,38 @@
+// Worker half of websocket-server-broadcast-group.test.ts: a server in the
+// same broadcast group whose clients subscribe to "room" on open, and which
+// publishes a numbered burst to "room" when asked.
+const { perMessageDeflate } = Bun.env.BROADCAST_TEST_DEFLATE === "1" ? { perMessageDeflate: true } : {};
+
+const server = Bun.serve({
+  port: 0,
+  fetch(req, server) {
+    if (server.upgrade(req)) return;
+    return new Response("expected a websocket", { status: 400 });
+  },
+  websocket: {
+    broadcastGroup: "broadcast-group-test",
+    perMessageDeflate,
+    open(ws) {
+      ws.subscribe("room");
+      postMessage({ type: "subscribed" });
+    },
+    message(ws, message) {
+      ws.publish("room", `worker: ${message}`);
+    },
+  },
+});
+
+self.onmessage = event => {
+  if (event.data === "stop") {
+    server.stop(true);
+    process.exit(0);
+  }
+  // Publish a numbered run of messages as fast as possible.
+  if (event.data?.type === "burst") {
+    const { id, count } = event.data;
+    for (let i = 0; i < count; i++) server.publish("room", `${id}:${i}`);
+    postMessage({ type: "burst-done" });
+  }
+};
+
+postMessage({ type: "ready", port: server.port });
@@ -0,0 +1,125 @@
+import { expect, test } from "bun:test";
+import { join } from "node:path";
+
+function startWorker(deflate: boolean) {
+  const worker = new Worker(join(import.meta.dir, "websocket-server-broadcast-group-worker.js"), {
+    env: { ...Bun.env, BROADCAST_TEST_DEFLATE: deflate ? "1" : "0" },
+  });
+  const messages: any[] = [];
+  let notify = () => {};
+  worker.onmessage = event => {
+    messages.push(event.data);
+    notify();
+  };
+  const next = async (type: string) => {
+    while (true) {
+      const index = messages.findIndex(m => m.type === type);
+      if (index !== -1) return messages.splice(index, 1)[0];
+      await new Promise<void>(resolve => (notify = resolve));
+    }
+  };
+  return { worker, next };
+}
+
+test.each([false, true])("publish reaches subscribers on another thread (perMessageDeflate: %p)", async deflate => {
+  const received: string[] = [];
+  let onReceived = () => {};
+
+  using server = Bun.serve({
+    port: 0,
+    fetch: () => new Response("no"),
+    websocket: {
+      broadcastGroup: "broadcast-group-test",
+      perMessageDeflate: deflate,
+      message() {},
+    },
+  });
+
+  const { worker, next } = startWorker(deflate);
+  try {
+    const { port } = await next("ready");
+
+    const client = new WebSocket(`ws://localhost:${port}`);
+    client.onmessage = event => {
+      received.push(String(event.data));
+      onReceived();
+    };
+    await next("subscribed");
+
+    // Nobody on this thread subscribes, but the message is forwarded.
+    expect(server.publish("room", "from main thread")).toBeGreaterThan(0);
+    server.publish("room", "x".repeat(64 * 1024), deflate);
+
+    while (received.length < 2) await new Promise<void>(resolve => (onReceived = resolve));
+    expect(received[0]).toBe("from main thread");
+    expect(received[1]).toBe("x".repeat(64 * 1024));
+    client.close();
+  } finally {
+    worker.postMessage("stop");
+    await new Promise(resolve => worker.addEventListener("close", resolve));
+  }
+});
+
+test("frames from each producer arrive in order when a ring overflows", async () => {
+  // Two workers publish far more than a member's ring holds while this
+  // thread is busy, so frames go through both the ring and the overflow list.
+  const count = 20_000;
+  const last = [-1, -1];
+  let received = 0;
+  let outOfOrder = 0;
+  let onReceived = () => {};
+
+  using server = Bun.serve({
+    port: 0,
+    fetch(req, server) {
+      if (server.upgrade(req)) return;
+      return new Response("no", { status: 400 });
+    },
+    websocket: {
+      broadcastGroup: "broadcast-group-test",
+      open(ws) {
+        ws.subscribe("room");
+      },
+      message() {},
+    },
+  });
+
+  const producers = [startWorker(false), startWorker(false)];
+  try {
+    await Promise.all(producers.map(({ next }) => next("ready")));
+
+    const client = new WebSocket(`ws://localhost:${server.port}`);
+    client.onmessage = event => {
+      const [id, seq] = String(event.data).split(":").map(Number);
+      if (seq !== last[id] + 1) outOfOrder++;
+      last[id] = seq;
+      received++;
+      onReceived();
+    };
+    await new Promise(resolve => (client.onopen = resolve));
+
+    producers.forEach(({ worker }, id) => worker.postMessage({ type: "burst", id, count }));
+    // Keep this loop from draining while the bursts run.
+    Bun.sleepSync(50);
+    await Promise.all(producers.map(({ next }) => next("burst-done")));
+
+    while (received < 2 * count) await new Promise<void>(resolve => (onReceived = resolve));
+    expect(outOfOrder).toBe(0);
+    expect(last).toEqual([count - 1, count - 1]);
+    client.close();
+  } finally {
+    for (const { worker } of producers) {
+      worker.postMessage("stop");
+      await new Promise(resolve => worker.addEventListener("close", resolve));
+    }
+  }
+});
+
+test("servers without the option keep publishes on their own thread", async () => {
+  using server = Bun.serve({
+    port: 0,
+    fetch: () => new Response("no"),
+    websocket: { message() {} },
+  });
+  expect(server.publish("room", "nobody")).toBe(0);
+});
@@ -0,0 +1,87 @@
+import { expect, test } from "bun:test";
+
+async function connect(port: number) {
+  const client = new WebSocket(`ws://localhost:${port}`);
+  const received: string[] = [];
+  let onReceived = () => {};
+  client.onmessage = event => {
+    received.push(String(event.data));
+    onReceived();
+  };
+  await new Promise((resolve, reject) => {
+    client.onopen = resolve;
+    client.onerror = reject;
+  });
+  const nextMessage = async () => {
+    while (!received.length) await new Promise<void>(resolve => (onReceived = resolve));
+    return received.shift()!;
+  };
+  return { client, nextMessage };
+}
+
+test('compress: "pooled" shares a bounded set of windows between sockets', async () => {
+  const sockets: any[] = [];
+  let onOpen = () => {};
+
+  using server = Bun.serve({
+    port: 0,
+    fetch(req, server) {
+      if (server.upgrade(req)) return;
+      return new Response("no");
+    },
+    websocket: {
+      perMessageDeflate: { compress: "pooled", poolSize: 1 },
+      open(ws) {
+        sockets.push(ws);
+        onOpen();
+      },
+      message() {},
+    },
+  });
+
+  const a = await connect(server.port);
+  const b = await connect(server.port);
+  while (sockets.length < 2) await new Promise<void>(resolve => (onOpen = resolve));
+  expect(a.client.extensions).toContain("permessage-deflate");
+
+  // Alternating senders keep taking the only window from each other, so every
+  // message after an eviction must decode without the previous context.
+  for (let i = 0; i < 4; i++) {
+    for (const [ws, client] of [
+      [sockets[0], a],
+      [sockets[1], b],
+    ] as const) {
+      const message = `message ${i} `.repeat(200);
+      ws.send(message, true);
+      expect(await client.nextMessage()).toBe(message);
+    }
+  }
+
+  // The same socket twice in a row keeps its window.
+  sockets[0].send("again ".repeat(200), true);
+  sockets[0].send("again ".repeat(200), true);
+  expect(await a.nextMessage()).toBe("again ".repeat(200));
+  expect(await a.nextMessage()).toBe("again ".repeat(200));
+
+  const stats = server.webSocketCompressionStats();
+  expect(stats.capacity).toBe(1);
+  expect(stats.windows).toBe(1);
+  expect(stats.sockets).toBe(2);
+  expect(stats.hits).toBeGreaterThanOrEqual(1);
+  expect(stats.evictions).toBeGreaterThanOrEqual(7);
+  expect(stats.windowBytes).toBeGreaterThan(0);
+  expect(stats.bytesPerSocket).toBe(stats.windowBytes / 2);
+
+  a.client.close();
+  b.client.close();
+});
+
+test("rejects an invalid poolSize", () => {
+  expect(() =>
+    Bun.serve({
+      port: 0,
+      fetch: () => new Response("no"),
+      websocket: { perMessageDeflate: { compress: "pooled", poolSize: 0 }, message() {} },
+    }),
+  ).toThrow("poolSize");
+});
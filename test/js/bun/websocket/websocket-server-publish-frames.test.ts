@@ -0,0 +1,122 @@
+import net from "node:net";
+import zlib from "node:zlib";
+import { expect, test } from "bun:test";
+
+const CLIENTS = 8;
+
+test.each([false, "shared", "dedicated", "pooled"] as const)(
+  "publish delivers every frame variant to every subscriber (compress: %p)",
+  async compress => {
+    const sockets: any[] = [];
+    let onSubscribed = () => {};
+
+    using server = Bun.serve({
+      port: 0,
+      fetch(req, server) {
+        if (server.upgrade(req)) return;
+        return new Response("no");
+      },
+      websocket: {
+        perMessageDeflate: compress ? { compress } : false,
+        open(ws) {
+          ws.subscribe("room");
+          sockets.push(ws);
+          onSubscribed();
+        },
+        message() {},
+      },
+    });
+
+    const received: string[][] = [];
+    let onReceived = () => {};
+    const clients = Array.from({ length: CLIENTS }, (_, i) => {
+      received.push([]);
+      const client = new WebSocket(`ws://localhost:${server.port}`);
+      client.onmessage = event => {
+        received[i].push(String(event.data));
+        onReceived();
+      };
+      return client;
+    });
+    while (sockets.length < CLIENTS) await new Promise<void>(resolve => (onSubscribed = resolve));
+
+    // Small frames are corked per subscriber; big ones skip the cork buffer
+    // and are shared by every subscriber's backpressure.
+    const messages = ["small", "small compressed", "big ".repeat(64 * 1024), "big compressed ".repeat(64 * 1024)];
+    for (const [i, message] of messages.entries()) {
+      expect(server.publish("room", message, i % 2 === 1)).toBeGreaterThan(0);
+    }
+    // A socket publishing skips itself.
+    sockets[0].publish("room", "from socket 0 ".repeat(8 * 1024), true);
+
+    const total = CLIENTS * (messages.length + 1) - 1;
+    while (received.reduce((n, r) => n + r.length, 0) < total) {
+      await new Promise<void>(resolve => (onReceived = resolve));
+    }
+    const withSocketMessage = [...messages, "from socket 0 ".repeat(8 * 1024)];
+    expect(received.filter(r => Bun.deepEquals(r, messages)).length).toBe(1);
+    expect(received.filter(r => Bun.deepEquals(r, withSocketMessage)).length).toBe(CLIENTS - 1);
+
+    for (const client of clients) client.close();
+  },
+);
+
+// The frame deflated once per publish uses a 15-bit window. A pooled socket
+// whose client asked for server_max_window_bits=9 has to compress the payload
+// itself, or back-references past 512 bytes reach a client that cannot
+// resolve them.
+test('publish respects a smaller server_max_window_bits on compress: "pooled"', async () => {
+  let onSubscribed = () => {};
+  let subscribed = false;
+  using server = Bun.serve({
+    port: 0,
+    fetch(req, server) {
+      if (server.upgrade(req)) return;
+      return new Response("no");
+    },
+    websocket: {
+      perMessageDeflate: { compress: "pooled" },
+      open(ws) {
+        ws.subscribe("room");
+        subscribed = true;
+        onSubscribed();
+      },
+      message() {},
+    },
+  });
+
+  const { promise: frame, resolve, reject } = Promise.withResolvers<Buffer>();
+  let buffered = Buffer.alloc(0);
+  const socket = net.connect(server.port, "127.0.0.1", () => {
+    socket.write(
+      "GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n" +
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n" +
+        "Sec-WebSocket-Extensions: permessage-deflate; server_max_window_bits=9\r\n\r\n",
+    );
+  });
+  socket.on("error", reject);
+  socket.on("data", data => {
+    buffered = Buffer.concat([buffered, data]);
+    const headEnd = buffered.indexOf("\r\n\r\n");
+    if (headEnd < 0) return;
+    const body = buffered.subarray(headEnd + 4);
+    if (body.length < 4) return;
+    let length = body[1] & 0x7f;
+    let offset = 2;
+    if (length === 126) [length, offset] = [body.readUInt16BE(2), 4];
+    if (body.length >= offset + length) resolve(body.subarray(0, offset + length));
+  });
+
+  while (!subscribed) await new Promise<void>(resolve => (onSubscribed = resolve));
+  // A random kilobyte repeated: every repeat is a back-reference 1024 bytes away.
+  const block = Buffer.from(crypto.getRandomValues(new Uint8Array(768))).toString("base64");
+  const message = block.repeat(4);
+  expect(server.publish("room", message, true)).toBeGreaterThan(0);
+
+  const received = await frame;
+  socket.destroy();
+  expect(received[0] & 0x40).toBe(0x40);
+  const payloadOffset = (received[1] & 0x7f) === 126 ? 4 : 2;
+  const deflated = Buffer.concat([received.subarray(payloadOffset), Buffer.from([0, 0, 0xff, 0xff])]);
+  expect(zlib.inflateRawSync(deflated, { windowBits: 9 }).toString()).toBe(message);
+});
@@ -1,3 +1,4 @@
+import { haveSameStructure } from "bun:internal-for-testing";
 import { heapStats } from "bun:jsc";
 import { describe, expect, test } from "bun:test";
 import { bunEnv, bunExe, isWindows, tempDir } from "harness";
@@ -1816,19 +1817,48 @@ describe("row-shape structure caching", () => {
     db.close();
   });
 
-  test("picks up column renames across ALTER TABLE (structure rebuilt per reset)", () => {
+  test("picks up column renames across ALTER TABLE (structure rebuilt on re-prepare)", () => {
     // sqlite3_prepare_v2 transparently re-prepares on SQLITE_SCHEMA,
     // so after ALTER TABLE … RENAME COLUMN the same `SELECT *`
     // statement returns the SAME column count with DIFFERENT names.
     // Keying the row-structure cache on count alone would serve the
-    // stale names forever; it must be rebuilt on each reset.
+    // stale names forever; it is keyed on the re-prepare count too.
     const db = new DatabaseSync(":memory:");
     db.exec("CREATE TABLE t (a INTEGER, b INTEGER); INSERT INTO t VALUES (1, 2)");
     const stmt = db.prepare("SELECT * FROM t");
     expect(stmt.get()).toEqual({ a: 1, b: 2 });
+    expect(stmt.get()).toEqual({ a: 1, b: 2 });
     db.exec("ALTER TABLE t RENAME COLUMN a TO x");
     expect(stmt.get()).toEqual({ x: 1, b: 2 });
-    db.close();
+    expect(stmt.all()).toEqual([{ x: 1, b: 2 }]);
+    db.close();
+  });
+
+  test("statements with the same columns produce rows of the same shape", () => {
+    const a = new DatabaseSync(":memory:");
+    const b = new DatabaseSync(":memory:");
+    const stmt = a.prepare("SELECT 1 AS id, 'x' AS name");
+    const first = stmt.get();
+    const rows = [
+      stmt.get(),
+      ...stmt.all(),
+      ...stmt.iterate(),
+      a.prepare("SELECT 2 AS id, 'y' AS name").get(),
+      b.prepare("SELECT 3 AS id, 'z' AS name").get(),
+    ];
+    for (const row of rows) expect(haveSameStructure(first, row)).toBe(true);
+    expect(haveSameStructure(first, a.prepare("SELECT 1 AS name, 'x' AS id").get())).toBe(false);
+
+    // Adding a property moves that one row to a new shape and leaves the
+    // shared one alone.
+    const extended = b.prepare("SELECT 4 AS id, 'w' AS name").get();
+    extended.extra = true;
+    expect(haveSameStructure(first, extended)).toBe(false);
+    const next = a.prepare("SELECT 5 AS id, 'v' AS name").get();
+    expect(Object.keys(next)).toEqual(["id", "name"]);
+    expect(haveSameStructure(first, next)).toBe(true);
+    a.close();
+    b.close();
   });
 
   test("all() reads the column count after step() re-prepares the statement", () => {
@@ -7,10 +7,11 @@ import { expect, test } from "bun:test";
 import { once } from "node:events";
 import tls from "node:tls";
 // @ts-expect-error - debug-only export
-import { sslCtxLiveCount } from "bun:internal-for-testing";
+import { caStoreCacheStats, sslCtxLiveCount } from "bun:internal-for-testing";
 import { tempDir, tls as tlsCerts } from "harness";
 import { readFileSync, writeFileSync } from "node:fs";
 import { join } from "node:path";
+import { Worker } from "node:worker_threads";
 
 async function withServer(fn: (port: number) => Promise<void>) {
   const server = tls.createServer({ ...tlsCerts, rejectUnauthorized: false }, s => s.end());
@@ -211,6 +212,27 @@ test("file-backed config: in-place rotation invalidates cache (mtime+size in dig
   });
 });
 
+// Beneath the per-VM SSL_CTX cache, usockets keeps parsed `ca` stores in a
+// process-wide cache: contexts that cannot share an SSL_CTX (user-facing ones,
+// other Workers) still parse an identical CA bundle once.
+test("identical ca options parse the CA bundle once per process", async () => {
+  // Text outside the PEM block is ignored, and makes this key unique.
+  const ca = `ca-store-cache ${Math.random()}\n${tlsCerts.cert}`;
+  const before = caStoreCacheStats();
+  tls.createSecureContext({ ca });
+  tls.createSecureContext({ ca, rejectUnauthorized: false });
+
+  const worker = new Worker(
+    `require("node:tls").createSecureContext({ ca: require("node:worker_threads").workerData });`,
+    { eval: true, workerData: ca },
+  );
+  await once(worker, "exit");
+
+  const after = caStoreCacheStats();
+  expect(after.misses - before.misses).toBe(1);
+  expect(after.hits - before.hits).toBe(2);
+});
+
 test("addCACert on one user-facing context does not affect another with identical options", () => {
   const a = tls.createSecureContext({});
   const b = tls.createSecureContext({});
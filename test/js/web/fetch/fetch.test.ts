@@ -3388,8 +3388,8 @@ it("does not reuse a keep-alive connection whose response carried more bytes tha
 it("an explicit numeric `timeout` extends the socket idle deadline past the default", async () => {
   // The child runs with a 1s idle default (BUN_CONFIG_HTTP_IDLE_TIMEOUT=1) and
   // talks to an in-process server whose handler holds every request idle for
-  // 10s (longer than the worst-case firing window of the 1s idle timer, which
-  // is swept on uSockets' 4s tick) before responding.
+  // 10s (well past the worst-case firing window of the 1s idle timer) before
+  // responding.
   //
   //   - `timeout: 60_000` must override the 1s idle default and resolve.
   //   - `timeout: 0` must keep meaning "no timeout" and resolve.
@@ -3496,9 +3496,9 @@ it("the idle timer is an absolute deadline for the response header block (not re
       );
 
     // /h: DRIP_N bytes * DRIP_MS = ~20s of drip before the response would
-    // complete; the 5s idle deadline (armed padded on uSockets' 4s-tick
-    // sweep, so it fires at ~8-12s) must fire first. A build that re-arms on
-    // every partial header read resolves 200 after the full drip instead.
+    // complete; the 5s idle deadline (fires at ~5-6s) must fire first. A
+    // build that re-arms on every partial header read resolves 200 after the
+    // full drip instead.
     // /b: headers arrive in one write, then the 3-byte body trickles at
     // DRIP_MS/byte (~8s). Each body chunk re-arms the idle timer, so this
     // resolves despite taking longer than IDLE_MS overall.
@@ -15,8 +15,8 @@ function hasIPv6Loopback() {
 
 describe("WebSocket upgrade", () => {
   // https://github.com/oven-sh/bun/issues/2896
-  // BUN_CONFIG_WS_HANDSHAKE_TIMEOUT=1: uSockets sweeps every 4 s, so the
-  // effective delay is ~4-8 s, hence the 30 s test budget. The child uses
+  // BUN_CONFIG_WS_HANDSHAKE_TIMEOUT=1: the timeout fires within 1-2 s (up to
+  // ~5 s under libuv's 4 s sweep), well inside the 30 s budget. The child uses
   // Bun.listen instead of node:net to avoid ~800 ms of module load in debug.
   test.concurrent(
     "fails the handshake when the server never responds",